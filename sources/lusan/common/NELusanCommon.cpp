@@ -18,6 +18,7 @@
  ************************************************************************/
 
 #include "lusan/common/NELusanCommon.hpp"
+#include "lusan/data/common/DocFileWatcher.hpp"
 
 #include <QColor>
 #include <QDateTime>
@@ -55,6 +56,7 @@ const QString    NELusanCommon::INIT_FILE      { "./config/lusan.init" };
 namespace
 {
     bool _darkThemeIcons{ false };
+    uint32_t _themeGeneration{ 1u };
 
     //!< Lightens dark strokes so monochrome icons stay visible on dark backgrounds.
     QImage adaptImageToDark(QImage image)
@@ -107,6 +109,7 @@ QIcon NELusanCommon::loadIcon(const QString & fileName, const QSize & size /*= Q
 void NELusanCommon::setIconsForDarkTheme(bool isDark)
 {
     _darkThemeIcons = isDark;
+    ++ _themeGeneration;
 }
 
 bool NELusanCommon::iconsForDarkTheme()
@@ -114,6 +117,11 @@ bool NELusanCommon::iconsForDarkTheme()
     return _darkThemeIcons;
 }
 
+uint32_t NELusanCommon::themeGeneration()
+{
+    return _themeGeneration;
+}
+
 QString NELusanCommon::getOptionsFile()
 {
     return getUserProfileFile(OPTIONS);
@@ -136,6 +144,11 @@ uint64_t NELusanCommon::getTimestamp()
     return static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
 }
 
+QString NELusanCommon::formatDuration(uint64_t microsec)
+{
+    return QString::number(static_cast<double>(microsec) / 1000.0, 'f', 3);
+}
+
 const QString& NELusanCommon::getStyleToolbutton()
 {
     static const QString& _style(QString::fromUtf8(NELusanCommon::StyleToolbuttonChecked.data(), NELusanCommon::StyleToolbuttonChecked.length()));
@@ -254,9 +267,11 @@ QString NELusanCommon::resolveLocation(const QString& hostDirectory, const QStri
         return (candidates.isEmpty() ? QString() : candidates.first());
     }
 
+    // Asked of the file watch, so a candidate already checked is answered without the disk.
+    DocFileWatcher& watcher = DocFileWatcher::getInstance();
     for (const QString& candidate : candidates)
     {
-        if (QFileInfo(candidate).isFile())
+        if (watcher.isFile(candidate))
         {
             return candidate;
         }
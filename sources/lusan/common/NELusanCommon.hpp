@@ -124,6 +124,12 @@ namespace NELusanCommon
      **/
     uint64_t getTimestamp();
 
+    /**
+     * \brief   Converts the duration of the log in microseconds to the displayed text in milliseconds.
+     * \param   microsec    The duration in microseconds.
+     **/
+    QString formatDuration(uint64_t microsec);
+
     /**
      * \brief   Stylesheet for QToolButton when it is checked.
      **/
@@ -483,6 +489,12 @@ namespace NELusanCommon
      **/
     bool iconsForDarkTheme();
 
+    /**
+     * \brief   Returns the generation of the application theme. The generation changes
+     *          every time a theme is applied, the caches of the themed icons are rebuilt.
+     **/
+    uint32_t themeGeneration();
+
     //!< Loads new workspace icon and sets the specified size
     inline QIcon iconNewWorkspace(const QSize & size = QSize{ 32, 32 });
 
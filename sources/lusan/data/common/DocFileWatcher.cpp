@@ -0,0 +1,290 @@
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   (c) 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/common/DocFileWatcher.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the change notifications of the files the document caches read.
+ *
+ ************************************************************************/
+
+#include "lusan/data/common/DocFileWatcher.hpp"
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QMutexLocker>
+#include <QStringList>
+#include <QTimer>
+
+#include <atomic>
+
+namespace
+{
+    //!< The file checks counted since the start of the application.
+    std::atomic<quint64> _statCount{ 0u };
+}
+
+DocFileWatcher& DocFileWatcher::getInstance()
+{
+    static DocFileWatcher _watcher;
+    return _watcher;
+}
+
+DocFileWatcher::DocFileWatcher()
+    : QObject       ( )
+    , mActive       (QCoreApplication::instance() != nullptr)
+    , mWatcher      (nullptr)
+    , mPollTimer    (nullptr)
+    , mPollInterval (DEFAULT_POLL_MS)
+    , mFiles        ( )
+    , mMissing      ( )
+    , mClock        ( )
+    , mLock         ( )
+{
+    mClock.start();
+    // The first cache to need the service may be on a worker thread, while the watch and the
+    // poll belong to the event loop of the application.
+    if (mActive)
+    {
+        moveToThread(QCoreApplication::instance()->thread());
+    }
+}
+
+bool DocFileWatcher::watch(const QString& absolutePath, const QDateTime& modified, qint64 size, bool isFile)
+{
+    if ((mActive == false) || absolutePath.isEmpty())
+    {
+        return false;
+    }
+
+    bool added{ false };
+    {
+        QMutexLocker locker(&mLock);
+        added = (mFiles.contains(absolutePath) == false);
+        mFiles.insert(absolutePath, Stamp{ modified, size, isFile });
+        mMissing.remove(absolutePath);
+    }
+
+    if (added)
+    {
+        QMetaObject::invokeMethod(this, [this, absolutePath]() { startWatching(absolutePath); }, Qt::QueuedConnection);
+    }
+
+    return true;
+}
+
+void DocFileWatcher::unwatch(const QString& absolutePath)
+{
+    if (mActive == false)
+    {
+        return;
+    }
+
+    bool removed{ false };
+    {
+        QMutexLocker locker(&mLock);
+        removed = (mFiles.remove(absolutePath) != 0);
+    }
+
+    if (removed)
+    {
+        QMetaObject::invokeMethod(this, [this, absolutePath]() { stopWatching(absolutePath); }, Qt::QueuedConnection);
+    }
+}
+
+bool DocFileWatcher::isFile(const QString& absolutePath)
+{
+    if (absolutePath.isEmpty())
+    {
+        return false;
+    }
+
+    if (mActive)
+    {
+        QMutexLocker locker(&mLock);
+        const auto found = mFiles.constFind(absolutePath);
+        if (found != mFiles.constEnd())
+        {
+            return found->isFile;
+        }
+
+        const auto missing = mMissing.constFind(absolutePath);
+        if ((missing != mMissing.constEnd()) && ((mClock.elapsed() - *missing) < MISSING_RECHECK_MS))
+        {
+            return false;
+        }
+    }
+
+    countStat();
+    const Stamp now = stampOf(absolutePath);
+    if (now.isFile)
+    {
+        watch(absolutePath, now.modified, now.size, now.isFile);
+    }
+    else if (mActive)
+    {
+        QMutexLocker locker(&mLock);
+        const qint64 checked{ mClock.elapsed() };
+        if (mMissing.size() >= MISSING_PRUNE_COUNT)
+        {
+            mMissing.removeIf([checked](const QHash<QString, qint64>::iterator& entry) { return ((checked - entry.value()) >= MISSING_RECHECK_MS); });
+        }
+
+        mMissing.insert(absolutePath, checked);
+    }
+
+    return now.isFile;
+}
+
+bool DocFileWatcher::isWatched(const QString& absolutePath) const
+{
+    QMutexLocker locker(&mLock);
+    return mFiles.contains(absolutePath);
+}
+
+void DocFileWatcher::setPollInterval(int milliseconds)
+{
+    QMetaObject::invokeMethod(this, [this, milliseconds]()
+    {
+        mPollInterval = (milliseconds < 0 ? 0 : milliseconds);
+        if (mPollTimer == nullptr)
+        {
+            return;
+        }
+        else if (mPollInterval > 0)
+        {
+            mPollTimer->start(mPollInterval);
+        }
+        else
+        {
+            mPollTimer->stop();
+        }
+    });
+}
+
+void DocFileWatcher::countStat()
+{
+    _statCount.fetch_add(1u, std::memory_order_relaxed);
+}
+
+quint64 DocFileWatcher::getStatCount()
+{
+    return _statCount.load(std::memory_order_relaxed);
+}
+
+void DocFileWatcher::startWatching(const QString& absolutePath)
+{
+    if (mWatcher == nullptr)
+    {
+        mWatcher = new QFileSystemWatcher(this);
+        connect(mWatcher, &QFileSystemWatcher::fileChanged, this, &DocFileWatcher::onWatchedFileChanged);
+    }
+
+    if (mPollTimer == nullptr)
+    {
+        mPollTimer = new QTimer(this);
+        connect(mPollTimer, &QTimer::timeout, this, &DocFileWatcher::onPollTimeout);
+        if (mPollInterval > 0)
+        {
+            mPollTimer->start(mPollInterval);
+        }
+    }
+
+    // The file was read before the watch was put on it. Checked once more after, so a change in
+    // between is reported too.
+    mWatcher->addPath(absolutePath);
+    checkFile(absolutePath);
+}
+
+void DocFileWatcher::stopWatching(const QString& absolutePath)
+{
+    {
+        QMutexLocker locker(&mLock);
+        if (mFiles.contains(absolutePath))
+        {
+            // Registered again before this ran.
+            return;
+        }
+    }
+
+    if ((mWatcher != nullptr) && mWatcher->files().contains(absolutePath))
+    {
+        mWatcher->removePath(absolutePath);
+    }
+}
+
+void DocFileWatcher::onWatchedFileChanged(const QString& absolutePath)
+{
+    const Stamp now = stampOf(absolutePath);
+    bool registered{ false };
+    {
+        QMutexLocker locker(&mLock);
+        const auto found = mFiles.find(absolutePath);
+        if (found != mFiles.end())
+        {
+            *found = now;
+            registered = true;
+        }
+    }
+
+    // A file saved by writing a new one and renaming it over the old is not watched any more.
+    if (registered && now.modified.isValid() && (mWatcher->files().contains(absolutePath) == false))
+    {
+        mWatcher->addPath(absolutePath);
+    }
+
+    emit fileChanged(absolutePath);
+}
+
+void DocFileWatcher::onPollTimeout()
+{
+    QStringList files;
+    {
+        QMutexLocker locker(&mLock);
+        files = mFiles.keys();
+    }
+
+    for (const QString& path : files)
+    {
+        checkFile(path);
+    }
+}
+
+void DocFileWatcher::checkFile(const QString& absolutePath)
+{
+    const Stamp now = stampOf(absolutePath);
+    {
+        QMutexLocker locker(&mLock);
+        const auto found = mFiles.find(absolutePath);
+        if ((found == mFiles.end()) || (*found == now))
+        {
+            return;
+        }
+
+        *found = now;
+    }
+
+    // A file that did not exist when it was registered is watched from the moment it does.
+    if (now.modified.isValid() && (mWatcher->files().contains(absolutePath) == false))
+    {
+        mWatcher->addPath(absolutePath);
+    }
+
+    emit fileChanged(absolutePath);
+}
+
+DocFileWatcher::Stamp DocFileWatcher::stampOf(const QString& absolutePath)
+{
+    const QFileInfo info(absolutePath);
+    return Stamp{ info.lastModified(), info.size(), info.isFile() };
+}
@@ -0,0 +1,207 @@
+#ifndef LUSAN_DATA_COMMON_DOCFILEWATCHER_HPP
+#define LUSAN_DATA_COMMON_DOCFILEWATCHER_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   (c) 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/common/DocFileWatcher.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the change notifications of the files the document caches read.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class QFileSystemWatcher;
+class QTimer;
+
+/**
+ * \class   DocFileWatcher
+ * \brief   Application-wide watch on the files the document caches hold parsed copies of. A cache
+ *          registers a file with the timestamp and size its copy was read at, and drops the copy
+ *          when the file is reported changed; until then a lookup is answered from the cache
+ *          without asking the file system. Validation looks up every import on every pass, and a
+ *          timestamp check per lookup is a storm of requests on a network drive.
+ *
+ *          Changes are reported by the file system where it can, and by a poll of the registered
+ *          files at a long interval where it cannot: a network share often reports nothing, and a
+ *          file that does not exist yet cannot be watched at all.
+ *
+ *          The watch lives on the thread of the application. Without an application there is no
+ *          event loop to report on, the service is inactive and a cache checks the file on every
+ *          lookup, as a command line tool or a test expects.
+ **/
+class DocFileWatcher : public QObject
+{
+    Q_OBJECT
+
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The interval of the fallback poll, in milliseconds.
+    static constexpr int    DEFAULT_POLL_MS { 5000 };
+
+    //!< How long a path found missing is answered as missing without asking the disk, in milliseconds.
+    static constexpr int    MISSING_RECHECK_MS  { 5000 };
+
+    //!< The number of missing paths kept, before the ones past their recheck time are dropped.
+    static constexpr int    MISSING_PRUNE_COUNT { 1024 };
+
+private:
+    //!< What a registered file looked like when it was last seen.
+    struct Stamp
+    {
+        QDateTime   modified;           //!< The file timestamp.
+        qint64      size { 0 };         //!< The file size.
+        bool        isFile { false };   //!< Whether the path is an existing regular file.
+
+        inline bool operator == (const Stamp& other) const
+        {
+            return (modified == other.modified) && (size == other.size) && (isFile == other.isFile);
+        }
+    };
+
+//////////////////////////////////////////////////////////////////////////
+// Operations
+//////////////////////////////////////////////////////////////////////////
+public:
+    static DocFileWatcher& getInstance();
+
+    /**
+     * \brief   True when changes of the registered files are reported. When false, a cache has to
+     *          check the file on every lookup.
+     **/
+    inline bool isActive() const;
+
+    /**
+     * \brief   Registers the file at \p absolutePath, as it was when its content was read. A change
+     *          made since then is reported as soon as the watch is in place, so nothing is missed
+     *          between reading the file and watching it. Callable on any thread.
+     * \param   absolutePath    The file, which does not have to exist.
+     * \param   modified        The file timestamp the content was read at.
+     * \param   size            The file size the content was read at.
+     * \param   isFile          Whether the path was an existing regular file.
+     * \return  True if the file is watched, so that a change of it will be reported.
+     **/
+    bool watch(const QString& absolutePath, const QDateTime& modified, qint64 size, bool isFile);
+
+    /**
+     * \brief   Removes the file at \p absolutePath from the watch. The next check of it asks the
+     *          file system again. Callable on any thread.
+     **/
+    void unwatch(const QString& absolutePath);
+
+    /**
+     * \brief   Whether \p absolutePath is an existing regular file. A registered path is answered
+     *          from its registration. Any other path is checked, and the check is counted. An
+     *          existing file is registered, so the next question about it does not touch the disk.
+     *          A missing path is not watched: resolving an import tries several locations, and
+     *          each missing one would stay in the poll for the lifetime of the application. It is
+     *          answered as missing for MISSING_RECHECK_MS, then checked again when asked.
+     *          The import resolvers ask this of every import on every validation pass.
+     **/
+    bool isFile(const QString& absolutePath);
+
+    /**
+     * \brief   True if \p absolutePath is registered, so its changes are reported.
+     **/
+    bool isWatched(const QString& absolutePath) const;
+
+    /**
+     * \brief   Sets the interval of the fallback poll in milliseconds. 0 disables it.
+     **/
+    void setPollInterval(int milliseconds);
+
+    /**
+     * \brief   Counts one request for the timestamp of a file. Every check a lookup of the document
+     *          caches or of this service makes is counted, so a validation pass can report how many
+     *          it cost. The checks of the watch itself, the poll and the change reports, run on
+     *          their own schedule and are not counted.
+     **/
+    static void countStat();
+
+    /**
+     * \brief   The number of file checks counted since the start of the application.
+     **/
+    static quint64 getStatCount();
+
+signals:
+    /**
+     * \brief   The file at \p absolutePath is not what it was registered as. Emitted on the thread
+     *          of the application.
+     **/
+    void fileChanged(const QString& absolutePath);
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+    DocFileWatcher();
+    virtual ~DocFileWatcher() = default;
+
+    //!< Puts the watch on a registered file. Runs on the thread of the application.
+    void startWatching(const QString& absolutePath);
+
+    //!< Takes the watch off a file that is no longer registered. Runs on the thread of the application.
+    void stopWatching(const QString& absolutePath);
+
+    //!< A watched file was written, replaced or removed.
+    void onWatchedFileChanged(const QString& absolutePath);
+
+    //!< Checks every registered file.
+    void onPollTimeout();
+
+    //!< Reports the file at \p absolutePath if it is not what it is registered as.
+    void checkFile(const QString& absolutePath);
+
+    //!< What the file at \p absolutePath looks like now. The check is not counted.
+    static Stamp stampOf(const QString& absolutePath);
+
+    DocFileWatcher(const DocFileWatcher&) = delete;
+    DocFileWatcher& operator = (const DocFileWatcher&) = delete;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    const bool              mActive;            //!< Whether there is an application to report on.
+    QFileSystemWatcher*     mWatcher;           //!< The watch of the file system, created on first use.
+    QTimer*                 mPollTimer;         //!< The fallback poll, created on first use.
+    int                     mPollInterval;      //!< The interval of the fallback poll.
+    QHash<QString, Stamp>   mFiles;             //!< The registered files, as they were last seen.
+    QHash<QString, qint64>  mMissing;           //!< The paths found missing, with the time of the check on mClock.
+    QElapsedTimer           mClock;             //!< The clock of the checks of the missing paths.
+    mutable QMutex          mLock;              //!< The caches register files on worker threads.
+};
+
+//////////////////////////////////////////////////////////////////////////
+// DocFileWatcher class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline bool DocFileWatcher::isActive() const
+{
+    return mActive;
+}
+
+#endif  // LUSAN_DATA_COMMON_DOCFILEWATCHER_HPP
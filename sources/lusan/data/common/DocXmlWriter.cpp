@@ -0,0 +1,331 @@
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   (c) 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/common/DocXmlWriter.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the direct UTF-8 writer of the number-heavy document sections.
+ *
+ ************************************************************************/
+
+#include "lusan/data/common/DocXmlWriter.hpp"
+
+#include <QXmlStreamWriter>
+
+#include <charconv>
+#include <cmath>
+
+namespace
+{
+    //!< The escape QXmlStreamWriter writes for a byte of UTF-8, or nullptr if it writes the byte.
+    //!< An attribute escapes the white space too, text keeps it.
+    inline const char* escapeOf(char ch, bool attribute)
+    {
+        switch (ch)
+        {
+        case '&':
+            return "&amp;";
+        case '<':
+            return "&lt;";
+        case '>':
+            return "&gt;";
+        case '"':
+            return "&quot;";
+        case '\n':
+            return (attribute ? "&#10;" : nullptr);
+        case '\r':
+            return (attribute ? "&#13;" : nullptr);
+        case '\t':
+            return (attribute ? "&#9;" : nullptr);
+        default:
+            return nullptr;
+        }
+    }
+
+    //!< True if every character of \p text is escaped by escapeOf() or written as it is. The
+    //!< other control characters and the code points XML does not allow are left to Qt, and so
+    //!< is a carriage return in text, which the versions of Qt do not write alike.
+    bool isPlainText(const QString& text, bool attribute)
+    {
+        const QChar* pos = text.constData();
+        const QChar* end = pos + text.size();
+        for ( ; pos != end; ++pos)
+        {
+            const char16_t ch = pos->unicode();
+            if (ch < 0x20u)
+            {
+                if ((ch != u'\n') && (ch != u'\t') && ((ch != u'\r') || (attribute == false)))
+                {
+                    return false;
+                }
+            }
+            else if (pos->isHighSurrogate())
+            {
+                if (((pos + 1) == end) || (pos[1].isLowSurrogate() == false))
+                {
+                    return false;
+                }
+
+                ++pos;
+            }
+            else if (pos->isLowSurrogate() || (ch == 0xFFFEu) || (ch == 0xFFFFu))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //!< \p text escaped by a QXmlStreamWriter, as an attribute value or as text.
+    QByteArray escapedByQt(const QString& text, bool attribute)
+    {
+        QByteArray written;
+        {
+            QXmlStreamWriter xml(&written);
+            xml.writeStartElement(QLatin1StringView("a"));
+            if (attribute)
+            {
+                xml.writeAttribute(QLatin1StringView("a"), text);
+            }
+
+            xml.writeCharacters(attribute ? QString() : text);
+        }
+
+        // `<a a="` and `">` around a value, `<a>` before text.
+        return (attribute ? written.mid(6, written.size() - 8) : written.mid(3));
+    }
+}
+
+DocXmlWriter::DocXmlWriter(QByteArray& buffer, int depth)
+    : mBuffer       (buffer)
+    , mTags         ( )
+    , mDepth        (depth)
+    , mInStart      (false)
+    , mLastWasStart (false)
+    , mWroteText    (false)
+{
+}
+
+void DocXmlWriter::writeStartElement(QLatin1StringView name)
+{
+    if (finishStartElement(false) == false)
+    {
+        indent(mDepth + static_cast<int>(mTags.size()));
+    }
+
+    mBuffer.append('<');
+    mBuffer.append(name.data(), name.size());
+    mTags.append(name);
+    mInStart = true;
+    mLastWasStart = true;
+}
+
+void DocXmlWriter::writeEndElement()
+{
+    if (mTags.isEmpty())
+    {
+        return;
+    }
+
+    // An element without content is closed in its start tag.
+    if (mInStart)
+    {
+        mBuffer.append("/>", 2);
+        mInStart = false;
+        mLastWasStart = false;
+        mTags.removeLast();
+        return;
+    }
+
+    if ((finishStartElement(false) == false) && (mLastWasStart == false))
+    {
+        indent(mDepth + static_cast<int>(mTags.size()) - 1);
+    }
+
+    mLastWasStart = false;
+    const QLatin1StringView name = mTags.takeLast();
+    mBuffer.append("</", 2);
+    mBuffer.append(name.data(), name.size());
+    mBuffer.append('>');
+}
+
+void DocXmlWriter::writeAttribute(QLatin1StringView name, QLatin1StringView value)
+{
+    appendName(name);
+    bool plain{ true };
+    for (const char ch : value)
+    {
+        if ((static_cast<unsigned char>(ch) < 0x20u) || (static_cast<unsigned char>(ch) >= 0x80u) || (escapeOf(ch, true) != nullptr))
+        {
+            plain = false;
+            break;
+        }
+    }
+
+    if (plain)
+    {
+        mBuffer.append(value.data(), value.size());
+    }
+    else
+    {
+        appendEscaped(QString(value), true);
+    }
+
+    mBuffer.append('"');
+}
+
+void DocXmlWriter::writeAttribute(QLatin1StringView name, const QString& value)
+{
+    appendName(name);
+    appendEscaped(value, true);
+    mBuffer.append('"');
+}
+
+void DocXmlWriter::writeAttribute(QLatin1StringView name, int value)
+{
+    appendName(name);
+    appendNumber(mBuffer, value);
+    mBuffer.append('"');
+}
+
+void DocXmlWriter::writeAttribute(QLatin1StringView name, uint32_t value)
+{
+    appendName(name);
+    appendNumber(mBuffer, value);
+    mBuffer.append('"');
+}
+
+void DocXmlWriter::writeAttribute(QLatin1StringView name, double value)
+{
+    appendName(name);
+    appendNumber(mBuffer, value);
+    mBuffer.append('"');
+}
+
+void DocXmlWriter::writeTextElement(QLatin1StringView name, const QString& text)
+{
+    writeStartElement(name);
+    finishStartElement(true);
+    appendEscaped(text, false);
+    writeEndElement();
+}
+
+void DocXmlWriter::appendNumber(QByteArray& buffer, int value)
+{
+    char digits[16];
+    const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr - digits);
+}
+
+void DocXmlWriter::appendNumber(QByteArray& buffer, uint32_t value)
+{
+    char digits[16];
+    const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr - digits);
+}
+
+void DocXmlWriter::appendNumber(QByteArray& buffer, double value)
+{
+    // QString::number() writes 6 significant digits the way printf's %g does, except that it
+    // writes no sign for a negative zero and rounds a value exactly halfway between two 6-digit
+    // numbers away from zero, where printf rounds it to even. Only a value whose shortest form
+    // has 7 digits ending in 5 can be such a tie; that one, and a value that is not finite,
+    // is left to Qt.
+    if (value == 0.0)
+    {
+        buffer.append('0');
+        return;
+    }
+
+    char digits[32];
+    std::to_chars_result result{ digits, std::errc() };
+    bool tie{ true };
+    if (std::isfinite(value))
+    {
+        result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::scientific);
+        int count{ 0 };
+        char last{ '0' };
+        for (const char* pos = digits; (pos != result.ptr) && (*pos != 'e'); ++pos)
+        {
+            if ((*pos >= '0') && (*pos <= '9'))
+            {
+                ++count;
+                last = *pos;
+            }
+        }
+
+        tie = (count == 7) && (last == '5');
+    }
+
+    if (tie)
+    {
+        buffer.append(QString::number(value).toLatin1());
+    }
+    else
+    {
+        result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+        buffer.append(digits, result.ptr - digits);
+    }
+}
+
+bool DocXmlWriter::finishStartElement(bool contents)
+{
+    const bool hadText{ mWroteText };
+    mWroteText = contents;
+    if (mInStart)
+    {
+        mBuffer.append('>');
+        mInStart = false;
+    }
+
+    return hadText;
+}
+
+void DocXmlWriter::indent(int level)
+{
+    mBuffer.append('\n');
+    mBuffer.append(static_cast<qsizetype>(level) * INDENT, ' ');
+}
+
+void DocXmlWriter::appendName(QLatin1StringView name)
+{
+    mBuffer.append(' ');
+    mBuffer.append(name.data(), name.size());
+    mBuffer.append("=\"", 2);
+}
+
+void DocXmlWriter::appendEscaped(const QString& text, bool attribute)
+{
+    if (isPlainText(text, attribute) == false)
+    {
+        mBuffer.append(escapedByQt(text, attribute));
+        return;
+    }
+
+    // The escaped characters are ASCII, so the escape is done on the UTF-8, in runs between them.
+    const QByteArray utf8 = text.toUtf8();
+    const char* run = utf8.constData();
+    const char* end = run + utf8.size();
+    for (const char* pos = run; pos != end; ++pos)
+    {
+        const char* escape = escapeOf(*pos, attribute);
+        if (escape != nullptr)
+        {
+            mBuffer.append(run, pos - run);
+            mBuffer.append(escape);
+            run = pos + 1;
+        }
+    }
+
+    mBuffer.append(run, end - run);
+}
@@ -0,0 +1,124 @@
+#ifndef LUSAN_DATA_COMMON_DOCXMLWRITER_HPP
+#define LUSAN_DATA_COMMON_DOCXMLWRITER_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   (c) 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/common/DocXmlWriter.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the direct UTF-8 writer of the number-heavy document sections.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QByteArray>
+#include <QLatin1StringView>
+#include <QList>
+#include <QString>
+
+#include <cstdint>
+
+/**
+ * \class   DocXmlWriter
+ * \brief   Appends elements to a document buffer as UTF-8, byte for byte as the auto-formatting
+ *          QXmlStreamWriter of the documents writes them: the same indentation, the same escapes,
+ *          the numbers as QString::number() formats them. It takes the calls of that writer that
+ *          a section of elements, attributes and text needs, plus the numbers themselves, and
+ *          formats them straight into the buffer without a QString in between.
+ *
+ *          The writer continues a document the auto-formatting writer has started, after an
+ *          element it has closed. A string the writer cannot be sure to escape alike, one with a
+ *          control character or a code point XML does not allow, is escaped by a QXmlStreamWriter.
+ **/
+class DocXmlWriter
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The spaces a level is indented by, as the documents are written.
+    static constexpr int    INDENT  { 4 };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   Starts to append to \p buffer.
+     * \param   buffer  The document, written up to the end of an element.
+     * \param   depth   The number of elements open around the appended ones.
+     **/
+    DocXmlWriter(QByteArray& buffer, int depth);
+    ~DocXmlWriter() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Operations
+//////////////////////////////////////////////////////////////////////////
+public:
+    void writeStartElement(QLatin1StringView name);
+
+    void writeEndElement();
+
+    void writeAttribute(QLatin1StringView name, QLatin1StringView value);
+
+    void writeAttribute(QLatin1StringView name, const QString& value);
+
+    void writeAttribute(QLatin1StringView name, int value);
+
+    void writeAttribute(QLatin1StringView name, uint32_t value);
+
+    void writeAttribute(QLatin1StringView name, double value);
+
+    void writeTextElement(QLatin1StringView name, const QString& text);
+
+    /**
+     * \brief   Appends \p value as QString::number() writes it.
+     **/
+    static void appendNumber(QByteArray& buffer, int value);
+    static void appendNumber(QByteArray& buffer, uint32_t value);
+    static void appendNumber(QByteArray& buffer, double value);
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+    //!< Closes an open start tag, as QXmlStreamWriter does before the next token.
+    //!< Returns whether text was written since the last tag.
+    bool finishStartElement(bool contents);
+
+    //!< Starts a new line at the indentation of \p level.
+    void indent(int level);
+
+    //!< Appends the name of an attribute and opens its value.
+    void appendName(QLatin1StringView name);
+
+    //!< Appends an attribute value or text, escaped. \p attribute escapes the white space too.
+    void appendEscaped(const QString& text, bool attribute);
+
+    DocXmlWriter(const DocXmlWriter& /*src*/) = delete;
+    DocXmlWriter& operator = (const DocXmlWriter& /*src*/) = delete;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    QByteArray&                 mBuffer;        //!< The document appended to.
+    QList<QLatin1StringView>    mTags;          //!< The elements opened by the writer.
+    const int                   mDepth;         //!< The elements open around the written ones.
+    bool                        mInStart;       //!< Whether a start tag is open.
+    bool                        mLastWasStart;  //!< Whether the last tag was a start tag.
+    bool                        mWroteText;     //!< Whether text was written since the last tag.
+};
+
+#endif  // LUSAN_DATA_COMMON_DOCXMLWRITER_HPP
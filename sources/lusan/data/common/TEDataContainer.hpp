@@ -19,6 +19,7 @@
  *
  ************************************************************************/
 
+#include <QHash>
 #include <QList>
 #include "lusan/common/NELusanCommon.hpp"
 #include "lusan/common/ElementBase.hpp"
@@ -30,11 +31,23 @@
 /**
  * \class   TEDataContainer
  * \brief   Template class for managing a list of data elements.
+ *
+ *          The lookups by ID and by name of a list of INDEX_MIN_ELEMENTS or more elements go
+ *          through a hash of the list positions, built on the first lookup. Appending keeps
+ *          the hash, any other change of the list drops it. A name can change without the
+ *          container knowing, so a name is confirmed on the element and a missed name is
+ *          looked up in the list as well. The list itself, its order and the XML written
+ *          from it are not affected.
  **/
 template<class Data, class ElemBase>
 class TEDataContainer : public ElemBase
 {
     using ref = NELusanCommon::get_ref<Data>;    using ptr = NELusanCommon::get_ptr<Data>;
+
+public:
+    //!< The smallest list, which lookups go through the hash of the positions. A shorter list is scanned.
+    static constexpr int    INDEX_MIN_ELEMENTS  { 16 };
+
 //////////////////////////////////////////////////////////////////////////
 // Constructors
 //////////////////////////////////////////////////////////////////////////
@@ -456,6 +469,33 @@ protected:
      **/
     inline void setIdReordering(bool reorder);
 
+    /**
+     * \brief   Called after every change of the list or of the element IDs: an element is
+     *          added, inserted, replaced or removed, the list is set, sorted or reordered,
+     *          or the IDs are re-numbered. Does nothing by default; a derived container
+     *          overrides it to drop whatever it derives from the list.
+     **/
+    virtual void elementsChanged();
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+    //!< Returns the position of the element with the ID, -1 if there is none.
+    int indexOfId(uint32_t id) const;
+
+    //!< Returns the position of the first element with the name, -1 if there is none.
+    int indexOfName(const QString& name) const;
+
+    //!< Builds the hash of the positions of the elements.
+    void buildIndex() const;
+
+    //!< Adds the last element of the list to the hash of the positions, if it is built.
+    inline void listAppended();
+
+    //!< Drops the hash of the positions.
+    inline void listChanged();
+
 //////////////////////////////////////////////////////////////////////////
 // Protected members
 //////////////////////////////////////////////////////////////////////////
@@ -463,6 +503,11 @@ protected:
     QList<Data>                 mElementList; //!< The list of data elements.
     NELusanCommon::eSortingType mSorting;     //!< The sorting type.
     bool                        mReorderIds;  //!< Whether a list change re-numbers the elements.
+
+private:
+    mutable QHash<uint32_t, int>    mIdIndex    { };        //!< The positions of the elements by ID.
+    mutable QHash<QString, int>     mNameIndex  { };        //!< The positions of the first elements by name.
+    mutable bool                    mIndexed    { false };  //!< Whether the hashes of the positions are built.
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -534,6 +579,8 @@ TEDataContainer<Data, ElemBase>& TEDataContainer<Data, ElemBase>::operator = (co
         mSorting     = other.mSorting;
         mReorderIds  = other.mReorderIds;
         fixEntries();
+        listChanged();
+        elementsChanged();
     }
 
     return *this;
@@ -549,6 +596,8 @@ TEDataContainer<Data, ElemBase>& TEDataContainer<Data, ElemBase>::operator = (TE
         mSorting     = other.mSorting;
         mReorderIds  = other.mReorderIds;
         fixEntries();
+        listChanged();
+        elementsChanged();
     }
 
     return *this;
@@ -572,6 +621,8 @@ void TEDataContainer<Data, ElemBase>::setElements(const QList<Data>& elements)
     mElementList = elements;
     fixEntries();
     reorderIds();
+    listChanged();
+    elementsChanged();
 }
 
 template<class Data, class ElemBase>
@@ -580,6 +631,8 @@ inline void TEDataContainer<Data, ElemBase>::setElements(QList<Data>&& elements)
     mElementList = std::move(elements);
     fixEntries();
     reorderIds();
+    listChanged();
+    elementsChanged();
 }
 
 template<class Data, class ElemBase>
@@ -589,6 +642,8 @@ bool TEDataContainer<Data, ElemBase>::addElement(Data&& element, bool unique)
     {
         mElementList.append(std::move(element));
         reorderIds();
+        listAppended();
+        elementsChanged();
         return true;
     }
 
@@ -602,6 +657,8 @@ bool TEDataContainer<Data, ElemBase>::addElement(const Data& element, bool uniqu
     {
         mElementList.append(element);
         reorderIds();
+        listAppended();
+        elementsChanged();
         return true;
     }
 
@@ -624,6 +681,8 @@ bool TEDataContainer<Data, ElemBase>::replaceElement(const Data& oldElement, Dat
         newElement.setId(temp->getId());
         *temp = std::move(newElement);
         reorderIds();
+        listChanged();
+        elementsChanged();
         return true;
     }
 
@@ -647,6 +706,8 @@ bool TEDataContainer<Data, ElemBase>::replaceElement(const Data& oldElement, con
         newElem->setId(oldElem->getId());
         *element = newElement;
         reorderIds();
+        listChanged();
+        elementsChanged();
         return true;
     }
 
@@ -666,6 +727,8 @@ bool TEDataContainer<Data, ElemBase>::replaceElement(uint32_t id, Data&& newElem
             newElem->setId(temp->getId());
             mElementList[i] = std::move(newElement);
             reorderIds();
+            listChanged();
+            elementsChanged();
             return true;
         }
     }
@@ -686,6 +749,8 @@ bool TEDataContainer<Data, ElemBase>::replaceElement(uint32_t id, const Data& ne
             newElem->setId(temp->getId());
             mElementList[i] = newElement;
             reorderIds();
+            listChanged();
+            elementsChanged();
             return true;
         }
     }
@@ -706,6 +771,8 @@ bool TEDataContainer<Data, ElemBase>::replaceElement(const QString& name, Data&&
             newElem->setId(temp->getId());
             mElementList[i] = std::move(newElement);
             reorderIds();
+            listChanged();
+            elementsChanged();
             return true;
         }
     }
@@ -726,6 +793,8 @@ bool TEDataContainer<Data, ElemBase>::replaceElement(const QString& name, const
             newElem->setId(temp->getId());
             mElementList[i] = newElement;
             reorderIds();
+            listChanged();
+            elementsChanged();
             return true;
         }
     }
@@ -745,6 +814,8 @@ bool TEDataContainer<Data, ElemBase>::insertElement(int index, Data&& element, b
     {
         mElementList.insert(index, std::move(element));
         reorderIds();
+        listChanged();
+        elementsChanged();
         return true;
     }
 
@@ -763,6 +834,8 @@ bool TEDataContainer<Data, ElemBase>::insertElement(int index, const Data& eleme
     {
         mElementList.insert(index, element);
         reorderIds();
+        listChanged();
+        elementsChanged();
         return true;
     }
 
@@ -783,6 +856,8 @@ bool TEDataContainer<Data, ElemBase>::removeElement(uint32_t id, Data* elemRemov
             }
 
             mElementList.removeAt(i);
+            listChanged();
+            elementsChanged();
             return true;
         }
     }
@@ -804,6 +879,8 @@ bool TEDataContainer<Data, ElemBase>::removeElement(const QString& name, Data* e
             }
 
             mElementList.removeAt(i);
+            listChanged();
+            elementsChanged();
             return true;
         }
     }
@@ -815,81 +892,42 @@ template<class Data, class ElemBase>
 inline void TEDataContainer<Data, ElemBase>::removeAllElements()
 {
     mElementList.clear();
+    listChanged();
+    elementsChanged();
 }
 
 template<class Data, class ElemBase>
 Data* TEDataContainer<Data, ElemBase>::findElement(const QString& uniqueName) const
 {
-    for (const Data& element : mElementList)
-    {
-        const auto* elem = ptr{}(element);
-        if (elem->getName() == uniqueName)
-        {
-            return const_cast<Data *>(&element);
-        }
-    }
-
-    return nullptr;
+    const int index = indexOfName(uniqueName);
+    return (index >= 0 ? const_cast<Data *>(&mElementList[index]) : nullptr);
 }
 
 template<class Data, class ElemBase>
 Data* TEDataContainer<Data, ElemBase>::findElement(const QString& uniqueName)
 {
-    for (Data& element : mElementList)
-    {
-        auto* elem = ptr{}(element);
-        if (elem->getName() == uniqueName)
-        {
-            return static_cast<Data *>(&element);
-        }
-    }
-
-    return nullptr;
+    const int index = indexOfName(uniqueName);
+    return (index >= 0 ? &mElementList[index] : nullptr);
 }
 
 template<class Data, class ElemBase>
 Data* TEDataContainer<Data, ElemBase>::findElement(uint32_t id) const
 {
-    for (const Data& element : mElementList)
-    {
-        const auto* elem = ptr{}(element);
-        if (elem->getId() == id)
-        {
-            return const_cast<Data *>(&element);
-        }
-    }
-
-    return nullptr;
+    const int index = indexOfId(id);
+    return (index >= 0 ? const_cast<Data *>(&mElementList[index]) : nullptr);
 }
 
 template<class Data, class ElemBase>
 Data* TEDataContainer<Data, ElemBase>::findElement(uint32_t id)
 {
-    for (Data& element : mElementList)
-    {
-        auto* elem = ptr{}(element);
-        if (elem->getId() == id)
-        {
-            return static_cast<Data *>(&element);
-        }
-    }
-
-    return nullptr;
+    const int index = indexOfId(id);
+    return (index >= 0 ? &mElementList[index] : nullptr);
 }
 
 template<class Data, class ElemBase>
 int TEDataContainer<Data, ElemBase>::findIndex(const QString& name) const
 {
-    for (int i = 0; i < mElementList.size(); ++i)
-    {
-        const auto* elem = ptr{}(mElementList[i]);
-        if (elem->getName() == name)
-        {
-            return i;
-        }
-    }
-
-    return -1;
+    return indexOfName(name);
 }
 
 template<class Data, class ElemBase>
@@ -901,16 +939,7 @@ inline int TEDataContainer<Data, ElemBase>::findIndex(const Data& field) const
 template<class Data, class ElemBase>
 int TEDataContainer<Data, ElemBase>::findIndex(uint32_t id) const
 {
-    for (int i = 0; i < mElementList.size(); ++i)
-    {
-        const auto* elem = ptr{}(mElementList[i]);
-        if (elem->getId() == id)
-        {
-            return i;
-        }
-    }
-
-    return -1;
+    return indexOfId(id);
 }
 
 template<class Data, class ElemBase>
@@ -939,6 +968,8 @@ void TEDataContainer<Data, ElemBase>::sortElementsByName(bool ascending)
     getIdsSorted(ids, ascending);
     NELusanCommon::sortByName(mElementList, ascending);
     setOrderedIds(ids);
+    listChanged();
+    elementsChanged();
 }
 
 template<class Data, class ElemBase>
@@ -949,6 +980,8 @@ inline void TEDataContainer<Data, ElemBase>::sortElementsById(bool ascending)
     mSorting = (ascending ? NELusanCommon::eSortingType::SortByIdAsc : NELusanCommon::eSortingType::SortByIdDesc);
     NELusanCommon::sortById(mElementList, ascending);
     setOrderedIds(ids);
+    listChanged();
+    elementsChanged();
 }
 
 template<class Data, class ElemBase>
@@ -976,6 +1009,8 @@ void TEDataContainer<Data, ElemBase>::swapElements(int index1, int index2)
     Data temp{ std::move(mElementList[index1]) };
     mElementList[index1] = mElementList[index2];
     mElementList[index2] = temp;
+    listChanged();
+    elementsChanged();
 }
 
 template<class Data, class ElemBase>
@@ -1013,6 +1048,8 @@ void TEDataContainer<Data, ElemBase>::moveElement(int from, int to)
     // reason an ID-referenced container can be reordered at all.
     mElementList.move(from, to);
     reorderIds();
+    listChanged();
+    elementsChanged();
 }
 
 template<class Data, class ElemBase>
@@ -1027,6 +1064,8 @@ void TEDataContainer<Data, ElemBase>::setOrderedIds(const QList<uint32_t>& order
         auto* temp = ptr{ }(mElementList[i]);
         temp->setId(orderedIds[i]);
     }
+
+    listChanged();
 }
 
 template<class Data, class ElemBase>
@@ -1095,18 +1134,17 @@ inline bool TEDataContainer<Data, ElemBase>::isSortedByIdDescending() const
 template<class Data, class ElemBase>
 bool TEDataContainer<Data, ElemBase>::checkUniqueness() const
 {
-    for (int i = 0; i < mElementList.size(); ++i)
+    QHash<QString, int> names;
+    names.reserve(mElementList.size());
+    for (const Data& element : mElementList)
     {
-        const auto* elem = ptr{}(mElementList[i]);
-        const QString& name{ elem->getName() };
-        for (int j = i + 1; j < mElementList.size(); ++j)
+        const auto* elem = ptr{}(element);
+        if (names.contains(elem->getName()))
         {
-            const auto* temp = ptr{}(mElementList[j]);
-            if (name == temp->getName())
-            {
-                return false;
-            }
+            return false;
         }
+
+        names.insert(elem->getName(), 0);
     }
 
     return true;
@@ -1196,6 +1234,126 @@ inline void TEDataContainer<Data, ElemBase>::setIdReordering(bool reorder)
     mReorderIds = reorder;
 }
 
+template<class Data, class ElemBase>
+void TEDataContainer<Data, ElemBase>::elementsChanged()
+{
+}
+
+template<class Data, class ElemBase>
+int TEDataContainer<Data, ElemBase>::indexOfId(uint32_t id) const
+{
+    const int count = static_cast<int>(mElementList.size());
+    if (count >= INDEX_MIN_ELEMENTS)
+    {
+        if (mIndexed == false)
+        {
+            buildIndex();
+        }
+
+        // The IDs change only by the container, a missed ID is not in the list.
+        int index = mIdIndex.value(id, -1);
+        if ((index >= 0) && ((index >= count) || (ptr{}(mElementList[index])->getId() != id)))
+        {
+            buildIndex();
+            index = mIdIndex.value(id, -1);
+        }
+
+        return index;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        const auto* elem = ptr{}(mElementList[i]);
+        if (elem->getId() == id)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+template<class Data, class ElemBase>
+int TEDataContainer<Data, ElemBase>::indexOfName(const QString& name) const
+{
+    const int count = static_cast<int>(mElementList.size());
+    if (count >= INDEX_MIN_ELEMENTS)
+    {
+        if (mIndexed == false)
+        {
+            buildIndex();
+        }
+
+        const int index = mNameIndex.value(name, -1);
+        if ((index >= 0) && (index < count) && (ptr{}(mElementList[index])->getName() == name))
+        {
+            return index;
+        }
+    }
+
+    // A short list, or a renamed element, which the container does not see.
+    for (int i = 0; i < count; ++i)
+    {
+        const auto* elem = ptr{}(mElementList[i]);
+        if (elem->getName() == name)
+        {
+            // The hash missed a renamed element, rebuild it on the next lookup.
+            mIndexed = mIndexed && (count < INDEX_MIN_ELEMENTS);
+
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+template<class Data, class ElemBase>
+void TEDataContainer<Data, ElemBase>::buildIndex() const
+{
+    const int count = static_cast<int>(mElementList.size());
+    mIdIndex.clear();
+    mNameIndex.clear();
+    mIdIndex.reserve(count);
+    mNameIndex.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const auto* elem = ptr{}(mElementList[i]);
+        mIdIndex.insert(elem->getId(), i);
+        if (mNameIndex.contains(elem->getName()) == false)
+        {
+            mNameIndex.insert(elem->getName(), i);
+        }
+    }
+
+    mIndexed = true;
+}
+
+template<class Data, class ElemBase>
+inline void TEDataContainer<Data, ElemBase>::listAppended()
+{
+    if (mIndexed)
+    {
+        const int index = static_cast<int>(mElementList.size()) - 1;
+        const auto* elem = ptr{}(mElementList[index]);
+        mIdIndex.insert(elem->getId(), index);
+        if (mNameIndex.contains(elem->getName()) == false)
+        {
+            mNameIndex.insert(elem->getName(), index);
+        }
+    }
+}
+
+template<class Data, class ElemBase>
+inline void TEDataContainer<Data, ElemBase>::listChanged()
+{
+    if (mIndexed)
+    {
+        mIdIndex.clear();
+        mNameIndex.clear();
+        mIndexed = false;
+    }
+}
+
 template<class Data, class ElemBase>
 inline void TEDataContainer<Data, ElemBase>::reorderIds()
 {
@@ -190,7 +190,7 @@ template<class FieldType>
 void TEDataTypeContainer<FieldType>::invalidate()
 {
     using BaseClass  = TEDataContainer< FieldType, DataTypeCustom >;
-    return BaseClass::mElementList.clear();
+    BaseClass::removeAllElements();
 }
 
 #endif // LUSAN_DATA_COMMON_TEDATATYPECONTAINER_HPP
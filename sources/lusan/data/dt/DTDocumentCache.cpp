@@ -20,6 +20,7 @@
 #include "lusan/data/dt/DTDocumentCache.hpp"
 
 #include "lusan/data/common/DataTypeCustom.hpp"
+#include "lusan/data/common/DocFileWatcher.hpp"
 #include "lusan/data/dt/DataTypeDocumentData.hpp"
 
 #include <QFileInfo>
@@ -35,6 +36,23 @@ QString DTDocumentCache::spaceOf(const QString& absolutePath)
     return (absolutePath.isEmpty() ? QString() : QFileInfo(absolutePath).completeBaseName());
 }
 
+DTDocumentCache::DTDocumentCache()
+{
+    // A change of a watched file drops its entry, which is what lets a watched entry be handed
+    // out without checking the file.
+    QObject::connect(&DocFileWatcher::getInstance(), &DocFileWatcher::fileChanged, [this](const QString& absolutePath)
+    {
+        invalidate(absolutePath);
+    });
+}
+
+DTDocumentCache::~DTDocumentCache()
+{
+    // A parse still waiting in the queue at exit has nobody left to read it.
+    mPool.clear();
+    mPool.waitForDone();
+}
+
 std::shared_ptr<const DataTypeDocumentData> DTDocumentCache::document(const QString& absolutePath)
 {
     if (absolutePath.isEmpty())
@@ -42,57 +60,134 @@ std::shared_ptr<const DataTypeDocumentData> DTDocumentCache::document(const QStr
         return nullptr;
     }
 
-    const QFileInfo info(absolutePath);
-    const QDateTime modified = info.lastModified();
-    const qint64    size     = info.size();
-
-    QMutexLocker locker(&mLock);
-    const auto found = mEntries.constFind(absolutePath);
-    if ((found != mEntries.constEnd()) && (found->modified == modified) && (found->size == size))
+    bool created{ false };
+    const Entry entry = claimEntry(absolutePath, created);
+    // Whoever claims the parse runs it, so a reader never waits behind the prefetch queue.
+    if (entry.pending->claimed.exchange(true) == false)
     {
-        return found->document;
+        const Document parsed = parse(absolutePath);
+        entry.pending->promise.set_value(parsed);
+        return parsed;
     }
 
-    Entry entry;
-    entry.modified = modified;
-    entry.size     = size;
-    if (info.isFile())
+    return entry.document.get();
+}
+
+void DTDocumentCache::prefetch(const QStringList& absolutePaths)
+{
+    for (const QString& path : absolutePaths)
     {
-        auto parsed = std::make_shared<DataTypeDocumentData>();
-        // A half-parsed document is worse than none: it would let a reader declare against types
-        // the file does not actually contain.
-        if (parsed->readFromFile(absolutePath) && parsed->openSucceeded())
+        bool created{ false };
+        const Entry entry = path.isEmpty() ? Entry() : claimEntry(path, created);
+        if (created == false)
         {
-            // Stamped once, here, while the document is still this function's own. From now on
-            // every reader sees it as `const` and its types answer to `Space::Name` only. The
-            // namespace is the name the document declares; the file name only fills in for a
-            // document that declares none.
-            const QString declared = parsed->getOverviewData().getName();
-            const QString space = declared.isEmpty() ? spaceOf(absolutePath) : declared;
-            for (DataTypeCustom* dataType : parsed->getDataTypeData().getCustomDataTypes())
+            continue;
+        }
+
+        std::shared_ptr<Pending> pending = entry.pending;
+        mPool.start([path, pending]() {
+            if (pending->claimed.exchange(true) == false)
             {
-                if (dataType != nullptr)
-                {
-                    dataType->setImportSpace(space);
-                }
+                pending->promise.set_value(parse(path));
             }
-
-            entry.document = std::move(parsed);
-        }
+        });
     }
-
-    mEntries.insert(absolutePath, entry);
-    return entry.document;
 }
 
 void DTDocumentCache::invalidate(const QString& absolutePath)
 {
-    QMutexLocker locker(&mLock);
-    mEntries.remove(absolutePath);
+    {
+        QMutexLocker locker(&mLock);
+        mEntries.remove(absolutePath);
+    }
+
+    DocFileWatcher::getInstance().unwatch(absolutePath);
 }
 
 void DTDocumentCache::clear()
 {
+    QStringList paths;
+    {
+        QMutexLocker locker(&mLock);
+        paths = mEntries.keys();
+        mEntries.clear();
+    }
+
+    DocFileWatcher& watcher = DocFileWatcher::getInstance();
+    for (const QString& path : paths)
+    {
+        watcher.unwatch(path);
+    }
+}
+
+DTDocumentCache::Entry DTDocumentCache::claimEntry(const QString& absolutePath, bool& out_created)
+{
+    {
+        QMutexLocker locker(&mLock);
+        const auto found = mEntries.constFind(absolutePath);
+        if ((found != mEntries.constEnd()) && found->watched)
+        {
+            out_created = false;
+            return *found;
+        }
+    }
+
+    DocFileWatcher& watcher = DocFileWatcher::getInstance();
+    DocFileWatcher::countStat();
+    const QFileInfo info(absolutePath);
+    const QDateTime modified = info.lastModified();
+    const qint64    size     = info.size();
+    const bool      isFile   = info.isFile();
+
     QMutexLocker locker(&mLock);
-    mEntries.clear();
+    const auto found = mEntries.find(absolutePath);
+    if ((found != mEntries.end()) && (found->modified == modified) && (found->size == size))
+    {
+        found->watched = watcher.watch(absolutePath, modified, size, isFile);
+        out_created = false;
+        return *found;
+    }
+
+    Entry entry;
+    entry.pending   = std::make_shared<Pending>();
+    entry.document  = entry.pending->promise.get_future().share();
+    entry.modified  = modified;
+    entry.size      = size;
+    entry.watched   = watcher.watch(absolutePath, modified, size, isFile);
+    mEntries.insert(absolutePath, entry);
+    out_created = true;
+    return entry;
+}
+
+DTDocumentCache::Document DTDocumentCache::parse(const QString& absolutePath)
+{
+    // The entry has just registered the file, so this does not touch the disk again.
+    if (DocFileWatcher::getInstance().isFile(absolutePath) == false)
+    {
+        return nullptr;
+    }
+
+    auto parsed = std::make_shared<DataTypeDocumentData>();
+    // A half-parsed document is worse than none: it would let a reader declare against types
+    // the file does not actually contain.
+    if ((parsed->readFromFile(absolutePath) == false) || (parsed->openSucceeded() == false))
+    {
+        return nullptr;
+    }
+
+    // Stamped once, here, while the document is still this function's own. From now on
+    // every reader sees it as `const` and its types answer to `Space::Name` only. The
+    // namespace is the name the document declares; the file name only fills in for a
+    // document that declares none.
+    const QString declared = parsed->getOverviewData().getName();
+    const QString space = declared.isEmpty() ? spaceOf(absolutePath) : declared;
+    for (DataTypeCustom* dataType : parsed->getDataTypeData().getCustomDataTypes())
+    {
+        if (dataType != nullptr)
+        {
+            dataType->setImportSpace(space);
+        }
+    }
+
+    return parsed;
 }
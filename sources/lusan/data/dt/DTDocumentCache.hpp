@@ -26,7 +26,11 @@
 #include <QHash>
 #include <QMutex>
 #include <QString>
+#include <QStringList>
+#include <QThreadPool>
 
+#include <atomic>
+#include <future>
 #include <memory>
 
 /************************************************************************
@@ -48,6 +52,10 @@ class DataTypeDocumentData;
  *          document and the file it came from are both in hand.
  *
  *          Entries are immutable once parsed: a reader only ever sees a `const` document.
+ *          The table is locked to find or claim an entry, never across a parse: the first
+ *          reader of a path parses it, a concurrent reader of the same path waits on that
+ *          entry, and the includes of one document are prefetched in parallel on the cache's
+ *          own thread pool.
  **/
 class DTDocumentCache
 {
@@ -55,11 +63,22 @@ class DTDocumentCache
 // Internal types
 //////////////////////////////////////////////////////////////////////////
 private:
+    using Document  = std::shared_ptr<const DataTypeDocumentData>;
+
+    //!< The parse of one entry. Whoever claims it first runs it: the pool or a reader.
+    struct Pending
+    {
+        std::promise<Document>  promise;                //!< Fulfilled once, by the claimer.
+        std::atomic_bool        claimed { false };      //!< Set by whoever runs the parse.
+    };
+
     struct Entry
     {
-        std::shared_ptr<const DataTypeDocumentData> document;    //!< Null when the file failed to parse.
-        QDateTime                                   modified;    //!< The file timestamp the entry was built from.
-        qint64                                      size { 0 };  //!< The file size at parse time.
+        std::shared_future<Document>    document;           //!< Holds null when the file failed to parse.
+        std::shared_ptr<Pending>        pending;            //!< The parse the entry is waiting on.
+        QDateTime                       modified;           //!< The file timestamp the entry was built from.
+        qint64                          size { 0 };         //!< The file size at parse time.
+        bool                            watched { false };  //!< A change of the file is reported, no check is needed.
     };
 
 //////////////////////////////////////////////////////////////////////////
@@ -76,6 +95,13 @@ public:
      **/
     std::shared_ptr<const DataTypeDocumentData> document(const QString& absolutePath);
 
+    /**
+     * \brief   Starts parsing the documents at the given absolute paths on the thread pool of
+     *          the cache. Returns at once; a later document() of any of them waits for the parse
+     *          or runs it, whichever comes first. Documents already in the cache are not read again.
+     **/
+    void prefetch(const QStringList& absolutePaths);
+
     /**
      * \brief   The fallback namespace of a file at the given path: its base name. Answered
      *          without reading the file, so a caller can name a document that does not parse.
@@ -84,12 +110,13 @@ public:
     static QString spaceOf(const QString& absolutePath);
 
     /**
-     * \brief   Drops the entry of one document, so the next request re-reads it.
+     * \brief   Drops the entry of one document and takes its file off the watch, so the next
+     *          request checks the file and re-reads it.
      **/
     void invalidate(const QString& absolutePath);
 
     /**
-     * \brief   Drops every entry.
+     * \brief   Drops every entry and takes their files off the watch.
      **/
     void clear();
 
@@ -97,7 +124,23 @@ public:
 // Hidden methods
 //////////////////////////////////////////////////////////////////////////
 private:
-    DTDocumentCache() = default;
+    DTDocumentCache();
+    ~DTDocumentCache();
+
+    /**
+     * \brief   The entry of the document at \p absolutePath. A watched entry is returned as it
+     *          is; any other is checked against the file, and a missing or stale one is replaced
+     *          by one waiting on a parse that nobody has claimed yet.
+     * \param   absolutePath    The document.
+     * \param   out_created     On output, true if the entry was created by this call.
+     **/
+    Entry claimEntry(const QString& absolutePath, bool& out_created);
+
+    /**
+     * \brief   Reads the document at \p absolutePath and stamps its namespace on its types,
+     *          or nullptr when it does not parse.
+     **/
+    static Document parse(const QString& absolutePath);
 
     DTDocumentCache(const DTDocumentCache&) = delete;
     DTDocumentCache& operator = (const DTDocumentCache&) = delete;
@@ -106,8 +149,9 @@ private:
 // Member variables
 //////////////////////////////////////////////////////////////////////////
 private:
-    QHash<QString, Entry>   mEntries;
-    QMutex                  mLock;
+    QHash<QString, Entry>   mEntries;   //!< The documents, by absolute path.
+    QMutex                  mLock;      //!< Guards the table only, never a parse.
+    QThreadPool             mPool;      //!< Runs the prefetched parses.
 };
 
 #endif  // LUSAN_DATA_DT_DTDOCUMENTCACHE_HPP
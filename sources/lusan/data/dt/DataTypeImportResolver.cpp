@@ -21,6 +21,7 @@
 
 #include "lusan/common/NELusanCommon.hpp"
 #include "lusan/data/common/DataTypeDataSection.hpp"
+#include "lusan/data/common/DocFileWatcher.hpp"
 #include "lusan/data/common/IncludeDataSection.hpp"
 #include "lusan/data/common/IncludeEntry.hpp"
 #include "lusan/data/dt/DTDocumentCache.hpp"
@@ -82,6 +83,23 @@ bool DataTypeImportResolver::refresh(DataTypeDataSection& types, const QString&
     QList<ImportedTypes> groups;
     QSet<QString>        claimed;
 
+    // Several includes are read in parallel; the loop below then only collects them.
+    QStringList included;
+    for (const IncludeEntry& include : includes.getElements())
+    {
+        const QString path = (includeKindOf(include.getLocation(), QString()) == eIncludeKind::DataType)
+                           ? absolutePath(hostFilePath, include.getLocation()) : QString();
+        if ((path.isEmpty() == false) && (included.contains(path) == false))
+        {
+            included.append(path);
+        }
+    }
+
+    if (included.size() > 1)
+    {
+        DTDocumentCache::getInstance().prefetch(included);
+    }
+
     for (const IncludeEntry& include : includes.getElements())
     {
         const QString location = include.getLocation();
@@ -97,7 +115,7 @@ bool DataTypeImportResolver::refresh(DataTypeDataSection& types, const QString&
         // Until the file is read, the best guess at the namespace is what it is called on disk.
         group.space        = DTDocumentCache::spaceOf(group.absolutePath.isEmpty() ? location : group.absolutePath);
 
-        if (group.absolutePath.isEmpty() || (QFileInfo(group.absolutePath).isFile() == false))
+        if (group.absolutePath.isEmpty() || (DocFileWatcher::getInstance().isFile(group.absolutePath) == false))
         {
             group.state = eImportState::NotFound;
             groups.append(std::move(group));
@@ -0,0 +1,136 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/LatencyHistogram.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the histogram of durations with a fixed relative precision.
+ *
+ ************************************************************************/
+
+#include "lusan/data/log/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    //!< The number of buckets per power of two range above the exactly counted values.
+    constexpr uint32_t  _halfCount  { LatencyHistogram::SubBucketCount / 2u };
+
+    //!< Returns the position of the highest set bit of the value, the value must not be 0.
+    inline uint32_t _highestBit(uint64_t value)
+    {
+        uint32_t result{ 0u };
+        while ((value >>= 1) != 0u)
+        {
+            ++ result;
+        }
+
+        return result;
+    }
+}
+
+LatencyHistogram::LatencyHistogram()
+    : mBuckets  ( )
+    , mCount    (0u)
+    , mMin      (0u)
+    , mMax      (0u)
+{
+}
+
+void LatencyHistogram::clear()
+{
+    mBuckets.clear();
+    mCount  = 0u;
+    mMin    = 0u;
+    mMax    = 0u;
+}
+
+void LatencyHistogram::record(uint64_t value)
+{
+    const uint32_t index{ _bucketIndex(value) };
+    if (index >= mBuckets.size())
+    {
+        mBuckets.resize(index + 1u, 0u);
+    }
+
+    ++ mBuckets[index];
+    mMin = (mCount == 0u) ? value : std::min(mMin, value);
+    mMax = std::max(mMax, value);
+    ++ mCount;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    if (other.mCount == 0u)
+        return;
+
+    if (other.mBuckets.size() > mBuckets.size())
+    {
+        mBuckets.resize(other.mBuckets.size(), 0u);
+    }
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(other.mBuckets.size()); ++ i)
+    {
+        mBuckets[i] += other.mBuckets[i];
+    }
+
+    mMin = (mCount == 0u) ? other.mMin : std::min(mMin, other.mMin);
+    mMax = std::max(mMax, other.mMax);
+    mCount += other.mCount;
+}
+
+uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const
+{
+    if (mCount == 0u)
+        return 0u;
+
+    // The rank of the value, at least the first value, at most the last one.
+    const double ratio{ std::clamp(percentile, 0.0, 100.0) / 100.0 };
+    const uint64_t rank{ std::max<uint64_t>(1u, static_cast<uint64_t>(std::ceil(ratio * static_cast<double>(mCount)))) };
+    uint64_t counted{ 0u };
+    for (uint32_t i = 0; i < static_cast<uint32_t>(mBuckets.size()); ++ i)
+    {
+        counted += mBuckets[i];
+        if (counted >= rank)
+        {
+            return std::clamp(_bucketUpperValue(i), getMin(), mMax);
+        }
+    }
+
+    return mMax;
+}
+
+inline uint32_t LatencyHistogram::_bucketIndex(uint64_t value)
+{
+    if (value < SubBucketCount)
+        return static_cast<uint32_t>(value);
+
+    // The value has 'SubBucketBits - 1' significant bits after the highest bit.
+    const uint32_t exponent{ _highestBit(value) };
+    const uint32_t shift{ exponent - (SubBucketBits - 1u) };
+    const uint32_t mantissa{ static_cast<uint32_t>(value >> shift) - _halfCount };
+    return SubBucketCount + (exponent - SubBucketBits) * _halfCount + mantissa;
+}
+
+inline uint64_t LatencyHistogram::_bucketUpperValue(uint32_t index)
+{
+    if (index < SubBucketCount)
+        return index;
+
+    const uint32_t offset{ index - SubBucketCount };
+    const uint32_t exponent{ SubBucketBits + offset / _halfCount };
+    const uint32_t shift{ exponent - (SubBucketBits - 1u) };
+    const uint64_t lower{ static_cast<uint64_t>(_halfCount + offset % _halfCount) << shift };
+    return lower + ((static_cast<uint64_t>(1u) << shift) - 1u);
+}
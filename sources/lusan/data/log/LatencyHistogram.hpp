@@ -0,0 +1,146 @@
+#ifndef LUSAN_DATA_LOG_LATENCYHISTOGRAM_HPP
+#define LUSAN_DATA_LOG_LATENCYHISTOGRAM_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/LatencyHistogram.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the histogram of durations with a fixed relative precision.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief   LatencyHistogram counts the durations in buckets with a fixed relative precision,
+ *          in the manner of the HDR histograms: the values below SubBucketCount are counted
+ *          exactly, every next power of two range is split in SubBucketCount / 2 buckets.
+ *          The relative error of a reported value is below 2 / SubBucketCount, the memory
+ *          does not depend on the number of recorded values, and the percentiles are read
+ *          without sorting. The histograms of the same kind of values can be merged.
+ **/
+class LatencyHistogram
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The number of bits of the value counted exactly.
+    static constexpr uint32_t   SubBucketBits   { 7u };
+    //!< The number of values counted exactly, the range of values of every bucket grows after it.
+    static constexpr uint32_t   SubBucketCount  { 1u << SubBucketBits };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram& src) = default;
+    LatencyHistogram(LatencyHistogram&& src) noexcept = default;
+    ~LatencyHistogram() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Operators
+//////////////////////////////////////////////////////////////////////////
+public:
+    LatencyHistogram& operator = (const LatencyHistogram& src) = default;
+    LatencyHistogram& operator = (LatencyHistogram&& src) noexcept = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Clears the histogram.
+     **/
+    void clear();
+
+    /**
+     * \brief   Counts the value in the histogram.
+     * \param   value   The value to count.
+     **/
+    void record(uint64_t value);
+
+    /**
+     * \brief   Adds the counts of another histogram to this histogram.
+     * \param   other   The histogram to add.
+     **/
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * \brief   Returns the number of counted values.
+     **/
+    inline uint64_t getCount() const;
+
+    /**
+     * \brief   Returns the smallest counted value, or 0 if the histogram is empty.
+     **/
+    inline uint64_t getMin() const;
+
+    /**
+     * \brief   Returns the biggest counted value, or 0 if the histogram is empty.
+     **/
+    inline uint64_t getMax() const;
+
+    /**
+     * \brief   Returns the value below or equal to which the given percent of counted values are.
+     *          The value is the upper bound of the bucket, it is never bigger than the biggest counted value.
+     * \param   percentile  The percent of the counted values, from 0 to 100.
+     **/
+    uint64_t getValueAtPercentile(double percentile) const;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Returns the index of the bucket of the value.
+    static inline uint32_t _bucketIndex(uint64_t value);
+
+    //!< Returns the biggest value counted in the bucket.
+    static inline uint64_t _bucketUpperValue(uint32_t index);
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    std::vector<uint64_t>   mBuckets;   //!< The counts of values per bucket, grows with the biggest value.
+    uint64_t                mCount;     //!< The number of counted values.
+    uint64_t                mMin;       //!< The smallest counted value.
+    uint64_t                mMax;       //!< The biggest counted value.
+};
+
+//////////////////////////////////////////////////////////////////////////
+// LatencyHistogram inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline uint64_t LatencyHistogram::getCount() const
+{
+    return mCount;
+}
+
+inline uint64_t LatencyHistogram::getMin() const
+{
+    return (mCount != 0u ? mMin : 0u);
+}
+
+inline uint64_t LatencyHistogram::getMax() const
+{
+    return mMax;
+}
+
+#endif  // LUSAN_DATA_LOG_LATENCYHISTOGRAM_HPP
@@ -0,0 +1,385 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/LogExportWriter.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the writers of the exported log messages.
+ *
+ ************************************************************************/
+
+#include "lusan/data/log/LogExportWriter.hpp"
+
+#include "areg/base/DateTime.hpp"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    //!< Appends the time in microseconds since epoch as local date and time with microseconds.
+    inline void _appendTime(QByteArray& buffer, TIME64 timestamp)
+    {
+        const QDateTime dateTime{ QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(timestamp / 1000u)) };
+        buffer.append(dateTime.toString(QStringLiteral("yyyy-MM-dd HH:mm:ss.zzz")).toLatin1());
+        buffer.append(QByteArray::number(static_cast<uint>(timestamp % 1000u)).rightJustified(3, '0'));
+    }
+
+    //!< Returns the name of the priority of the log message.
+    inline std::string _prioName(const areg::LogEntry& entry)
+    {
+        return std::string(areg::priority_to_string(entry.logMessagePrio).data());
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// LogExportWriter class implementation
+//////////////////////////////////////////////////////////////////////////
+
+LogExportWriter::eFormat LogExportWriter::getFormat(const QString& filePath)
+{
+    const QString suffix{ QFileInfo(filePath).suffix().toLower() };
+    if (suffix == QStringLiteral("sqlog"))
+        return eFormat::FormatSqlog;
+    else if (suffix == QStringLiteral("csv"))
+        return eFormat::FormatCsv;
+    else if ((suffix == QStringLiteral("ndjson")) || (suffix == QStringLiteral("jsonl")) || (suffix == QStringLiteral("json")))
+        return eFormat::FormatJson;
+    else
+        return eFormat::FormatInvalid;
+}
+
+const QString& LogExportWriter::getFileFilter()
+{
+    static const QString _filter{ "Log Files (*.sqlog);;CSV Files (*.csv);;NDJSON Files (*.ndjson *.jsonl)" };
+    return _filter;
+}
+
+std::unique_ptr<LogExportWriter> LogExportWriter::create(LogExportWriter::eFormat format)
+{
+    switch (format)
+    {
+    case eFormat::FormatSqlog:
+        return std::make_unique<LogSqliteExportWriter>();
+
+    case eFormat::FormatCsv:
+        return std::make_unique<LogCsvExportWriter>();
+
+    case eFormat::FormatJson:
+        return std::make_unique<LogJsonExportWriter>();
+
+    default:
+        return std::unique_ptr<LogExportWriter>();
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// LogTextExportWriter class implementation
+//////////////////////////////////////////////////////////////////////////
+
+LogTextExportWriter::LogTextExportWriter()
+    : LogExportWriter   ( )
+    , mFile             ( )
+    , mBuffer           ( )
+{
+}
+
+bool LogTextExportWriter::open(const QString& filePath, areg::ext::LogSqliteDatabase& /*source*/)
+{
+    mFile.setFileName(filePath);
+    if (mFile.open(QIODevice::WriteOnly) == false)
+        return false;
+
+    mBuffer.clear();
+    mBuffer.reserve(LogTextExportWriter::BUFFER_SIZE + LogTextExportWriter::BUFFER_SIZE / 4);
+    mBuffer.append(header());
+    return true;
+}
+
+bool LogTextExportWriter::write(const areg::LogEntry& entry)
+{
+    appendEntry(mBuffer, entry);
+    return (mBuffer.size() < LogTextExportWriter::BUFFER_SIZE) || flush();
+}
+
+bool LogTextExportWriter::flush()
+{
+    if (mBuffer.isEmpty())
+        return true;
+
+    const bool result{ mFile.write(mBuffer) == mBuffer.size() };
+    mBuffer.resize(0);  // keeps the capacity
+    return result;
+}
+
+bool LogTextExportWriter::close(bool commit)
+{
+    if (mFile.isOpen() == false)
+        return false;
+
+    if (commit && flush())
+    {
+        return mFile.commit();
+    }
+
+    mBuffer.clear();
+    mFile.cancelWriting();
+    mFile.commit();
+    return false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// LogCsvExportWriter class implementation
+//////////////////////////////////////////////////////////////////////////
+
+void LogCsvExportWriter::appendField(QByteArray& buffer, const char* text, int length)
+{
+    bool quote{ false };
+    for (int i = 0; (quote == false) && (i < length); ++i)
+    {
+        const char ch{ text[i] };
+        quote = (ch == ',') || (ch == '"') || (ch == '\n') || (ch == '\r');
+    }
+
+    if (quote == false)
+    {
+        buffer.append(text, length);
+        return;
+    }
+
+    buffer.append('"');
+    for (int i = 0; i < length; ++i)
+    {
+        if (text[i] == '"')
+            buffer.append('"');
+
+        buffer.append(text[i]);
+    }
+
+    buffer.append('"');
+}
+
+QByteArray LogCsvExportWriter::header() const
+{
+    return QByteArrayLiteral("Priority,Timestamp,Received,Duration,Source,Source ID,Thread,Thread ID,Scope ID,Message\n");
+}
+
+void LogCsvExportWriter::appendEntry(QByteArray& buffer, const areg::LogEntry& entry) const
+{
+    const std::string prio{ _prioName(entry) };
+    buffer.append(prio.c_str(), static_cast<int>(prio.size()));
+    buffer.append(',');
+    _appendTime(buffer, entry.logTimestamp);
+    buffer.append(',');
+    _appendTime(buffer, entry.logReceived);
+    buffer.append(',');
+    buffer.append(QByteArray::number(static_cast<qulonglong>(entry.logDuration)));
+    buffer.append(',');
+    appendField(buffer, entry.logModule, static_cast<int>(qstrlen(entry.logModule)));
+    buffer.append(',');
+    buffer.append(QByteArray::number(static_cast<qulonglong>(entry.logCookie)));
+    buffer.append(',');
+    appendField(buffer, entry.logThread, static_cast<int>(qstrlen(entry.logThread)));
+    buffer.append(',');
+    buffer.append(QByteArray::number(static_cast<qulonglong>(entry.logThreadId)));
+    buffer.append(',');
+    buffer.append(QByteArray::number(static_cast<qulonglong>(entry.logScopeId)));
+    buffer.append(',');
+    appendField(buffer, entry.logMessage, static_cast<int>(entry.logMessageLen));
+    buffer.append('\n');
+}
+
+//////////////////////////////////////////////////////////////////////////
+// LogJsonExportWriter class implementation
+//////////////////////////////////////////////////////////////////////////
+
+void LogJsonExportWriter::appendString(QByteArray& buffer, const char* text, int length)
+{
+    static constexpr char _hex[]{ "0123456789abcdef" };
+
+    buffer.append('"');
+    for (int i = 0; i < length; ++i)
+    {
+        const unsigned char ch{ static_cast<unsigned char>(text[i]) };
+        switch (ch)
+        {
+        case '"':
+            buffer.append("\\\"", 2);
+            break;
+
+        case '\\':
+            buffer.append("\\\\", 2);
+            break;
+
+        case '\n':
+            buffer.append("\\n", 2);
+            break;
+
+        case '\r':
+            buffer.append("\\r", 2);
+            break;
+
+        case '\t':
+            buffer.append("\\t", 2);
+            break;
+
+        default:
+            if (ch < 0x20u)
+            {
+                buffer.append("\\u00", 4);
+                buffer.append(_hex[ch >> 4]);
+                buffer.append(_hex[ch & 0x0Fu]);
+            }
+            else
+            {
+                // The text is UTF-8, the multibyte characters are copied as they are.
+                buffer.append(static_cast<char>(ch));
+            }
+            break;
+        }
+    }
+
+    buffer.append('"');
+}
+
+QByteArray LogJsonExportWriter::header() const
+{
+    return QByteArray();
+}
+
+void LogJsonExportWriter::appendEntry(QByteArray& buffer, const areg::LogEntry& entry) const
+{
+    const std::string prio{ _prioName(entry) };
+    buffer.append("{\"priority\":", 12);
+    appendString(buffer, prio.c_str(), static_cast<int>(prio.size()));
+    buffer.append(",\"timestamp\":");
+    buffer.append(QByteArray::number(static_cast<qulonglong>(entry.logTimestamp)));
+    buffer.append(",\"received\":");
+    buffer.append(QByteArray::number(static_cast<qulonglong>(entry.logReceived)));
+    buffer.append(",\"duration\":");
+    buffer.append(QByteArray::number(static_cast<qulonglong>(entry.logDuration)));
+    buffer.append(",\"source\":");
+    appendString(buffer, entry.logModule, static_cast<int>(qstrlen(entry.logModule)));
+    buffer.append(",\"source_id\":");
+    buffer.append(QByteArray::number(static_cast<qulonglong>(entry.logCookie)));
+    buffer.append(",\"thread\":");
+    appendString(buffer, entry.logThread, static_cast<int>(qstrlen(entry.logThread)));
+    buffer.append(",\"thread_id\":");
+    buffer.append(QByteArray::number(static_cast<qulonglong>(entry.logThreadId)));
+    buffer.append(",\"scope_id\":");
+    buffer.append(QByteArray::number(static_cast<qulonglong>(entry.logScopeId)));
+    buffer.append(",\"message\":");
+    appendString(buffer, entry.logMessage, static_cast<int>(entry.logMessageLen));
+    buffer.append("}\n", 2);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// LogSqliteExportWriter class implementation
+//////////////////////////////////////////////////////////////////////////
+
+LogSqliteExportWriter::LogSqliteExportWriter()
+    : LogExportWriter   ( )
+    , mDatabase         ( )
+    , mFilePath         ( )
+    , mPartPath         ( )
+    , mInBatch          (false)
+{
+}
+
+LogSqliteExportWriter::~LogSqliteExportWriter()
+{
+    if (mDatabase.is_operable())
+    {
+        close(false);
+    }
+}
+
+bool LogSqliteExportWriter::open(const QString& filePath, areg::ext::LogSqliteDatabase& source)
+{
+    mFilePath = filePath;
+    mPartPath = filePath + QStringLiteral(".part");
+    QFile::remove(mPartPath);
+    if (mDatabase.connect(mPartPath.toStdString(), false) == false)
+        return false;
+
+    // The instances and the scopes are copied, so that the exported file is shown with the scope trees.
+    std::vector<areg::ConnectedInstance> instances;
+    source.log_instance_infos(instances);
+    mDatabase.begin();
+    for (const areg::ConnectedInstance& instance : instances)
+    {
+        const areg::DateTime timestamp(instance.ciTimestamp);
+        mDatabase.log_instance_connected(instance, timestamp);
+
+        std::vector<areg::ScopeEntry> scopes;
+        source.log_inst_scopes(scopes, instance.ciCookie);
+        for (const areg::ScopeEntry& scope : scopes)
+        {
+            mDatabase.log_scope_activate(scope.scopeName, scope.scopeId, scope.scopePrio, instance.ciCookie, timestamp);
+        }
+    }
+
+    mInBatch = true;
+    return flush();
+}
+
+bool LogSqliteExportWriter::write(const areg::LogEntry& entry)
+{
+    if (mInBatch == false)
+    {
+        mDatabase.begin();
+        mInBatch = true;
+    }
+
+    // A failed insert (disk full, locked file) fails the export, the file is not published.
+    return mDatabase.log_message(entry, areg::DateTime(entry.logReceived));
+}
+
+bool LogSqliteExportWriter::flush()
+{
+    if (mInBatch == false)
+        return true;
+
+    mInBatch = false;
+    return mDatabase.commit(true);
+}
+
+bool LogSqliteExportWriter::close(bool commit)
+{
+    if (mDatabase.is_operable() == false)
+        return false;
+
+    bool result{ commit && flush() };
+    if (mInBatch)
+    {
+        mDatabase.commit(false);
+        mInBatch = false;
+    }
+
+    mDatabase.disconnect();
+    if (result)
+    {
+        QFile::remove(mFilePath);
+        result = QFile::rename(mPartPath, mFilePath);
+    }
+
+    if (result == false)
+    {
+        QFile::remove(mPartPath);
+    }
+
+    return result;
+}
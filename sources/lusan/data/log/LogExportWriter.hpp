@@ -0,0 +1,278 @@
+#ifndef LUSAN_DATA_LOG_LOGEXPORTWRITER_HPP
+#define LUSAN_DATA_LOG_LOGEXPORTWRITER_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/LogExportWriter.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the writers of the exported log messages.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include "areg/base/areg_global.h"
+#include "areg/logging/areg_log.h"
+#include "aregextend/db/LogSqliteDatabase.hpp"
+
+#include <QByteArray>
+#include <QSaveFile>
+#include <QString>
+
+#include <memory>
+
+//////////////////////////////////////////////////////////////////////////
+// LogExportWriter class declaration
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * \brief   The base class of the writers of the exported log messages. The messages are written
+ *          one by one and the writer keeps only a batch of them: `flush()` ends the batch and
+ *          writes it to the file, so that the used memory does not depend on the number of
+ *          exported messages. The exported file is written aside and replaces the target file
+ *          only when the writer is closed with commit, the canceled export leaves no file.
+ **/
+class LogExportWriter
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   The format of the exported file.
+     **/
+    enum class eFormat : int
+    {
+          FormatInvalid = -1    //!< Unknown format.
+        , FormatSqlog   = 0     //!< The log database file, which can be opened in the log viewer.
+        , FormatCsv             //!< Comma separated values, one log message per line.
+        , FormatJson            //!< Newline delimited JSON, one object per log message.
+    };
+
+//////////////////////////////////////////////////////////////////////////
+// Static methods
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Returns the format of the exported file by the extension of the file path.
+     **/
+    static LogExportWriter::eFormat getFormat(const QString& filePath);
+
+    /**
+     * \brief   Returns the filter of the file dialog with the supported formats.
+     **/
+    static const QString& getFileFilter();
+
+    /**
+     * \brief   Creates the writer of the format. Returns nullptr if the format is invalid.
+     **/
+    static std::unique_ptr<LogExportWriter> create(LogExportWriter::eFormat format);
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+protected:
+    LogExportWriter() = default;
+
+public:
+    virtual ~LogExportWriter() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Overrides
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Opens the exported file to write.
+     * \param   filePath    The path of the exported file.
+     * \param   source      The log database of the exported messages, used to copy the instances and scopes.
+     * \return  Returns true if the file is opened.
+     **/
+    virtual bool open(const QString& filePath, areg::ext::LogSqliteDatabase& source) = 0;
+
+    /**
+     * \brief   Writes the log message to the current batch.
+     * \return  True if the message is written. On failure, the export fails.
+     **/
+    virtual bool write(const areg::LogEntry& entry) = 0;
+
+    /**
+     * \brief   Ends the current batch and writes it to the file.
+     **/
+    virtual bool flush() = 0;
+
+    /**
+     * \brief   Closes the exported file.
+     * \param   commit  If true, the written file replaces the target file.
+     *                  Otherwise, the written file is discarded.
+     * \return  Returns true if the file is committed.
+     **/
+    virtual bool close(bool commit) = 0;
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(LogExportWriter);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// LogTextExportWriter class declaration
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * \brief   The base class of the writers of the text formats. The lines of the batch are collected
+ *          in the UTF-8 buffer, the text of the messages is copied without conversion.
+ **/
+class LogTextExportWriter : public LogExportWriter
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The size of the buffer, which is written to the file when exceeded.
+    static constexpr int    BUFFER_SIZE { 1024 * 1024 };
+
+protected:
+    LogTextExportWriter();
+
+public:
+    virtual ~LogTextExportWriter() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Overrides
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    virtual bool open(const QString& filePath, areg::ext::LogSqliteDatabase& source) override;
+
+    virtual bool write(const areg::LogEntry& entry) override;
+
+    virtual bool flush() override;
+
+    virtual bool close(bool commit) override;
+
+protected:
+
+    //!< Returns the first line of the file, empty if there is no header.
+    virtual QByteArray header() const = 0;
+
+    //!< Appends the line of the log message to the buffer.
+    virtual void appendEntry(QByteArray& buffer, const areg::LogEntry& entry) const = 0;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    QSaveFile   mFile;      //!< The exported file.
+    QByteArray  mBuffer;    //!< The lines of the batch, which are not written yet.
+
+private:
+    AREG_NOCOPY_NOMOVE(LogTextExportWriter);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// LogCsvExportWriter class declaration
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * \brief   Writes the log messages as comma separated values with the header line.
+ *          The times are written as local date and time with microseconds.
+ **/
+class LogCsvExportWriter : public LogTextExportWriter
+{
+public:
+    LogCsvExportWriter() = default;
+    virtual ~LogCsvExportWriter() = default;
+
+    /**
+     * \brief   Appends the field to the buffer, quoted if it contains a separator, a quote or a line break.
+     **/
+    static void appendField(QByteArray& buffer, const char* text, int length);
+
+protected:
+
+    virtual QByteArray header() const override;
+
+    virtual void appendEntry(QByteArray& buffer, const areg::LogEntry& entry) const override;
+
+private:
+    AREG_NOCOPY_NOMOVE(LogCsvExportWriter);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// LogJsonExportWriter class declaration
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * \brief   Writes the log messages as newline delimited JSON, one object per line.
+ *          The times are written as microseconds since epoch.
+ **/
+class LogJsonExportWriter : public LogTextExportWriter
+{
+public:
+    LogJsonExportWriter() = default;
+    virtual ~LogJsonExportWriter() = default;
+
+    /**
+     * \brief   Appends the quoted and escaped JSON string to the buffer.
+     **/
+    static void appendString(QByteArray& buffer, const char* text, int length);
+
+protected:
+
+    virtual QByteArray header() const override;
+
+    virtual void appendEntry(QByteArray& buffer, const areg::LogEntry& entry) const override;
+
+private:
+    AREG_NOCOPY_NOMOVE(LogJsonExportWriter);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// LogSqliteExportWriter class declaration
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * \brief   Writes the log messages to the new log database. The instances and the scopes of the
+ *          source database are copied when the file is opened, the messages of a batch are
+ *          written in one transaction.
+ **/
+class LogSqliteExportWriter : public LogExportWriter
+{
+public:
+    LogSqliteExportWriter();
+    virtual ~LogSqliteExportWriter();
+
+public:
+
+    virtual bool open(const QString& filePath, areg::ext::LogSqliteDatabase& source) override;
+
+    virtual bool write(const areg::LogEntry& entry) override;
+
+    virtual bool flush() override;
+
+    virtual bool close(bool commit) override;
+
+private:
+    areg::ext::LogSqliteDatabase    mDatabase;  //!< The exported log database.
+    QString                         mFilePath;  //!< The path of the target file.
+    QString                         mPartPath;  //!< The path of the written file, which is renamed when committed.
+    bool                            mInBatch;   //!< Flag, indicating whether the transaction of the batch is open.
+
+private:
+    AREG_NOCOPY_NOMOVE(LogSqliteExportWriter);
+};
+
+#endif  // LUSAN_DATA_LOG_LOGEXPORTWRITER_HPP
@@ -0,0 +1,259 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/LogIngestTelemetry.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the telemetry of the pipeline of the live log messages.
+ *
+ ************************************************************************/
+
+#include "lusan/data/log/LogIngestTelemetry.hpp"
+
+#include <QSaveFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    //!< Returns the steady time in microseconds, used to measure the latencies in the process.
+    inline uint64_t _steadyTime()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    //!< Returns the system time in microseconds since epoch, the clock of the log messages.
+    inline uint64_t _systemTime()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    //!< Sets the value to the atomic, if it is bigger than the value of the atomic.
+    inline void _storeMax(std::atomic<uint64_t>& target, uint64_t value)
+    {
+        uint64_t current{ target.load(std::memory_order_relaxed) };
+        while ((value > current) && (target.compare_exchange_weak(current, value, std::memory_order_relaxed) == false))
+        {
+        }
+    }
+}
+
+LogIngestTelemetry& LogIngestTelemetry::getInstance()
+{
+    static LogIngestTelemetry _instance;
+    return _instance;
+}
+
+const char* LogIngestTelemetry::getMetricName(LogIngestTelemetry::eMetric metric)
+{
+    switch (metric)
+    {
+    case eMetric::MetricRate:
+        return "messages_per_sec";
+    case eMetric::MetricObserverQueue:
+        return "observer_queue";
+    case eMetric::MetricUiQueue:
+        return "ui_queue";
+    case eMetric::MetricFlushLatency:
+        return "ui_flush_latency_ms";
+    case eMetric::MetricDeliveryLag:
+        return "delivery_lag_ms";
+    case eMetric::MetricRows:
+        return "model_rows";
+    case eMetric::MetricEvicted:
+        return "evicted_rows";
+    default:
+        return "";
+    }
+}
+
+LogIngestTelemetry::LogIngestTelemetry()
+    : mReceived     ( 0u )
+    , mDispatched   ( 0u )
+    , mDeliveryLag  ( 0u )
+    , mReceiveTimes ( )
+    , mShown        ( 0u )
+    , mFlushLatency ( 0u )
+    , mEvicted      ( 0u )
+    , mRows         ( 0u )
+    , mLastReceived ( 0u )
+    , mLastTime     ( _steadyTime() )
+    , mHistory      ( )
+    , mSessionMax   ( )
+{
+    for (std::atomic<uint64_t>& entry : mReceiveTimes)
+    {
+        entry.store(0u, std::memory_order_relaxed);
+    }
+}
+
+void LogIngestTelemetry::messageReceived(TIME64 collectorTime)
+{
+    const uint64_t sequence{ mReceived.load(std::memory_order_relaxed) };
+    mReceiveTimes[sequence % RECEIVE_RING_SIZE].store(_steadyTime(), std::memory_order_relaxed);
+    mReceived.store(sequence + 1u, std::memory_order_release);
+
+    if (collectorTime != 0u)
+    {
+        // The log collector may run on another host, the clocks may differ slightly.
+        const uint64_t now{ _systemTime() };
+        _storeMax(mDeliveryLag, now > collectorTime ? now - collectorTime : 0u);
+    }
+}
+
+void LogIngestTelemetry::messageShown(uint32_t rows)
+{
+    // The messages pass the threads in the order they are received, the shown message has the
+    // sequence number of the shown messages, unless it was overwritten in the ring.
+    const uint64_t received{ mReceived.load(std::memory_order_acquire) };
+    if ((mShown < received) && (received - mShown <= RECEIVE_RING_SIZE))
+    {
+        const uint64_t receivedAt{ mReceiveTimes[mShown % RECEIVE_RING_SIZE].load(std::memory_order_relaxed) };
+        const uint64_t now{ _steadyTime() };
+        mFlushLatency = std::max(mFlushLatency, now > receivedAt ? now - receivedAt : 0u);
+    }
+
+    ++ mShown;
+    mRows = rows;
+}
+
+void LogIngestTelemetry::rowsEvicted(uint32_t count, uint32_t rows)
+{
+    mEvicted += count;
+    mRows = rows;
+}
+
+const LogIngestTelemetry::sIngestSample& LogIngestTelemetry::takeSample()
+{
+    const uint64_t now{ _steadyTime() };
+    const uint64_t received{ mReceived.load(std::memory_order_acquire) };
+    const uint64_t dispatched{ std::min(mDispatched.load(std::memory_order_relaxed), received) };
+    const uint64_t shown{ std::min(mShown, dispatched) };
+    const uint64_t elapsed{ std::max<uint64_t>(now - mLastTime, 1u) };
+
+    sIngestSample sample;
+    sample.timestamp = static_cast<TIME64>(_systemTime());
+    sample.values[eMetric::MetricRate]          = static_cast<double>(received - std::min(mLastReceived, received)) * 1000000.0 / static_cast<double>(elapsed);
+    sample.values[eMetric::MetricObserverQueue] = static_cast<double>(received - dispatched);
+    sample.values[eMetric::MetricUiQueue]       = static_cast<double>(dispatched - shown);
+    sample.values[eMetric::MetricFlushLatency]  = static_cast<double>(mFlushLatency) / 1000.0;
+    sample.values[eMetric::MetricDeliveryLag]   = static_cast<double>(mDeliveryLag.exchange(0u, std::memory_order_relaxed)) / 1000.0;
+    sample.values[eMetric::MetricRows]          = static_cast<double>(mRows);
+    sample.values[eMetric::MetricEvicted]       = static_cast<double>(mEvicted);
+
+    mFlushLatency   = 0u;
+    mLastReceived   = received;
+    mLastTime       = now;
+
+    for (int i = 0; i < static_cast<int>(eMetric::MetricCount); ++i)
+    {
+        mSessionMax.values[i] = std::max(mSessionMax.values[i], sample.values[i]);
+    }
+
+    mSessionMax.timestamp = sample.timestamp;
+    if (mHistory.size() >= MAX_SAMPLES)
+    {
+        mHistory.pop_front();
+    }
+
+    mHistory.push_back(sample);
+    return mHistory.back();
+}
+
+void LogIngestTelemetry::reset()
+{
+    // The counters of the other threads are not touched, the stages start counting from the received messages.
+    const uint64_t received{ mReceived.load(std::memory_order_acquire) };
+    mDispatched.store(received, std::memory_order_relaxed);
+    mDeliveryLag.store(0u, std::memory_order_relaxed);
+    mShown          = received;
+    mFlushLatency   = 0u;
+    mEvicted        = 0u;
+    mRows           = 0u;
+    mLastReceived   = received;
+    mLastTime       = _steadyTime();
+    mHistory.clear();
+    mSessionMax     = sIngestSample{};
+}
+
+LogIngestTelemetry::sIngestSample LogIngestTelemetry::getHighWater(uint32_t samples /*= HIGH_WATER_SAMPLES*/) const
+{
+    const uint32_t last{ static_cast<uint32_t>(mHistory.size()) };
+    return _highWater(last - std::min(samples, last), last);
+}
+
+bool LogIngestTelemetry::exportCsv(const QString& filePath) const
+{
+    QSaveFile file(filePath);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Text) == false)
+        return false;
+
+    QTextStream stream(&file);
+    stream << "time_us";
+    for (int i = 0; i < static_cast<int>(eMetric::MetricCount); ++i)
+    {
+        stream << ',' << getMetricName(static_cast<eMetric>(i));
+    }
+
+    for (int i = 0; i < static_cast<int>(eMetric::MetricCount); ++i)
+    {
+        stream << ',' << getMetricName(static_cast<eMetric>(i)) << "_hwm";
+    }
+
+    stream << '\n';
+    const uint32_t count{ static_cast<uint32_t>(mHistory.size()) };
+    for (uint32_t pos = 0u; pos < count; ++pos)
+    {
+        const sIngestSample& sample{ mHistory[pos] };
+        const sIngestSample highWater{ _highWater(pos + 1u - std::min(pos + 1u, HIGH_WATER_SAMPLES), pos + 1u) };
+        stream << static_cast<qulonglong>(sample.timestamp);
+        for (double value : sample.values)
+        {
+            stream << ',' << value;
+        }
+
+        for (double value : highWater.values)
+        {
+            stream << ',' << value;
+        }
+
+        stream << '\n';
+    }
+
+    stream.flush();
+    if (stream.status() != QTextStream::Status::Ok)
+    {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+LogIngestTelemetry::sIngestSample LogIngestTelemetry::_highWater(uint32_t first, uint32_t last) const
+{
+    sIngestSample result;
+    for (uint32_t pos = first; pos < last; ++pos)
+    {
+        const sIngestSample& sample{ mHistory[pos] };
+        for (int i = 0; i < static_cast<int>(eMetric::MetricCount); ++i)
+        {
+            result.values[i] = std::max(result.values[i], sample.values[i]);
+        }
+
+        result.timestamp = sample.timestamp;
+    }
+
+    return result;
+}
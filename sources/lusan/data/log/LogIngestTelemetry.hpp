@@ -0,0 +1,247 @@
+#ifndef LUSAN_DATA_LOG_LOGINGESTTELEMETRY_HPP
+#define LUSAN_DATA_LOG_LOGINGESTTELEMETRY_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/LogIngestTelemetry.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the telemetry of the pipeline of the live log messages.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include "areg/base/areg_global.h"
+
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <deque>
+
+/**
+ * \brief   LogIngestTelemetry measures the pipeline of the live log messages. A message is
+ *          received in the thread of the log collector client, is dispatched by the thread of
+ *          the log observer and is shown by the live log model in the UI thread. The telemetry
+ *          counts the messages of every stage, so that the number of messages queued between
+ *          the threads is known, measures the latency from receiving to showing a message,
+ *          and the lag between the log collector receiving the message and the client
+ *          delivering it. The UI thread takes a sample of
+ *          the metrics once in a while, the samples are kept in the history with the rolling
+ *          high-water marks and can be exported as CSV.
+ *          The counting methods are called in the threads of their stages, the sampling
+ *          and the history are accessed only in the UI thread.
+ **/
+class LogIngestTelemetry
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   The metrics of the sample.
+     **/
+    enum eMetric : int
+    {
+          MetricRate            = 0 //!< The number of received messages per second.
+        , MetricObserverQueue       //!< The number of messages queued to the log observer thread.
+        , MetricUiQueue             //!< The number of messages queued to the UI thread.
+        , MetricFlushLatency        //!< The maximum latency from receiving to showing a message, in milliseconds.
+        , MetricDeliveryLag         //!< The maximum lag from the log collector receiving a message to the client delivering it, in milliseconds.
+        , MetricRows                //!< The number of rows of the live log model.
+        , MetricEvicted             //!< The number of rows evicted from the live log model.
+        , MetricCount               //!< The number of metrics.
+    };
+
+    /**
+     * \brief   One sample of the metrics.
+     **/
+    struct sIngestSample
+    {
+        TIME64  timestamp   { 0u }; //!< The time of the sample in microseconds since epoch.
+        double  values[static_cast<int>(eMetric::MetricCount)] { };    //!< The values of the metrics.
+
+        //!< Returns the value of the metric.
+        inline double get(LogIngestTelemetry::eMetric metric) const;
+    };
+
+    using ListSamples = std::deque<sIngestSample>;
+
+    //!< The number of samples kept in the history, one hour of samples taken every second.
+    static constexpr uint32_t   MAX_SAMPLES         { 3600u };
+
+    //!< The number of the latest samples of the rolling high-water marks.
+    static constexpr uint32_t   HIGH_WATER_SAMPLES  { 60u };
+
+    //!< The number of remembered receive times. The latency of a message is not measured,
+    //!< if more messages than that are queued.
+    static constexpr uint32_t   RECEIVE_RING_SIZE   { 8192u };
+
+//////////////////////////////////////////////////////////////////////////
+// Static methods
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Returns the telemetry of the live log messages.
+     **/
+    static LogIngestTelemetry& getInstance();
+
+    /**
+     * \brief   Returns the name of the metric used in the header of the CSV file.
+     **/
+    static const char* getMetricName(LogIngestTelemetry::eMetric metric);
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    LogIngestTelemetry();
+    ~LogIngestTelemetry() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Counts the message received from the log collector. Called in the thread of the client.
+     * \param   collectorTime   The time when the log collector received the message, in microseconds
+     *                          since epoch. If zero, the delivery lag is not measured.
+     **/
+    void messageReceived(TIME64 collectorTime);
+
+    /**
+     * \brief   Counts the message dispatched by the log observer. Called in the thread of the log observer.
+     **/
+    inline void messageDispatched();
+
+    /**
+     * \brief   Counts the message shown by the live log model. Called in the UI thread.
+     * \param   rows    The number of rows of the live log model.
+     **/
+    void messageShown(uint32_t rows);
+
+    /**
+     * \brief   Counts the rows evicted from the live log model. Called in the UI thread.
+     * \param   count   The number of evicted rows.
+     * \param   rows    The number of rows of the live log model.
+     **/
+    void rowsEvicted(uint32_t count, uint32_t rows);
+
+    /**
+     * \brief   Takes the sample of the metrics and adds it to the history. Called in the UI thread.
+     * \return  Returns the taken sample.
+     **/
+    const LogIngestTelemetry::sIngestSample& takeSample();
+
+    /**
+     * \brief   Clears the history and the high-water marks and starts counting the queued messages
+     *          from the current state. Called in the UI thread when the live log model subscribes.
+     **/
+    void reset();
+
+    /**
+     * \brief   Returns the history of the samples, the oldest first.
+     **/
+    inline const LogIngestTelemetry::ListSamples& getHistory() const;
+
+    /**
+     * \brief   Returns the last sample, or the empty sample if there is no sample.
+     **/
+    inline LogIngestTelemetry::sIngestSample getLastSample() const;
+
+    /**
+     * \brief   Returns the maximum of every metric of the latest samples of the history.
+     * \param   samples     The number of the latest samples.
+     **/
+    LogIngestTelemetry::sIngestSample getHighWater(uint32_t samples = HIGH_WATER_SAMPLES) const;
+
+    /**
+     * \brief   Returns the maximum of every metric since the telemetry is reset.
+     **/
+    inline const LogIngestTelemetry::sIngestSample& getSessionHighWater() const;
+
+    /**
+     * \brief   Exports the history of the samples as CSV. Every row contains the time, the values
+     *          of the metrics and the rolling high-water marks of the metrics up to the sample.
+     * \param   filePath    The path of the file to write.
+     * \return  Returns true if the file is written.
+     **/
+    bool exportCsv(const QString& filePath) const;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Returns the maximum of every metric of the samples of the history in the range [first, last).
+    LogIngestTelemetry::sIngestSample _highWater(uint32_t first, uint32_t last) const;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    using ReceiveRing   = std::array<std::atomic<uint64_t>, RECEIVE_RING_SIZE>;
+
+    std::atomic<uint64_t>   mReceived;      //!< The number of received messages.
+    std::atomic<uint64_t>   mDispatched;    //!< The number of dispatched messages.
+    std::atomic<uint64_t>   mDeliveryLag;   //!< The maximum delivery lag since the last sample, in microseconds.
+    ReceiveRing             mReceiveTimes;  //!< The receive times of the latest messages per sequence number, in microseconds.
+
+    uint64_t                mShown;         //!< The number of shown messages.
+    uint64_t                mFlushLatency;  //!< The maximum latency of shown messages since the last sample, in microseconds.
+    uint64_t                mEvicted;       //!< The number of evicted rows.
+    uint32_t                mRows;          //!< The number of rows of the live log model.
+    uint64_t                mLastReceived;  //!< The number of received messages of the last sample.
+    uint64_t                mLastTime;      //!< The steady time of the last sample, in microseconds.
+    ListSamples             mHistory;       //!< The history of the samples.
+    sIngestSample           mSessionMax;    //!< The maximum of every metric since reset.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(LogIngestTelemetry);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// LogIngestTelemetry class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline double LogIngestTelemetry::sIngestSample::get(LogIngestTelemetry::eMetric metric) const
+{
+    return values[static_cast<int>(metric)];
+}
+
+inline void LogIngestTelemetry::messageDispatched()
+{
+    mDispatched.fetch_add(1u, std::memory_order_relaxed);
+}
+
+inline const LogIngestTelemetry::ListSamples& LogIngestTelemetry::getHistory() const
+{
+    return mHistory;
+}
+
+inline LogIngestTelemetry::sIngestSample LogIngestTelemetry::getLastSample() const
+{
+    return (mHistory.empty() ? sIngestSample{} : mHistory.back());
+}
+
+inline const LogIngestTelemetry::sIngestSample& LogIngestTelemetry::getSessionHighWater() const
+{
+    return mSessionMax;
+}
+
+#endif  // LUSAN_DATA_LOG_LOGINGESTTELEMETRY_HPP
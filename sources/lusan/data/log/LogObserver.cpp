@@ -23,6 +23,7 @@
 
 #include "lusan/common/LogCollectorClient.hpp"
 #include "lusan/common/NELusanCommon.hpp"
+#include "lusan/data/log/LogIngestTelemetry.hpp"
 
 #include "areg/appbase/AppDefs.hpp"
 #include "areg/base/DateTime.hpp"
@@ -526,6 +527,7 @@ void LogObserver::process_event(const LogObserverEventData& data)
 
     case LogObserverEventData::LogObserverCommand::CMD_LogMessage:
     {
+        LogIngestTelemetry::getInstance().messageDispatched();
         emit signalLogMessage(stream);
     }
     break;
@@ -624,5 +626,9 @@ void LogObserver::slotLogUpdateScopes(ITEM_ID cookie, const ScopeInfo* scopes, i
 
 void LogObserver::slotLogMessage(const areg::MessageEnvelope& logMessage)
 {
-    LogObserverEvent::send_event(LogObserverEventData(LogObserverEventData::LogObserverCommand::CMD_LogMessage, areg::SharedBuffer(logMessage)), master_thread());
+    // The lag is measured from the receive time, which the log collector stamps on the message.
+    areg::SharedBuffer buffer(logMessage);
+    const areg::LogEntry* entry{ reinterpret_cast<const areg::LogEntry*>(buffer.buffer()) };
+    LogIngestTelemetry::getInstance().messageReceived(entry != nullptr ? entry->logReceived : 0u);
+    LogObserverEvent::send_event(LogObserverEventData(LogObserverEventData::LogObserverCommand::CMD_LogMessage, buffer), master_thread());
 }
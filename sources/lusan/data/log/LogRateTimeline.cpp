@@ -0,0 +1,254 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/LogRateTimeline.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the number of log messages per time bucket and priority.
+ *
+ ************************************************************************/
+
+#include "lusan/data/log/LogRateTimeline.hpp"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+
+namespace
+{
+    //!< The signature of the sidecar file.
+    constexpr quint32   _sidecarMagic   { 0x4C52544Cu };
+    //!< The version of the format of the sidecar file.
+    constexpr quint32   _sidecarVersion { 1u };
+}
+
+LogRateTimeline::eRate LogRateTimeline::toRate(areg::LogPriority prio)
+{
+    switch (prio)
+    {
+    case areg::LogPriority::PrioFatal:
+    case areg::LogPriority::PrioError:
+        return eRate::RateError;
+    case areg::LogPriority::PrioWarning:
+        return eRate::RateWarning;
+    case areg::LogPriority::PrioInfo:
+        return eRate::RateInfo;
+    case areg::LogPriority::PrioDebug:
+        return eRate::RateDebug;
+    default:
+        return eRate::RateScope;
+    }
+}
+
+QString LogRateTimeline::getSidecarPath(const QString& dbPath)
+{
+    return (dbPath.isEmpty() ? QString() : dbPath + QStringLiteral(".timeline"));
+}
+
+LogRateTimeline::LogRateTimeline()
+    : mLevels   (LevelCount)
+    , mOrigin   (0u)
+    , mBegin    (0u)
+    , mEnd      (0u)
+    , mCount    (0u)
+    , mFinest   (0u)
+{
+}
+
+void LogRateTimeline::clear()
+{
+    for (ListBuckets& buckets : mLevels)
+    {
+        buckets.clear();
+    }
+
+    mOrigin = 0u;
+    mBegin  = 0u;
+    mEnd    = 0u;
+    mCount  = 0u;
+    mFinest = 0u;
+}
+
+void LogRateTimeline::append(TIME64 timestamp, areg::LogPriority prio)
+{
+    if (mCount == 0u)
+    {
+        // The origin is aligned with the coarsest level, so that the buckets of all levels start together.
+        mOrigin = timestamp - (timestamp % getBucketWidth(LevelCount - 1u));
+        mBegin  = timestamp;
+        mEnd    = timestamp;
+    }
+    else
+    {
+        if (timestamp < mOrigin)
+        {
+            _extendFront(timestamp);
+        }
+
+        mBegin  = std::min(mBegin, timestamp);
+        mEnd    = std::max(mEnd, timestamp);
+    }
+
+    ++ mCount;
+    const int rate{ static_cast<int>(toRate(prio)) };
+    const TIME64 base{ (timestamp - mOrigin) / BaseBucketWidth };
+    for (uint32_t level = mFinest; level < LevelCount; ++level)
+    {
+        ListBuckets& buckets = mLevels[level];
+        const TIME64 index{ base >> (LevelShift * level) };
+        if (index >= static_cast<TIME64>(buckets.size()))
+        {
+            if ((index >= static_cast<TIME64>(MaxBuckets)) && (level + 1u < LevelCount))
+            {
+                // The span is too long for this level, the coarser levels show it.
+                ListBuckets().swap(buckets);
+                mFinest = level + 1u;
+                continue;
+            }
+
+            buckets.resize(static_cast<size_t>(index) + 1u);
+        }
+
+        ++ buckets[static_cast<size_t>(index)].counts[rate];
+    }
+}
+
+int LogRateTimeline::findBucket(uint32_t level, TIME64 timestamp) const
+{
+    if ((level >= LevelCount) || (timestamp < mOrigin))
+        return -1;
+
+    const TIME64 index{ (timestamp - mOrigin) / getBucketWidth(level) };
+    return (index < static_cast<TIME64>(mLevels[level].size()) ? static_cast<int>(index) : -1);
+}
+
+uint32_t LogRateTimeline::selectLevel(TIME64 span, int maxBuckets) const
+{
+    const TIME64 limit{ static_cast<TIME64>(std::max(maxBuckets, 1)) };
+    for (uint32_t level = mFinest; level < LevelCount; ++level)
+    {
+        if (span / getBucketWidth(level) < limit)
+            return level;
+    }
+
+    return (LevelCount - 1u);
+}
+
+bool LogRateTimeline::save(const QString& path, const LogRateTimeline::sSourceInfo& source) const
+{
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly) == false)
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Version::Qt_6_0);
+    stream << _sidecarMagic << _sidecarVersion
+           << static_cast<qint64>(source.fileSize) << static_cast<qint64>(source.modified)
+           << static_cast<quint64>(mOrigin) << static_cast<quint64>(mBegin) << static_cast<quint64>(mEnd)
+           << static_cast<quint64>(mCount) << static_cast<quint32>(mFinest);
+
+    for (const ListBuckets& buckets : mLevels)
+    {
+        stream << static_cast<quint32>(buckets.size());
+        for (const sRateBucket& bucket : buckets)
+        {
+            for (uint32_t count : bucket.counts)
+            {
+                stream << static_cast<quint32>(count);
+            }
+        }
+    }
+
+    if (stream.status() != QDataStream::Status::Ok)
+    {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+bool LogRateTimeline::load(const QString& path, const LogRateTimeline::sSourceInfo& source)
+{
+    QFile file(path);
+    if (file.open(QIODevice::ReadOnly) == false)
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Version::Qt_6_0);
+
+    quint32 magic{ 0u }, version{ 0u }, finest{ 0u };
+    qint64  fileSize{ 0 }, modified{ 0 };
+    quint64 origin{ 0u }, begin{ 0u }, end{ 0u }, count{ 0u };
+    stream >> magic >> version >> fileSize >> modified;
+    if ((magic != _sidecarMagic) || (version != _sidecarVersion) || (fileSize != source.fileSize) || (modified != source.modified))
+        return false;
+
+    stream >> origin >> begin >> end >> count >> finest;
+    if ((stream.status() != QDataStream::Status::Ok) || (finest >= LevelCount))
+        return false;
+
+    std::vector<ListBuckets> levels(LevelCount);
+    for (ListBuckets& buckets : levels)
+    {
+        quint32 size{ 0u };
+        stream >> size;
+        if ((stream.status() != QDataStream::Status::Ok) || (size > static_cast<quint32>(MaxBuckets)))
+            return false;
+
+        buckets.resize(size);
+        for (sRateBucket& bucket : buckets)
+        {
+            for (uint32_t& value : bucket.counts)
+            {
+                quint32 read{ 0u };
+                stream >> read;
+                value = read;
+            }
+        }
+    }
+
+    if (stream.status() != QDataStream::Status::Ok)
+        return false;
+
+    mLevels = std::move(levels);
+    mOrigin = static_cast<TIME64>(origin);
+    mBegin  = static_cast<TIME64>(begin);
+    mEnd    = static_cast<TIME64>(end);
+    mCount  = static_cast<uint64_t>(count);
+    mFinest = finest;
+    return true;
+}
+
+void LogRateTimeline::_extendFront(TIME64 timestamp)
+{
+    const TIME64 origin{ timestamp - (timestamp % getBucketWidth(LevelCount - 1u)) };
+    const TIME64 delta{ mOrigin - origin };
+    for (uint32_t level = mFinest; level < LevelCount; ++level)
+    {
+        ListBuckets& buckets = mLevels[level];
+        const TIME64 shift{ delta / getBucketWidth(level) };
+        if ((shift + buckets.size() > static_cast<TIME64>(MaxBuckets)) && (level + 1u < LevelCount))
+        {
+            ListBuckets().swap(buckets);
+            mFinest = level + 1u;
+        }
+        else
+        {
+            buckets.insert(buckets.begin(), static_cast<size_t>(shift), sRateBucket{});
+        }
+    }
+
+    mOrigin = origin;
+}
@@ -0,0 +1,317 @@
+#ifndef LUSAN_DATA_LOG_LOGRATETIMELINE_HPP
+#define LUSAN_DATA_LOG_LOGRATETIMELINE_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/LogRateTimeline.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the number of log messages per time bucket and priority.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include "areg/base/areg_global.h"
+#include "areg/logging/areg_log.h"
+
+#include <QString>
+#include <vector>
+
+/**
+ * \brief   LogRateTimeline counts the log messages per time bucket and per priority. The counts
+ *          are kept in a pyramid of levels: the buckets of the first level are BaseBucketWidth
+ *          long, every next level merges 1 << LevelShift buckets of the previous level. All
+ *          levels are updated when a message is added, so that the counts of any zoom of the
+ *          timeline are read without summing, and the size of the pyramid depends on the time
+ *          span of the logs, not on the number of messages. A level stops growing when it has
+ *          MaxBuckets buckets, then the span of the logs is shown by the coarser levels only.
+ *          The pyramid can be saved in a sidecar file next to the log database and loaded back,
+ *          if the database has not changed. The times are in microseconds.
+ **/
+class LogRateTimeline
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   The groups of priorities counted in the timeline.
+     **/
+    enum eRate : int
+    {
+          RateError     = 0 //!< The fatal errors and errors.
+        , RateWarning       //!< The warnings.
+        , RateInfo          //!< The information messages.
+        , RateDebug         //!< The debug messages.
+        , RateScope         //!< The messages of scopes and the messages without priority.
+        , RateCount         //!< The number of groups.
+    };
+
+    //!< The width of a bucket of the first level, 100 milliseconds.
+    static constexpr TIME64     BaseBucketWidth { 100000u };
+    //!< Every next level merges 1 << LevelShift buckets of the previous level.
+    static constexpr uint32_t   LevelShift      { 2u };
+    //!< The number of levels of the pyramid.
+    static constexpr uint32_t   LevelCount      { 8u };
+    //!< The maximum number of buckets of a level.
+    static constexpr int        MaxBuckets      { 1 << 21 };
+
+    /**
+     * \brief   The number of messages of one time bucket per group of priorities.
+     **/
+    struct sRateBucket
+    {
+        uint32_t    counts[static_cast<int>(eRate::RateCount)] { };    //!< The number of messages per group of priorities.
+
+        //!< Returns the number of messages in the bucket.
+        inline uint32_t total() const;
+    };
+
+    /**
+     * \brief   Identifies the state of the log database the sidecar file is built from.
+     **/
+    struct sSourceInfo
+    {
+        int64_t     fileSize    { 0 };  //!< The size of the database file in bytes.
+        int64_t     modified    { 0 };  //!< The time of the last modification of the database file, in milliseconds since epoch.
+    };
+
+//////////////////////////////////////////////////////////////////////////
+// Static methods
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Returns the group of the log priority.
+     **/
+    static LogRateTimeline::eRate toRate(areg::LogPriority prio);
+
+    /**
+     * \brief   Returns the path of the sidecar file of the log database.
+     * \param   dbPath  The path of the log database file.
+     **/
+    static QString getSidecarPath(const QString& dbPath);
+
+    /**
+     * \brief   Returns the width of a bucket of the level.
+     **/
+    static inline TIME64 getBucketWidth(uint32_t level);
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    LogRateTimeline();
+    LogRateTimeline(const LogRateTimeline& src) = default;
+    LogRateTimeline(LogRateTimeline&& src) noexcept = default;
+    ~LogRateTimeline() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Operators
+//////////////////////////////////////////////////////////////////////////
+public:
+    LogRateTimeline& operator = (const LogRateTimeline& src) = default;
+    LogRateTimeline& operator = (LogRateTimeline&& src) noexcept = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Clears the timeline.
+     **/
+    void clear();
+
+    /**
+     * \brief   Counts the log message in the timeline.
+     * \param   entry   The log message to count.
+     **/
+    inline void append(const areg::LogEntry& entry);
+
+    /**
+     * \brief   Counts the log message of the given time and priority in the timeline.
+     * \param   timestamp   The time of the log message.
+     * \param   prio        The priority of the log message.
+     **/
+    void append(TIME64 timestamp, areg::LogPriority prio);
+
+    /**
+     * \brief   Returns the number of counted log messages.
+     **/
+    inline uint64_t getTotalCount() const;
+
+    /**
+     * \brief   Returns true if no log message is counted.
+     **/
+    inline bool isEmpty() const;
+
+    /**
+     * \brief   Returns the time of the earliest counted log message.
+     **/
+    inline TIME64 getBeginTime() const;
+
+    /**
+     * \brief   Returns the time of the latest counted log message.
+     **/
+    inline TIME64 getEndTime() const;
+
+    /**
+     * \brief   Returns the time where the first bucket of every level starts.
+     **/
+    inline TIME64 getOrigin() const;
+
+    /**
+     * \brief   Returns the finest level, which counts all log messages.
+     **/
+    inline uint32_t getFinestLevel() const;
+
+    /**
+     * \brief   Returns the number of buckets of the level.
+     **/
+    inline int getBucketCount(uint32_t level) const;
+
+    /**
+     * \brief   Returns the bucket of the level. The level and the index must be valid.
+     **/
+    inline const LogRateTimeline::sRateBucket& getBucket(uint32_t level, int index) const;
+
+    /**
+     * \brief   Returns the time where the bucket of the level starts.
+     **/
+    inline TIME64 getBucketTime(uint32_t level, int index) const;
+
+    /**
+     * \brief   Returns the index of the bucket of the level, which contains the time, or -1 if there is no such bucket.
+     * \param   level       The level of the pyramid.
+     * \param   timestamp   The time to search.
+     **/
+    int findBucket(uint32_t level, TIME64 timestamp) const;
+
+    /**
+     * \brief   Returns the finest level, which shows the time span in not more than the given number of buckets.
+     * \param   span        The time span to show.
+     * \param   maxBuckets  The maximum number of buckets to show, usually the width of the view in pixels.
+     **/
+    uint32_t selectLevel(TIME64 span, int maxBuckets) const;
+
+    /**
+     * \brief   Saves the timeline to the sidecar file.
+     * \param   path    The path of the sidecar file.
+     * \param   source  The state of the log database, the timeline is built from.
+     * \return  Returns true if succeeded to save the file.
+     **/
+    bool save(const QString& path, const LogRateTimeline::sSourceInfo& source) const;
+
+    /**
+     * \brief   Loads the timeline from the sidecar file, if it is built from the same state of the log database.
+     *          The timeline is not changed if the file is missing, damaged or outdated.
+     * \param   path    The path of the sidecar file.
+     * \param   source  The current state of the log database.
+     * \return  Returns true if succeeded to load the timeline.
+     **/
+    bool load(const QString& path, const LogRateTimeline::sSourceInfo& source);
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Moves the origin of the timeline back to count the messages before the first bucket.
+    void _extendFront(TIME64 timestamp);
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    using ListBuckets   = std::vector<sRateBucket>;
+
+    std::vector<ListBuckets>    mLevels;    //!< The buckets of the levels, the first level is the finest.
+    TIME64                      mOrigin;    //!< The time where the first bucket of every level starts.
+    TIME64                      mBegin;     //!< The time of the earliest counted message.
+    TIME64                      mEnd;       //!< The time of the latest counted message.
+    uint64_t                    mCount;     //!< The number of counted messages.
+    uint32_t                    mFinest;    //!< The finest level, which counts all messages.
+};
+
+//////////////////////////////////////////////////////////////////////////
+// LogRateTimeline inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline uint32_t LogRateTimeline::sRateBucket::total() const
+{
+    uint32_t result{ 0u };
+    for (uint32_t count : counts)
+    {
+        result += count;
+    }
+
+    return result;
+}
+
+inline TIME64 LogRateTimeline::getBucketWidth(uint32_t level)
+{
+    return (BaseBucketWidth << (LevelShift * level));
+}
+
+inline void LogRateTimeline::append(const areg::LogEntry& entry)
+{
+    append(entry.logTimestamp, entry.logMessagePrio);
+}
+
+inline uint64_t LogRateTimeline::getTotalCount() const
+{
+    return mCount;
+}
+
+inline bool LogRateTimeline::isEmpty() const
+{
+    return (mCount == 0u);
+}
+
+inline TIME64 LogRateTimeline::getBeginTime() const
+{
+    return mBegin;
+}
+
+inline TIME64 LogRateTimeline::getEndTime() const
+{
+    return mEnd;
+}
+
+inline TIME64 LogRateTimeline::getOrigin() const
+{
+    return mOrigin;
+}
+
+inline uint32_t LogRateTimeline::getFinestLevel() const
+{
+    return mFinest;
+}
+
+inline int LogRateTimeline::getBucketCount(uint32_t level) const
+{
+    return static_cast<int>(mLevels[level].size());
+}
+
+inline const LogRateTimeline::sRateBucket& LogRateTimeline::getBucket(uint32_t level, int index) const
+{
+    return mLevels[level][static_cast<uint32_t>(index)];
+}
+
+inline TIME64 LogRateTimeline::getBucketTime(uint32_t level, int index) const
+{
+    return mOrigin + static_cast<TIME64>(index) * getBucketWidth(level);
+}
+
+#endif  // LUSAN_DATA_LOG_LOGRATETIMELINE_HPP
@@ -0,0 +1,285 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopeCallTree.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the call tree of scopes rebuilt from the log messages.
+ *
+ ************************************************************************/
+
+#include "lusan/data/log/ScopeCallTree.hpp"
+
+#include <algorithm>
+
+ScopeCallTree::ScopeCallTree()
+    : mCalls    ( )
+    , mThreads  ( )
+    , mThreadMap( )
+    , mRowCount (0)
+    , mUnmatched(0)
+{
+}
+
+void ScopeCallTree::clear()
+{
+    mCalls.clear();
+    mThreads.clear();
+    mThreadMap.clear();
+    mRowCount   = 0;
+    mUnmatched  = 0;
+}
+
+int ScopeCallTree::append(const areg::LogEntry& entry, std::vector<int>* closed)
+{
+    const int row{ mRowCount ++ };
+    const uint64_t timestamp{ static_cast<uint64_t>(entry.logTimestamp) };
+    int result{ InvalidIndex };
+
+    switch (entry.logMsgType)
+    {
+    case areg::LogMessageType::ScopeEnter:
+    {
+        const int thread{ _thread(entry) };
+        sThreadCalls& calls = mThreads[static_cast<uint32_t>(thread)];
+        result = static_cast<int>(mCalls.size());
+
+        sCallNode node;
+        node.instId     = entry.logCookie;
+        node.threadId   = entry.logThreadId;
+        node.scopeId    = entry.logScopeId;
+        node.sessionId  = entry.logSessionId;
+        node.thread     = thread;
+        node.parent     = calls.stack.empty() ? InvalidIndex : calls.stack.back();
+        node.depth      = static_cast<int>(calls.stack.size());
+        node.enterRow   = row;
+        node.enterTime  = timestamp;
+
+        std::vector<int>& siblings = node.parent == InvalidIndex ? calls.roots : mCalls[static_cast<uint32_t>(node.parent)].children;
+        node.position   = static_cast<int>(siblings.size());
+        siblings.push_back(result);
+        calls.stack.push_back(result);
+        calls.lastTime  = std::max(calls.lastTime, timestamp);
+        mCalls.push_back(std::move(node));
+    }
+    break;
+
+    case areg::LogMessageType::ScopeExit:
+    {
+        const int thread{ findThread(entry.logCookie, entry.logThreadId) };
+        std::vector<int>* stack = thread != InvalidIndex ? &mThreads[static_cast<uint32_t>(thread)].stack : nullptr;
+        int pos{ stack != nullptr ? static_cast<int>(stack->size()) - 1 : InvalidIndex };
+        for ( ; pos >= 0; -- pos)
+        {
+            const sCallNode& node = mCalls[static_cast<uint32_t>((*stack)[static_cast<uint32_t>(pos)])];
+            if ((node.scopeId == entry.logScopeId) && (node.sessionId == entry.logSessionId))
+                break;
+        }
+
+        if (pos < 0)
+        {
+            ++ mUnmatched;
+            break;
+        }
+
+        mThreads[static_cast<uint32_t>(thread)].lastTime = std::max(mThreads[static_cast<uint32_t>(thread)].lastTime, timestamp);
+
+        // The nested calls, which exit is not in the log, end together with the calling scope.
+        while (static_cast<int>(stack->size()) > pos + 1)
+        {
+            const int nested{ stack->back() };
+            stack->pop_back();
+            _closeCall(nested, timestamp, 0u);
+            if (closed != nullptr)
+            {
+                closed->push_back(nested);
+            }
+        }
+
+        result = stack->back();
+        stack->pop_back();
+        mCalls[static_cast<uint32_t>(result)].exitRow = row;
+        _closeCall(result, timestamp, static_cast<uint64_t>(entry.logDuration));
+        if (closed != nullptr)
+        {
+            closed->push_back(result);
+        }
+    }
+    break;
+
+    default:
+    {
+        const int thread{ findThread(entry.logCookie, entry.logThreadId) };
+        if (thread != InvalidIndex)
+        {
+            sThreadCalls& calls = mThreads[static_cast<uint32_t>(thread)];
+            calls.lastTime = std::max(calls.lastTime, timestamp);
+        }
+    }
+    break;
+    }
+
+    return result;
+}
+
+void ScopeCallTree::removeFront(int count)
+{
+    if (count <= 0)
+        return;
+
+    if (count >= mRowCount)
+    {
+        const int unmatched{ mUnmatched };
+        clear();
+        mUnmatched = unmatched;
+        return;
+    }
+
+    // The calls are in the order of their scope enter messages, the dropped calls are the first ones.
+    const auto firstKept = std::lower_bound(mCalls.begin(), mCalls.end(), count, [](const sCallNode& call, int row) {
+                                                return (call.enterRow < row);
+                                            });
+    const int dropped{ static_cast<int>(firstKept - mCalls.begin()) };
+    mCalls.erase(mCalls.begin(), firstKept);
+
+    // The threads that still have calls keep their order.
+    std::vector<int> threadMap(mThreads.size(), InvalidIndex);
+    for (const sCallNode& call : mCalls)
+    {
+        threadMap[static_cast<uint32_t>(call.thread)] = 0;
+    }
+
+    std::vector<sThreadCalls> threads;
+    threads.reserve(mThreads.size());
+    mThreadMap.clear();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(mThreads.size()); ++i)
+    {
+        if (threadMap[i] == InvalidIndex)
+            continue;
+
+        threadMap[i] = static_cast<int>(threads.size());
+        sThreadCalls& calls = mThreads[i];
+        calls.roots.clear();
+        calls.stack.erase(std::remove_if(calls.stack.begin(), calls.stack.end(), [dropped](int node) { return (node < dropped); }), calls.stack.end());
+        for (int& node : calls.stack)
+        {
+            node -= dropped;
+        }
+
+        mThreadMap.emplace(ThreadKey(calls.instId, calls.threadId), threadMap[i]);
+        threads.push_back(std::move(calls));
+    }
+
+    mThreads = std::move(threads);
+
+    // A parent is before its nested calls, so its new depth is known when they are visited.
+    // The nested calls of the kept calls are all kept, only the roots are collected again.
+    for (uint32_t i = 0; i < static_cast<uint32_t>(mCalls.size()); ++i)
+    {
+        sCallNode& call = mCalls[i];
+        sThreadCalls& calls = mThreads[static_cast<uint32_t>(threadMap[static_cast<uint32_t>(call.thread)])];
+        call.thread     = threadMap[static_cast<uint32_t>(call.thread)];
+        call.enterRow  -= count;
+        call.exitRow    = call.exitRow != InvalidIndex ? call.exitRow - count : InvalidIndex;
+        call.parent     = call.parent >= dropped ? call.parent - dropped : InvalidIndex;
+        for (int& child : call.children)
+        {
+            child -= dropped;
+        }
+
+        if (call.parent == InvalidIndex)
+        {
+            // The first kept call of the thread has no kept parent, it starts the thread now.
+            calls.firstTime = calls.roots.empty() ? call.enterTime : calls.firstTime;
+            call.depth      = 0;
+            call.position   = static_cast<int>(calls.roots.size());
+            calls.roots.push_back(static_cast<int>(i));
+        }
+        else
+        {
+            call.depth      = mCalls[static_cast<uint32_t>(call.parent)].depth + 1;
+        }
+    }
+
+    mRowCount -= count;
+}
+
+int ScopeCallTree::findThread(ITEM_ID instId, ITEM_ID threadId) const
+{
+    auto pos = mThreadMap.find(ThreadKey(instId, threadId));
+    return (pos != mThreadMap.end() ? pos->second : InvalidIndex);
+}
+
+int ScopeCallTree::getOpenCall(int thread) const
+{
+    const sThreadCalls& calls = getThread(thread);
+    return (calls.stack.empty() ? InvalidIndex : calls.stack.back());
+}
+
+uint64_t ScopeCallTree::getInclusive(int node) const
+{
+    const sCallNode& call = getCall(node);
+    if (call.closed)
+        return call.inclusive;
+
+    const uint64_t lastTime{ getThread(call.thread).lastTime };
+    return (lastTime > call.enterTime ? lastTime - call.enterTime : 0u);
+}
+
+uint64_t ScopeCallTree::getExclusive(int node) const
+{
+    const sCallNode& call = getCall(node);
+    if (call.closed)
+        return call.exclusive();
+
+    // Only the last nested call of the open call can be still open.
+    uint64_t nested{ call.childTime };
+    if ((call.children.empty() == false) && (getCall(call.children.back()).closed == false))
+    {
+        nested += getInclusive(call.children.back());
+    }
+
+    const uint64_t inclusive{ getInclusive(node) };
+    return (inclusive > nested ? inclusive - nested : 0u);
+}
+
+int ScopeCallTree::_thread(const areg::LogEntry& entry)
+{
+    const ThreadKey key(entry.logCookie, entry.logThreadId);
+    auto pos = mThreadMap.find(key);
+    if (pos != mThreadMap.end())
+        return pos->second;
+
+    const int result{ static_cast<int>(mThreads.size()) };
+    sThreadCalls calls;
+    calls.instId    = entry.logCookie;
+    calls.threadId  = entry.logThreadId;
+    calls.module    = QString(entry.logModule);
+    calls.name      = QString(entry.logThread);
+    calls.firstTime = static_cast<uint64_t>(entry.logTimestamp);
+    mThreads.push_back(std::move(calls));
+    mThreadMap.emplace(key, result);
+    return result;
+}
+
+void ScopeCallTree::_closeCall(int node, uint64_t exitTime, uint64_t duration)
+{
+    sCallNode& call = mCalls[static_cast<uint32_t>(node)];
+    call.closed     = true;
+    call.exitTime   = exitTime;
+    // The scope exit message carries the measured duration, otherwise it is the time between messages.
+    call.inclusive  = duration != 0u ? duration : (exitTime > call.enterTime ? exitTime - call.enterTime : 0u);
+    if (call.parent != InvalidIndex)
+    {
+        mCalls[static_cast<uint32_t>(call.parent)].childTime += call.inclusive;
+    }
+}
@@ -0,0 +1,262 @@
+#ifndef LUSAN_DATA_LOG_SCOPECALLTREE_HPP
+#define LUSAN_DATA_LOG_SCOPECALLTREE_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopeCallTree.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the call tree of scopes rebuilt from the log messages.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include "areg/base/areg_global.h"
+#include "areg/logging/areg_log.h"
+
+#include <QString>
+#include <map>
+#include <vector>
+
+/**
+ * \brief   ScopeCallTree rebuilds the per-thread call tree of the scopes from the pairs of
+ *          scope enter and scope exit messages. Every call (scope session) is a node of the
+ *          tree. The node knows its parent and its nested calls, the rows of the log where the
+ *          call starts and ends, and the inclusive and exclusive time of the call.
+ *
+ *          The tree is filled in the order of the log messages: in one pass when the logs are
+ *          loaded from a file, and message by message for the live logs. The nodes are kept in
+ *          a single vector and referred by index, the index of a node never changes until the
+ *          tree is cleared. The times are in microseconds.
+ **/
+class ScopeCallTree
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The index of invalid node, thread or row.
+    static constexpr int    InvalidIndex    { -1 };
+
+    /**
+     * \brief   The call of a scope, a node of the call tree.
+     **/
+    struct sCallNode
+    {
+        ITEM_ID             instId      { 0u };             //!< The ID of the instance (cookie) that logged the call.
+        ITEM_ID             threadId    { 0u };             //!< The ID of the thread that logged the call.
+        uint32_t            scopeId     { 0u };             //!< The ID of the scope.
+        uint32_t            sessionId   { 0u };             //!< The ID of the session of the scope.
+        int                 thread      { InvalidIndex };   //!< The index of the thread of the call.
+        int                 parent      { InvalidIndex };   //!< The index of the calling node, invalid if the call is a root of the thread.
+        int                 position    { 0 };              //!< The position of the node in the list of calls of the parent or of the thread roots.
+        int                 depth       { 0 };              //!< The nesting depth of the call, 0 is the root call.
+        int                 enterRow    { InvalidIndex };   //!< The row of the log of the scope enter message.
+        int                 exitRow     { InvalidIndex };   //!< The row of the log of the scope exit message, invalid if the exit is not logged.
+        uint64_t            enterTime   { 0u };             //!< The timestamp of the scope enter message.
+        uint64_t            exitTime    { 0u };             //!< The timestamp when the call ended, 0 if the call is still open.
+        uint64_t            inclusive   { 0u };             //!< The time spent in the call, including the nested calls.
+        uint64_t            childTime   { 0u };             //!< The time spent in the closed nested calls.
+        bool                closed      { false };          //!< Flag, indicating whether the call is ended.
+        std::vector<int>    children    { };                //!< The indexes of the nested calls in the order of calls.
+
+        //!< Returns the time spent in the call, excluding the nested calls.
+        inline uint64_t exclusive() const;
+    };
+
+    /**
+     * \brief   The calls of a thread of an instance.
+     **/
+    struct sThreadCalls
+    {
+        ITEM_ID             instId      { 0u };     //!< The ID of the instance (cookie).
+        ITEM_ID             threadId    { 0u };     //!< The ID of the thread.
+        QString             module      { };        //!< The name of the module of the instance.
+        QString             name        { };        //!< The name of the thread.
+        uint64_t            firstTime   { 0u };     //!< The timestamp of the first call of the thread.
+        uint64_t            lastTime    { 0u };     //!< The timestamp of the last message of the thread.
+        std::vector<int>    roots       { };        //!< The indexes of the root calls in the order of calls.
+        std::vector<int>    stack       { };        //!< The indexes of the calls that are entered and not ended yet.
+    };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    ScopeCallTree();
+    ~ScopeCallTree() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Clears the call tree.
+     **/
+    void clear();
+
+    /**
+     * \brief   Adds the next log message to the call tree. The messages should be passed in the
+     *          order of the log. The scope enter message opens a new call of the thread, the scope
+     *          exit message ends the call, and the rest of messages are only counted as rows.
+     *          If the exit of nested calls is not in the log, they end together with the calling scope.
+     *          The scope exit message of the call that has no scope enter message in the log is ignored.
+     * \param   entry   The log message to add.
+     * \param   closed  If not nullptr, on output contains the indexes of the calls ended by the message.
+     * \return  Returns the index of the call opened or ended by the message, or InvalidIndex if the
+     *          message did not change the call tree.
+     **/
+    int append(const areg::LogEntry& entry, std::vector<int>* closed = nullptr);
+
+    /**
+     * \brief   Drops the given number of the oldest rows from the call tree. The calls entered in
+     *          the dropped rows are removed, their nested calls entered later become the root calls
+     *          of the thread, and the threads left without calls are removed. The rest of the calls
+     *          keep their times, and the rows of the messages that are still in the log move up.
+     *          The indexes of the calls and threads change.
+     * \param   count   The number of the oldest rows to drop.
+     **/
+    void removeFront(int count);
+
+    /**
+     * \brief   Returns the number of rows of the log added to the call tree.
+     **/
+    inline int getRowCount() const;
+
+    /**
+     * \brief   Returns the number of calls in the tree.
+     **/
+    inline int getCallCount() const;
+
+    /**
+     * \brief   Returns the number of threads that have calls.
+     **/
+    inline int getThreadCount() const;
+
+    /**
+     * \brief   Returns the number of scope exit messages ignored because the scope enter message is not in the log.
+     **/
+    inline int getUnmatchedCount() const;
+
+    /**
+     * \brief   Returns the call node of the given index. The index must be valid.
+     **/
+    inline const ScopeCallTree::sCallNode& getCall(int node) const;
+
+    /**
+     * \brief   Returns the calls of the thread of the given index. The index must be valid.
+     **/
+    inline const ScopeCallTree::sThreadCalls& getThread(int thread) const;
+
+    /**
+     * \brief   Returns the index of the thread of the given instance, or InvalidIndex if the thread has no calls.
+     * \param   instId      The ID of the instance (cookie).
+     * \param   threadId    The ID of the thread.
+     **/
+    int findThread(ITEM_ID instId, ITEM_ID threadId) const;
+
+    /**
+     * \brief   Returns the index of the innermost call of the thread that is not ended yet,
+     *          or InvalidIndex if the thread has no open calls.
+     * \param   thread      The index of the thread.
+     **/
+    int getOpenCall(int thread) const;
+
+    /**
+     * \brief   Returns the time spent in the call. The time of the call, which is not ended yet,
+     *          is counted until the last message of its thread.
+     * \param   node    The index of the call.
+     **/
+    uint64_t getInclusive(int node) const;
+
+    /**
+     * \brief   Returns the time spent in the call, excluding the nested calls.
+     *          The time of the call, which is not ended yet, is counted until the last message of its thread.
+     * \param   node    The index of the call.
+     **/
+    uint64_t getExclusive(int node) const;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Returns the index of the thread of the log message, creates new if it does not exist.
+    int _thread(const areg::LogEntry& entry);
+
+    //!< Ends the call at the given time and adds its time to the calling node.
+    void _closeCall(int node, uint64_t exitTime, uint64_t duration);
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    using ThreadKey     = std::pair<ITEM_ID, ITEM_ID>;
+    using MapThreads    = std::map<ThreadKey, int>;
+
+    std::vector<sCallNode>      mCalls;     //!< The calls of all threads.
+    std::vector<sThreadCalls>   mThreads;   //!< The threads in the order they appear in the log.
+    MapThreads                  mThreadMap; //!< Per instance and thread, the index of the thread.
+    int                         mRowCount;  //!< The number of rows of the log added to the tree.
+    int                         mUnmatched; //!< The number of the ignored scope exit messages.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(ScopeCallTree);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ScopeCallTree inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline uint64_t ScopeCallTree::sCallNode::exclusive() const
+{
+    return (inclusive > childTime ? inclusive - childTime : 0u);
+}
+
+inline int ScopeCallTree::getRowCount() const
+{
+    return mRowCount;
+}
+
+inline int ScopeCallTree::getCallCount() const
+{
+    return static_cast<int>(mCalls.size());
+}
+
+inline int ScopeCallTree::getThreadCount() const
+{
+    return static_cast<int>(mThreads.size());
+}
+
+inline int ScopeCallTree::getUnmatchedCount() const
+{
+    return mUnmatched;
+}
+
+inline const ScopeCallTree::sCallNode& ScopeCallTree::getCall(int node) const
+{
+    Q_ASSERT((node >= 0) && (node < static_cast<int>(mCalls.size())));
+    return mCalls[static_cast<uint32_t>(node)];
+}
+
+inline const ScopeCallTree::sThreadCalls& ScopeCallTree::getThread(int thread) const
+{
+    Q_ASSERT((thread >= 0) && (thread < static_cast<int>(mThreads.size())));
+    return mThreads[static_cast<uint32_t>(thread)];
+}
+
+#endif  // LUSAN_DATA_LOG_SCOPECALLTREE_HPP
@@ -0,0 +1,72 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopeLatencyStats.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the statistics of durations of the scopes.
+ *
+ ************************************************************************/
+
+#include "lusan/data/log/ScopeLatencyStats.hpp"
+
+bool ScopeLatencyStats::getSample(const areg::LogEntry& entry, ScopeLatencyStats::sLatencySample& sample)
+{
+    if ((entry.logMsgType != areg::LogMessageType::ScopeExit) || (entry.logScopeId == 0u))
+        return false;
+
+    sample.instId   = entry.logCookie;
+    sample.scopeId  = entry.logScopeId;
+    sample.duration = static_cast<uint32_t>(entry.logDuration);
+    return true;
+}
+
+ScopeLatencyStats::ScopeLatencyStats()
+    : mScopes   ( )
+    , mScopeMap ( )
+{
+}
+
+void ScopeLatencyStats::clear()
+{
+    mScopes.clear();
+    mScopeMap.clear();
+}
+
+int ScopeLatencyStats::record(const ScopeLatencyStats::sLatencySample& sample)
+{
+    const int next{ static_cast<int>(mScopes.size()) };
+    auto result = mScopeMap.emplace(ScopeKey(sample.instId, sample.scopeId), next);
+    if (result.second)
+    {
+        sScopeLatency scope;
+        scope.instId    = sample.instId;
+        scope.scopeId   = sample.scopeId;
+        mScopes.push_back(std::move(scope));
+    }
+
+    const int pos{ result.first->second };
+    mScopes[static_cast<uint32_t>(pos)].histogram.record(sample.duration);
+    return pos;
+}
+
+int ScopeLatencyStats::append(const areg::LogEntry& entry)
+{
+    sLatencySample sample;
+    return (getSample(entry, sample) ? record(sample) : -1);
+}
+
+int ScopeLatencyStats::findScope(ITEM_ID instId, uint32_t scopeId) const
+{
+    auto pos = mScopeMap.find(ScopeKey(instId, scopeId));
+    return (pos != mScopeMap.end() ? pos->second : -1);
+}
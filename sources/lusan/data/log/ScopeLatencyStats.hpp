@@ -0,0 +1,162 @@
+#ifndef LUSAN_DATA_LOG_SCOPELATENCYSTATS_HPP
+#define LUSAN_DATA_LOG_SCOPELATENCYSTATS_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopeLatencyStats.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the statistics of durations of the scopes.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include "areg/base/areg_global.h"
+#include "areg/logging/areg_log.h"
+#include "lusan/data/log/LatencyHistogram.hpp"
+
+#include <map>
+#include <vector>
+
+/**
+ * \brief   ScopeLatencyStats collects the durations of the calls of every scope of every
+ *          instance from the scope exit messages, and keeps them in the histograms to report
+ *          the count, the minimum, the maximum and the percentiles of the durations.
+ *          The scopes are listed in the order they are seen first, the position of a scope
+ *          in the list does not change when more durations are recorded. The statistics are
+ *          copyable, so that they can be continued in another thread. The durations are in
+ *          microseconds.
+ **/
+class ScopeLatencyStats
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   The duration of one call of the scope, taken from the scope exit message.
+     **/
+    struct sLatencySample
+    {
+        ITEM_ID     instId      { 0u }; //!< The ID of the instance (cookie).
+        uint32_t    scopeId     { 0u }; //!< The ID of the scope.
+        uint32_t    duration    { 0u }; //!< The duration of the call.
+    };
+
+    /**
+     * \brief   The statistics of the durations of one scope of the instance.
+     **/
+    struct sScopeLatency
+    {
+        ITEM_ID             instId      { 0u };     //!< The ID of the instance (cookie).
+        uint32_t            scopeId     { 0u };     //!< The ID of the scope.
+        LatencyHistogram    histogram   { };        //!< The histogram of the durations of the scope.
+    };
+
+    using ListSamples   = std::vector<sLatencySample>;
+
+//////////////////////////////////////////////////////////////////////////
+// Static methods
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Returns true if the log message is the scope exit message, and on output sets the duration of the call.
+     * \param   entry   The log message to check.
+     * \param   sample  On output, contains the duration of the call of the scope, if the message is the scope exit.
+     **/
+    static bool getSample(const areg::LogEntry& entry, ScopeLatencyStats::sLatencySample& sample);
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    ScopeLatencyStats();
+    ScopeLatencyStats(const ScopeLatencyStats& src) = default;
+    ScopeLatencyStats(ScopeLatencyStats&& src) noexcept = default;
+    ~ScopeLatencyStats() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Operators
+//////////////////////////////////////////////////////////////////////////
+public:
+    ScopeLatencyStats& operator = (const ScopeLatencyStats& src) = default;
+    ScopeLatencyStats& operator = (ScopeLatencyStats&& src) noexcept = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Clears the statistics.
+     **/
+    void clear();
+
+    /**
+     * \brief   Records the duration of the call of the scope.
+     * \param   sample  The duration of the call of the scope.
+     * \return  Returns the position of the scope in the list of scopes.
+     **/
+    int record(const ScopeLatencyStats::sLatencySample& sample);
+
+    /**
+     * \brief   Records the duration of the call, if the log message is the scope exit message.
+     * \param   entry   The log message to record.
+     * \return  Returns the position of the scope in the list of scopes, or -1 if the message is not the scope exit.
+     **/
+    int append(const areg::LogEntry& entry);
+
+    /**
+     * \brief   Returns the number of scopes in the statistics.
+     **/
+    inline int getScopeCount() const;
+
+    /**
+     * \brief   Returns the statistics of the scope at the given position. The position must be valid.
+     **/
+    inline const ScopeLatencyStats::sScopeLatency& getScope(int pos) const;
+
+    /**
+     * \brief   Returns the position of the scope of the instance, or -1 if the scope has no recorded durations.
+     * \param   instId  The ID of the instance (cookie).
+     * \param   scopeId The ID of the scope.
+     **/
+    int findScope(ITEM_ID instId, uint32_t scopeId) const;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    using ScopeKey  = std::pair<ITEM_ID, uint32_t>;
+    using MapScopes = std::map<ScopeKey, int>;
+
+    std::vector<sScopeLatency>  mScopes;    //!< The statistics of the scopes in the order they are seen first.
+    MapScopes                   mScopeMap;  //!< Per instance and scope, the position in the list of scopes.
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ScopeLatencyStats inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline int ScopeLatencyStats::getScopeCount() const
+{
+    return static_cast<int>(mScopes.size());
+}
+
+inline const ScopeLatencyStats::sScopeLatency& ScopeLatencyStats::getScope(int pos) const
+{
+    return mScopes[static_cast<uint32_t>(pos)];
+}
+
+#endif  // LUSAN_DATA_LOG_SCOPELATENCYSTATS_HPP
@@ -27,6 +27,7 @@ ScopeNodeBase::ScopeNodeBase()
     , mParent       ( nullptr )
     , mPrioStates   ( static_cast<uint32_t>(areg::LogPriority::PrioInvalid) )
     , mNodeName     ( )
+    , mTraffic      ( )
 {
 }
 
@@ -36,6 +37,7 @@ ScopeNodeBase::ScopeNodeBase(ScopeNodeBase::eNode nodeType, ScopeNodeBase* paren
     , mParent       ( parent )
     , mPrioStates   ( static_cast<uint32_t>(areg::LogPriority::PrioInvalid) )
     , mNodeName     ( )
+    , mTraffic      ( )
 {
 }
 
@@ -45,6 +47,7 @@ ScopeNodeBase::ScopeNodeBase(ScopeNodeBase::eNode nodeType, const QString& nodeN
     , mParent       ( parent )
     , mPrioStates   ( prio )
     , mNodeName     ( nodeName )
+    , mTraffic      ( )
 {
 }
 
@@ -54,6 +57,7 @@ ScopeNodeBase::ScopeNodeBase(const ScopeNodeBase& src)
     , mParent       ( src.mParent )
     , mPrioStates   ( src.mPrioStates )
     , mNodeName     ( src.mNodeName )
+    , mTraffic      ( src.mTraffic )
 {
 }
 
@@ -63,6 +67,7 @@ ScopeNodeBase::ScopeNodeBase(ScopeNodeBase&& src) noexcept
     , mParent       ( src.mParent )
     , mPrioStates   ( src.mPrioStates )
     , mNodeName     ( std::move(src.mNodeName) )
+    , mTraffic      ( src.mTraffic )
 {
 }
 
@@ -74,6 +79,7 @@ ScopeNodeBase& ScopeNodeBase::operator = (const ScopeNodeBase& src)
         mNodeState  = src.mNodeState;
         mPrioStates = src.mPrioStates;
         mNodeName   = src.mNodeName;
+        mTraffic    = src.mTraffic;
     }
 
     return (*this);
@@ -87,6 +93,7 @@ ScopeNodeBase& ScopeNodeBase::operator = (ScopeNodeBase&& src) noexcept
         mNodeState  = src.mNodeState;
         mPrioStates = src.mPrioStates;
         mNodeName   = std::move(src.mNodeName);
+        mTraffic    = src.mTraffic;
     }
 
     return (*this);
@@ -137,19 +144,19 @@ void ScopeNodeBase::setPriority( uint32_t prio)
 {
     if ((hasPrioValid() == false) || hasPrioNotset())
     {
-        mPrioStates = prio;
+        changePriority(prio);
     }
     else if (hasScopeEntries() && (prio != static_cast<uint32_t>(areg::LogPriority::PrioNotset)) && _isExactPrio(prio))
     {
-        mPrioStates = prio | static_cast<uint32_t>(areg::LogPriority::PrioScope);
+        changePriority(prio | static_cast<uint32_t>(areg::LogPriority::PrioScope));
     }
     else if (prio == static_cast<uint32_t>(areg::LogPriority::PrioScope))
     {
-        mPrioStates |= prio;
+        changePriority(mPrioStates | prio);
     }
     else
     {
-        mPrioStates = prio;
+        changePriority(prio);
     }
 }
 
@@ -161,21 +168,18 @@ void ScopeNodeBase::addPriority( unsigned int prio )
     }
     else if (hasPrioNotset())
     {
-        mPrioStates = prio;
+        changePriority(prio);
     }
     else
     {
-        mPrioStates |= prio;
+        changePriority(mPrioStates | prio);
     }
 }
 
 void ScopeNodeBase::removePriority(unsigned int prio)
 {
-    mPrioStates &= ~prio;
-    if (hasPrioValid() == false)
-    {
-        mPrioStates = static_cast<uint32_t>(areg::LogPriority::PrioNotset);
-    }
+    const uint32_t result{ mPrioStates & ~prio };
+    changePriority(result != static_cast<uint32_t>(areg::LogPriority::PrioInvalid) ? result : static_cast<uint32_t>(areg::LogPriority::PrioNotset));
 }
 
 int ScopeNodeBase::addChildRecursive(const areg::ScopeEntry& scope)
@@ -212,9 +216,9 @@ ScopeNodeBase* ScopeNodeBase::addChildNode(QStringList& nodeNames, uint32_t prio
     return addChildNode(childNode);
 }
 
-ScopeNodeBase* ScopeNodeBase::addChildNode(ScopeNodeBase* childNode)
+ScopeNodeBase* ScopeNodeBase::addChildNode(ScopeNodeBase* /*childNode*/)
 {
-    delete childNode;
+    // The node has no children, the child node is owned by the arena of the tree root.
     return nullptr;
 }
 
@@ -296,6 +300,21 @@ int ScopeNodeBase::getChildLeafsCount() const
     return 0;
 }
 
+int ScopeNodeBase::getChildRow(const ScopeNodeBase& child) const
+{
+    return static_cast<int>(areg::INVALID_INDEX);
+}
+
+int ScopeNodeBase::getFetchedCount() const
+{
+    return 0;
+}
+
+int ScopeNodeBase::fetchChildren(int count)
+{
+    return 0;
+}
+
 void ScopeNodeBase::addChildPriorityRecursive(QString& nodePath, uint32_t prio)
 {
     QStringList nameList;
@@ -313,15 +332,11 @@ void ScopeNodeBase::addChildPriorityRecursive(QStringList& pathList, uint32_t pr
         if (child != nullptr)
         {
             child->addChildPriorityRecursive(pathList, prio);
-            prio = child->getPriority();
         }
     }
-    
-    if (hasPrioValid() && (isLeaf() == false))
-    {
-        mPrioStates |= prio;
-    }
-    else
+
+    // The nodes on the path get the priority from the leaf.
+    if (isLeaf())
     {
         ScopeNodeBase::setPriority(prio);
     }
@@ -380,14 +395,23 @@ int ScopeNodeBase::getChildren(std::vector<ScopeNodeBase*>& children) const
 
 void ScopeNodeBase::resetPrioritiesRecursive(bool skipLeafs)
 {
-    if ((isLeaf() == false) || (skipLeafs == false))
+    if (skipLeafs == false)
         resetPriority();
 }
 
+void ScopeNodeBase::resetTrafficRecursive()
+{
+    mTraffic.reset();
+}
+
 void ScopeNodeBase::refreshPrioritiesRecursive()
 {
 }
 
+void ScopeNodeBase::updateLeafPriority(uint32_t /*oldPrio*/, uint32_t /*newPrio*/)
+{
+}
+
 QList<ScopeNodeBase*> ScopeNodeBase::getNodesWithPriority() const
 {
     QList<ScopeNodeBase*> result;
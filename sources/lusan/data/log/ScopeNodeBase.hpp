@@ -22,6 +22,7 @@
  * Include files.
  ************************************************************************/
 #include "lusan/common/NELusanCommon.hpp"
+#include "lusan/data/log/ScopeTraffic.hpp"
 #include "areg/base/areg_global.h"
 #include "areg/logging/areg_log.h"
 
@@ -208,17 +209,11 @@ public:
     inline void setParent(ScopeNodeBase* parent);
 
     /**
-     * \brief   Resets the priority bits of the node.
+     * \brief   Resets the priority bits of the leaf. The priority of the nodes follows the priorities of their leafs
+     *          and is not reset.
      **/
     inline void resetPriority();
 
-    /**
-     * \brief   Updates priority bits of the parent node.
-     * \param   prio        The priority bits to set.
-     * \param   recursive   If true, the parent node is updated recursively until root node.
-     **/
-    inline void updateParentPrio(uint32_t prio, bool recursive);
-
     /**
      * \brief   Returns true if node has children.
      **/
@@ -268,6 +263,18 @@ public:
      **/
     inline void setNodeTreeCollapsed();
 
+    /**
+     * \brief   Returns the traffic statistics of the log messages of the node and its children.
+     **/
+    inline const ScopeTraffic& getTraffic() const;
+
+    /**
+     * \brief   Counts the log message in the traffic statistics of the node and of the parent nodes up to the root.
+     * \param   bytes       The length of the text of the message.
+     * \param   timestamp   The timestamp of the message in microseconds.
+     **/
+    inline void countTraffic(uint32_t bytes, TIME64 timestamp);
+
 //////////////////////////////////////////////////////////////////////////
 // Overrides
 //////////////////////////////////////////////////////////////////////////
@@ -350,6 +357,8 @@ public:
     /**
      * \brief   Adds a child node to the parent if the node does not exist.
      *          Otherwise, it adds in the existing node the log priority of the passed node object.
+     *          The child node is created by `makeChildNode()` and is owned by the tree root,
+     *          it is never deleted by this call.
      * \param   childNode   The child node to add to the parent.
      * \return  The pointer to the added child node.
      **/
@@ -434,6 +443,27 @@ public:
      **/
     virtual int getChildLeafsCount() const;
 
+    /**
+     * \brief   Returns the position of the child in the list of children, the child nodes are
+     *          followed by the child leafs. Returns NECommon::INVALID_INDEX if it is not a child.
+     *          Unlike `getChildPosition()`, only the list of the type of the child is searched.
+     * \param   child   The child node or leaf to find.
+     **/
+    virtual int getChildRow(const ScopeNodeBase& child) const;
+
+    /**
+     * \brief   Returns the number of children fetched to show, which are the child nodes and
+     *          the fetched child leafs. The leafs of the node are fetched by pages on request.
+     **/
+    virtual int getFetchedCount() const;
+
+    /**
+     * \brief   Fetches the next leafs of the node to show.
+     * \param   count   The maximum number of the leafs to fetch.
+     * \return  Returns the number of fetched leafs, which are placed after the fetched children.
+     **/
+    virtual int fetchChildren(int count);
+
     /**
      * \brief   Adds the priority recursively to the child nodes.
      *          On returns, the `nodePath` returns empty string if the complete path was updated.
@@ -494,17 +524,25 @@ public:
     virtual int getChildren(std::vector<ScopeNodeBase*> & children) const;
 
     /**
-     * \brief   Resets and invalidates the priorities of the node and all child nodes.
-     * \param   skipLeafs   If true, skips resetting the priority of the leafs and resets the priority only nodes.
-     *                      Otherwise, it resets the priority of the leafs and nodes.
+     * \brief   Resets and invalidates the priorities of the leafs of the node and all child nodes.
+     *          The priorities of the nodes follow the priorities of the leafs.
+     * \param   skipLeafs   If true, nothing is reset, the priorities of the nodes are always up to date.
+     *                      Otherwise, it resets the priority of the leafs.
      **/
     virtual void resetPrioritiesRecursive(bool skipLeafs);
 
     /**
-     * \brief   Refreshes the priorities by keeping the priority of leafs and refreshing the priorities of the nodes.
+     * \brief   Recalculates the priorities of the nodes from the priorities of the leafs.
+     *          The priorities of the nodes are updated when a leaf changes, the call is not required
+     *          to keep them up to date.
      **/
     virtual void refreshPrioritiesRecursive();
 
+    /**
+     * \brief   Resets the traffic statistics of the node and all child nodes.
+     **/
+    virtual void resetTrafficRecursive();
+
     /**
      * \brief   Returns the list of nodes with log priority. The node should not have NotSet priority flag.
      **/
@@ -564,6 +602,25 @@ public:
      **/
     virtual uint32_t getScopeId() const;
 
+//////////////////////////////////////////////////////////////////////////
+// Protected methods
+//////////////////////////////////////////////////////////////////////////
+protected:
+
+    /**
+     * \brief   Called on the parent node when the priority of the child leaf is changed.
+     *          The nodes update the priority of the path up to the root.
+     * \param   oldPrio     The priority of the leaf before the change.
+     * \param   newPrio     The priority of the leaf after the change.
+     **/
+    virtual void updateLeafPriority(uint32_t oldPrio, uint32_t newPrio);
+
+    /**
+     * \brief   Sets the priority bits. If the priority of the leaf is changed, notifies the parent node.
+     * \param   prio        The priority bits to set.
+     **/
+    inline void changePriority(uint32_t prio);
+
 private:
     //!< Return true if the prio is an exact match
     inline bool _isExactPrio(uint32_t prio) const;
@@ -582,6 +639,8 @@ protected:
     unsigned int                mPrioStates;
     //!< The name of the node.
     QString                     mNodeName;
+    //!< The traffic statistics of the log messages of the node and its children.
+    ScopeTraffic                mTraffic;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -696,17 +755,21 @@ inline void ScopeNodeBase::setParent(ScopeNodeBase* parent)
 
 inline void ScopeNodeBase::resetPriority()
 {
-    mPrioStates = static_cast<uint32_t>(areg::LogPriority::PrioInvalid);
+    if (isLeaf())
+    {
+        changePriority(static_cast<uint32_t>(areg::LogPriority::PrioInvalid));
+    }
 }
 
-inline void ScopeNodeBase::updateParentPrio(uint32_t prio, bool recursive)
+inline void ScopeNodeBase::changePriority(uint32_t prio)
 {
-    if (mParent != nullptr)
+    if (mPrioStates != prio)
     {
-        mParent->mPrioStates |= prio;
-        if (recursive)
+        const uint32_t oldPrio{ mPrioStates };
+        mPrioStates = prio;
+        if (isLeaf() && (mParent != nullptr))
         {
-            mParent->updateParentPrio(prio, recursive);
+            mParent->updateLeafPriority(oldPrio, prio);
         }
     }
 }
@@ -780,18 +843,29 @@ inline void ScopeNodeBase::setNodeState(bool isExpanded)
     else
     {
         mNodeState = ScopeNodeBase::eNodeState::NodeCollapsed;
-        std::vector<ScopeNodeBase*> children;
-        if (getChildren(children) > 0)
+        const int count{ getChildCount() };
+        for (int i = 0; i < count; ++i)
         {
-            for (ScopeNodeBase* child : children)
-            {
-                Q_ASSERT(child != nullptr);
-                child->setNodeState(false);
-            }
+            ScopeNodeBase* child{ getChildAt(i) };
+            Q_ASSERT(child != nullptr);
+            child->setNodeState(false);
         }
     }
 }
 
+inline const ScopeTraffic& ScopeNodeBase::getTraffic() const
+{
+    return mTraffic;
+}
+
+inline void ScopeNodeBase::countTraffic(uint32_t bytes, TIME64 timestamp)
+{
+    for (ScopeNodeBase* node = this; node != nullptr; node = node->mParent)
+    {
+        node->mTraffic.countMessage(bytes, timestamp);
+    }
+}
+
 inline ScopeNodeBase::eNodeState ScopeNodeBase::getNodeState() const
 {
     return mNodeState;
@@ -805,28 +879,24 @@ inline bool ScopeNodeBase::isNodeExpanded() const
 inline void ScopeNodeBase::setNodeTreeExpanded()
 {
     mNodeState = ScopeNodeBase::eNodeState::NodeExpanded;
-    std::vector<ScopeNodeBase*> children;
-    if (getChildren(children) > 0)
+    const int count{ getChildCount() };
+    for (int i = 0; i < count; ++i)
     {
-        for (ScopeNodeBase* child : children)
-        {
-            Q_ASSERT(child != nullptr);
-            child->setNodeTreeExpanded();
-        }
+        ScopeNodeBase* child{ getChildAt(i) };
+        Q_ASSERT(child != nullptr);
+        child->setNodeTreeExpanded();
     }
 }
 
 inline void ScopeNodeBase::setNodeTreeCollapsed()
 {
     mNodeState = ScopeNodeBase::eNodeState::NodeCollapsed;
-    std::vector<ScopeNodeBase*> children;
-    if (getChildren(children) > 0)
+    const int count{ getChildCount() };
+    for (int i = 0; i < count; ++i)
     {
-        for (ScopeNodeBase* child : children)
-        {
-            Q_ASSERT(child != nullptr);
-            child->setNodeTreeCollapsed();
-        }
+        ScopeNodeBase* child{ getChildAt(i) };
+        Q_ASSERT(child != nullptr);
+        child->setNodeTreeCollapsed();
     }
 }
 
@@ -95,6 +95,8 @@ ScopeNode::ScopeNode(ScopeNode* parent)
     : ScopeNodeBase (ScopeNodeBase::eNode::Node, parent)
     , mChildNodes   ( )
     , mChildLeafs   ( )
+    , mPrioCounts   ( )
+    , mFetchedLeafs ( 0 )
 {
 }
 
@@ -102,6 +104,8 @@ ScopeNode::ScopeNode(const QString& nodeName, uint32_t prio, ScopeNode* parent)
     : ScopeNodeBase (ScopeNodeBase::eNode::Node, nodeName, prio, parent)
     , mChildNodes   ( )
     , mChildLeafs   ( )
+    , mPrioCounts   ( )
+    , mFetchedLeafs ( 0 )
 {
 }
 
@@ -109,6 +113,8 @@ ScopeNode::ScopeNode(const ScopeNodeBase& base)
     : ScopeNodeBase (ScopeNodeBase::eNode::Node, base.getNodeName(), base.getPriority(), base.getParent())
     , mChildNodes   ( )
     , mChildLeafs   ( )
+    , mPrioCounts   ( )
+    , mFetchedLeafs ( 0 )
 {
 }
 
@@ -116,6 +122,8 @@ ScopeNode::ScopeNode(const ScopeNode& src)
     : ScopeNodeBase ( static_cast<const ScopeNodeBase &>(src) )
     , mChildNodes   ( src.mChildNodes )
     , mChildLeafs   ( src.mChildLeafs )
+    , mPrioCounts   ( src.mPrioCounts )
+    , mFetchedLeafs ( src.mFetchedLeafs )
 {
 }
 
@@ -123,6 +131,8 @@ ScopeNode::ScopeNode( ScopeNode && src ) noexcept
     : ScopeNodeBase ( static_cast<const ScopeNodeBase &>(src) )
     , mChildNodes   ( std::move(src.mChildNodes) )
     , mChildLeafs   ( std::move(src.mChildLeafs) )
+    , mPrioCounts   ( src.mPrioCounts )
+    , mFetchedLeafs ( src.mFetchedLeafs )
 {
 }
 
@@ -130,6 +140,8 @@ ScopeNode::ScopeNode( ScopeNodeBase::eNode nodeType, const QString & name, unsig
     : ScopeNodeBase ( nodeType, name, prio, parent )
     , mChildNodes   ( )
     , mChildLeafs   ( )
+    , mPrioCounts   ( )
+    , mFetchedLeafs ( 0 )
 {
 }
 
@@ -137,6 +149,8 @@ ScopeNode::ScopeNode( ScopeNodeBase::eNode nodeType, const QString & name, Scope
     : ScopeNodeBase ( nodeType, name, static_cast<uint32_t>(areg::LogPriority::PrioNotset), parent )
     , mChildNodes   ( )
     , mChildLeafs   ( )
+    , mPrioCounts   ( )
+    , mFetchedLeafs ( 0 )
 {
 }
 
@@ -144,23 +158,14 @@ ScopeNode::ScopeNode( ScopeNodeBase::eNode nodeType, ScopeRoot * parent /*= null
     : ScopeNodeBase ( nodeType, parent )
     , mChildNodes   ( )
     , mChildLeafs   ( )
+    , mPrioCounts   ( )
+    , mFetchedLeafs ( 0 )
 {
 }
 
 ScopeNode::~ScopeNode()
 {
-    for (const auto& node : mChildLeafs )
-    {
-        Q_ASSERT(node.second != nullptr);
-        delete node.second;
-    }
-    
-    for (const auto& node : mChildNodes)
-    {
-        Q_ASSERT(node.second != nullptr);
-        delete node.second;
-    }
-
+    // The children are owned and destroyed by the arena of the root.
     mChildLeafs.clear();
     mChildNodes.clear();
 }
@@ -172,6 +177,8 @@ ScopeNode & ScopeNode::operator = ( const ScopeNode & src )
     {
         mChildNodes = src.mChildNodes;
         mChildLeafs = src.mChildLeafs;
+        mPrioCounts = src.mPrioCounts;
+        mFetchedLeafs = src.mFetchedLeafs;
     }
 
     return (*this);
@@ -184,6 +191,8 @@ ScopeNode & ScopeNode::operator = ( ScopeNode && src ) noexcept
     {
         mChildNodes = std::move(src.mChildNodes);
         mChildLeafs = std::move(src.mChildLeafs);
+        mPrioCounts = src.mPrioCounts;
+        mFetchedLeafs = src.mFetchedLeafs;
     }
 
     return (*this);
@@ -191,63 +200,81 @@ ScopeNode & ScopeNode::operator = ( ScopeNode && src ) noexcept
 
 void ScopeNode::setPriority( uint32_t prio)
 {
-    ScopeNodeBase::setPriority(prio);
-
-    for (auto & child : mChildLeafs)
+    for (ScopeLeaf* child : mChildLeafs)
     {
-        child.second->setPriority(prio);
+        child->setPriority(prio);
     }
 
-    for (auto & child : mChildNodes)
+    for (ScopeNode* child : mChildNodes)
     {
-        child.second->setPriority(prio);
+        child->setPriority(prio);
     }
 }
 
 void ScopeNode::addPriority(uint32_t prio)
 {
-    ScopeNodeBase::addPriority(prio);
-
-    for (auto& child : mChildLeafs)
+    for (ScopeLeaf* child : mChildLeafs)
     {
-        child.second->addPriority(prio);
+        child->addPriority(prio);
     }
 
-    for (auto& child : mChildNodes)
+    for (ScopeNode* child : mChildNodes)
     {
-        child.second->addPriority(prio);
+        child->addPriority(prio);
     }
 }
 
 void ScopeNode::removePriority(uint32_t prio)
 {
-    ScopeNodeBase::removePriority(prio);
+    for (ScopeLeaf* child : mChildLeafs)
+    {
+        child->removePriority(prio);
+    }
 
-    for (auto& child : mChildLeafs)
+    for (ScopeNode* child : mChildNodes)
     {
-        child.second->removePriority(prio);
+        child->removePriority(prio);
     }
+}
+
+int ScopeNode::addChildRecursive(QStringList& nodeNames, uint32_t prio, uint32_t scopeId)
+{
+    ScopeNodeBase* treeRoot{ nodeNames.isEmpty() ? nullptr : getTreeRoot() };
+    if (treeRoot == nullptr)
+        return 0;
 
-    for (auto& child : mChildNodes)
+    ScopeRoot& root = *static_cast<ScopeRoot*>(treeRoot);
+    const int count{ static_cast<int>(nodeNames.size()) };
+    ScopeNode* node{ this };
+    for (int i = 0; i < count - 1; ++i)
     {
-        child.second->removePriority(prio);
+        node = node->getOrAddNode(root, nodeNames[i]);
     }
+
+    ScopeLeaf* leaf = node->getOrAddLeaf(root, nodeNames[count - 1], prio);
+    leaf->setScopeId(scopeId);
+    root._indexLeaf(leaf);
+    nodeNames.clear();
+
+    return count;
 }
 
 ScopeNodeBase* ScopeNode::makeChildNode(QStringList& nodeNames, uint32_t prio)
 {
     ScopeNodeBase * result { nullptr };
-    if (nodeNames.isEmpty() == false)
+    ScopeNodeBase* treeRoot{ nodeNames.isEmpty() ? nullptr : getTreeRoot() };
+    if (treeRoot != nullptr)
     {
+        ScopeRoot& root = *static_cast<ScopeRoot*>(treeRoot);
         QString nodeName = nodeNames.front();
         nodeNames.pop_front();
         if (nodeNames.isEmpty())
         {
-            result = new ScopeLeaf(nodeName, prio, this);
+            result = root._makeLeaf(nodeName, prio, this);
         }
         else
         {
-            result = new ScopeNode(nodeName, prio, this);
+            result = root._makeNode(nodeName, this);
         }
     }
     
@@ -260,38 +287,37 @@ ScopeNodeBase* ScopeNode::addChildNode(ScopeNodeBase* childNode)
     {
         if (childNode->isNode())
         {
-            ScopeNode* existing{ containsNode(childNode->getNodeName()) ? mChildNodes[childNode->getNodeName()] : nullptr };
-            if (existing != nullptr)
+            NodeList::const_iterator pos = lowerNode(childNode->getNodeName());
+            if ((pos != mChildNodes.end()) && ((*pos)->getNodeName() == childNode->getNodeName()))
             {
-                if (existing->hasPrioValid() == false)
-                {
-                    existing->mPrioStates = childNode->getPriority();
-                }
-                else
-                {
-                    existing->mPrioStates |= childNode->getPriority();
-                }
-                
-                delete childNode;
-                childNode = existing;
+                // The priority of the existing node follows its leafs.
+                childNode = *pos;
             }
             else
             {
-                mChildNodes[childNode->getNodeName()] = static_cast<ScopeNode*>(childNode);
+                mChildNodes.insert(pos, static_cast<ScopeNode*>(childNode));
             }
         }
         else if (childNode->isLeaf())
         {
-            ScopeLeaf* existing{ containsLeaf(childNode->getNodeName()) ? mChildLeafs[childNode->getNodeName()] : nullptr };
-            mChildLeafs[childNode->getNodeName()] = static_cast<ScopeLeaf*>(childNode);
-            if (existing != nullptr)
+            LeafList::const_iterator pos = lowerLeaf(childNode->getNodeName());
+            if ((pos != mChildLeafs.end()) && ((*pos)->getNodeName() == childNode->getNodeName()))
             {
-                delete existing;
+                ScopeLeaf* existing{ *pos };
+                existing->resetPriority();
+                existing->setPriority(childNode->getPriority());
+                childNode = existing;
+            }
+            else
+            {
+                // A leaf inserted among the fetched leafs is shown with them.
+                mFetchedLeafs += (static_cast<int>(pos - mChildLeafs.begin()) < mFetchedLeafs) ? 1 : 0;
+                mChildLeafs.insert(pos, static_cast<ScopeLeaf*>(childNode));
+                updateLeafPriority(static_cast<uint32_t>(areg::LogPriority::PrioInvalid), childNode->getPriority());
             }
         }
         else
         {
-            delete childNode;
             childNode = nullptr;
         }
     }
@@ -301,85 +327,39 @@ ScopeNodeBase* ScopeNode::addChildNode(ScopeNodeBase* childNode)
 
 ScopeNodeBase* ScopeNode::findChild(const QString& childName) const
 {
-    ScopeNodeBase* result{ nullptr };
-    NodeList::const_iterator itNode = mChildNodes.find(childName);
-    if (itNode != mChildNodes.end())
-    {
-        result = itNode->second;
-    }
-    else
-    {
-        LeafList::const_iterator itLeaf = mChildLeafs.find(childName);
-        if (itLeaf != mChildLeafs.end())
-        {
-            result = itLeaf->second;
-        }
-    }
+    NodeList::const_iterator itNode = lowerNode(childName);
+    if ((itNode != mChildNodes.end()) && ((*itNode)->getNodeName() == childName))
+        return *itNode;
 
-    return result;
+    LeafList::const_iterator itLeaf = lowerLeaf(childName);
+    if ((itLeaf != mChildLeafs.end()) && ((*itLeaf)->getNodeName() == childName))
+        return *itLeaf;
+
+    return nullptr;
 }
 
 int ScopeNode::getChildPosition(const QString& childName) const
 {
-    int result{ static_cast<int>(areg::INVALID_INDEX) };
-    int pos = 0;
-    for (const auto & node : mChildNodes)
-    {
-        if (node.second->getNodeName() == childName)
-        {
-            result = pos;
-            break;
-        }
-
-        ++pos;
-    }
+    NodeList::const_iterator itNode = lowerNode(childName);
+    if ((itNode != mChildNodes.end()) && ((*itNode)->getNodeName() == childName))
+        return static_cast<int>(itNode - mChildNodes.begin());
 
-    if (result == static_cast<int>(areg::INVALID_INDEX))
-    {
-        pos = 0;
-        for (const auto & node : mChildLeafs)
-        {
-            if (node.second->getNodeName() == childName)
-            {
-                result = pos;
-                break;
-            }
+    // The leafs are listed after the nodes.
+    LeafList::const_iterator itLeaf = lowerLeaf(childName);
+    if ((itLeaf != mChildLeafs.end()) && ((*itLeaf)->getNodeName() == childName))
+        return static_cast<int>(mChildNodes.size()) + static_cast<int>(itLeaf - mChildLeafs.begin());
 
-            ++pos;
-        }
-    }
-
-    return result;
+    return static_cast<int>(areg::INVALID_INDEX);
 }
 
 ScopeNodeBase* ScopeNode::getChildAt(int pos) const
 {
-    ScopeNodeBase* result = nullptr;
-    int cntNode = static_cast<int>(mChildNodes.size());
-    int cntLeaf = static_cast<int>(mChildLeafs.size());
-    
-    if ((pos >= 0) && (pos < (cntNode + cntLeaf)))
-    {
-        if (pos < cntNode)
-        {
-            auto it = mChildNodes.begin();
-            for (int i = 0; i < pos; ++i)
-                ++it;
-            Q_ASSERT(it != mChildNodes.end());
-            return it->second;
-        }
-        else
-        {
-            pos -= static_cast<int>(mChildNodes.size());
-            Q_ASSERT(pos >= 0);
-            auto it = mChildLeafs.begin();
-            for (int i = 0; i < pos; ++ i)
-                ++it;
-            return it->second;
-        }
-    }
-    
-    return result;
+    const int cntNode = static_cast<int>(mChildNodes.size());
+    const int cntLeaf = static_cast<int>(mChildLeafs.size());
+    if ((pos < 0) || (pos >= (cntNode + cntLeaf)))
+        return nullptr;
+
+    return (pos < cntNode ? static_cast<ScopeNodeBase*>(mChildNodes[pos]) : static_cast<ScopeNodeBase*>(mChildLeafs[pos - cntNode]));
 }
 
 int ScopeNode::getChildCount() const
@@ -397,6 +377,60 @@ int ScopeNode::getChildLeafsCount() const
     return static_cast<int>(mChildLeafs.size());
 }
 
+int ScopeNode::getChildRow(const ScopeNodeBase& child) const
+{
+    if (child.getParent() != this)
+        return static_cast<int>(areg::INVALID_INDEX);
+
+    if (child.isNode())
+    {
+        NodeList::const_iterator pos = lowerNode(child.getNodeName());
+        if ((pos != mChildNodes.end()) && (*pos == &child))
+            return static_cast<int>(pos - mChildNodes.begin());
+    }
+    else if (child.isLeaf())
+    {
+        LeafList::const_iterator pos = lowerLeaf(child.getNodeName());
+        if ((pos != mChildLeafs.end()) && (*pos == &child))
+            return static_cast<int>(mChildNodes.size()) + static_cast<int>(pos - mChildLeafs.begin());
+    }
+
+    return static_cast<int>(areg::INVALID_INDEX);
+}
+
+int ScopeNode::getFetchedCount() const
+{
+    // The leafs are never removed, the fetched leafs are the first leafs of the list.
+    return static_cast<int>(mChildNodes.size()) + std::min(mFetchedLeafs, static_cast<int>(mChildLeafs.size()));
+}
+
+int ScopeNode::fetchChildren(int count)
+{
+    const int fetched{ std::min(mFetchedLeafs, static_cast<int>(mChildLeafs.size())) };
+    const int result{ std::max(0, std::min(count, static_cast<int>(mChildLeafs.size()) - fetched)) };
+    mFetchedLeafs = fetched + result;
+    return result;
+}
+
+int ScopeNode::getInsertRow(const QString& childName, bool isNode) const
+{
+    if (isNode)
+    {
+        NodeList::const_iterator pos = lowerNode(childName);
+        if ((pos != mChildNodes.end()) && ((*pos)->getNodeName() == childName))
+            return static_cast<int>(areg::INVALID_INDEX);
+
+        return static_cast<int>(pos - mChildNodes.begin());
+    }
+
+    LeafList::const_iterator pos = lowerLeaf(childName);
+    if ((pos != mChildLeafs.end()) && ((*pos)->getNodeName() == childName))
+        return static_cast<int>(areg::INVALID_INDEX);
+
+    const int leafRow{ static_cast<int>(pos - mChildLeafs.begin()) };
+    return (leafRow < mFetchedLeafs ? static_cast<int>(mChildNodes.size()) + leafRow : static_cast<int>(areg::INVALID_INDEX));
+}
+
 bool ScopeNode::hasNodes() const
 {
     return (mChildNodes.empty() == false);
@@ -409,59 +443,57 @@ bool ScopeNode::hasLeafs() const
 
 bool ScopeNode::containsLeaf(const QString& leafName) const
 {
-    return (mChildLeafs.find(leafName) != mChildLeafs.end());
+    LeafList::const_iterator pos = lowerLeaf(leafName);
+    return ((pos != mChildLeafs.end()) && ((*pos)->getNodeName() == leafName));
 }
 
 bool ScopeNode::containsNode(const QString& nodeName) const
 {
-    return (mChildNodes.find(nodeName) != mChildNodes.end());
+    NodeList::const_iterator pos = lowerNode(nodeName);
+    return ((pos != mChildNodes.end()) && ((*pos)->getNodeName() == nodeName));
 }
 
 int ScopeNode::getChildren(std::vector<ScopeNodeBase*>& children) const
 {
-    const auto extractValue = [](const auto &key) { return key.second; };
-
-    std::transform(mChildNodes.cbegin(),
-                   mChildNodes.cend(),
-                   std::back_inserter(children),
-                   extractValue);
-
-    std::transform(mChildLeafs.cbegin(),
-                   mChildLeafs.cend(),
-                   std::back_inserter(children),
-                   extractValue);
+    children.insert(children.end(), mChildNodes.cbegin(), mChildNodes.cend());
+    children.insert(children.end(), mChildLeafs.cbegin(), mChildLeafs.cend());
     return static_cast<int>(children.size());
 }
 
 void ScopeNode::resetPrioritiesRecursive(bool skipLeafs /*= false*/)
 {
-    ScopeNodeBase::resetPrioritiesRecursive(skipLeafs);
-    for (const auto & node : mChildNodes)
+    // The priorities of the nodes follow the leafs, there is nothing to reset if the leafs are skipped.
+    if (skipLeafs)
+        return;
+
+    for (ScopeNode* node : mChildNodes)
     {
-        node.second->resetPrioritiesRecursive(skipLeafs);
+        node->resetPrioritiesRecursive(skipLeafs);
     }
-    
-    if (skipLeafs == false)
+
+    for (ScopeLeaf* leaf : mChildLeafs)
     {
-        for (const auto & node : mChildLeafs)
-        {
-            node.second->resetPrioritiesRecursive(skipLeafs);
-        }
+        leaf->resetPrioritiesRecursive(skipLeafs);
     }
 }
 
 void ScopeNode::refreshPrioritiesRecursive()
 {
-    for (const auto& node : mChildNodes)
+    // The counts of the subtree do not change, so that the parent nodes remain valid.
+    refreshNodePriorities();
+}
+
+void ScopeNode::resetTrafficRecursive()
+{
+    ScopeNodeBase::resetTrafficRecursive();
+    for (ScopeNode* node : mChildNodes)
     {
-        node.second->refreshPrioritiesRecursive();
+        node->resetTrafficRecursive();
     }
 
-    for (const auto& leaf : mChildLeafs)
+    for (ScopeLeaf* leaf : mChildLeafs)
     {
-        ScopeNodeBase* node = leaf.second;
-        Q_ASSERT(node != nullptr);
-        node->updateParentPrio(node->getPriority(), true);
+        leaf->resetTrafficRecursive();
     }
 }
 
@@ -470,16 +502,16 @@ QList<ScopeNodeBase*> ScopeNode::getNodesWithPriority() const
     QList<ScopeNodeBase*> result = ScopeNodeBase::getNodesWithPriority();
     if (result.isEmpty())
     {
-        for (const auto& node : mChildNodes)
+        for (ScopeNode* node : mChildNodes)
         {
-            QList<ScopeNodeBase*> list = node.second->getNodesWithPriority();
+            QList<ScopeNodeBase*> list = node->getNodesWithPriority();
             if (list.isEmpty() == false)
                 result.append(list);
         }
         
-        for (const auto& node : mChildLeafs)
+        for (ScopeLeaf* node : mChildLeafs)
         {
-            QList<ScopeNodeBase*> list = node.second->getNodesWithPriority();
+            QList<ScopeNodeBase*> list = node->getNodesWithPriority();
             if (list.isEmpty() == false)
                 result.append(list);
         }
@@ -493,14 +525,14 @@ int ScopeNode::extractNodesWithPriority(QList<ScopeNodeBase*>& list) const
     int result{ ScopeNodeBase::extractNodesWithPriority(list) };
     if (result == 0)
     {
-        for (const auto& node : mChildNodes)
+        for (ScopeNode* node : mChildNodes)
         {
-            result += node.second->extractNodesWithPriority(list);
+            result += node->extractNodesWithPriority(list);
         }
 
-        for (const auto& node : mChildLeafs)
+        for (ScopeLeaf* node : mChildLeafs)
         {
-            result += node.second->extractNodesWithPriority(list);
+            result += node->extractNodesWithPriority(list);
         }
     }
 
@@ -510,14 +542,14 @@ int ScopeNode::extractNodesWithPriority(QList<ScopeNodeBase*>& list) const
 int ScopeNode::extractChildNodesWithPriority(QList<ScopeNodeBase*>& list) const
 {
     int result{ 0 };
-    for (const auto& node : mChildNodes)
+    for (ScopeNode* node : mChildNodes)
     {
-        result += node.second->extractNodesWithPriority(list);
+        result += node->extractNodesWithPriority(list);
     }
 
-    for (const auto& node : mChildLeafs)
+    for (ScopeLeaf* node : mChildLeafs)
     {
-        result += node.second->extractNodesWithPriority(list);
+        result += node->extractNodesWithPriority(list);
     }
 
     return result;
@@ -532,17 +564,82 @@ std::vector<ScopeNodeBase*> ScopeNode::extractNodeLeafs() const
 
 uint32_t ScopeNode::extractNodeLeafs(std::vector<ScopeNodeBase*>& leafs) const
 {
-    for (auto node : mChildLeafs)
+    leafs.insert(leafs.end(), mChildLeafs.cbegin(), mChildLeafs.cend());
+    for (ScopeNode* node : mChildNodes)
     {
-        leafs.push_back(node.second);
+        node->extractNodeLeafs(leafs);
     }
 
-    for (const auto& node : mChildNodes)
+    return static_cast<uint32_t>(leafs.size());
+}
+
+ScopeNode* ScopeNode::getOrAddNode(ScopeRoot& root, const QString& nodeName)
+{
+    NodeList::const_iterator pos = lowerNode(nodeName);
+    if ((pos != mChildNodes.end()) && ((*pos)->getNodeName() == nodeName))
+        return *pos;
+
+    ScopeNode* node = root._makeNode(nodeName, this);
+    mChildNodes.insert(pos, node);
+    return node;
+}
+
+ScopeLeaf* ScopeNode::getOrAddLeaf(ScopeRoot& root, const QString& leafName, uint32_t prio)
+{
+    LeafList::const_iterator pos = lowerLeaf(leafName);
+    if ((pos != mChildLeafs.end()) && ((*pos)->getNodeName() == leafName))
     {
-        node.second->extractNodeLeafs(leafs);
+        ScopeLeaf* existing{ *pos };
+        existing->resetPriority();
+        existing->setPriority(prio);
+        return existing;
     }
 
-    return static_cast<uint32_t>(leafs.size());
+    ScopeLeaf* leaf = root._makeLeaf(leafName, prio, this);
+    // A leaf inserted among the fetched leafs is shown with them.
+    mFetchedLeafs += (static_cast<int>(pos - mChildLeafs.begin()) < mFetchedLeafs) ? 1 : 0;
+    mChildLeafs.insert(pos, leaf);
+    updateLeafPriority(static_cast<uint32_t>(areg::LogPriority::PrioInvalid), prio);
+    return leaf;
+}
+
+void ScopeNode::updateLeafPriority(uint32_t oldPrio, uint32_t newPrio)
+{
+    for (ScopeNode* node = this; node != nullptr; node = static_cast<ScopeNode*>(node->mParent))
+    {
+        node->countLeafPriority(oldPrio, newPrio);
+    }
+}
+
+void ScopeNode::refreshNodePriorities()
+{
+    mPrioCounts.fill(0u);
+    for (ScopeNode* node : mChildNodes)
+    {
+        node->refreshNodePriorities();
+        for (uint32_t bit = 0u; bit < PRIO_BITS; ++bit)
+        {
+            mPrioCounts[bit] += node->mPrioCounts[bit];
+        }
+    }
+
+    uint32_t prio{ static_cast<uint32_t>(areg::LogPriority::PrioInvalid) };
+    for (ScopeLeaf* leaf : mChildLeafs)
+    {
+        const uint32_t leafPrio{ leaf->getPriority() };
+        prio |= leafPrio;
+        for (uint32_t bit = 0u; bit < PRIO_BITS; ++bit)
+        {
+            mPrioCounts[bit] += (leafPrio >> bit) & 1u;
+        }
+    }
+
+    for (ScopeNode* node : mChildNodes)
+    {
+        prio |= node->mPrioStates;
+    }
+
+    mPrioStates = prio;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -552,51 +649,49 @@ uint32_t ScopeNode::extractNodeLeafs(std::vector<ScopeNodeBase*>& leafs) const
 ScopeRoot::ScopeRoot()
     : ScopeNode (ScopeNodeBase::eNode::Root, nullptr)
     , mRootId   (areg::COOKIE_LOCAL)
+    , mNodeArena( )
+    , mLeafArena( )
+    , mNames    ( )
+    , mScopes   ( )
 {
 }
 
 ScopeRoot::ScopeRoot(ITEM_ID rootId)
     : ScopeNode (ScopeNodeBase::eNode::Root, nullptr)
     , mRootId   (rootId)
+    , mNodeArena( )
+    , mLeafArena( )
+    , mNames    ( )
+    , mScopes   ( )
 {
 }
 
 ScopeRoot::ScopeRoot(const areg::ConnectedInstance& instance)
     : ScopeNode (ScopeNodeBase::eNode::Root, QString(instance.ciInstance.c_str()), static_cast<uint32_t>(areg::LogPriority::PrioNotset), nullptr)
     , mRootId   (instance.ciCookie)
+    , mNodeArena( )
+    , mLeafArena( )
+    , mNames    ( )
+    , mScopes   ( )
 {
 }
 
 ScopeRoot::ScopeRoot(ITEM_ID rootId, const QString& rootName)
     : ScopeNode (ScopeNodeBase::eNode::Root, rootName, static_cast<uint32_t>(areg::LogPriority::PrioNotset), nullptr)
     , mRootId   (rootId)
+    , mNodeArena( )
+    , mLeafArena( )
+    , mNames    ( )
+    , mScopes   ( )
 {
 }
 
-ScopeRoot::ScopeRoot(const ScopeRoot& src)
-    : ScopeNode ( static_cast<const ScopeNode &>(src) )
-    , mRootId   ( src.mRootId )
-{
-}
-
-ScopeRoot::ScopeRoot(ScopeRoot&& src) noexcept
-    : ScopeNode ( std::move(static_cast<ScopeNode &&>(src)) )
-    , mRootId   ( src.mRootId )
+ScopeRoot::~ScopeRoot()
 {
-}
-
-ScopeRoot& ScopeRoot::operator = (const ScopeRoot& src)
-{
-    ScopeNode::operator = (static_cast<const ScopeNode&>(src));
-    mRootId = src.mRootId;
-    return (*this);
-}
-
-ScopeRoot& ScopeRoot::operator = (ScopeRoot&& src) noexcept
-{
-    ScopeNode::operator = (std::move(static_cast<ScopeNode&&>(src)));
-    mRootId = src.mRootId;
-    return (*this);
+    // The nodes are destroyed with the arena, the lists of children are not used anymore.
+    mChildLeafs.clear();
+    mChildNodes.clear();
+    mScopes.clear();
 }
 
 QString ScopeRoot::getPathString() const
@@ -609,3 +704,14 @@ QString ScopeRoot::getDisplayName() const
     QString result {getNodeName() + " (" + QString::number(mRootId) + ")"};
     return result;
 }
+
+const QString& ScopeRoot::_internName(const QString& name)
+{
+    QSet<QString>::const_iterator pos = mNames.constFind(name);
+    if (pos == mNames.cend())
+    {
+        pos = mNames.insert(name);
+    }
+
+    return *pos;
+}
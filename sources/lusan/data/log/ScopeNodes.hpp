@@ -22,10 +22,16 @@
  * Include files.
  ************************************************************************/
 #include "lusan/data/log/ScopeNodeBase.hpp"
+#include "lusan/data/log/TEScopeArena.hpp"
 #include "areg/base/SortedLinkedList.hpp"
 #include "areg/component/ServiceDefs.hpp"
 
-#include <map>
+#include <QHash>
+#include <QSet>
+
+#include <algorithm>
+#include <array>
+#include <vector>
 
 /************************************************************************
  * Declared classes
@@ -129,6 +135,13 @@ private:
 //////////////////////////////////////////////////////////////////////////
 /**
  * \brief   The scope node, which has parent, leafs and child nodes.
+ *          The child nodes and the child leafs are kept in the arrays sorted by name,
+ *          so that the child is found by the binary search and is accessed by position
+ *          directly. The children are allocated in the arena of the root of the tree
+ *          and are destroyed together with the root.
+ *          The priority of the node is the priority of all its leafs. The node counts per
+ *          priority bit the leafs that have the bit set, so that the change of one leaf
+ *          updates only the nodes on the path to the root.
  **/
 class ScopeNode : public ScopeNodeBase
 {
@@ -136,10 +149,15 @@ class ScopeNode : public ScopeNodeBase
 // Internal types
 //////////////////////////////////////////////////////////////////////////
 public:
-    //!< The list of the nodes.
-    using NodeList = std::map<QString, ScopeNode *>;
-    //!< The list of leafs.
-    using LeafList = std::map<QString, ScopeLeaf *>;
+    //!< The list of the nodes, sorted by name.
+    using NodeList = std::vector<ScopeNode *>;
+    //!< The list of leafs, sorted by name.
+    using LeafList = std::vector<ScopeLeaf *>;
+
+    //!< The number of the bits of the log priority.
+    static constexpr uint32_t   PRIO_BITS   { 8u * static_cast<uint32_t>(sizeof(areg::LogPriority)) };
+    //!< Per priority bit, the number of leafs of the node with the bit set.
+    using PrioCounts = std::array<uint32_t, PRIO_BITS>;
 
 //////////////////////////////////////////////////////////////////////////
 // Constructors / Destructor
@@ -205,37 +223,52 @@ public:
  ************************************************************************/
 
     /**
-     * \brief   Sets the node priority flag.
+     * \brief   Sets the priority flag of all leafs of the node.
      **/
     void setPriority(uint32_t prio) override;
 
     /**
-     * \brief   Adds log priority bits.
+     * \brief   Adds log priority bits to all leafs of the node.
      **/
     void addPriority(unsigned int prio) override;
 
     /**
-     * \brief   Adds log priority bits.
+     * \brief   Removes log priority bits from all leafs of the node.
      **/
     void removePriority(unsigned int prio) override;
 
+    using ScopeNodeBase::addChildRecursive;
+
+    /**
+     * \brief   Adds the child nodes and the leaf of the path if they do not exist.
+     *          The leaf gets the log priority and the scope ID, the nodes get the priority from the leaf.
+     *          The nodes are found and created level by level, no intermediate node is created.
+     * \param   nodeNames   The list of node names, the last name is the leaf.
+     *                      On output, the list is empty.
+     * \param   prio        The logging priority to set.
+     * \param   scopeId     The scope ID to set for the leaf node.
+     * \return  The number of nodes and leafs in the path.
+     **/
+    int addChildRecursive(QStringList& nodeNames, uint32_t prio, uint32_t scopeId) override;
+
     /**
-     * \brief   Creates a child node. The child node is not added to the parent.
+     * \brief   Creates a child node in the arena of the root. The child node is not added to the parent.
      *          Each child node is listed in the `nodeNames`. If the list contains last entry, it is created as a 'leaf'.
-     *          If the passed list empty, returns nullptr.
+     *          If the passed list empty or the node is not in the tree of a root, returns nullptr.
      * \param   nodeNames   The list of node names.
      *                      On output, it removes the first node name from the list.
      *                      The last name should be marked as 'leaf'.
-     * \param   prio        The logging priority to set.
+     * \param   prio        The logging priority to set to the leaf. The node gets the priority from its leafs.
      * \return  The node object created.
      **/
     ScopeNodeBase* makeChildNode(QStringList& nodeNames, uint32_t prio) override;
 
     /**
      * \brief   Adds a child node to the parent if the node does not exist.
-     *          Otherwise, it adds in the existing node the log priority of the passed node object.
-     * \param   childNode   The child node to add to the parent.
-     * \return  The pointer to the added child node.
+     *          Otherwise, the existing leaf gets the log priority of the passed leaf object,
+     *          and the passed node remains unused in the arena of the root.
+     * \param   childNode   The child node created by `makeChildNode()` to add to the parent.
+     * \return  The pointer to the added or existing child node.
      **/
     ScopeNodeBase* addChildNode(ScopeNodeBase* childNode) override;
 
@@ -275,6 +308,26 @@ public:
      **/
     int getChildLeafsCount() const override;
 
+    /**
+     * \brief   Returns the position of the child in the list of children, the child nodes are
+     *          followed by the child leafs. Returns NECommon::INVALID_INDEX if it is not a child.
+     * \param   child   The child node or leaf to find.
+     **/
+    int getChildRow(const ScopeNodeBase& child) const override;
+
+    /**
+     * \brief   Returns the number of children fetched to show, which are all child nodes
+     *          and the first fetched child leafs.
+     **/
+    int getFetchedCount() const override;
+
+    /**
+     * \brief   Fetches the next leafs of the node to show.
+     * \param   count   The maximum number of the leafs to fetch.
+     * \return  Returns the number of fetched leafs.
+     **/
+    int fetchChildren(int count) override;
+
     /**
      * \brief   Returns true if the current node has other node objects with children.
      **/
@@ -303,17 +356,25 @@ public:
     int getChildren(std::vector<ScopeNodeBase*>& children) const override;
     
     /**
-     * \brief   Resets and invalidates the priorities of the node and all child nodes.
-     * \param   skipLeafs   If true, skips resetting the priority of the leafs and resets the priority only nodes.
-     *                      Otherwise, it resets the priority of the leafs and nodes.
+     * \brief   Resets and invalidates the priorities of the leafs of the node and all child nodes.
+     *          The priorities of the nodes follow the priorities of the leafs.
+     * \param   skipLeafs   If true, nothing is reset, the priorities of the nodes are always up to date.
+     *                      Otherwise, it resets the priority of the leafs.
      **/
     void resetPrioritiesRecursive(bool skipLeafs) override;
 
     /**
-     * \brief   Refreshes the priorities by keeping the priority of leafs and refreshing the priorities of the nodes.
+     * \brief   Counts again the priorities of the leafs of the node and all child nodes.
+     *          The priorities of the nodes are updated when a leaf changes, the call is not required
+     *          to keep them up to date.
      **/
     void refreshPrioritiesRecursive() override;
 
+    /**
+     * \brief   Resets the traffic statistics of the node and all child nodes.
+     **/
+    void resetTrafficRecursive() override;
+
     /**
      * \brief   Returns the list of nodes with log priority. The node should not have NotSet priority flag.
      **/
@@ -364,20 +425,64 @@ public:
      **/
     inline unsigned int childNodeCount() const;
 
+    /**
+     * \brief   Returns the number of leafs of the node and all child nodes, which have the priority bit set.
+     * \param   prio    The priority bit to check.
+     **/
+    inline uint32_t getLeafCount(areg::LogPriority prio) const;
+
+    /**
+     * \brief   Returns the row, which a new child with the given name takes among the shown children.
+     *          Returns NECommon::INVALID_INDEX if the child exists, or if it is a leaf placed after
+     *          the fetched leafs, which is shown only when it is fetched.
+     * \param   childName   The name of the new child.
+     * \param   isNode      True if the new child is a node, false if it is a leaf.
+     **/
+    int getInsertRow(const QString& childName, bool isNode) const;
+
 //////////////////////////////////////////////////////////////////////////
 // Protected members
 //////////////////////////////////////////////////////////////////////////
 protected:
 
     /**
-     * \brief   Resets the priority of the nodes.
+     * \brief   Called when the priority of the leaf of the node or of the child nodes is changed.
+     *          Updates the priority counts and the priority of this node and of the parent nodes up to the root.
+     * \param   oldPrio     The priority of the leaf before the change.
+     * \param   newPrio     The priority of the leaf after the change.
      **/
-    inline void resetPrioNodes();
+    void updateLeafPriority(uint32_t oldPrio, uint32_t newPrio) override;
 
     /**
-     * \brief   Resets the priority of the leafs.
+     * \brief   Returns the child node with the given name. Creates the node in the arena of the root, if it does not exist.
      **/
-    inline void resetPrioLeafs();
+    ScopeNode* getOrAddNode(ScopeRoot& root, const QString& nodeName);
+
+    /**
+     * \brief   Returns the child leaf with the given name. Creates the leaf in the arena of the root, if it does not exist.
+     *          The leaf gets the log priority.
+     **/
+    ScopeLeaf* getOrAddLeaf(ScopeRoot& root, const QString& leafName, uint32_t prio);
+
+    /**
+     * \brief   Counts again the priorities of the leafs of the node and of the child nodes.
+     **/
+    void refreshNodePriorities();
+
+    /**
+     * \brief   Updates the priority counts and the priority bits of the node by the difference of the leaf priorities.
+     **/
+    inline void countLeafPriority(uint32_t oldPrio, uint32_t newPrio);
+
+    /**
+     * \brief   Returns the position of the child node with the given name, or the position to insert it.
+     **/
+    inline NodeList::const_iterator lowerNode(const QString& nodeName) const;
+
+    /**
+     * \brief   Returns the position of the child leaf with the given name, or the position to insert it.
+     **/
+    inline LeafList::const_iterator lowerLeaf(const QString& leafName) const;
 
 //////////////////////////////////////////////////////////////////////////
 // Protected members
@@ -387,6 +492,10 @@ protected:
     NodeList    mChildNodes;
     //!< The list of child leafs.
     LeafList    mChildLeafs;
+    //!< Per priority bit, the number of leafs of the node and child nodes with the bit set.
+    PrioCounts  mPrioCounts;
+    //!< The number of the first child leafs fetched to show. The child nodes are always shown.
+    int         mFetchedLeafs;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -394,9 +503,14 @@ protected:
 //////////////////////////////////////////////////////////////////////////
 /**
  * \brief   The root node, which is a top level of node, has no parent, leafs and child nodes.
+ *          The root owns the arena where the nodes and leafs of the tree are allocated,
+ *          the table of the names of the nodes, so that the same name of the nodes on
+ *          different levels is stored once, and the index of the leafs by scope ID.
  **/
 class ScopeRoot : public ScopeNode
 {
+    friend class ScopeNode;
+
 //////////////////////////////////////////////////////////////////////////
 // Constructors / Destructor
 //////////////////////////////////////////////////////////////////////////
@@ -426,23 +540,7 @@ public:
      */
     ScopeRoot(ITEM_ID rootId, const QString& rootName );
 
-    /**
-     * \brief   Copies or moves data from the given source
-     **/
-    ScopeRoot( const ScopeRoot & src );
-    ScopeRoot( ScopeRoot && src ) noexcept;
-    
-    virtual ~ScopeRoot() = default;
-
-//////////////////////////////////////////////////////////////////////////
-// Assigning operators
-//////////////////////////////////////////////////////////////////////////
-public:
-    /**
-     * \brief   Copies data from the given source.
-     **/
-    ScopeRoot & operator = ( const ScopeRoot & src );
-    ScopeRoot & operator = ( ScopeRoot && src ) noexcept;
+    virtual ~ScopeRoot();
 
 //////////////////////////////////////////////////////////////////////////
 // Override
@@ -488,12 +586,56 @@ public:
      **/
     inline void setRootName(const QString& newRoot);
 
+    /**
+     * \brief   Returns the leaf of the scope with the given ID, or nullptr if the tree has no such scope.
+     * \param   scopeId     The ID of the scope to search.
+     **/
+    inline ScopeLeaf* findLeaf(uint32_t scopeId) const;
+
+    /**
+     * \brief   Returns the number of scopes with ID in the tree.
+     **/
+    inline int getScopeCount() const;
+
+    /**
+     * \brief   Returns the number of nodes and leafs allocated in the tree.
+     **/
+    inline uint32_t getAllocatedCount() const;
+
 //////////////////////////////////////////////////////////////////////////
-// Protected members
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Returns the stored copy of the name, the equal names of the tree share the same data.
+    const QString& _internName(const QString& name);
+
+    //!< Creates the child node of the parent in the arena. The node has no priority until it gets leafs.
+    inline ScopeNode* _makeNode(const QString& nodeName, ScopeNode* parent);
+
+    //!< Creates the child leaf of the parent in the arena.
+    inline ScopeLeaf* _makeLeaf(const QString& leafName, uint32_t prio, ScopeNode* parent);
+
+    //!< Indexes the leaf by its scope ID.
+    inline void _indexLeaf(ScopeLeaf* leaf);
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    using ScopeIndex = QHash<uint32_t, ScopeLeaf*>;
+
+    ITEM_ID                     mRootId;    //!< The ID of the root.
+    TEScopeArena<ScopeNode>     mNodeArena; //!< The arena of the nodes of the tree.
+    TEScopeArena<ScopeLeaf>     mLeafArena; //!< The arena of the leafs of the tree.
+    QSet<QString>               mNames;     //!< The names of the nodes and leafs of the tree.
+    ScopeIndex                  mScopes;    //!< The leafs of the tree by scope ID.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
 //////////////////////////////////////////////////////////////////////////
 private:
-    //!< The ID of the root.
-    ITEM_ID     mRootId;
+    AREG_NOCOPY_NOMOVE(ScopeRoot);
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -512,25 +654,64 @@ inline const ScopeNode::LeafList& ScopeNode::getLeafs() const
 
 inline unsigned int ScopeNode::childNodeCount() const
 {
-    return (mChildLeafs.size() + mChildNodes.size());
+    return static_cast<unsigned int>(mChildLeafs.size() + mChildNodes.size());
 }
 
-inline void ScopeNode::resetPrioNodes()
+inline uint32_t ScopeNode::getLeafCount(areg::LogPriority prio) const
 {
-    resetPriority();
-    for (const auto& node : mChildNodes)
+    for (uint32_t bit = 0u; bit < PRIO_BITS; ++bit)
     {
-        node.second->resetPrioNodes();
+        if (static_cast<uint32_t>(prio) == (1u << bit))
+            return mPrioCounts[bit];
     }
+
+    return 0u;
 }
 
-inline void ScopeNode::resetPrioLeafs()
+inline void ScopeNode::countLeafPriority(uint32_t oldPrio, uint32_t newPrio)
 {
-    resetPriority();
-    for (const auto& leaf : mChildLeafs)
+    bool changed{ false };
+    uint32_t diff{ oldPrio ^ newPrio };
+    for (uint32_t bit = 0u; (diff != 0u) && (bit < PRIO_BITS); ++bit, diff >>= 1)
     {
-        leaf.second->resetPriority();
+        const uint32_t mask{ 1u << bit };
+        if ((diff & 1u) != 0u)
+        {
+            if ((newPrio & mask) != 0u)
+            {
+                changed |= (mPrioCounts[bit] ++ == 0u);
+            }
+            else
+            {
+                Q_ASSERT(mPrioCounts[bit] != 0u);
+                changed |= (-- mPrioCounts[bit] == 0u);
+            }
+        }
     }
+
+    if (changed)
+    {
+        // The node has the priority bit while at least one leaf has it.
+        uint32_t prio{ static_cast<uint32_t>(areg::LogPriority::PrioInvalid) };
+        for (uint32_t bit = 0u; bit < PRIO_BITS; ++bit)
+        {
+            prio |= (mPrioCounts[bit] != 0u ? (1u << bit) : 0u);
+        }
+
+        mPrioStates = prio;
+    }
+}
+
+inline ScopeNode::NodeList::const_iterator ScopeNode::lowerNode(const QString& nodeName) const
+{
+    return std::lower_bound(mChildNodes.begin(), mChildNodes.end(), nodeName
+                            , [](const ScopeNode* node, const QString& name) { return (node->getNodeName() < name); });
+}
+
+inline ScopeNode::LeafList::const_iterator ScopeNode::lowerLeaf(const QString& leafName) const
+{
+    return std::lower_bound(mChildLeafs.begin(), mChildLeafs.end(), leafName
+                            , [](const ScopeLeaf* leaf, const QString& name) { return (leaf->getNodeName() < name); });
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -557,4 +738,37 @@ inline void ScopeRoot::setRootName(const QString& newRoot)
     mNodeName = newRoot;
 }
 
+inline ScopeLeaf* ScopeRoot::findLeaf(uint32_t scopeId) const
+{
+    return mScopes.value(scopeId, nullptr);
+}
+
+inline int ScopeRoot::getScopeCount() const
+{
+    return static_cast<int>(mScopes.size());
+}
+
+inline uint32_t ScopeRoot::getAllocatedCount() const
+{
+    return (mNodeArena.getCount() + mLeafArena.getCount());
+}
+
+inline ScopeNode* ScopeRoot::_makeNode(const QString& nodeName, ScopeNode* parent)
+{
+    return mNodeArena.make(_internName(nodeName), static_cast<uint32_t>(areg::LogPriority::PrioInvalid), parent);
+}
+
+inline ScopeLeaf* ScopeRoot::_makeLeaf(const QString& leafName, uint32_t prio, ScopeNode* parent)
+{
+    return mLeafArena.make(_internName(leafName), prio, parent);
+}
+
+inline void ScopeRoot::_indexLeaf(ScopeLeaf* leaf)
+{
+    if (leaf->getScopeId() != areg::LOG_SCOPE_ID_NONE)
+    {
+        mScopes[leaf->getScopeId()] = leaf;
+    }
+}
+
 #endif  // LUSAN_DATA_LOG_SCOPENODES_HPP
@@ -0,0 +1,236 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopePrioTransaction.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the transaction of the scope priority changes.
+ *
+ ************************************************************************/
+
+#include "lusan/data/log/ScopePrioTransaction.hpp"
+#include "lusan/common/NELusanCommon.hpp"
+#include "lusan/data/log/ScopeNodes.hpp"
+
+#include "areg/logging/areg_log.h"
+
+ScopePrioTransaction::ScopePrioTransaction()
+    : mChanges  ( )
+    , mPaths    ( )
+{
+}
+
+void ScopePrioTransaction::beginChange(const ScopeNodeBase& node)
+{
+    const ScopeRoot* root = static_cast<const ScopeRoot*>(node.getTreeRoot());
+    if (root == nullptr)
+        return;
+
+    sRootChanges& changes = mChanges[root->getRootId()];
+    if (changes.root != root)
+    {
+        changes.root = root;
+        changes.applied.clear();
+        changes.edited.clear();
+    }
+
+    // If the node or one of its parents is already edited, the leafs are remembered.
+    if (_isEdited(&node, changes.edited) == false)
+    {
+        _rememberLeafs(node, changes.applied);
+        changes.edited.insert(&node);
+    }
+}
+
+uint32_t ScopePrioTransaction::commit(const ScopeRoot& root, ScopePrioTransaction::ListScopes& scopes)
+{
+    scopes.clear();
+
+    const ITEM_ID rootId{ root.getRootId() };
+    QHash<ITEM_ID, sRootChanges>::iterator pos = mChanges.find(rootId);
+    if (pos == mChanges.end())
+        return 0u;
+
+    sRootChanges changes{ std::move(*pos) };
+    mChanges.erase(pos);
+    if (changes.root != &root)
+        return 0u; // the tree is replaced, the nodes of the changes do not exist anymore
+
+    sRootPaths& cache = mPaths[rootId];
+    if (cache.root != &root)
+    {
+        cache.root = &root;
+        cache.paths.clear();
+    }
+
+    for (const ScopeNodeBase* node : changes.edited)
+    {
+        // The nodes inside of the edited subtree are collected with the subtree.
+        if (_isEdited(node->getParent(), changes.edited) == false)
+        {
+            _collect(*node, changes.applied, cache, scopes);
+        }
+    }
+
+    return static_cast<uint32_t>(scopes.size());
+}
+
+void ScopePrioTransaction::discard(ITEM_ID rootId)
+{
+    mChanges.remove(rootId);
+    mPaths.remove(rootId);
+}
+
+void ScopePrioTransaction::clear()
+{
+    mChanges.clear();
+    mPaths.clear();
+}
+
+void ScopePrioTransaction::_rememberLeafs(const ScopeNodeBase& node, AppliedPrio& applied) const
+{
+    if (node.isLeaf())
+    {
+        if (applied.contains(&node) == false)
+        {
+            applied.insert(&node, node.getPriority());
+        }
+    }
+    else
+    {
+        const ScopeNode& parent = static_cast<const ScopeNode&>(node);
+        for (const ScopeNode* child : parent.getNodes())
+        {
+            _rememberLeafs(*child, applied);
+        }
+
+        for (const ScopeLeaf* child : parent.getLeafs())
+        {
+            _rememberLeafs(*child, applied);
+        }
+    }
+}
+
+ScopePrioTransaction::sSubtree ScopePrioTransaction::_collect(const ScopeNodeBase& node, const AppliedPrio& applied, sRootPaths& cache, ListScopes& scopes)
+{
+    sSubtree result;
+    if (node.isLeaf())
+    {
+        // The leafs added after the change started have the priority of the target.
+        AppliedPrio::const_iterator pos = applied.constFind(&node);
+        result.empty    = false;
+        result.prio     = node.getPriority();
+        result.changed  = (pos != applied.cend()) && (*pos != result.prio);
+        if (result.changed)
+        {
+            _addScope(_path(node, cache), result.prio, scopes);
+        }
+
+        return result;
+    }
+
+    const ScopeNode& parent = static_cast<const ScopeNode&>(node);
+    const size_t first{ scopes.size() };
+    auto combine = [&result](const sSubtree& child)
+        {
+            if (child.empty)
+                return;
+
+            result.changed |= child.changed;
+            if (result.empty)
+            {
+                result.empty    = false;
+                result.uniform  = child.uniform;
+                result.prio     = child.prio;
+            }
+            else
+            {
+                result.uniform  = result.uniform && child.uniform && (result.prio == child.prio);
+            }
+        };
+
+    for (const ScopeNode* child : parent.getNodes())
+    {
+        combine(_collect(*child, applied, cache, scopes));
+    }
+
+    for (const ScopeLeaf* child : parent.getLeafs())
+    {
+        combine(_collect(*child, applied, cache, scopes));
+    }
+
+    // All leafs of the node have the same priority, one wildcard replaces the changes of the subtree.
+    if (result.changed && result.uniform && (result.empty == false))
+    {
+        scopes.resize(first);
+        _addScope(_path(node, cache), result.prio, scopes);
+    }
+
+    return result;
+}
+
+QByteArray ScopePrioTransaction::_path(const ScopeNodeBase& node, sRootPaths& cache) const
+{
+    CachedPaths::const_iterator pos = cache.paths.constFind(&node);
+    if (pos != cache.paths.cend())
+        return *pos;
+
+    QByteArray result;
+    if (node.isRoot() || (node.getParent() == nullptr))
+    {
+        result.append(NELusanCommon::SCOPE_ALL);
+    }
+    else
+    {
+        // The parent path is `node_*`, the path of the child replaces the wildcard.
+        result = _path(*node.getParent(), cache);
+        result.chop(1);
+        if (node.isLeaf())
+        {
+            if (result.isEmpty() == false)
+            {
+                result.back() = NELusanCommon::SCOPE_LEAF_SEPRATOR;
+            }
+
+            result.append(node.getNodeName().toUtf8());
+        }
+        else
+        {
+            result.append(node.getNodeName().toUtf8());
+            result.append(NELusanCommon::SCOPE_SEPRATOR);
+            result.append(NELusanCommon::SCOPE_ALL);
+        }
+    }
+
+    cache.paths.insert(&node, result);
+    return result;
+}
+
+void ScopePrioTransaction::_addScope(const QByteArray& path, uint32_t prio, ListScopes& scopes)
+{
+    scopes.emplace_back();
+    ScopeInfo& scope = scopes.back();
+    scope.lsId  = 0u;
+    scope.lsPrio= prio;
+    areg::copy_string(scope.lsName, LENGTH_SCOPE, path.constData());
+}
+
+bool ScopePrioTransaction::_isEdited(const ScopeNodeBase* node, const QSet<const ScopeNodeBase*>& edited)
+{
+    for (; node != nullptr; node = node->getParent())
+    {
+        if (edited.contains(node))
+            return true;
+    }
+
+    return false;
+}
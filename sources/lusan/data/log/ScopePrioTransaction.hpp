@@ -0,0 +1,192 @@
+#ifndef LUSAN_DATA_LOG_SCOPEPRIOTRANSACTION_HPP
+#define LUSAN_DATA_LOG_SCOPEPRIOTRANSACTION_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopePrioTransaction.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the transaction of the scope priority changes.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include "areg/base/areg_global.h"
+#include "areglogger/client/LogObserverApi.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+
+#include <vector>
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class ScopeNodeBase;
+class ScopeRoot;
+
+/**
+ * \brief   ScopePrioTransaction accumulates the changes of the log priorities of the scope
+ *          trees and converts them to the list of scope priorities to send to the instance.
+ *          Before a node of the tree changes the priority, the priorities of the leafs of the
+ *          node are remembered as the last applied state. On commit, only the leafs that
+ *          differ from the applied state are sent, and a node, which leafs all have the same
+ *          priority, is sent as one entry with the wildcard path `node_*` instead of the list
+ *          of the leafs. The changes of every instance are committed separately, so that one
+ *          request per instance is sent. The paths of the scopes are cached per instance and
+ *          are not built again on the next commit.
+ **/
+class ScopePrioTransaction
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    using ListScopes    = std::vector<ScopeInfo>;
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    ScopePrioTransaction();
+    ~ScopePrioTransaction() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Remembers the priorities of the leafs of the node as the applied state.
+     *          Should be called before the priority of the node is changed. The leafs,
+     *          which are already remembered in the transaction, keep their applied priority.
+     * \param   node    The node of the scope tree, which priority is going to change.
+     **/
+    void beginChange(const ScopeNodeBase& node);
+
+    /**
+     * \brief   Returns true if there are changes of the instance to commit.
+     * \param   rootId  The ID of the instance (cookie).
+     **/
+    inline bool hasChanges(ITEM_ID rootId) const;
+
+    /**
+     * \brief   Returns true if there are no changes to commit.
+     **/
+    inline bool isEmpty() const;
+
+    /**
+     * \brief   Compares the priorities of the changed nodes of the scope tree with the applied
+     *          state and creates the list of scope priorities to send to the instance. The state
+     *          of the committed tree becomes the applied state.
+     * \param   root    The root of the scope tree of the instance.
+     * \param   scopes  On output, contains the list of scopes with priorities to send.
+     *                  The list is cleared before the scopes are added.
+     * \return  Returns the number of scopes in the list, 0 if nothing changed.
+     **/
+    uint32_t commit(const ScopeRoot& root, ScopePrioTransaction::ListScopes& scopes);
+
+    /**
+     * \brief   Drops the changes and the cached paths of the instance, for example,
+     *          when the instance is disconnected and the scope tree is deleted.
+     * \param   rootId  The ID of the instance (cookie).
+     **/
+    void discard(ITEM_ID rootId);
+
+    /**
+     * \brief   Drops all changes and the cached paths.
+     **/
+    void clear();
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden types and methods
+//////////////////////////////////////////////////////////////////////////
+private:
+    using AppliedPrio   = QHash<const ScopeNodeBase*, uint32_t>;
+    using CachedPaths   = QHash<const ScopeNodeBase*, QByteArray>;
+
+    /**
+     * \brief   The changes of the scope tree of one instance.
+     **/
+    struct sRootChanges
+    {
+        const ScopeRoot*            root    { nullptr };    //!< The root of the changed tree.
+        AppliedPrio                 applied { };            //!< Per leaf, the last applied priority.
+        QSet<const ScopeNodeBase*>  edited  { };            //!< The nodes, which priority is changed.
+    };
+
+    /**
+     * \brief   The cached paths of the scope tree of one instance.
+     **/
+    struct sRootPaths
+    {
+        const ScopeRoot*            root    { nullptr };    //!< The root of the tree.
+        CachedPaths                 paths   { };            //!< Per node, the path to send.
+    };
+
+    /**
+     * \brief   The state of the subtree, collected on commit.
+     **/
+    struct sSubtree
+    {
+        bool        changed { false };  //!< Flag, indicating that a leaf of the subtree is changed.
+        bool        uniform { true  };  //!< Flag, indicating that all leafs have the same priority.
+        bool        empty   { true  };  //!< Flag, indicating that the subtree has no leafs.
+        uint32_t    prio    { 0u };     //!< The priority of the leafs, if uniform.
+    };
+
+    //!< Remembers the priorities of the leafs of the node, which are not remembered yet.
+    void _rememberLeafs(const ScopeNodeBase& node, AppliedPrio& applied) const;
+
+    //!< Compares the subtree with the applied state, adds the changed leafs or the wildcard of the uniform subtree.
+    ScopePrioTransaction::sSubtree _collect(const ScopeNodeBase& node, const AppliedPrio& applied, sRootPaths& cache, ListScopes& scopes);
+
+    //!< Returns the cached path of the node, `node_*` for the nodes and `node.leaf` for the leafs.
+    QByteArray _path(const ScopeNodeBase& node, sRootPaths& cache) const;
+
+    //!< Adds the scope with the priority to the list.
+    static void _addScope(const QByteArray& path, uint32_t prio, ListScopes& scopes);
+
+    //!< Returns true if the node or one of its parents is in the set of the edited nodes.
+    static bool _isEdited(const ScopeNodeBase* node, const QSet<const ScopeNodeBase*>& edited);
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    QHash<ITEM_ID, sRootChanges>    mChanges;   //!< Per instance, the changes to commit.
+    QHash<ITEM_ID, sRootPaths>      mPaths;     //!< Per instance, the cached paths of the scopes.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(ScopePrioTransaction);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ScopePrioTransaction inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline bool ScopePrioTransaction::hasChanges(ITEM_ID rootId) const
+{
+    return mChanges.contains(rootId);
+}
+
+inline bool ScopePrioTransaction::isEmpty() const
+{
+    return mChanges.isEmpty();
+}
+
+#endif  // LUSAN_DATA_LOG_SCOPEPRIOTRANSACTION_HPP
@@ -0,0 +1,158 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopeSessionIndex.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the index of scope sessions in the list of log messages.
+ *
+ ************************************************************************/
+
+#include "lusan/data/log/ScopeSessionIndex.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+ScopeSessionIndex::ScopeSessionIndex()
+    : mSessions     ( )
+    , mOpenScopes   ( )
+    , mRowCount     (0)
+    , mRowsDropped  (0)
+{
+}
+
+void ScopeSessionIndex::clear()
+{
+    mSessions.clear();
+    mOpenScopes.clear();
+    mRowCount   = 0;
+    mRowsDropped= 0;
+}
+
+void ScopeSessionIndex::append(const areg::LogEntry& entry)
+{
+    const int row{ mRowCount ++ };
+    if (entry.logScopeId == 0u)
+        return; // the message is not logged in a scope
+
+    const sSessionKey key{ entry.logCookie, entry.logThreadId, entry.logScopeId, entry.logSessionId };
+    std::vector<sSessionKey>& stack = mOpenScopes[ThreadKey(entry.logCookie, entry.logThreadId)];
+
+    switch (entry.logMsgType)
+    {
+    case areg::LogMessageType::ScopeEnter:
+    {
+        sSessionInterval& interval = _interval(key, static_cast<int>(stack.size()));
+        interval.enterRow   = row;
+        interval.exitRow    = InvalidRow;
+        interval.depth      = static_cast<int>(stack.size());
+        stack.push_back(key);
+    }
+    break;
+
+    case areg::LogMessageType::ScopeExit:
+    {
+        // The scopes entered after this one and not exited (their exit messages are lost) stay open.
+        auto pos = std::find(stack.rbegin(), stack.rend(), key);
+        int depth{ static_cast<int>(stack.size()) };
+        if (pos != stack.rend())
+        {
+            depth = static_cast<int>(std::distance(pos, stack.rend())) - 1;
+            stack.erase(std::next(pos).base(), stack.end());
+        }
+
+        sSessionInterval& interval = _interval(key, depth);
+        interval.exitRow = row;
+    }
+    break;
+
+    default:
+    {
+        // The scope enter message is not in the log, the session starts with its first message.
+        sSessionInterval& interval = _interval(key, static_cast<int>(stack.size()));
+        if (interval.enterRow == InvalidRow)
+        {
+            interval.enterRow = row;
+        }
+    }
+    break;
+    }
+}
+
+void ScopeSessionIndex::removeFront(int count)
+{
+    if (count <= 0)
+        return;
+
+    mRowsDropped = std::min(mRowsDropped + count, mRowCount);
+    for (auto it = mSessions.begin(); it != mSessions.end(); )
+    {
+        const sSessionInterval& interval = it.value();
+        if ((interval.exitRow != InvalidRow) && (interval.exitRow < mRowsDropped))
+        {
+            it = mSessions.erase(it);
+        }
+        else
+        {
+            ++ it;
+        }
+    }
+}
+
+int ScopeSessionIndex::getEnterRow(const ScopeSessionIndex::sSessionKey& key) const
+{
+    auto pos = mSessions.constFind(key);
+    return (pos != mSessions.constEnd() ? _toLogRow(pos.value().enterRow) : InvalidRow);
+}
+
+int ScopeSessionIndex::getExitRow(const ScopeSessionIndex::sSessionKey& key) const
+{
+    auto pos = mSessions.constFind(key);
+    return (pos != mSessions.constEnd() ? _toLogRow(pos.value().exitRow) : InvalidRow);
+}
+
+int ScopeSessionIndex::getDepth(const ScopeSessionIndex::sSessionKey& key) const
+{
+    auto pos = mSessions.constFind(key);
+    return (pos != mSessions.constEnd() ? pos.value().depth : InvalidRow);
+}
+
+bool ScopeSessionIndex::isInside(const ScopeSessionIndex::sSessionKey& key, int row) const
+{
+    auto pos = mSessions.constFind(key);
+    if ((pos == mSessions.constEnd()) || (row < 0))
+        return false;
+
+    // Compare the rows of the index, they keep the order when the oldest rows are dropped.
+    const sSessionInterval& interval = pos.value();
+    const int indexRow{ row + mRowsDropped };
+    return  ((interval.enterRow == InvalidRow) || (interval.enterRow < indexRow)) &&
+            ((interval.exitRow  == InvalidRow) || (indexRow < interval.exitRow));
+}
+
+inline int ScopeSessionIndex::_toLogRow(int indexRow) const
+{
+    return ((indexRow != InvalidRow) && (indexRow >= mRowsDropped) ? indexRow - mRowsDropped : InvalidRow);
+}
+
+inline ScopeSessionIndex::sSessionInterval& ScopeSessionIndex::_interval(const ScopeSessionIndex::sSessionKey& key, int depth)
+{
+    auto pos = mSessions.find(key);
+    if (pos == mSessions.end())
+    {
+        sSessionInterval interval;
+        interval.depth = depth;
+        pos = mSessions.insert(key, interval);
+    }
+
+    return pos.value();
+}
@@ -0,0 +1,217 @@
+#ifndef LUSAN_DATA_LOG_SCOPESESSIONINDEX_HPP
+#define LUSAN_DATA_LOG_SCOPESESSIONINDEX_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopeSessionIndex.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the index of scope sessions in the list of log messages.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include "areg/base/areg_global.h"
+#include "areg/logging/areg_log.h"
+
+#include <QHash>
+#include <map>
+#include <vector>
+
+/**
+ * \brief   ScopeSessionIndex maps every scope session found in the list of log messages
+ *          to the interval of rows it covers: the row of the scope enter message, the row
+ *          of the scope exit message and the nesting depth of the scope in its thread.
+ *          A session is identified by the instance (cookie), thread, scope and session IDs.
+ *
+ *          The index is filled once, in the order of the log messages, when the logs are
+ *          loaded, and grows with the live logs. The rows are counted from the first message
+ *          ever indexed, so that dropping the oldest messages of the live logs does not
+ *          require to rebuild the index. The lookups are const and do not depend on the
+ *          order in which the rows are queried.
+ **/
+class ScopeSessionIndex
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The row is not in the log: the message was not logged, not received or already dropped.
+    static constexpr int    InvalidRow  { -1 };
+
+    /**
+     * \brief   The key of the scope session.
+     **/
+    struct sSessionKey
+    {
+        ITEM_ID     instId      { 0u }; //!< The ID of the instance (cookie) that logged the session.
+        ITEM_ID     threadId    { 0u }; //!< The ID of the thread that logged the session.
+        uint32_t    scopeId     { 0u }; //!< The ID of the scope.
+        uint32_t    sessionId   { 0u }; //!< The ID of the session of the scope.
+
+        inline bool operator == (const sSessionKey& other) const;
+    };
+
+    /**
+     * \brief   The interval of the scope session. The rows are counted from the first indexed message.
+     **/
+    struct sSessionInterval
+    {
+        //!< The row of the scope enter message. If the scope enter message is not in the log,
+        //!< it is the row of the first message of the session. Invalid, if only the scope exit is in the log.
+        int         enterRow    { InvalidRow };
+        //!< The row of the scope exit message. Invalid, if the session is not closed yet.
+        int         exitRow     { InvalidRow };
+        //!< The nesting depth of the scope in the thread, 0 is the outermost scope.
+        int         depth       { 0 };
+    };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    ScopeSessionIndex();
+    ~ScopeSessionIndex() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Clears the index.
+     **/
+    void clear();
+
+    /**
+     * \brief   Indexes the next log message. The messages should be passed in the order of the log.
+     * \param   entry   The log message to index.
+     **/
+    void append(const areg::LogEntry& entry);
+
+    /**
+     * \brief   Drops the given number of the oldest rows from the index. The sessions that
+     *          were closed in the dropped rows are removed, the rest of the sessions keep their
+     *          intervals, and the rows of the messages that are still in the log move up.
+     * \param   count   The number of the oldest rows to drop.
+     **/
+    void removeFront(int count);
+
+    /**
+     * \brief   Returns the number of rows in the log that are indexed.
+     **/
+    inline int getRowCount() const;
+
+    /**
+     * \brief   Returns the number of scope sessions in the index.
+     **/
+    inline int getSessionCount() const;
+
+    /**
+     * \brief   Returns true if the scope session is in the index.
+     **/
+    inline bool contains(const ScopeSessionIndex::sSessionKey& key) const;
+
+    /**
+     * \brief   Returns the row of the log where the session starts, i.e. the row of the scope enter
+     *          message or the row of the first message of the session.
+     *          Returns InvalidRow if the session is not in the index or its first row was dropped.
+     * \param   key     The key of the scope session.
+     **/
+    int getEnterRow(const ScopeSessionIndex::sSessionKey& key) const;
+
+    /**
+     * \brief   Returns the row of the log of the scope exit message of the session.
+     *          Returns InvalidRow if the session is not in the index or it is not closed yet.
+     * \param   key     The key of the scope session.
+     **/
+    int getExitRow(const ScopeSessionIndex::sSessionKey& key) const;
+
+    /**
+     * \brief   Returns the nesting depth of the scope session in its thread, or InvalidRow if
+     *          the session is not in the index.
+     * \param   key     The key of the scope session.
+     **/
+    int getDepth(const ScopeSessionIndex::sSessionKey& key) const;
+
+    /**
+     * \brief   Returns true if the row of the log is strictly inside of the scope session,
+     *          i.e. it is after the start and before the exit of the session. If the session
+     *          is not closed yet, every row after the start is inside. If the start of the
+     *          session is not in the log, every row before the exit is inside.
+     * \param   key     The key of the scope session.
+     * \param   row     The row of the log to check.
+     **/
+    bool isInside(const ScopeSessionIndex::sSessionKey& key, int row) const;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Converts the row of the index to the row of the log, returns InvalidRow if the row was dropped.
+    inline int _toLogRow(int indexRow) const;
+
+    //!< Returns the interval of the session, creates new if it does not exist.
+    inline ScopeSessionIndex::sSessionInterval& _interval(const ScopeSessionIndex::sSessionKey& key, int depth);
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    using MapSessions   = QHash<sSessionKey, sSessionInterval>;
+    using ThreadKey     = std::pair<ITEM_ID, ITEM_ID>;
+    using MapOpenScopes = std::map<ThreadKey, std::vector<sSessionKey>>;
+
+    MapSessions     mSessions;      //!< The intervals of the scope sessions.
+    MapOpenScopes   mOpenScopes;    //!< Per instance and thread, the stack of sessions that are entered and not exited yet.
+    int             mRowCount;      //!< The number of indexed rows, including dropped rows.
+    int             mRowsDropped;   //!< The number of the oldest rows that are dropped from the log.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(ScopeSessionIndex);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ScopeSessionIndex inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline bool ScopeSessionIndex::sSessionKey::operator == (const ScopeSessionIndex::sSessionKey& other) const
+{
+    return (sessionId == other.sessionId) && (scopeId == other.scopeId) && (threadId == other.threadId) && (instId == other.instId);
+}
+
+inline size_t qHash(const ScopeSessionIndex::sSessionKey& key, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, key.instId, key.threadId, key.scopeId, key.sessionId);
+}
+
+inline int ScopeSessionIndex::getRowCount() const
+{
+    return (mRowCount - mRowsDropped);
+}
+
+inline int ScopeSessionIndex::getSessionCount() const
+{
+    return static_cast<int>(mSessions.size());
+}
+
+inline bool ScopeSessionIndex::contains(const ScopeSessionIndex::sSessionKey& key) const
+{
+    return mSessions.contains(key);
+}
+
+#endif  // LUSAN_DATA_LOG_SCOPESESSIONINDEX_HPP
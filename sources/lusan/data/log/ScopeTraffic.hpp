@@ -0,0 +1,200 @@
+#ifndef LUSAN_DATA_LOG_SCOPETRAFFIC_HPP
+#define LUSAN_DATA_LOG_SCOPETRAFFIC_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopeTraffic.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the traffic statistics of the log messages of a scope node.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include "areg/base/areg_global.h"
+
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////////
+// ScopeTraffic class declaration
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * \brief   The traffic statistics of the log messages of a scope node: the number of messages,
+ *          the number of bytes of the message texts, the time of the first and the last message
+ *          and the number of messages per second. The messages are counted by the second of
+ *          their timestamps, the rate is the number of messages of the last complete second.
+ **/
+class ScopeTraffic
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The number of microseconds in one second, the unit of the timestamps of the messages.
+    static constexpr TIME64     MICROSECONDS    { 1000000u };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    inline ScopeTraffic();
+    ScopeTraffic(const ScopeTraffic& /*src*/) = default;
+    ScopeTraffic& operator = (const ScopeTraffic& /*src*/) = default;
+    ~ScopeTraffic() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Counts one log message.
+     * \param   bytes       The length of the text of the message.
+     * \param   timestamp   The timestamp of the message in microseconds.
+     **/
+    inline void countMessage(uint32_t bytes, TIME64 timestamp);
+
+    /**
+     * \brief   Resets the statistics.
+     **/
+    inline void reset();
+
+    /**
+     * \brief   Returns the number of counted messages.
+     **/
+    inline uint64_t getMessages() const;
+
+    /**
+     * \brief   Returns the number of bytes of the texts of the counted messages.
+     **/
+    inline uint64_t getBytes() const;
+
+    /**
+     * \brief   Returns the timestamp of the first counted message, or zero if no message is counted.
+     **/
+    inline TIME64 getFirstSeen() const;
+
+    /**
+     * \brief   Returns the latest timestamp of the counted messages, or zero if no message is counted.
+     **/
+    inline TIME64 getLastSeen() const;
+
+    /**
+     * \brief   Returns the number of messages per second.
+     * \param   now     The current time in microseconds. If the messages of the last complete second
+     *                  before `now` are counted, returns their number, otherwise returns zero.
+     *                  If zero, returns the average rate between the first and the last message,
+     *                  which is used for the logs read from a file.
+     **/
+    inline double getRate(TIME64 now) const;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    uint64_t    mMessages;      //!< The number of counted messages.
+    uint64_t    mBytes;         //!< The number of bytes of the texts of the counted messages.
+    TIME64      mFirstSeen;     //!< The timestamp of the first counted message.
+    TIME64      mLastSeen;      //!< The latest timestamp of the counted messages.
+    TIME64      mSecond;        //!< The second of the timestamp of the messages counted in `mSecondCount`.
+    uint32_t    mSecondCount;   //!< The number of messages of the second `mSecond`.
+    uint32_t    mPrevCount;     //!< The number of messages of the second before `mSecond`.
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ScopeTraffic class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline ScopeTraffic::ScopeTraffic()
+    : mMessages     ( 0u )
+    , mBytes        ( 0u )
+    , mFirstSeen    ( 0u )
+    , mLastSeen     ( 0u )
+    , mSecond       ( 0u )
+    , mSecondCount  ( 0u )
+    , mPrevCount    ( 0u )
+{
+}
+
+inline void ScopeTraffic::countMessage(uint32_t bytes, TIME64 timestamp)
+{
+    const TIME64 second{ timestamp / MICROSECONDS };
+    if (second > mSecond)
+    {
+        // The count of the previous second is kept only if the seconds follow each other.
+        mPrevCount  = (second == mSecond + 1u) ? mSecondCount : 0u;
+        mSecond     = second;
+        mSecondCount= 0u;
+    }
+
+    ++ mSecondCount;
+    ++ mMessages;
+    mBytes     += bytes;
+    mFirstSeen  = (mFirstSeen == 0u) ? timestamp : std::min(mFirstSeen, timestamp);
+    mLastSeen   = std::max(mLastSeen, timestamp);
+}
+
+inline void ScopeTraffic::reset()
+{
+    *this = ScopeTraffic();
+}
+
+inline uint64_t ScopeTraffic::getMessages() const
+{
+    return mMessages;
+}
+
+inline uint64_t ScopeTraffic::getBytes() const
+{
+    return mBytes;
+}
+
+inline TIME64 ScopeTraffic::getFirstSeen() const
+{
+    return mFirstSeen;
+}
+
+inline TIME64 ScopeTraffic::getLastSeen() const
+{
+    return mLastSeen;
+}
+
+inline double ScopeTraffic::getRate(TIME64 now) const
+{
+    if (mMessages == 0u)
+    {
+        return 0.0;
+    }
+    else if (now == 0u)
+    {
+        const TIME64 span{ std::max(mLastSeen - mFirstSeen, MICROSECONDS) };
+        return static_cast<double>(mMessages) * static_cast<double>(MICROSECONDS) / static_cast<double>(span);
+    }
+
+    const TIME64 second{ now / MICROSECONDS };
+    if (second == mSecond + 1u)
+    {
+        return static_cast<double>(mSecondCount);
+    }
+    else if (second == mSecond)
+    {
+        return static_cast<double>(mPrevCount);
+    }
+    else
+    {
+        return 0.0;
+    }
+}
+
+#endif  // LUSAN_DATA_LOG_SCOPETRAFFIC_HPP
@@ -0,0 +1,143 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopeTreeBuilder.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, builds the scope trees of the instances in the worker threads.
+ *
+ ************************************************************************/
+
+#include "lusan/data/log/ScopeTreeBuilder.hpp"
+
+#include "aregextend/db/LogSqliteDatabase.hpp"
+
+#include <algorithm>
+#include <thread>
+
+ScopeTreeBuilder::ScopeTreeBuilder()
+    : areg::ThreadConsumer  ( )
+    , mDatabasePath ( )
+    , mTrees        ( )
+    , mScopePrio    ( 0u )
+    , mCallback     ( )
+    , mNextTree     ( 0u )
+    , mRunning      ( 0u )
+    , mCanceled     ( false )
+    , mThreads      ( )
+{
+}
+
+ScopeTreeBuilder::~ScopeTreeBuilder()
+{
+    cancel();
+}
+
+bool ScopeTreeBuilder::start(const std::string& dbPath, ScopeTreeBuilder::ListTrees&& trees, uint32_t scopePrio, ScopeTreeBuilder::FuncBuilt callback)
+{
+    cancel();
+    if (trees.empty())
+        return false;
+
+    mDatabasePath   = dbPath;
+    mTrees          = std::move(trees);
+    mScopePrio      = scopePrio;
+    mCallback       = std::move(callback);
+    mNextTree       = 0u;
+    mCanceled       = false;
+
+    // The threads are set to run before any starts, the last finished thread calls the callback.
+    const uint32_t cores{ std::max(std::thread::hardware_concurrency(), 1u) };
+    const uint32_t count{ std::min({ ScopeTreeBuilder::MAX_THREADS, cores, static_cast<uint32_t>(mTrees.size()) }) };
+    static std::atomic<uint32_t> _sequence{ 0u };
+    for (uint32_t i = 0u; i < count; ++i)
+    {
+        const std::string name{ "_ScopeTreeThread_" + std::to_string(_sequence ++) };
+        mThreads.emplace_back(new areg::Thread(static_cast<areg::ThreadConsumer &>(self()), name.c_str()));
+    }
+
+    mRunning = count;
+    for (std::unique_ptr<areg::Thread>& thread : mThreads)
+    {
+        thread->start(areg::DO_NOT_WAIT);
+    }
+
+    return true;
+}
+
+void ScopeTreeBuilder::cancel()
+{
+    mCanceled = true;
+    _joinThreads();
+    mTrees.clear();
+    mCallback = nullptr;
+}
+
+void ScopeTreeBuilder::wait()
+{
+    _joinThreads();
+}
+
+bool ScopeTreeBuilder::buildTree(ScopeTreeBuilder::sScopeTree& tree, uint32_t scopePrio, const std::atomic_bool* canceled /*= nullptr*/)
+{
+    tree.root.reset(new ScopeRoot(tree.instance));
+    uint32_t count{ 0u };
+    for (const areg::ScopeEntry& scope : tree.scopes)
+    {
+        if ((++ count % ScopeTreeBuilder::CANCEL_CHECK_SCOPES == 0u) && (canceled != nullptr) && canceled->load())
+            return false;
+
+        QString scopePath(QString::fromStdString(scope.scopeName.data()));
+        tree.root->addChildRecursive(scopePath, scopePrio != 0u ? scopePrio : scope.scopePrio, scope.scopeId);
+    }
+
+    return true;
+}
+
+void ScopeTreeBuilder::on_run()
+{
+    // Runs in every worker thread. The threads take the trees one by one, each reads
+    // the database with its own connection.
+    areg::ext::LogSqliteDatabase database;
+    const bool readScopes{ (mDatabasePath.empty() == false) && database.connect(mDatabasePath, true) };
+    const uint32_t count{ static_cast<uint32_t>(mTrees.size()) };
+    for (uint32_t pos = mNextTree ++; (pos < count) && (mCanceled.load() == false); pos = mNextTree ++)
+    {
+        sScopeTree& tree = mTrees[pos];
+        if (readScopes && tree.scopes.empty())
+        {
+            database.log_inst_scopes(tree.scopes, tree.instance.ciCookie);
+        }
+
+        buildTree(tree, mScopePrio, &mCanceled);
+    }
+
+    database.disconnect();
+    if ((mRunning.fetch_sub(1u) == 1u) && (mCanceled.load() == false) && mCallback)
+    {
+        mCallback(mTrees);
+    }
+}
+
+void ScopeTreeBuilder::_joinThreads()
+{
+    for (std::unique_ptr<areg::Thread>& thread : mThreads)
+    {
+        if (thread->is_valid())
+        {
+            thread->shutdown(areg::WAIT_INFINITE);
+        }
+    }
+
+    mThreads.clear();
+    mRunning = 0u;
+}
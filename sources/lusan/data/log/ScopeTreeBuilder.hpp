@@ -0,0 +1,179 @@
+#ifndef LUSAN_DATA_LOG_SCOPETREEBUILDER_HPP
+#define LUSAN_DATA_LOG_SCOPETREEBUILDER_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/ScopeTreeBuilder.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, builds the scope trees of the instances in the worker threads.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include "areg/base/areg_global.h"
+#include "areg/base/Thread.hpp"
+#include "areg/base/ThreadConsumer.hpp"
+#include "areg/logging/areg_log.h"
+#include "lusan/data/log/ScopeNodes.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \brief   ScopeTreeBuilder builds the scope trees of the instances of the log database in
+ *          the worker threads, one instance at a time per thread. Every thread reads the
+ *          scopes of the instance with its own connection to the database and builds the
+ *          tree of the instance, the trees of different instances are built in parallel.
+ *          When all trees are built, the callback receives them. The trees are not changed
+ *          by the builder anymore, the receiver takes the ownership and adopts them at once.
+ **/
+class ScopeTreeBuilder : protected areg::ThreadConsumer
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   The scope tree of one instance.
+     **/
+    struct sScopeTree
+    {
+        areg::ConnectedInstance         instance    { };    //!< The instance of the tree.
+        std::vector<areg::ScopeEntry>   scopes      { };    //!< The scopes of the instance, read from the database if empty.
+        std::unique_ptr<ScopeRoot>      root        { };    //!< The built scope tree of the instance.
+    };
+
+    using ListTrees = std::vector<sScopeTree>;
+
+    //!< The callback to receive the built trees, called in the worker thread, which finished last.
+    using FuncBuilt = std::function<void(ScopeTreeBuilder::ListTrees& trees)>;
+
+    //!< The maximum number of the worker threads to build the trees.
+    static constexpr uint32_t   MAX_THREADS         { 8u };
+
+    //!< The number of scopes to add to the tree before checking whether the build is canceled.
+    static constexpr uint32_t   CANCEL_CHECK_SCOPES { 4096u };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    ScopeTreeBuilder();
+
+    /**
+     * \brief   Cancels the running build and waits for the worker threads.
+     **/
+    virtual ~ScopeTreeBuilder();
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Starts building the scope trees in the worker threads. The running build is canceled.
+     * \param   dbPath      The path to the log database to read the scopes. If empty, the trees
+     *                      are built from the scopes set in the list.
+     * \param   trees       The list of trees to build with the instances set.
+     * \param   scopePrio   The priority to set to every scope. If zero, the priority of the scope is set.
+     * \param   callback    The callback to receive the built trees.
+     * \return  Returns true if the worker threads started.
+     **/
+    bool start(const std::string& dbPath, ScopeTreeBuilder::ListTrees&& trees, uint32_t scopePrio, ScopeTreeBuilder::FuncBuilt callback);
+
+    /**
+     * \brief   Cancels the running build and waits for the worker threads. The callback is not called.
+     **/
+    void cancel();
+
+    /**
+     * \brief   Waits until the worker threads complete the running build.
+     **/
+    void wait();
+
+    /**
+     * \brief   Returns true if the worker threads build the trees.
+     **/
+    inline bool isBuilding() const;
+
+    /**
+     * \brief   Builds the scope tree of the instance from the list of scopes.
+     * \param   tree        The tree to build, the root is created.
+     * \param   scopePrio   The priority to set to every scope. If zero, the priority of the scope is set.
+     * \param   canceled    The flag, which is checked while adding the scopes. Can be nullptr.
+     * \return  Returns false if the build is canceled.
+     **/
+    static bool buildTree(ScopeTreeBuilder::sScopeTree& tree, uint32_t scopePrio, const std::atomic_bool* canceled = nullptr);
+
+/************************************************************************/
+// areg::ThreadConsumer interface overrides
+/************************************************************************/
+protected:
+
+    /**
+     * \brief   Runs in every worker thread, builds the trees of the instances until all are built.
+     **/
+    void on_run() override;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Waits for the worker threads and releases them.
+    void _joinThreads();
+
+    //!< Returns the reference to this object.
+    inline ScopeTreeBuilder& self();
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    using ListThreads   = std::vector<std::unique_ptr<areg::Thread>>;
+
+    std::string             mDatabasePath;  //!< The path to the log database to read the scopes.
+    ListTrees               mTrees;         //!< The trees to build.
+    uint32_t                mScopePrio;     //!< The priority to set to the scopes, or zero to keep.
+    FuncBuilt               mCallback;      //!< The callback to receive the built trees.
+    std::atomic<uint32_t>   mNextTree;      //!< The position of the next tree to build.
+    std::atomic<uint32_t>   mRunning;       //!< The number of the running worker threads.
+    std::atomic_bool        mCanceled;      //!< Flag, indicating that the build is canceled.
+    ListThreads             mThreads;       //!< The worker threads.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(ScopeTreeBuilder);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ScopeTreeBuilder inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline bool ScopeTreeBuilder::isBuilding() const
+{
+    return (mRunning.load() != 0u);
+}
+
+inline ScopeTreeBuilder& ScopeTreeBuilder::self()
+{
+    return (*this);
+}
+
+#endif  // LUSAN_DATA_LOG_SCOPETREEBUILDER_HPP
@@ -0,0 +1,163 @@
+﻿#ifndef LUSAN_DATA_LOG_TESCOPEARENA_HPP
+#define LUSAN_DATA_LOG_TESCOPEARENA_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/log/TEScopeArena.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, Template arena of the scope nodes.
+ *
+ ************************************************************************/
+/************************************************************************
+ * Include files.
+ ************************************************************************/
+#include "areg/base/areg_global.h"
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////
+// TEScopeArena class template declaration
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * \class   TEScopeArena
+ * \brief   Allocates the objects of one type in chunks of ChunkSize objects. The objects are
+ *          never moved and cannot be freed one by one, all objects are destroyed together with
+ *          the arena. The scope tree of one instance allocates its nodes in the arena of the
+ *          root, thousands of nodes cost a few allocations and are destroyed at once.
+ * \tparam  Node        The type of the allocated objects.
+ * \tparam  ChunkSize   The number of objects in one chunk of memory.
+ **/
+template<class Node, uint32_t ChunkSize = 256u>
+class TEScopeArena
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types
+//////////////////////////////////////////////////////////////////////////
+private:
+    //!< The raw memory of one object.
+    struct sSlot
+    {
+        alignas(Node) unsigned char data[sizeof(Node)];
+    };
+
+    using ListChunks = std::vector<std::unique_ptr<sSlot[]>>;
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    TEScopeArena();
+
+    ~TEScopeArena();
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Creates the object in the arena, the parameters are passed to the constructor.
+     * \return  Returns the pointer to the created object, valid until the arena is cleared.
+     **/
+    template<typename ... Params>
+    Node* make(Params&& ... params);
+
+    /**
+     * \brief   Destroys all objects and releases the memory.
+     **/
+    void clear();
+
+    /**
+     * \brief   Returns the number of the objects in the arena.
+     **/
+    inline uint32_t getCount() const;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    ListChunks  mChunks;    //!< The chunks of memory, only the last one is not full.
+    uint32_t    mUsed;      //!< The number of objects in the last chunk.
+    uint32_t    mCount;     //!< The number of objects in the arena.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(TEScopeArena);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// TEScopeArena class template implementation
+//////////////////////////////////////////////////////////////////////////
+
+template<class Node, uint32_t ChunkSize>
+TEScopeArena<Node, ChunkSize>::TEScopeArena()
+    : mChunks   ( )
+    , mUsed     ( ChunkSize )
+    , mCount    ( 0u )
+{
+    static_assert(ChunkSize != 0u, "The chunk of the arena cannot be empty");
+}
+
+template<class Node, uint32_t ChunkSize>
+TEScopeArena<Node, ChunkSize>::~TEScopeArena()
+{
+    clear();
+}
+
+template<class Node, uint32_t ChunkSize>
+template<typename ... Params>
+Node* TEScopeArena<Node, ChunkSize>::make(Params&& ... params)
+{
+    if (mUsed == ChunkSize)
+    {
+        mChunks.emplace_back(new sSlot[ChunkSize]);
+        mUsed = 0u;
+    }
+
+    Node* result = new (mChunks.back()[mUsed].data) Node(std::forward<Params>(params) ...);
+    ++ mUsed;
+    ++ mCount;
+    return result;
+}
+
+template<class Node, uint32_t ChunkSize>
+void TEScopeArena<Node, ChunkSize>::clear()
+{
+    for (uint32_t i = 0u; i < static_cast<uint32_t>(mChunks.size()); ++i)
+    {
+        sSlot* chunk = mChunks[i].get();
+        const uint32_t count{ i + 1u == static_cast<uint32_t>(mChunks.size()) ? mUsed : ChunkSize };
+        for (uint32_t j = 0u; j < count; ++j)
+        {
+            std::launder(reinterpret_cast<Node*>(chunk[j].data))->~Node();
+        }
+    }
+
+    mChunks.clear();
+    mUsed   = ChunkSize;
+    mCount  = 0u;
+}
+
+template<class Node, uint32_t ChunkSize>
+inline uint32_t TEScopeArena<Node, ChunkSize>::getCount() const
+{
+    return mCount;
+}
+
+#endif  // LUSAN_DATA_LOG_TESCOPEARENA_HPP
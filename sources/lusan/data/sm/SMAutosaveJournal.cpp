@@ -0,0 +1,1040 @@
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   (c) 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/sm/SMAutosaveJournal.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the autosave journal of a state machine document.
+ *
+ ************************************************************************/
+
+#include "lusan/data/sm/SMAutosaveJournal.hpp"
+
+#include "lusan/common/XmlSM.hpp"
+#include "lusan/data/sm/SMLayoutData.hpp"
+#include "lusan/data/sm/SMOperation.hpp"
+#include "lusan/data/sm/SMState.hpp"
+#include "lusan/data/sm/SMTransition.hpp"
+#include "lusan/data/sm/StateMachineData.hpp"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QMap>
+#include <QSaveFile>
+#include <QStringList>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+    //!< The first bytes of a journal file.
+    constexpr quint32   JOURNAL_MAGIC   { 0x4C534A4Eu };    // "LSJN"
+    //!< The extension a journal adds to the document path.
+    constexpr char      JOURNAL_EXT[]   { ".autosave.journal" };
+
+    //!< What a record of the journal replaces.
+    enum class eRecord : quint8
+    {
+          Commit    = 0 //!< The end of an autosave; the records before it are complete.
+        , Section       //!< A whole section, keyed by its place in the document. Empty when the section is not written.
+        , State         //!< One state without its nested states, keyed by its ID.
+        , Level         //!< The IDs of the states of one level, keyed by its owner.
+        , Grid          //!< The grid settings of the Layout section.
+        , View          //!< One View, keyed by its owner. Empty when there is none.
+        , Node          //!< One Node, keyed by its owner. Empty when there is none.
+        , Edge          //!< One Edge, keyed by its owner. Empty when there is none.
+        , Note          //!< One Note, keyed by its ID. Empty when there is none.
+    };
+
+    //!< One record read back from a journal.
+    struct Record
+    {
+        eRecord     kind    { eRecord::Commit };
+        uint32_t    key     { 0u };
+        QByteArray  payload { };
+    };
+
+    //!< The place of the states and of the layout among the sections of the document.
+    constexpr int   SECTION_STATES  { 9 };
+    constexpr int   SECTION_LAYOUT  { 10 };
+
+    //!< The kinds of the layout entries, in the order the Layout section writes them.
+    constexpr int   ENTRY_COUNT     { 4 };
+
+    //!< The root elements of the sections, by their place in the document.
+    constexpr QLatin1StringView _sectionNames[]
+    {
+          XmlSM::xmlSMElementOverview
+        , XmlSM::xmlSMElementDataTypeList
+        , XmlSM::xmlSMElementAttributeList
+        , XmlSM::xmlSMElementEventList
+        , XmlSM::xmlSMElementTimerList
+        , XmlSM::xmlSMElementMethodList
+        , XmlSM::xmlSMElementConstantList
+        , XmlSM::xmlSMElementIncludeList
+        , XmlSM::xmlSMElementImportList
+        , XmlSM::xmlSMElementStateList
+        , XmlSM::xmlSMElementLayout
+    };
+
+    //!< The lists of the layout entries, and the entries, by their kind.
+    constexpr QLatin1StringView _entryLists[ENTRY_COUNT]
+    {
+          XmlSM::xmlSMElementViewList
+        , XmlSM::xmlSMElementNodeList
+        , XmlSM::xmlSMElementEdgeList
+        , XmlSM::xmlSMElementNoteList
+    };
+
+    constexpr QLatin1StringView _entryNames[ENTRY_COUNT]
+    {
+          XmlSM::xmlSMElementView
+        , XmlSM::xmlSMElementNode
+        , XmlSM::xmlSMElementEdge
+        , XmlSM::xmlSMElementNote
+    };
+
+    int sectionOf(QStringView name)
+    {
+        for (int i = 0; i < static_cast<int>(std::size(_sectionNames)); ++i)
+        {
+            if (name == _sectionNames[i])
+                return i;
+        }
+
+        return -1;
+    }
+
+    int entryOf(QStringView name)
+    {
+        for (int i = 0; i < ENTRY_COUNT; ++i)
+        {
+            if (name == _entryNames[i])
+                return i;
+        }
+
+        return -1;
+    }
+
+    QByteArray hashOf(const QByteArray& data)
+    {
+        return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    }
+
+    QByteArray readFile(const QString& path)
+    {
+        QFile file(path);
+        return (file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray());
+    }
+
+    bool writeFile(const QString& path, const QByteArray& content)
+    {
+        QSaveFile file(path);
+        file.setDirectWriteFallback(false);
+        if (file.open(QIODevice::WriteOnly) == false)
+            return false;
+
+        if (file.write(content) != content.size())
+        {
+            file.cancelWriting();
+            return false;
+        }
+
+        return file.commit();
+    }
+
+    //!< The XML the \p write function writes, without a document around it.
+    template<typename Writer>
+    QByteArray fragment(Writer write)
+    {
+        QByteArray buffer;
+        {
+            QXmlStreamWriter xml(&buffer);
+            write(xml);
+        }
+
+        return buffer;
+    }
+
+    QByteArray sectionXml(const StateMachineData& data, SMAutosaveJournal::eSection section)
+    {
+        return fragment([&data, section](QXmlStreamWriter& xml)
+        {
+            switch (section)
+            {
+            case SMAutosaveJournal::eSection::Overview:
+                data.getOverview().writeToXml(xml);
+                break;
+            case SMAutosaveJournal::eSection::DataTypes:
+                data.getDataTypes().writeToXml(xml);
+                break;
+            case SMAutosaveJournal::eSection::Attributes:
+                data.getAttributes().writeToXml(xml);
+                break;
+            case SMAutosaveJournal::eSection::Events:
+                data.getEvents().writeToXml(xml);
+                break;
+            case SMAutosaveJournal::eSection::Timers:
+                data.getTimers().writeToXml(xml);
+                break;
+            case SMAutosaveJournal::eSection::Methods:
+                data.getMethods().writeToXml(xml);
+                break;
+            case SMAutosaveJournal::eSection::Constants:
+                data.getConstants().writeToXml(xml);
+                break;
+            case SMAutosaveJournal::eSection::Includes:
+                data.getIncludes().writeToXml(xml);
+                break;
+            }
+        });
+    }
+
+    QByteArray idsOf(const QList<uint32_t>& ids)
+    {
+        QByteArray result;
+        for (uint32_t id : ids)
+        {
+            if (result.isEmpty() == false)
+            {
+                result.append(',');
+            }
+
+            result.append(QByteArray::number(id));
+        }
+
+        return result;
+    }
+
+    QList<uint32_t> idsFrom(const QByteArray& payload)
+    {
+        QList<uint32_t> result;
+        if (payload.isEmpty() == false)
+        {
+            for (const QByteArray& id : payload.split(','))
+            {
+                result.append(id.toUInt());
+            }
+        }
+
+        return result;
+    }
+
+    void writeRecord(QDataStream& out, eRecord kind, uint32_t key, const QByteArray& payload)
+    {
+        QByteArray block;
+        {
+            QDataStream data(&block, QIODevice::WriteOnly);
+            data.setVersion(QDataStream::Qt_6_0);
+            data << static_cast<quint8>(kind) << static_cast<quint32>(key) << payload;
+        }
+
+        out << block << qChecksum(block);
+    }
+
+    //!< Reads the committed records of \p journal, if it is the journal of \p snapshot.
+    bool readRecords(const QByteArray& journal, const QByteArray& snapshot, QList<Record>& out_records)
+    {
+        QDataStream in(journal);
+        in.setVersion(QDataStream::Qt_6_0);
+
+        quint32 magic{ 0u };
+        quint32 version{ 0u };
+        QByteArray snapshotHash;
+        in >> magic >> version >> snapshotHash;
+        if ((in.status() != QDataStream::Ok) || (magic != JOURNAL_MAGIC)
+            || (version != SMAutosaveJournal::JOURNAL_VERSION) || (snapshotHash != hashOf(snapshot)))
+        {
+            return false;
+        }
+
+        // A record cut short by a crash ends the journal, and so does one that does not match its
+        // checksum. The records of an autosave count only once its commit is read.
+        QList<Record> batch;
+        while (in.atEnd() == false)
+        {
+            QByteArray block;
+            quint16 checksum{ 0u };
+            in >> block >> checksum;
+            if ((in.status() != QDataStream::Ok) || (checksum != qChecksum(block)))
+                break;
+
+            QDataStream data(block);
+            data.setVersion(QDataStream::Qt_6_0);
+            quint8 kind{ 0u };
+            Record record;
+            data >> kind >> record.key >> record.payload;
+            if ((data.status() != QDataStream::Ok) || (kind > static_cast<quint8>(eRecord::Note)))
+                break;
+
+            record.kind = static_cast<eRecord>(kind);
+            if (record.kind == eRecord::Commit)
+            {
+                out_records.append(batch);
+                batch.clear();
+            }
+            else
+            {
+                batch.append(record);
+            }
+        }
+
+        return true;
+    }
+
+    //!< A child of the root element of the snapshot.
+    struct Block
+    {
+        int     section { -1 }; //!< The place of the section, -1 for an element the format does not define.
+        QString text    { };    //!< The element as written; empty for the states and the layout, which are rebuilt.
+    };
+
+    //!< The snapshot taken apart into the units the journal records.
+    struct Snapshot
+    {
+        QString                             head;                   //!< Up to and with the start tag of the root.
+        QString                             tail;                   //!< From the end tag of the root.
+        QList<Block>                        blocks;                 //!< The children of the root, in document order.
+        QHash<uint32_t, QString>            states;                 //!< Every state without its nested states.
+        QHash<uint32_t, QList<uint32_t>>    levels;                 //!< The states of every level, by its owner.
+        QString                             gridSize;               //!< The GridSize of the Layout section.
+        QString                             gridVisible;            //!< The GridVisible of the Layout section.
+        QMap<uint32_t, QString>             entries[ENTRY_COUNT];   //!< The layout entries by their kind, in the order they are written.
+    };
+
+    //!< The offset of the '<' of the tag read after \p before. Character data is read up to and
+    //!< with the '<' that ends it, so the tag after it starts one before where the reader says.
+    inline qsizetype tagBegin(const QString& text, qsizetype before)
+    {
+        return text.lastIndexOf(QLatin1Char('<'), before);
+    }
+
+    bool parseSnapshot(const QString& text, Snapshot& out)
+    {
+        struct OpenState
+        {
+            uint32_t    id          { 0u };
+            qsizetype   begin       { 0 };
+            qsizetype   nestedBegin { -1 };
+            qsizetype   nestedEnd   { -1 };
+        };
+
+        QXmlStreamReader xml(text);
+        QStringList         path;
+        QList<OpenState>    openStates;
+        QList<uint32_t>     openLevels;
+        qsizetype           before{ 0 };
+        qsizetype           blockBegin{ 0 };
+        qsizetype           entryBegin{ 0 };
+        int                 section{ -1 };
+        int                 entry{ -1 };
+        uint32_t            entryKey{ 0u };
+
+        while (xml.atEnd() == false)
+        {
+            const QXmlStreamReader::TokenType token = xml.readNext();
+            const qsizetype after = static_cast<qsizetype>(xml.characterOffset());
+            if (token == QXmlStreamReader::StartElement)
+            {
+                const qsizetype begin = tagBegin(text, before);
+                const QString name = xml.name().toString();
+                const qsizetype depth = path.size();
+                if (depth == 0)
+                {
+                    out.head = text.left(after);
+                }
+                else if (depth == 1)
+                {
+                    blockBegin = begin;
+                    section = sectionOf(name);
+                    if (section == SECTION_STATES)
+                    {
+                        openLevels.append(0u);
+                    }
+                    else if (section == SECTION_LAYOUT)
+                    {
+                        out.gridSize    = xml.attributes().value(XmlSM::xmlSMAttributeGridSize).toString();
+                        out.gridVisible = xml.attributes().value(XmlSM::xmlSMAttributeGridVisible).toString();
+                    }
+                }
+                else if (section == SECTION_STATES)
+                {
+                    if ((name == XmlSM::xmlSMElementState) && (path.constLast() == XmlSM::xmlSMElementStateList) && (openLevels.isEmpty() == false))
+                    {
+                        OpenState state;
+                        state.id    = xml.attributes().value(XmlSM::xmlSMAttributeID).toUInt();
+                        state.begin = begin;
+                        openStates.append(state);
+                        out.levels[openLevels.constLast()].append(state.id);
+                    }
+                    else if ((name == XmlSM::xmlSMElementStateList) && (path.constLast() == XmlSM::xmlSMElementState) && (openStates.isEmpty() == false))
+                    {
+                        openStates.last().nestedBegin = begin;
+                        openLevels.append(openStates.constLast().id);
+                    }
+                }
+                else if ((section == SECTION_LAYOUT) && (depth == 3))
+                {
+                    entry = entryOf(name);
+                    entryBegin = begin;
+                    entryKey = xml.attributes().value(entry == 3 ? XmlSM::xmlSMAttributeID : XmlSM::xmlSMAttributeOwner).toUInt();
+                }
+
+                path.append(name);
+            }
+            else if ((token == QXmlStreamReader::EndElement) && (path.isEmpty() == false))
+            {
+                path.removeLast();
+                const qsizetype depth = path.size();
+                if (depth == 0)
+                {
+                    out.tail = text.mid(tagBegin(text, before));
+                }
+                else if (depth == 1)
+                {
+                    const bool rebuilt = (section == SECTION_STATES) || (section == SECTION_LAYOUT);
+                    out.blocks.append(Block{ section, rebuilt ? QString() : text.mid(blockBegin, after - blockBegin) });
+                    section = -1;
+                    openLevels.clear();
+                    openStates.clear();
+                }
+                else if ((section == SECTION_STATES) && (openStates.isEmpty() == false))
+                {
+                    if ((xml.name() == XmlSM::xmlSMElementState) && (path.constLast() == XmlSM::xmlSMElementStateList))
+                    {
+                        const OpenState state = openStates.takeLast();
+                        out.states.insert(state.id, (state.nestedBegin < 0)
+                                                    ? text.mid(state.begin, after - state.begin)
+                                                    : text.mid(state.begin, state.nestedBegin - state.begin) + text.mid(state.nestedEnd, after - state.nestedEnd));
+                    }
+                    else if ((xml.name() == XmlSM::xmlSMElementStateList) && (path.constLast() == XmlSM::xmlSMElementState))
+                    {
+                        openStates.last().nestedEnd = after;
+                        openLevels.removeLast();
+                    }
+                }
+                else if ((section == SECTION_LAYOUT) && (depth == 3) && (entry >= 0))
+                {
+                    out.entries[entry].insert(entryKey, text.mid(entryBegin, after - entryBegin));
+                    entry = -1;
+                }
+            }
+
+            before = after;
+        }
+
+        return (xml.hasError() == false) && (out.head.isEmpty() == false) && (out.tail.isEmpty() == false);
+    }
+
+    //!< Puts a section in its place among the children of the root, replacing the one there.
+    void placeBlock(Snapshot& snapshot, int section, const QString& text, bool replace)
+    {
+        for (qsizetype i = 0; i < snapshot.blocks.size(); ++i)
+        {
+            if (snapshot.blocks.at(i).section == section)
+            {
+                if (replace == false)
+                {
+                    return;
+                }
+                else if (text.isEmpty())
+                {
+                    snapshot.blocks.removeAt(i);
+                }
+                else
+                {
+                    snapshot.blocks[i].text = text;
+                }
+
+                return;
+            }
+        }
+
+        if (text.isEmpty() && replace)
+            return;
+
+        const auto next = std::find_if(snapshot.blocks.begin(), snapshot.blocks.end(), [section](const Block& block) { return block.section > section; });
+        snapshot.blocks.insert(next, Block{ section, text });
+    }
+
+    void applyRecord(Snapshot& snapshot, const Record& record)
+    {
+        const QString payload = QString::fromUtf8(record.payload);
+        switch (record.kind)
+        {
+        case eRecord::Section:
+            if (static_cast<int>(record.key) < SECTION_STATES)
+            {
+                placeBlock(snapshot, static_cast<int>(record.key), payload, true);
+            }
+            break;
+
+        case eRecord::State:
+            if (payload.isEmpty())
+                snapshot.states.remove(record.key);
+            else
+                snapshot.states.insert(record.key, payload);
+            break;
+
+        case eRecord::Level:
+            if (payload.isEmpty())
+            {
+                snapshot.levels.remove(record.key);
+            }
+            else
+            {
+                snapshot.levels.insert(record.key, idsFrom(record.payload));
+                if (record.key == 0u)
+                {
+                    placeBlock(snapshot, SECTION_STATES, QString(), false);
+                }
+            }
+            break;
+
+        case eRecord::Grid:
+            snapshot.gridSize    = payload.section(QLatin1Char(' '), 0, 0);
+            snapshot.gridVisible = payload.section(QLatin1Char(' '), 1, 1);
+            break;
+
+        case eRecord::View:
+        case eRecord::Node:
+        case eRecord::Edge:
+        case eRecord::Note:
+            {
+                QMap<uint32_t, QString>& entries = snapshot.entries[static_cast<int>(record.kind) - static_cast<int>(eRecord::View)];
+                if (payload.isEmpty())
+                {
+                    entries.remove(record.key);
+                }
+                else
+                {
+                    entries.insert(record.key, payload);
+                    placeBlock(snapshot, SECTION_LAYOUT, QString(), false);
+                }
+            }
+            break;
+
+        case eRecord::Commit:
+        default:
+            break;
+        }
+    }
+
+    //!< The StateList of the level owned by \p key, with the nested levels of its states.
+    QString levelXml(const Snapshot& snapshot, uint32_t key, QSet<uint32_t>& written)
+    {
+        const QList<uint32_t> ids = snapshot.levels.value(key);
+        if (ids.isEmpty())
+            return QString();
+
+        QString result = QStringLiteral("<%1>").arg(XmlSM::xmlSMElementStateList);
+        for (uint32_t id : ids)
+        {
+            QString state = snapshot.states.value(id);
+            if (state.isEmpty() || written.contains(id))
+                continue;
+
+            written.insert(id);
+            const QString nested = levelXml(snapshot, id, written);
+            if (nested.isEmpty() == false)
+            {
+                if (state.endsWith(QLatin1String("/>")))
+                {
+                    state.chop(2);
+                    state += QStringLiteral(">%1</%2>").arg(nested, XmlSM::xmlSMElementState);
+                }
+                else
+                {
+                    state.insert(state.lastIndexOf(QLatin1String("</")), nested);
+                }
+            }
+
+            result += state;
+        }
+
+        result += QStringLiteral("</%1>").arg(XmlSM::xmlSMElementStateList);
+        return result;
+    }
+
+    QString layoutXml(const Snapshot& snapshot)
+    {
+        if (std::all_of(std::begin(snapshot.entries), std::end(snapshot.entries), [](const QMap<uint32_t, QString>& entries) { return entries.isEmpty(); }))
+            return QString();
+
+        QString result = QStringLiteral("<%1 %2=\"%3\" %4=\"%5\">").arg(XmlSM::xmlSMElementLayout, XmlSM::xmlSMAttributeGridSize, snapshot.gridSize
+                                                                         , XmlSM::xmlSMAttributeGridVisible, snapshot.gridVisible);
+        for (int i = 0; i < ENTRY_COUNT; ++i)
+        {
+            if (snapshot.entries[i].isEmpty())
+                continue;
+
+            result += QStringLiteral("<%1>").arg(_entryLists[i]);
+            for (const QString& entry : snapshot.entries[i])
+            {
+                result += entry;
+            }
+
+            result += QStringLiteral("</%1>").arg(_entryLists[i]);
+        }
+
+        result += QStringLiteral("</%1>").arg(XmlSM::xmlSMElementLayout);
+        return result;
+    }
+
+    QString renderSnapshot(const Snapshot& snapshot)
+    {
+        QString result = snapshot.head;
+        QSet<uint32_t> written;
+        for (const Block& block : snapshot.blocks)
+        {
+            const QString text = (block.section == SECTION_STATES) ? levelXml(snapshot, 0u, written)
+                               : (block.section == SECTION_LAYOUT) ? layoutXml(snapshot)
+                               : block.text;
+            if (text.isEmpty() == false)
+            {
+                result += QLatin1String("\n    ") + text;
+            }
+        }
+
+        result += QLatin1Char('\n') + snapshot.tail;
+        return result;
+    }
+
+    //!< Collects the states and transitions of a submachine that is not written.
+    void dropSubtree(const SMStateData& level, QSet<uint32_t>& dropOwners)
+    {
+        for (const SMStateEntry* state : level.getElements())
+        {
+            if (state == nullptr)
+                continue;
+
+            dropOwners.insert(state->getId());
+            for (const SMTransitionEntry* transition : state->getTransitions().getElements())
+            {
+                if (transition != nullptr)
+                {
+                    dropOwners.insert(transition->getId());
+                }
+            }
+
+            if (state->hasNestedStates())
+            {
+                dropSubtree(*state->getNestedStates(), dropOwners);
+            }
+        }
+    }
+
+    void addOperations(const SMOperationList& operations, uint32_t stateId, QHash<uint32_t, uint32_t>& owners)
+    {
+        for (const SMOperationBase* operation : operations.getOperations())
+        {
+            if (operation != nullptr)
+            {
+                owners.insert(operation->getId(), stateId);
+            }
+        }
+    }
+
+    inline QSet<uint32_t> changedOf(const QSet<uint32_t>& before, const QSet<uint32_t>& after)
+    {
+        return (after - before).unite(before - after);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SMAutosaveJournal::Changes implementation
+//////////////////////////////////////////////////////////////////////////
+
+bool SMAutosaveJournal::Changes::isEmpty() const
+{
+    return sections.isEmpty() && elements.isEmpty() && owners.isEmpty() && notes.isEmpty() && (grid == false) && (full == false);
+}
+
+void SMAutosaveJournal::Changes::clear()
+{
+    sections.clear();
+    elements.clear();
+    owners.clear();
+    notes.clear();
+    grid = false;
+    full = false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SMAutosaveJournal implementation
+//////////////////////////////////////////////////////////////////////////
+
+SMAutosaveJournal::SMAutosaveJournal()
+    : mDocumentPath ( )
+    , mTree         ( )
+    , mSnapshotSize (0)
+    , mJournalSize  (0)
+    , mRecords      (0)
+    , mCompacted    (false)
+    , mCompacting   (false)
+    , mTicket       (0u)
+{
+}
+
+QString SMAutosaveJournal::journalPathForDocument(const QString& documentPath)
+{
+    return documentPath.isEmpty() ? QString() : documentPath + QLatin1String(JOURNAL_EXT);
+}
+
+bool SMAutosaveJournal::write(const StateMachineData& data, const QString& documentPath, const Changes& changes)
+{
+    if (documentPath.isEmpty())
+        return false;
+
+    if (appendChanges(data, documentPath, changes))
+        return true;
+
+    const uint32_t ticket = beginCompaction(data, documentPath);
+    const QByteArray snapshot = data.writeToBuffer();
+    qint64 journalSize{ 0 };
+    const bool written = writeSnapshot(snapshot, documentPath, journalSize);
+    return endCompaction(ticket, written, snapshot.size(), journalSize);
+}
+
+bool SMAutosaveJournal::appendChanges(const StateMachineData& data, const QString& documentPath, const Changes& changes)
+{
+    const bool started = (mCompacting == false) && (documentPath.isEmpty() == false) && (mDocumentPath == documentPath);
+    if (started && changes.isEmpty())
+    {
+        mCompacted = false;
+        return true;
+    }
+
+    // The elements the format does not define are put back by the document writer alone, so a
+    // document that has them is always written whole.
+    if (started && (changes.full == false) && data.getUnknownElements().isEmpty() && (needsCompaction() == false) && append(data, changes))
+    {
+        mCompacted = false;
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t SMAutosaveJournal::beginCompaction(const StateMachineData& data, const QString& documentPath)
+{
+    reset();
+    walkLevel(data.getStates(), 0u, mTree);
+    mDocumentPath = documentPath;
+    mCompacting   = true;
+    return mTicket;
+}
+
+bool SMAutosaveJournal::writeSnapshot(const QByteArray& snapshot, const QString& documentPath, qint64& journalSize)
+{
+    journalSize = 0;
+    const QString snapshotPath = StateMachineData::autosavePathForDocument(documentPath);
+    const QString journalPath  = journalPathForDocument(documentPath);
+
+    // The old journal goes first. It names the old snapshot and would be dropped by a replay
+    // anyway, but a crash between the two writes must not leave it to be tried.
+    remove(documentPath);
+    if (writeFile(snapshotPath, snapshot) == false)
+        return false;
+
+    QByteArray header;
+    {
+        QDataStream out(&header, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << JOURNAL_MAGIC << JOURNAL_VERSION << hashOf(snapshot);
+    }
+
+    if (writeFile(journalPath, header) == false)
+        return false;
+
+    journalSize = header.size();
+    return true;
+}
+
+bool SMAutosaveJournal::endCompaction(uint32_t ticket, bool written, qint64 snapshotSize, qint64 journalSize)
+{
+    // A reset since the compaction began took the journal back; this snapshot is not its base.
+    if ((ticket != mTicket) || (mCompacting == false))
+        return false;
+
+    if (written == false)
+    {
+        reset();
+        return false;
+    }
+
+    mCompacting   = false;
+    mSnapshotSize = snapshotSize;
+    mJournalSize  = journalSize;
+    mCompacted    = true;
+    return true;
+}
+
+void SMAutosaveJournal::reset()
+{
+    mDocumentPath.clear();
+    mTree = Tree();
+    mSnapshotSize = 0;
+    mJournalSize  = 0;
+    mRecords      = 0;
+    mCompacted    = false;
+    mCompacting   = false;
+    ++mTicket;
+}
+
+bool SMAutosaveJournal::replay(const QString& documentPath)
+{
+    const QString journalPath = journalPathForDocument(documentPath);
+    if (journalPath.isEmpty() || (QFile::exists(journalPath) == false))
+        return true;
+
+    const QString snapshotPath = StateMachineData::autosavePathForDocument(documentPath);
+    const QByteArray snapshot = readFile(snapshotPath);
+    if (snapshot.isEmpty())
+    {
+        QFile::remove(journalPath);
+        return false;
+    }
+
+    QList<Record> records;
+    if ((readRecords(readFile(journalPath), snapshot, records) == false) || records.isEmpty())
+    {
+        // The journal of another snapshot, or one without a complete autosave: the snapshot is it.
+        QFile::remove(journalPath);
+        return true;
+    }
+
+    Snapshot parsed;
+    if (parseSnapshot(QString::fromUtf8(snapshot), parsed) == false)
+        return false;
+
+    for (const Record& record : records)
+    {
+        applyRecord(parsed, record);
+    }
+
+    if (writeFile(snapshotPath, renderSnapshot(parsed).toUtf8()) == false)
+        return false;
+
+    QFile::remove(journalPath);
+    return true;
+}
+
+bool SMAutosaveJournal::remove(const QString& documentPath)
+{
+    const QString path = journalPathForDocument(documentPath);
+    return path.isEmpty() ? true : ((QFile::exists(path) == false) || QFile::remove(path));
+}
+
+bool SMAutosaveJournal::append(const StateMachineData& data, const Changes& changes)
+{
+    Tree tree;
+    walkLevel(data.getStates(), 0u, tree);
+
+    // The states written again: the changed ones, the ones whose transitions or operations
+    // changed, and the ones new to the written levels. A state that is not written any more
+    // goes with the level that lost it.
+    QSet<uint32_t> states;
+    for (uint32_t id : changes.elements)
+    {
+        const uint32_t owner = tree.owners.value(id, mTree.owners.value(id, 0u));
+        if (owner != 0u)
+        {
+            if (tree.owners.contains(owner))
+            {
+                states.insert(owner);
+            }
+        }
+        else if ((tree.dropOwners.contains(id) == false) && (mTree.dropOwners.contains(id) == false))
+        {
+            return false;
+        }
+    }
+
+    QList<uint32_t> levels;
+    for (auto it = tree.levels.constBegin(); it != tree.levels.constEnd(); ++it)
+    {
+        if (mTree.levels.value(it.key()) != it.value())
+        {
+            levels.append(it.key());
+        }
+    }
+
+    for (auto it = mTree.levels.constBegin(); it != mTree.levels.constEnd(); ++it)
+    {
+        if (tree.levels.contains(it.key()) == false)
+        {
+            levels.append(it.key());
+        }
+    }
+
+    for (uint32_t key : levels)
+    {
+        // The history and the final hook of a state are written only with its nested states.
+        if ((key != 0u) && tree.owners.contains(key))
+        {
+            states.insert(key);
+        }
+
+        for (uint32_t id : tree.levels.value(key))
+        {
+            if (mTree.owners.contains(id) == false)
+            {
+                states.insert(id);
+            }
+        }
+    }
+
+    // A submachine that stops or starts being written takes the layout of its states with it.
+    const SMLayoutData& layout = data.getLayout();
+    const QSet<uint32_t> droppedOwners = changedOf(mTree.dropOwners, tree.dropOwners);
+    const QSet<uint32_t> droppedLevels = changedOf(mTree.dropLevels, tree.dropLevels);
+    QSet<uint32_t> owners = changes.owners;
+    owners.unite(droppedOwners).unite(droppedLevels);
+    QSet<uint32_t> notes = changes.notes;
+    if ((droppedOwners.isEmpty() == false) || (droppedLevels.isEmpty() == false))
+    {
+        for (const SMLayoutNote& note : layout.getNotes())
+        {
+            if (droppedLevels.contains(note.level) || droppedOwners.contains(note.owner))
+            {
+                notes.insert(note.id);
+            }
+        }
+    }
+
+    QByteArray records;
+    int count{ 0 };
+    {
+        QDataStream out(&records, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+
+        QList<int> sections = changes.sections.values();
+        std::sort(sections.begin(), sections.end());
+        for (int section : sections)
+        {
+            if ((section < static_cast<int>(eSection::Overview)) || (section > static_cast<int>(eSection::Includes)))
+                return false;
+
+            writeRecord(out, eRecord::Section, static_cast<uint32_t>(section), sectionXml(data, static_cast<eSection>(section)));
+            ++count;
+        }
+
+        for (uint32_t id : states)
+        {
+            const SMStateEntry* state = data.findStateById(id);
+            if (state == nullptr)
+                return false;
+
+            writeRecord(out, eRecord::State, id, fragment([state](QXmlStreamWriter& xml) { state->writeToXml(xml, false); }));
+            ++count;
+        }
+
+        for (uint32_t key : levels)
+        {
+            writeRecord(out, eRecord::Level, key, idsOf(tree.levels.value(key)));
+            ++count;
+        }
+
+        if (changes.grid || (owners.isEmpty() == false) || (notes.isEmpty() == false))
+        {
+            // A Layout section the snapshot did not have needs the grid to be written with.
+            const QByteArray visible{ layout.isGridVisible() ? XmlSM::xmlSMValueTrue.latin1() : XmlSM::xmlSMValueFalse.latin1() };
+            writeRecord(out, eRecord::Grid, 0u, QByteArray::number(layout.getGridSize()) + ' ' + visible);
+            ++count;
+        }
+
+        for (uint32_t owner : owners)
+        {
+            const SMLayoutView* view = tree.dropLevels.contains(owner) ? nullptr : layout.findView(owner);
+            const SMLayoutNode* node = tree.dropOwners.contains(owner) ? nullptr : layout.findNode(owner);
+            const SMLayoutEdge* edge = tree.dropOwners.contains(owner) ? nullptr : layout.findEdge(owner);
+            writeRecord(out, eRecord::View, owner, view != nullptr ? fragment([view](QXmlStreamWriter& xml) { SMLayoutData::writeView(xml, *view); }) : QByteArray());
+            writeRecord(out, eRecord::Node, owner, node != nullptr ? fragment([node](QXmlStreamWriter& xml) { SMLayoutData::writeNode(xml, *node); }) : QByteArray());
+            writeRecord(out, eRecord::Edge, owner, edge != nullptr ? fragment([edge](QXmlStreamWriter& xml) { SMLayoutData::writeEdge(xml, *edge); }) : QByteArray());
+            count += 3;
+        }
+
+        for (uint32_t id : notes)
+        {
+            const SMLayoutNote* note = layout.findNote(id);
+            const bool dropped = (note != nullptr) && (tree.dropLevels.contains(note->level) || ((note->owner != 0u) && tree.dropOwners.contains(note->owner)));
+            writeRecord(out, eRecord::Note, id, (note != nullptr) && (dropped == false) ? fragment([note](QXmlStreamWriter& xml) { SMLayoutData::writeNote(xml, *note); }) : QByteArray());
+            ++count;
+        }
+
+        writeRecord(out, eRecord::Commit, 0u, QByteArray());
+    }
+
+    // A journal removed under the model is not appended to; a new snapshot replaces it.
+    QFile file(journalPathForDocument(mDocumentPath));
+    if ((file.exists() == false) || (file.open(QIODevice::WriteOnly | QIODevice::Append) == false))
+        return false;
+
+    if ((file.write(records) != records.size()) || (file.flush() == false))
+        return false;
+
+    mTree = std::move(tree);
+    mJournalSize += records.size();
+    mRecords += count;
+    return true;
+}
+
+bool SMAutosaveJournal::needsCompaction() const
+{
+    return (mRecords >= COMPACT_RECORDS) || ((mJournalSize * 100) >= (mSnapshotSize * COMPACT_PERCENT));
+}
+
+void SMAutosaveJournal::walkLevel(const SMStateData& level, uint32_t key, Tree& tree)
+{
+    // The list goes into the tree once complete: the nested levels are added to it meanwhile.
+    QList<uint32_t> ids;
+    for (const SMStateEntry* state : level.getElements())
+    {
+        if (state == nullptr)
+            continue;
+
+        const uint32_t id = state->getId();
+        ids.append(id);
+        tree.owners.insert(id, id);
+        addOperations(state->getEntryList(), id, tree.owners);
+        addOperations(state->getExitList(), id, tree.owners);
+        for (const SMTransitionEntry* transition : state->getTransitions().getElements())
+        {
+            if (transition != nullptr)
+            {
+                tree.owners.insert(transition->getId(), id);
+                addOperations(transition->getOperations(), id, tree.owners);
+            }
+        }
+
+        if (state->hasNestedStates())
+        {
+            const SMStateData* nested = state->getNestedStates();
+            if (nested->hasRealState())
+            {
+                walkLevel(*nested, id, tree);
+            }
+            else
+            {
+                tree.dropLevels.insert(id);
+                dropSubtree(*nested, tree.dropOwners);
+            }
+        }
+    }
+
+    tree.levels.insert(key, ids);
+}
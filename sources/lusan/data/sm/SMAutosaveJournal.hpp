@@ -0,0 +1,254 @@
+#ifndef LUSAN_DATA_SM_SMAUTOSAVEJOURNAL_HPP
+#define LUSAN_DATA_SM_SMAUTOSAVEJOURNAL_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   (c) 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/sm/SMAutosaveJournal.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the autosave journal of a state machine document.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+#include <cstdint>
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class SMStateData;
+class StateMachineData;
+
+/**
+ * \class   SMAutosaveJournal
+ * \brief   The autosave of a state machine document as a full snapshot plus a journal of the
+ *          edits made since. The snapshot is the `.autosave` file, written as the document is
+ *          saved. The journal, the `.autosave.journal` file beside it, is appended with the
+ *          elements that changed, each written as the document writes it: a section, one state
+ *          without its nested states, the order of the states of a level, one layout entry. An
+ *          autosave of a moved box costs the box, not the document.
+ *
+ *          The journal is folded into a new snapshot when it grows past a share of the
+ *          snapshot, and whenever a change cannot be placed in it: a document with elements
+ *          the format does not define, or a change that names an element the journal does not
+ *          know. Recovery replays the journal into the snapshot before the snapshot is opened.
+ *
+ *          Every append ends with a commit record, and every record carries a checksum. A
+ *          journal cut short by a crash is replayed up to its last commit; a journal of another
+ *          snapshot is dropped.
+ **/
+class SMAutosaveJournal
+{
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The layout of a journal file. A journal of another layout is dropped.
+    static constexpr quint32    JOURNAL_VERSION     { 1u };
+    //!< The most records a journal takes before it is folded into a new snapshot.
+    static constexpr int        COMPACT_RECORDS     { 4096 };
+    //!< The size of a journal, in percent of the snapshot, it is folded into a new snapshot at.
+    static constexpr int        COMPACT_PERCENT     { 50 };
+
+    //!< The sections of the document recorded as a whole, by their place in the document.
+    enum class eSection : int
+    {
+          Overview      = 0 //!< The Overview section.
+        , DataTypes         //!< The data types.
+        , Attributes        //!< The attributes.
+        , Events            //!< The events.
+        , Timers            //!< The timers.
+        , Methods           //!< The methods.
+        , Constants         //!< The constants.
+        , Includes          //!< The includes and the machine imports.
+    };
+
+    /**
+     * \struct  Changes
+     * \brief   What changed in the document since the last autosave, as the edits reported it.
+     **/
+    struct Changes
+    {
+        QSet<int>       sections;           //!< The changed sections, eSection values.
+        QSet<uint32_t>  elements;           //!< The changed states, transitions and operations.
+        QSet<uint32_t>  owners;             //!< The owners of the changed views, nodes and edges.
+        QSet<uint32_t>  notes;              //!< The changed notes.
+        bool            grid    { false };  //!< The grid settings changed.
+        bool            full    { false };  //!< A change the journal cannot record; the next autosave is a snapshot.
+
+        //!< True if nothing changed.
+        bool isEmpty() const;
+
+        //!< Forgets every change.
+        void clear();
+    };
+
+private:
+    /**
+     * \struct  Tree
+     * \brief   The states as the document writes them, the base the next changes are found against.
+     **/
+    struct Tree
+    {
+        QHash<uint32_t, QList<uint32_t>>    levels;     //!< The states of every written level, by its owner; 0 is the top level.
+        QHash<uint32_t, uint32_t>           owners;     //!< The state every written state, transition and operation belongs to.
+        QSet<uint32_t>                      dropOwners; //!< The states and transitions of the submachines not written.
+        QSet<uint32_t>                      dropLevels; //!< The owners of the submachines not written.
+    };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    SMAutosaveJournal();
+    ~SMAutosaveJournal() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Operations
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   Returns the journal sibling path for a document path.
+     **/
+    static QString journalPathForDocument(const QString& documentPath);
+
+    /**
+     * \brief   Autosaves the document: appends the \p changes to the journal, or writes a new
+     *          snapshot and starts a new journal if the changes cannot be appended.
+     * \param   data            The document.
+     * \param   documentPath    The path of the document, which the autosave files are named after.
+     * \param   changes         What changed since the last autosave.
+     * \return  True if the autosave files hold the document.
+     **/
+    bool write(const StateMachineData& data, const QString& documentPath, const Changes& changes);
+
+    /**
+     * \brief   Appends the \p changes to the journal, if they can be placed in it.
+     * \return  True if the journal holds the document; false if a new snapshot is due.
+     **/
+    bool appendChanges(const StateMachineData& data, const QString& documentPath, const Changes& changes);
+
+    /**
+     * \brief   Starts a new snapshot of the document, which is written with writeSnapshot(), on
+     *          any thread, and taken by endCompaction(). The journal takes no changes meanwhile.
+     * \return  The ticket to end the compaction with.
+     **/
+    uint32_t beginCompaction(const StateMachineData& data, const QString& documentPath);
+
+    /**
+     * \brief   Writes the snapshot of the document at \p documentPath and a journal without
+     *          records. Touches no journal state, so it runs on any thread.
+     * \param   snapshot        The document as StateMachineData::writeToBuffer() writes it.
+     * \param   documentPath    The path of the document.
+     * \param   journalSize     On output, the size of the new journal.
+     * \return  True if both files are written.
+     **/
+    static bool writeSnapshot(const QByteArray& snapshot, const QString& documentPath, qint64& journalSize);
+
+    /**
+     * \brief   Ends the compaction started with \p ticket. A compaction reset meanwhile is ignored.
+     * \return  True if the journal continues from the new snapshot.
+     **/
+    bool endCompaction(uint32_t ticket, bool written, qint64 snapshotSize, qint64 journalSize);
+
+    /**
+     * \brief   Forgets the autosave written so far. The next autosave is a snapshot.
+     **/
+    void reset();
+
+    /**
+     * \brief   Folds the journal of the document at \p documentPath into its autosave snapshot
+     *          and deletes the journal.
+     * \return  True if the snapshot holds the last committed autosave.
+     **/
+    static bool replay(const QString& documentPath);
+
+    /**
+     * \brief   Deletes the journal of the document at \p documentPath.
+     **/
+    static bool remove(const QString& documentPath);
+
+    //!< True if the last autosave wrote a snapshot rather than appending to the journal.
+    inline bool lastWriteCompacted() const;
+
+    //!< True while a snapshot is being written.
+    inline bool isCompacting() const;
+
+    //!< The number of records in the journal.
+    inline int getRecordCount() const;
+
+    //!< The size of the journal, in bytes.
+    inline qint64 getJournalSize() const;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+    //!< Appends the changes to the journal. False if they cannot be placed in it.
+    bool append(const StateMachineData& data, const Changes& changes);
+
+    //!< True if the journal is due to be folded into a new snapshot.
+    bool needsCompaction() const;
+
+    //!< Collects the written states of \p level, owned by \p key, into \p tree.
+    static void walkLevel(const SMStateData& level, uint32_t key, Tree& tree);
+
+    SMAutosaveJournal(const SMAutosaveJournal&) = delete;
+    SMAutosaveJournal& operator = (const SMAutosaveJournal&) = delete;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    QString     mDocumentPath;  //!< The document the journal is written for, empty when nothing is written.
+    Tree        mTree;          //!< The states as the snapshot and the journal have them.
+    qint64      mSnapshotSize;  //!< The size of the snapshot, in bytes.
+    qint64      mJournalSize;   //!< The size of the journal, in bytes.
+    int         mRecords;       //!< The number of records in the journal.
+    bool        mCompacted;     //!< Whether the last autosave wrote a snapshot.
+    bool        mCompacting;    //!< Whether a snapshot is being written.
+    uint32_t    mTicket;        //!< The compaction the journal waits for; every reset moves it on.
+};
+
+//////////////////////////////////////////////////////////////////////////
+// SMAutosaveJournal class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline bool SMAutosaveJournal::lastWriteCompacted() const
+{
+    return mCompacted;
+}
+
+inline bool SMAutosaveJournal::isCompacting() const
+{
+    return mCompacting;
+}
+
+inline int SMAutosaveJournal::getRecordCount() const
+{
+    return mRecords;
+}
+
+inline qint64 SMAutosaveJournal::getJournalSize() const
+{
+    return mJournalSize;
+}
+
+#endif  // LUSAN_DATA_SM_SMAUTOSAVEJOURNAL_HPP
@@ -19,6 +19,9 @@
 
 #include "lusan/data/sm/SMDocumentCache.hpp"
 
+#include "lusan/data/common/DocFileWatcher.hpp"
+#include "lusan/data/common/IncludeEntry.hpp"
+#include "lusan/data/sm/SMImportResolver.hpp"
 #include "lusan/data/sm/StateMachineData.hpp"
 
 #include <QFileInfo>
@@ -29,6 +32,23 @@ SMDocumentCache& SMDocumentCache::getInstance()
     return _cache;
 }
 
+SMDocumentCache::SMDocumentCache()
+{
+    // A change of a watched file drops its entry, which is what lets a watched entry be handed
+    // out without checking the file.
+    QObject::connect(&DocFileWatcher::getInstance(), &DocFileWatcher::fileChanged, [this](const QString& absolutePath)
+    {
+        invalidate(absolutePath);
+    });
+}
+
+SMDocumentCache::~SMDocumentCache()
+{
+    // A parse still waiting in the queue at exit has nobody left to read it.
+    mPool.clear();
+    mPool.waitForDone();
+}
+
 std::shared_ptr<const StateMachineData> SMDocumentCache::document(const QString& absolutePath)
 {
     if (absolutePath.isEmpty())
@@ -36,43 +56,159 @@ std::shared_ptr<const StateMachineData> SMDocumentCache::document(const QString&
         return nullptr;
     }
 
+    bool created{ false };
+    const Entry entry = claimEntry(absolutePath, 0, created);
+    // Whoever claims the parse runs it, so a requester never waits behind the prefetch queue.
+    if (entry.pending->claimed.exchange(true) == false)
+    {
+        return fulfil(absolutePath, *entry.pending);
+    }
+
+    return entry.document.get();
+}
+
+void SMDocumentCache::prefetch(const QStringList& absolutePaths)
+{
+    prefetchAt(absolutePaths, 1);
+}
+
+void SMDocumentCache::prefetchImports(const StateMachineData& host)
+{
+    prefetchAt(importPaths(host), 1);
+}
+
+void SMDocumentCache::invalidate(const QString& absolutePath)
+{
+    {
+        QMutexLocker locker(&mLock);
+        mEntries.remove(absolutePath);
+    }
+
+    DocFileWatcher::getInstance().unwatch(absolutePath);
+}
+
+void SMDocumentCache::clear()
+{
+    QStringList paths;
+    {
+        QMutexLocker locker(&mLock);
+        paths = mEntries.keys();
+        mEntries.clear();
+    }
+
+    DocFileWatcher& watcher = DocFileWatcher::getInstance();
+    for (const QString& path : paths)
+    {
+        watcher.unwatch(path);
+    }
+}
+
+SMDocumentCache::Entry SMDocumentCache::claimEntry(const QString& absolutePath, int depth, bool& out_created)
+{
+    {
+        QMutexLocker locker(&mLock);
+        const auto found = mEntries.constFind(absolutePath);
+        if ((found != mEntries.constEnd()) && found->watched)
+        {
+            out_created = false;
+            return *found;
+        }
+    }
+
+    DocFileWatcher& watcher = DocFileWatcher::getInstance();
+    DocFileWatcher::countStat();
     const QFileInfo info(absolutePath);
     const QDateTime modified = info.lastModified();
     const qint64    size     = info.size();
+    const bool      isFile   = info.isFile();
 
     QMutexLocker locker(&mLock);
-    const auto found = mEntries.constFind(absolutePath);
-    if ((found != mEntries.constEnd()) && (found->modified == modified) && (found->size == size))
+    const auto found = mEntries.find(absolutePath);
+    if ((found != mEntries.end()) && (found->modified == modified) && (found->size == size))
     {
-        return found->document;
+        found->watched = watcher.watch(absolutePath, modified, size, isFile);
+        out_created = false;
+        return *found;
     }
 
     Entry entry;
-    entry.modified = modified;
-    entry.size     = size;
-    if (info.isFile())
+    entry.pending           = std::make_shared<Pending>();
+    entry.pending->depth    = depth;
+    entry.document          = entry.pending->promise.get_future().share();
+    entry.modified          = modified;
+    entry.size              = size;
+    entry.watched           = watcher.watch(absolutePath, modified, size, isFile);
+    mEntries.insert(absolutePath, entry);
+    out_created = true;
+    return entry;
+}
+
+SMDocumentCache::Document SMDocumentCache::fulfil(const QString& absolutePath, Pending& pending)
+{
+    const Document parsed = parse(absolutePath);
+    pending.promise.set_value(parsed);
+
+    // The next level goes behind everything already queued, which is what keeps the walk
+    // breadth-first. An import cycle ends at the entries the walk has already created.
+    if ((parsed != nullptr) && (pending.depth > 0) && (pending.depth < SMImportResolver::MAX_IMPORT_DEPTH))
     {
-        auto parsed = std::make_shared<StateMachineData>();
-        // A half-parsed document is worse than none: it would let a host validate against
-        // content the file does not actually contain.
-        if (parsed->readFromFile(absolutePath) && parsed->openSucceeded())
+        prefetchAt(importPaths(*parsed), pending.depth + 1);
+    }
+
+    return parsed;
+}
+
+void SMDocumentCache::prefetchAt(const QStringList& absolutePaths, int depth)
+{
+    for (const QString& path : absolutePaths)
+    {
+        bool created{ false };
+        const Entry entry = path.isEmpty() ? Entry() : claimEntry(path, depth, created);
+        if (created == false)
         {
-            entry.document = std::move(parsed);
+            continue;
         }
-    }
 
-    mEntries.insert(absolutePath, entry);
-    return entry.document;
+        std::shared_ptr<Pending> pending = entry.pending;
+        mPool.start([this, path, pending]() {
+            if (pending->claimed.exchange(true) == false)
+            {
+                fulfil(path, *pending);
+            }
+        });
+    }
 }
 
-void SMDocumentCache::invalidate(const QString& absolutePath)
+QStringList SMDocumentCache::importPaths(const StateMachineData& host)
 {
-    QMutexLocker locker(&mLock);
-    mEntries.remove(absolutePath);
+    QStringList result;
+    for (const IncludeEntry* entry : host.machineImports())
+    {
+        const QString path = (entry != nullptr) ? SMImportResolver::absolutePath(host, entry->getLocation()) : QString();
+        if ((path.isEmpty() == false) && (result.contains(path) == false))
+        {
+            result.append(path);
+        }
+    }
+
+    return result;
 }
 
-void SMDocumentCache::clear()
+SMDocumentCache::Document SMDocumentCache::parse(const QString& absolutePath)
 {
-    QMutexLocker locker(&mLock);
-    mEntries.clear();
+    // The entry has just registered the file, so this does not touch the disk again.
+    if (DocFileWatcher::getInstance().isFile(absolutePath) == false)
+    {
+        return nullptr;
+    }
+
+    auto parsed = std::make_shared<StateMachineData>();
+    // A half-parsed document is worse than none: it would let a host validate against
+    // content the file does not actually contain.
+    if (parsed->readFromFile(absolutePath) && parsed->openSucceeded())
+    {
+        return parsed;
+    }
+
+    return nullptr;
 }
@@ -26,7 +26,11 @@
 #include <QHash>
 #include <QMutex>
 #include <QString>
+#include <QStringList>
+#include <QThreadPool>
 
+#include <atomic>
+#include <future>
 #include <memory>
 
 /************************************************************************
@@ -44,8 +48,15 @@ class StateMachineData;
  *          copies agree.
  *
  *          Entries are immutable once parsed: a consumer only ever sees a `const` document.
- *          The cache is reachable from the validator, which runs on a worker thread, so every
- *          access is serialized.
+ *          The cache is reachable from the validator, which runs on a worker thread, so the
+ *          table is locked -- but only to find or claim an entry, never across a parse. The
+ *          first requester of a path parses it; a concurrent requester of the same path waits
+ *          on that entry, and requesters of other paths are not held up at all.
+ *
+ *          Opening a document prefetches its imports on the cache's own thread pool, level by
+ *          level: every parsed import queues its own imports behind the ones already waiting,
+ *          so the graph is read breadth-first and in parallel. A requester that reaches an
+ *          import still waiting in the queue parses it on the spot instead of waiting its turn.
  **/
 class SMDocumentCache
 {
@@ -53,11 +64,23 @@ class SMDocumentCache
 // Internal types
 //////////////////////////////////////////////////////////////////////////
 private:
+    using Document  = std::shared_ptr<const StateMachineData>;
+
+    //!< The parse of one entry. Whoever claims it first runs it: the pool or a requester.
+    struct Pending
+    {
+        std::promise<Document>  promise;                //!< Fulfilled once, by the claimer.
+        std::atomic_bool        claimed { false };      //!< Set by whoever runs the parse.
+        int                     depth   { 0 };          //!< The import depth of a prefetched document, 0 when requested.
+    };
+
     struct Entry
     {
-        std::shared_ptr<const StateMachineData> document;    //!< Null when the file failed to parse.
-        QDateTime                               modified;    //!< The file timestamp the entry was built from.
-        qint64                                  size { 0 };  //!< The file size at parse time.
+        std::shared_future<Document>    document;           //!< Holds null when the file failed to parse.
+        std::shared_ptr<Pending>        pending;            //!< The parse the entry is waiting on.
+        QDateTime                       modified;           //!< The file timestamp the entry was built from.
+        qint64                          size { 0 };         //!< The file size at parse time.
+        bool                            watched { false };  //!< A change of the file is reported, no check is needed.
     };
 
 //////////////////////////////////////////////////////////////////////////
@@ -75,12 +98,28 @@ public:
     std::shared_ptr<const StateMachineData> document(const QString& absolutePath);
 
     /**
-     * \brief   Drops the entry of one document, so the next request re-reads it.
+     * \brief   Starts parsing the documents at the given absolute paths, and then the documents
+     *          they import, on the thread pool of the cache. Returns at once; a later document()
+     *          of any of them waits for the parse or runs it, whichever comes first. Documents
+     *          already in the cache are not read again.
+     **/
+    void prefetch(const QStringList& absolutePaths);
+
+    /**
+     * \brief   Prefetches the import graph of \p host breadth-first, down to
+     *          SMImportResolver::MAX_IMPORT_DEPTH. Called when a document opens, so its imports
+     *          are parsed while the rest of the document is set up.
+     **/
+    void prefetchImports(const StateMachineData& host);
+
+    /**
+     * \brief   Drops the entry of one document and takes its file off the watch, so the next
+     *          request checks the file and re-reads it.
      **/
     void invalidate(const QString& absolutePath);
 
     /**
-     * \brief   Drops every entry.
+     * \brief   Drops every entry and takes their files off the watch.
      **/
     void clear();
 
@@ -88,7 +127,39 @@ public:
 // Hidden methods
 //////////////////////////////////////////////////////////////////////////
 private:
-    SMDocumentCache() = default;
+    SMDocumentCache();
+    ~SMDocumentCache();
+
+    /**
+     * \brief   The entry of the document at \p absolutePath. A watched entry is returned as it
+     *          is; any other is checked against the file, and a missing or stale one is replaced
+     *          by one waiting on a parse that nobody has claimed yet.
+     * \param   absolutePath    The document.
+     * \param   depth           The import depth the document is prefetched at, 0 when requested.
+     * \param   out_created     On output, true if the entry was created by this call.
+     **/
+    Entry claimEntry(const QString& absolutePath, int depth, bool& out_created);
+
+    /**
+     * \brief   Parses the document of a claimed entry, fulfils the entry and, for a prefetched
+     *          document, queues the documents it imports.
+     **/
+    Document fulfil(const QString& absolutePath, Pending& pending);
+
+    /**
+     * \brief   Queues a parse of every document in \p absolutePaths that has no entry yet.
+     **/
+    void prefetchAt(const QStringList& absolutePaths, int depth);
+
+    /**
+     * \brief   The absolute paths of the machine imports of \p host.
+     **/
+    static QStringList importPaths(const StateMachineData& host);
+
+    /**
+     * \brief   Reads the document at \p absolutePath, or nullptr when it does not parse.
+     **/
+    static Document parse(const QString& absolutePath);
 
     SMDocumentCache(const SMDocumentCache&) = delete;
     SMDocumentCache& operator = (const SMDocumentCache&) = delete;
@@ -97,8 +168,9 @@ private:
 // Member variables
 //////////////////////////////////////////////////////////////////////////
 private:
-    QHash<QString, Entry>   mEntries;
-    QMutex                  mLock;
+    QHash<QString, Entry>   mEntries;   //!< The documents, by absolute path.
+    QMutex                  mLock;      //!< Guards the table only, never a parse.
+    QThreadPool             mPool;      //!< Runs the prefetched parses.
 };
 
 #endif  // LUSAN_DATA_SM_SMDOCUMENTCACHE_HPP
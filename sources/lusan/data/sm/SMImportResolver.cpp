@@ -20,6 +20,7 @@
 #include "lusan/data/sm/SMImportResolver.hpp"
 
 #include "lusan/common/NELusanCommon.hpp"
+#include "lusan/data/common/DocFileWatcher.hpp"
 #include "lusan/data/sm/SMDocumentCache.hpp"
 #include "lusan/data/common/IncludeEntry.hpp"
 #include "lusan/data/sm/StateMachineData.hpp"
@@ -121,7 +122,7 @@ SMImportResolver::Resolution SMImportResolver::resolve(const StateMachineData& h
     }
 
     result.absolutePath = absolutePath(host, entry.getLocation());
-    if (result.absolutePath.isEmpty() || (QFileInfo(result.absolutePath).isFile() == false))
+    if (result.absolutePath.isEmpty() || (DocFileWatcher::getInstance().isFile(result.absolutePath) == false))
     {
         result.state = eState::NotFound;
         return result;
@@ -19,6 +19,7 @@
 
 #include "lusan/data/sm/SMLayoutData.hpp"
 #include "lusan/common/XmlSM.hpp"
+#include "lusan/data/common/DocXmlWriter.hpp"
 
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
@@ -44,6 +45,223 @@ namespace
         std::sort(result.begin(), result.end(), [key](const Entry* lhs, const Entry* rhs) { return key(*lhs) < key(*rhs); });
         return result;
     }
+
+    /**
+     * \brief   The calls of DocXmlWriter made on a QXmlStreamWriter, with the numbers formatted by
+     *          QString::number(). The layout is written by the templates below through either
+     *          writer, so both write the same bytes.
+     **/
+    class QtLayoutWriter
+    {
+    public:
+        explicit QtLayoutWriter(QXmlStreamWriter& xml)
+            : mXml(xml)
+        {
+        }
+
+        inline void writeStartElement(QLatin1StringView name)
+        {
+            mXml.writeStartElement(name);
+        }
+
+        inline void writeEndElement()
+        {
+            mXml.writeEndElement();
+        }
+
+        inline void writeAttribute(QLatin1StringView name, QLatin1StringView value)
+        {
+            mXml.writeAttribute(name, value);
+        }
+
+        inline void writeAttribute(QLatin1StringView name, const QString& value)
+        {
+            mXml.writeAttribute(name, value);
+        }
+
+        inline void writeAttribute(QLatin1StringView name, int value)
+        {
+            mXml.writeAttribute(name, QString::number(value));
+        }
+
+        inline void writeAttribute(QLatin1StringView name, uint32_t value)
+        {
+            mXml.writeAttribute(name, QString::number(value));
+        }
+
+        inline void writeAttribute(QLatin1StringView name, double value)
+        {
+            mXml.writeAttribute(name, QString::number(value));
+        }
+
+        inline void writeTextElement(QLatin1StringView name, const QString& text)
+        {
+            mXml.writeTextElement(name, text);
+        }
+
+    private:
+        QXmlStreamWriter&   mXml;   //!< The writer of the document.
+    };
+
+    //!< Writes a layout entry, through a QtLayoutWriter or a DocXmlWriter.
+    template <typename Writer>
+    void writeEntry(Writer& xml, const SMLayoutView& view)
+    {
+        xml.writeStartElement(XmlSM::xmlSMElementView);
+        xml.writeAttribute(XmlSM::xmlSMAttributeOwner, view.owner);
+        xml.writeAttribute(XmlSM::xmlSMAttributeZoom, view.zoom);
+        xml.writeAttribute(XmlSM::xmlSMAttributeX, view.x);
+        xml.writeAttribute(XmlSM::xmlSMAttributeY, view.y);
+        xml.writeEndElement();
+    }
+
+    template <typename Writer>
+    void writeEntry(Writer& xml, const SMLayoutNode& node)
+    {
+        xml.writeStartElement(XmlSM::xmlSMElementNode);
+        xml.writeAttribute(XmlSM::xmlSMAttributeOwner, node.owner);
+        xml.writeAttribute(XmlSM::xmlSMAttributeX, node.x);
+        xml.writeAttribute(XmlSM::xmlSMAttributeY, node.y);
+        xml.writeAttribute(XmlSM::xmlSMAttributeWidth, node.width);
+        xml.writeAttribute(XmlSM::xmlSMAttributeHeight, node.height);
+        if (node.color.isEmpty() == false)
+        {
+            xml.writeAttribute(XmlSM::xmlSMAttributeColor, node.color);
+        }
+        if (node.headerColor.isEmpty() == false)
+        {
+            xml.writeAttribute(XmlSM::xmlSMAttributeHeaderColor, node.headerColor);
+        }
+        if (node.hasExpanded)
+        {
+            xml.writeAttribute(XmlSM::xmlSMAttributeExpanded, node.expanded ? XmlSM::xmlSMValueTrue : XmlSM::xmlSMValueFalse);
+        }
+        xml.writeEndElement();
+    }
+
+    template <typename Writer>
+    void writeEntry(Writer& xml, const SMLayoutEdge& edge)
+    {
+        xml.writeStartElement(XmlSM::xmlSMElementEdge);
+        xml.writeAttribute(XmlSM::xmlSMAttributeOwner, edge.owner);
+        if (edge.shape == SMLayoutEdge::eShape::Arc)
+        {
+            xml.writeAttribute(XmlSM::xmlSMAttributeShape, XmlSM::xmlSMShapeArc);
+            xml.writeAttribute(XmlSM::xmlSMAttributeBulge, edge.bulge);
+        }
+        if (edge.color.isEmpty() == false)
+        {
+            xml.writeAttribute(XmlSM::xmlSMAttributeColor, edge.color);
+        }
+        for (const QPointF& point : edge.points)
+        {
+            xml.writeStartElement(XmlSM::xmlSMElementPoint);
+            xml.writeAttribute(XmlSM::xmlSMAttributeX, point.x());
+            xml.writeAttribute(XmlSM::xmlSMAttributeY, point.y());
+            xml.writeEndElement();
+        }
+        if (edge.hasLabel)
+        {
+            xml.writeStartElement(XmlSM::xmlSMElementLabel);
+            xml.writeAttribute(XmlSM::xmlSMAttributeX, edge.label.x());
+            xml.writeAttribute(XmlSM::xmlSMAttributeY, edge.label.y());
+            xml.writeEndElement();
+        }
+        xml.writeEndElement();
+    }
+
+    template <typename Writer>
+    void writeEntry(Writer& xml, const SMLayoutNote& note)
+    {
+        xml.writeStartElement(XmlSM::xmlSMElementNote);
+        xml.writeAttribute(XmlSM::xmlSMAttributeID, note.id);
+        xml.writeAttribute(XmlSM::xmlSMAttributeLevel, note.level);
+        if (note.owner != 0)
+        {
+            xml.writeAttribute(XmlSM::xmlSMAttributeOwner, note.owner);
+        }
+        xml.writeAttribute(XmlSM::xmlSMAttributeX, note.x);
+        xml.writeAttribute(XmlSM::xmlSMAttributeY, note.y);
+        xml.writeAttribute(XmlSM::xmlSMAttributeWidth, note.width);
+        xml.writeAttribute(XmlSM::xmlSMAttributeHeight, note.height);
+        if (note.color.isEmpty() == false)
+        {
+            xml.writeAttribute(XmlSM::xmlSMAttributeColor, note.color);
+        }
+        xml.writeTextElement(XmlSM::xmlSMElementText, note.text);
+        xml.writeEndElement();
+    }
+
+    //!< Writes the Layout section without the entries of the dropped elements.
+    template <typename Writer>
+    void writeLayout(Writer& xml, const SMLayoutData& layout, const QSet<uint32_t>& dropOwners, const QSet<uint32_t>& dropLevels)
+    {
+        // The Layout section is editor state only; omit it when there is nothing to persist.
+        if (layout.getViews().isEmpty() && layout.getNodes().isEmpty() && layout.getEdges().isEmpty() && layout.getNotes().isEmpty())
+            return;
+
+        xml.writeStartElement(XmlSM::xmlSMElementLayout);
+        xml.writeAttribute(XmlSM::xmlSMAttributeGridSize, layout.getGridSize());
+        xml.writeAttribute(XmlSM::xmlSMAttributeGridVisible, layout.isGridVisible() ? XmlSM::xmlSMValueTrue : XmlSM::xmlSMValueFalse);
+
+        if (layout.getViews().isEmpty() == false)
+        {
+            xml.writeStartElement(XmlSM::xmlSMElementViewList);
+            for (const SMLayoutView* entry : sortedByKey(layout.getViews(), [](const SMLayoutView& v) { return v.owner; }))
+            {
+                if (dropLevels.contains(entry->owner))
+                {
+                    continue;   // the sublevel of a dropped submachine: no View is persisted for it
+                }
+                writeEntry(xml, *entry);
+            }
+            xml.writeEndElement();
+        }
+
+        if (layout.getNodes().isEmpty() == false)
+        {
+            xml.writeStartElement(XmlSM::xmlSMElementNodeList);
+            for (const SMLayoutNode* entry : sortedByKey(layout.getNodes(), [](const SMLayoutNode& n) { return n.owner; }))
+            {
+                if (dropOwners.contains(entry->owner))
+                {
+                    continue;   // a nested state of a dropped submachine
+                }
+                writeEntry(xml, *entry);
+            }
+            xml.writeEndElement();
+        }
+
+        if (layout.getEdges().isEmpty() == false)
+        {
+            xml.writeStartElement(XmlSM::xmlSMElementEdgeList);
+            for (const SMLayoutEdge* entry : sortedByKey(layout.getEdges(), [](const SMLayoutEdge& e) { return e.owner; }))
+            {
+                if (dropOwners.contains(entry->owner))
+                {
+                    continue;   // a transition inside a dropped submachine
+                }
+                writeEntry(xml, *entry);
+            }
+            xml.writeEndElement();
+        }
+
+        if (layout.getNotes().isEmpty() == false)
+        {
+            xml.writeStartElement(XmlSM::xmlSMElementNoteList);
+            for (const SMLayoutNote* entry : sortedByKey(layout.getNotes(), [](const SMLayoutNote& n) { return n.id; }))
+            {
+                if (dropLevels.contains(entry->level) || ((entry->owner != 0) && dropOwners.contains(entry->owner)))
+                {
+                    continue;   // a note placed at, or bound inside, a dropped submachine
+                }
+                writeEntry(xml, *entry);
+            }
+            xml.writeEndElement();
+        }
+
+        xml.writeEndElement();
+    }
 }
 
 SMLayoutData::SMLayoutData(ElementBase* parent /*= nullptr*/)
@@ -217,139 +435,54 @@ void SMLayoutData::writeToXml(QXmlStreamWriter& xml) const
 
 void SMLayoutData::writeToXml(QXmlStreamWriter& xml, const QSet<uint32_t>& dropOwners, const QSet<uint32_t>& dropLevels) const
 {
-    // The Layout section is editor state only; omit it when there is nothing to persist.
-    if (mViews.isEmpty() && mNodes.isEmpty() && mEdges.isEmpty() && mNotes.isEmpty())
-        return;
+    QtLayoutWriter writer(xml);
+    writeLayout(writer, *this, dropOwners, dropLevels);
+}
 
-    xml.writeStartElement(XmlSM::xmlSMElementLayout);
-    xml.writeAttribute(XmlSM::xmlSMAttributeGridSize, QString::number(mGridSize));
-    xml.writeAttribute(XmlSM::xmlSMAttributeGridVisible, mGridVisible ? XmlSM::xmlSMValueTrue : XmlSM::xmlSMValueFalse);
+void SMLayoutData::writeToXml(DocXmlWriter& xml, const QSet<uint32_t>& dropOwners, const QSet<uint32_t>& dropLevels) const
+{
+    writeLayout(xml, *this, dropOwners, dropLevels);
+}
 
-    if (mViews.isEmpty() == false)
+qsizetype SMLayoutData::estimateXmlSize() const
+{
+    // About the bytes of a written entry, its line and its indentation with it.
+    qsizetype result{ 256 + 72 * mViews.size() + 112 * mNodes.size() + 64 * mEdges.size() + 160 * mNotes.size() };
+    for (const SMLayoutEdge& edge : mEdges)
     {
-        xml.writeStartElement(XmlSM::xmlSMElementViewList);
-        for (const SMLayoutView* entry : sortedByKey(mViews, [](const SMLayoutView& v) { return v.owner; }))
-        {
-            const SMLayoutView& view{ *entry };
-            if (dropLevels.contains(view.owner))
-            {
-                continue;   // the sublevel of a dropped submachine: no View is persisted for it
-            }
-            xml.writeStartElement(XmlSM::xmlSMElementView);
-            xml.writeAttribute(XmlSM::xmlSMAttributeOwner, QString::number(view.owner));
-            xml.writeAttribute(XmlSM::xmlSMAttributeZoom, QString::number(view.zoom));
-            xml.writeAttribute(XmlSM::xmlSMAttributeX, QString::number(view.x));
-            xml.writeAttribute(XmlSM::xmlSMAttributeY, QString::number(view.y));
-            xml.writeEndElement();
-        }
-        xml.writeEndElement();
+        result += 40 * (edge.points.size() + (edge.hasLabel ? 1 : 0));
     }
 
-    if (mNodes.isEmpty() == false)
+    for (const SMLayoutNote& note : mNotes)
     {
-        xml.writeStartElement(XmlSM::xmlSMElementNodeList);
-        for (const SMLayoutNode* entry : sortedByKey(mNodes, [](const SMLayoutNode& n) { return n.owner; }))
-        {
-            const SMLayoutNode& node{ *entry };
-            if (dropOwners.contains(node.owner))
-            {
-                continue;   // a nested state of a dropped submachine
-            }
-            xml.writeStartElement(XmlSM::xmlSMElementNode);
-            xml.writeAttribute(XmlSM::xmlSMAttributeOwner, QString::number(node.owner));
-            xml.writeAttribute(XmlSM::xmlSMAttributeX, QString::number(node.x));
-            xml.writeAttribute(XmlSM::xmlSMAttributeY, QString::number(node.y));
-            xml.writeAttribute(XmlSM::xmlSMAttributeWidth, QString::number(node.width));
-            xml.writeAttribute(XmlSM::xmlSMAttributeHeight, QString::number(node.height));
-            if (node.color.isEmpty() == false)
-            {
-                xml.writeAttribute(XmlSM::xmlSMAttributeColor, node.color);
-            }
-            if (node.headerColor.isEmpty() == false)
-            {
-                xml.writeAttribute(XmlSM::xmlSMAttributeHeaderColor, node.headerColor);
-            }
-            if (node.hasExpanded)
-            {
-                xml.writeAttribute(XmlSM::xmlSMAttributeExpanded, node.expanded ? XmlSM::xmlSMValueTrue : XmlSM::xmlSMValueFalse);
-            }
-            xml.writeEndElement();
-        }
-        xml.writeEndElement();
+        result += note.text.size();
     }
 
-    if (mEdges.isEmpty() == false)
-    {
-        xml.writeStartElement(XmlSM::xmlSMElementEdgeList);
-        for (const SMLayoutEdge* entry : sortedByKey(mEdges, [](const SMLayoutEdge& e) { return e.owner; }))
-        {
-            const SMLayoutEdge& edge{ *entry };
-            if (dropOwners.contains(edge.owner))
-            {
-                continue;   // a transition inside a dropped submachine
-            }
-            xml.writeStartElement(XmlSM::xmlSMElementEdge);
-            xml.writeAttribute(XmlSM::xmlSMAttributeOwner, QString::number(edge.owner));
-            if (edge.shape == SMLayoutEdge::eShape::Arc)
-            {
-                xml.writeAttribute(XmlSM::xmlSMAttributeShape, XmlSM::xmlSMShapeArc);
-                xml.writeAttribute(XmlSM::xmlSMAttributeBulge, QString::number(edge.bulge));
-            }
-            if (edge.color.isEmpty() == false)
-            {
-                xml.writeAttribute(XmlSM::xmlSMAttributeColor, edge.color);
-            }
-            for (const QPointF& point : edge.points)
-            {
-                xml.writeStartElement(XmlSM::xmlSMElementPoint);
-                xml.writeAttribute(XmlSM::xmlSMAttributeX, QString::number(point.x()));
-                xml.writeAttribute(XmlSM::xmlSMAttributeY, QString::number(point.y()));
-                xml.writeEndElement();
-            }
-            if (edge.hasLabel)
-            {
-                xml.writeStartElement(XmlSM::xmlSMElementLabel);
-                xml.writeAttribute(XmlSM::xmlSMAttributeX, QString::number(edge.label.x()));
-                xml.writeAttribute(XmlSM::xmlSMAttributeY, QString::number(edge.label.y()));
-                xml.writeEndElement();
-            }
-            xml.writeEndElement();
-        }
-        xml.writeEndElement();
-    }
+    return result;
+}
 
-    if (mNotes.isEmpty() == false)
-    {
-        xml.writeStartElement(XmlSM::xmlSMElementNoteList);
-        for (const SMLayoutNote* entry : sortedByKey(mNotes, [](const SMLayoutNote& n) { return n.id; }))
-        {
-            const SMLayoutNote& note{ *entry };
-            if (dropLevels.contains(note.level) || ((note.owner != 0) && dropOwners.contains(note.owner)))
-            {
-                continue;   // a note placed at, or bound inside, a dropped submachine
-            }
-            xml.writeStartElement(XmlSM::xmlSMElementNote);
-            xml.writeAttribute(XmlSM::xmlSMAttributeID, QString::number(note.id));
-            xml.writeAttribute(XmlSM::xmlSMAttributeLevel, QString::number(note.level));
-            if (note.owner != 0)
-            {
-                xml.writeAttribute(XmlSM::xmlSMAttributeOwner, QString::number(note.owner));
-            }
-            xml.writeAttribute(XmlSM::xmlSMAttributeX, QString::number(note.x));
-            xml.writeAttribute(XmlSM::xmlSMAttributeY, QString::number(note.y));
-            xml.writeAttribute(XmlSM::xmlSMAttributeWidth, QString::number(note.width));
-            xml.writeAttribute(XmlSM::xmlSMAttributeHeight, QString::number(note.height));
-            if (note.color.isEmpty() == false)
-            {
-                xml.writeAttribute(XmlSM::xmlSMAttributeColor, note.color);
-            }
-            xml.writeTextElement(XmlSM::xmlSMElementText, note.text);
-            xml.writeEndElement();
-        }
-        xml.writeEndElement();
-    }
+void SMLayoutData::writeView(QXmlStreamWriter& xml, const SMLayoutView& view)
+{
+    QtLayoutWriter writer(xml);
+    writeEntry(writer, view);
+}
+
+void SMLayoutData::writeNode(QXmlStreamWriter& xml, const SMLayoutNode& node)
+{
+    QtLayoutWriter writer(xml);
+    writeEntry(writer, node);
+}
 
-    xml.writeEndElement();
+void SMLayoutData::writeEdge(QXmlStreamWriter& xml, const SMLayoutEdge& edge)
+{
+    QtLayoutWriter writer(xml);
+    writeEntry(writer, edge);
+}
+
+void SMLayoutData::writeNote(QXmlStreamWriter& xml, const SMLayoutNote& note)
+{
+    QtLayoutWriter writer(xml);
+    writeEntry(writer, note);
 }
 
 SMLayoutView& SMLayoutData::addView(uint32_t owner)
@@ -29,6 +29,11 @@
 #include <QSet>
 #include <QString>
 
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class DocXmlWriter;
+
 /**
  * \brief   `View`: the saved zoom/scroll of a machine level, keyed by the
  *          `Owner` element ID (the level's composite state, or the Overview for level 0).
@@ -134,6 +139,26 @@ public:
      **/
     void writeToXml(QXmlStreamWriter& xml, const QSet<uint32_t>& dropOwners, const QSet<uint32_t>& dropLevels) const;
 
+    /**
+     * \brief   Writes the Layout section as the method above does, straight to UTF-8. The layout
+     *          is most of the bytes of a large machine, and nearly all of them numbers.
+     **/
+    void writeToXml(DocXmlWriter& xml, const QSet<uint32_t>& dropOwners, const QSet<uint32_t>& dropLevels) const;
+
+    /**
+     * \brief   The size the written Layout section is expected at, in bytes, to reserve for it.
+     **/
+    qsizetype estimateXmlSize() const;
+
+    /**
+     * \brief   Write one entry of the Layout section, exactly as the section writes it. The
+     *          autosave journal records a single moved box without writing the whole section.
+     **/
+    static void writeView(QXmlStreamWriter& xml, const SMLayoutView& view);
+    static void writeNode(QXmlStreamWriter& xml, const SMLayoutNode& node);
+    static void writeEdge(QXmlStreamWriter& xml, const SMLayoutEdge& edge);
+    static void writeNote(QXmlStreamWriter& xml, const SMLayoutNote& note);
+
 //////////////////////////////////////////////////////////////////////////
 // Attributes and operations
 //////////////////////////////////////////////////////////////////////////
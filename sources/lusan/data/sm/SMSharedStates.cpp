@@ -0,0 +1,290 @@
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   (c) 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/sm/SMSharedStates.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the states of a document frozen as shared, immutable subtrees.
+ *
+ ************************************************************************/
+
+#include "lusan/data/sm/SMSharedStates.hpp"
+
+#include "lusan/common/XmlSM.hpp"
+#include "lusan/data/sm/SMOperation.hpp"
+#include "lusan/data/sm/SMState.hpp"
+#include "lusan/data/sm/SMTransition.hpp"
+
+#include <QXmlStreamWriter>
+
+namespace
+{
+    //!< Calls \p visit with the ID of every transition and operation of \p state.
+    template <typename Visit>
+    void forEachElement(const SMStateEntry& state, Visit visit)
+    {
+        for (const SMOperationBase* operation : state.getEntryList().getOperations())
+        {
+            if (operation != nullptr)
+            {
+                visit(operation->getId());
+            }
+        }
+
+        for (const SMOperationBase* operation : state.getExitList().getOperations())
+        {
+            if (operation != nullptr)
+            {
+                visit(operation->getId());
+            }
+        }
+
+        for (const SMTransitionEntry* transition : state.getTransitions().getElements())
+        {
+            if (transition == nullptr)
+                continue;
+
+            visit(transition->getId());
+            for (const SMOperationBase* operation : transition->getOperations().getOperations())
+            {
+                if (operation != nullptr)
+                {
+                    visit(operation->getId());
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SMSharedState class implementation
+//////////////////////////////////////////////////////////////////////////
+
+SMSharedState::SMSharedState(std::shared_ptr<const SMStateEntry> state, Level nested, bool nestedDropped)
+    : mState        (std::move(state))
+    , mNested       (std::move(nested))
+    , mNestedDropped(nestedDropped)
+{
+}
+
+uint32_t SMSharedState::getId() const
+{
+    return mState->getId();
+}
+
+void SMSharedState::writeToXml(QXmlStreamWriter& xml) const
+{
+    mState->writeStartToXml(xml, mNestedDropped);
+    writeToXml(xml, mNested);
+    xml.writeEndElement();
+}
+
+void SMSharedState::writeToXml(QXmlStreamWriter& xml, const Level& level)
+{
+    if (level.isEmpty())
+        return;
+
+    xml.writeStartElement(XmlSM::xmlSMElementStateList);
+    for (const Ptr& state : level)
+    {
+        state->writeToXml(xml);
+    }
+
+    xml.writeEndElement();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SMSharedStates class implementation
+//////////////////////////////////////////////////////////////////////////
+
+SMSharedStates::SMSharedStates()
+    : mStates   ( )
+    , mOwners   ( )
+    , mChanged  ( )
+    , mUnknown  ( )
+    , mCopied   (0)
+{
+}
+
+void SMSharedStates::elementChanged(uint32_t id)
+{
+    if (mStates.contains(id))
+    {
+        mChanged.insert(id);
+        return;
+    }
+
+    // An element the last freeze did not have is looked for when the states are at hand.
+    const auto owner = mOwners.constFind(id);
+    if (owner != mOwners.constEnd())
+    {
+        mChanged.insert(owner.value());
+    }
+    else
+    {
+        mUnknown.insert(id);
+    }
+}
+
+void SMSharedStates::reset()
+{
+    mStates.clear();
+    mOwners.clear();
+    mChanged.clear();
+    mUnknown.clear();
+}
+
+SMSharedState::Level SMSharedStates::freeze(const SMStateData& states)
+{
+    if ((mUnknown.isEmpty() == false) && (placeUnknown(states) == false))
+    {
+        reset();
+    }
+
+    QHash<uint32_t, SMSharedState::Ptr> frozen;
+    frozen.reserve(mStates.size());
+    mCopied = 0;
+    SMSharedState::Level result{ freezeLevel(states, frozen) };
+
+    // The copies frozen last time and not taken again go with the elements they had, then the
+    // new copies bring theirs: an element moved from one state to another ends at the new one.
+    for (auto it = mStates.constBegin(); it != mStates.constEnd(); ++it)
+    {
+        const SMSharedState::Ptr next = frozen.value(it.key());
+        if ((next == nullptr) || (next->mState != it.value()->mState))
+        {
+            removeOwners(it.value()->getState());
+        }
+    }
+
+    for (auto it = frozen.constBegin(); it != frozen.constEnd(); ++it)
+    {
+        const SMSharedState::Ptr last = mStates.value(it.key());
+        if ((last == nullptr) || (last->mState != it.value()->mState))
+        {
+            addOwners(it.value()->getState());
+        }
+    }
+
+    mStates = std::move(frozen);
+    mChanged.clear();
+    mUnknown.clear();
+    return result;
+}
+
+SMSharedState::Level SMSharedStates::freezeLevel(const SMStateData& level, QHash<uint32_t, SMSharedState::Ptr>& frozen)
+{
+    SMSharedState::Level result;
+    result.reserve(level.getElements().size());
+    for (const SMStateEntry* state : level.getElements())
+    {
+        if (state == nullptr)
+            continue;
+
+        // The nested level goes first: the node of the state is taken again only if that level is.
+        const uint32_t id = state->getId();
+        const SMStateData* nested = state->getNestedStates();
+        const bool nestedDropped = (nested != nullptr) && (nested->hasRealState() == false);
+        SMSharedState::Level frozenNested;
+        if ((nested != nullptr) && (nestedDropped == false))
+        {
+            frozenNested = freezeLevel(*nested, frozen);
+        }
+
+        SMSharedState::Ptr node;
+        std::shared_ptr<const SMStateEntry> copy;
+        const SMSharedState::Ptr last = mStates.value(id);
+        if ((last != nullptr) && (mChanged.contains(id) == false))
+        {
+            // A state that gains or loses its painted level loses its submachine alias with it.
+            const bool hadNested = (last->mNested.isEmpty() == false) || last->mNestedDropped;
+            if ((last->mNested == frozenNested) && (last->mNestedDropped == nestedDropped))
+            {
+                node = last;
+            }
+            else if (hadNested == (nested != nullptr))
+            {
+                copy = last->mState;
+            }
+        }
+
+        if (node == nullptr)
+        {
+            if (copy == nullptr)
+            {
+                // Nothing of the copy may reach back into the document the editor goes on changing.
+                std::shared_ptr<SMStateEntry> entry{ std::make_shared<SMStateEntry>(*state, false) };
+                entry->setParent(static_cast<ElementBase*>(nullptr));
+                copy = std::move(entry);
+                ++mCopied;
+            }
+
+            node = std::make_shared<const SMSharedState>(std::move(copy), std::move(frozenNested), nestedDropped);
+        }
+
+        frozen.insert(id, node);
+        result.append(node);
+    }
+
+    return result;
+}
+
+bool SMSharedStates::placeUnknown(const SMStateData& states)
+{
+    for (const SMStateEntry* state : states.getElements())
+    {
+        if (state == nullptr)
+            continue;
+
+        const uint32_t id = state->getId();
+        if (mUnknown.remove(id))
+        {
+            mChanged.insert(id);
+        }
+
+        forEachElement(*state, [this, id](uint32_t element) {
+            if (mUnknown.remove(element))
+            {
+                mChanged.insert(id);
+            }
+        });
+
+        if (state->hasNestedStates())
+        {
+            placeUnknown(*state->getNestedStates());
+        }
+    }
+
+    // An element added and removed again since the last freeze may have left its mark on a
+    // state the cache cannot name.
+    return mUnknown.isEmpty();
+}
+
+void SMSharedStates::addOwners(const SMStateEntry& state)
+{
+    const uint32_t id = state.getId();
+    forEachElement(state, [this, id](uint32_t element) {
+        mOwners.insert(element, id);
+    });
+}
+
+void SMSharedStates::removeOwners(const SMStateEntry& state)
+{
+    const uint32_t id = state.getId();
+    forEachElement(state, [this, id](uint32_t element) {
+        const auto owner = mOwners.constFind(element);
+        if ((owner != mOwners.constEnd()) && (owner.value() == id))
+        {
+            mOwners.erase(owner);
+        }
+    });
+}
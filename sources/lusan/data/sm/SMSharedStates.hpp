@@ -0,0 +1,219 @@
+#ifndef LUSAN_DATA_SM_SMSHAREDSTATES_HPP
+#define LUSAN_DATA_SM_SMSHAREDSTATES_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   (c) 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/data/sm/SMSharedStates.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the states of a document frozen as shared, immutable subtrees.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QHash>
+#include <QList>
+#include <QSet>
+
+#include <cstdint>
+#include <memory>
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class QXmlStreamWriter;
+class SMStateData;
+class SMStateEntry;
+
+/**
+ * \class   SMSharedState
+ * \brief   One state frozen with its nested states: an immutable node that any number of frozen
+ *          trees hold by reference. The state itself is a copy without its nested states, held
+ *          apart from the node, so a node rebuilt for a changed nested level keeps the copy.
+ *          A node is never changed; it is written on any thread.
+ **/
+class SMSharedState
+{
+    friend class SMSharedStates;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< A frozen state, shared by the trees that have it unchanged.
+    using Ptr   = std::shared_ptr<const SMSharedState>;
+    //!< A frozen level: its states in document order.
+    using Level = QList<Ptr>;
+
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   Freezes a state.
+     * \param   state           The copy of the state, without its nested states.
+     * \param   nested          The frozen nested level, empty if the state writes none.
+     * \param   nestedDropped   Whether the state has a painted level without a real state, which
+     *                          is not written, and the attributes that need one go with it.
+     **/
+    SMSharedState(std::shared_ptr<const SMStateEntry> state, Level nested, bool nestedDropped);
+    ~SMSharedState() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The ID of the frozen state.
+    uint32_t getId() const;
+
+    //!< The frozen state, without its nested states.
+    inline const SMStateEntry& getState() const;
+
+    //!< The frozen nested level, empty if the state writes none.
+    inline const Level& getNested() const;
+
+    //!< True if the state has a painted level without a real state.
+    inline bool isNestedDropped() const;
+
+    /**
+     * \brief   Writes the state and its nested states as SMStateEntry::writeToXml writes the
+     *          state they were frozen from.
+     **/
+    void writeToXml(QXmlStreamWriter& xml) const;
+
+    /**
+     * \brief   Writes a frozen level as SMStateData::writeToXml writes the level it was frozen from.
+     **/
+    static void writeToXml(QXmlStreamWriter& xml, const Level& level);
+
+private:
+    SMSharedState(const SMSharedState& /*src*/) = delete;
+    SMSharedState& operator = (const SMSharedState& /*src*/) = delete;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    const std::shared_ptr<const SMStateEntry>   mState;         //!< The state without its nested states.
+    const Level                                 mNested;        //!< The frozen nested level.
+    const bool                                  mNestedDropped; //!< Whether the painted level is not written.
+};
+
+/**
+ * \class   SMSharedStates
+ * \brief   Freezes the states of a document for the snapshots taken of it, sharing with the last
+ *          frozen tree every state that did not change since. A changed state is copied again,
+ *          without its nested states, and the states above it get new nodes that hold the
+ *          copies they had; the rest of the tree is the one frozen last time. A snapshot of a
+ *          large machine edited in one state costs that state and the path up to it.
+ *
+ *          The states do not report their changes, the document edits do: every change of a
+ *          state, of its transitions or of its operations is passed to elementChanged() before
+ *          the next freeze. The levels are compared at each freeze, so a reordered, grown or
+ *          shrunk level needs no report. An ID the cache cannot place in the states, and
+ *          reset(), make the next freeze copy every state.
+ **/
+class SMSharedStates
+{
+//////////////////////////////////////////////////////////////////////////
+// Constructors / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    SMSharedStates();
+    ~SMSharedStates() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Operations
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   Notes that the state, transition or operation \p id was changed, added or removed.
+     *          The next freeze copies the state it belongs to.
+     **/
+    void elementChanged(uint32_t id);
+
+    /**
+     * \brief   Forgets the frozen states. The next freeze copies every state.
+     **/
+    void reset();
+
+    /**
+     * \brief   Freezes \p states, sharing the states unchanged since the last freeze with it.
+     * \return  The frozen top level.
+     **/
+    SMSharedState::Level freeze(const SMStateData& states);
+
+    //!< The number of states the last freeze copied.
+    inline int getCopiedCount() const;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+    //!< Freezes the states of \p level into \p frozen, by their IDs.
+    SMSharedState::Level freezeLevel(const SMStateData& level, QHash<uint32_t, SMSharedState::Ptr>& frozen);
+
+    //!< Finds the states the changed elements unknown to the last freeze belong to.
+    //!< Returns false if one of them is not in the states.
+    bool placeUnknown(const SMStateData& states);
+
+    //!< Notes the transitions and operations of a frozen state as belonging to it.
+    void addOwners(const SMStateEntry& state);
+
+    //!< Forgets the transitions and operations of a frozen state.
+    void removeOwners(const SMStateEntry& state);
+
+    SMSharedStates(const SMSharedStates& /*src*/) = delete;
+    SMSharedStates& operator = (const SMSharedStates& /*src*/) = delete;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    QHash<uint32_t, SMSharedState::Ptr> mStates;    //!< The states of the last freeze, by ID.
+    QHash<uint32_t, uint32_t>           mOwners;    //!< The state every frozen transition and operation belongs to.
+    QSet<uint32_t>                      mChanged;   //!< The states changed since the last freeze.
+    QSet<uint32_t>                      mUnknown;   //!< The changed elements the last freeze did not have.
+    int                                 mCopied;    //!< The number of states the last freeze copied.
+};
+
+//////////////////////////////////////////////////////////////////////////
+// SMSharedState class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline const SMStateEntry& SMSharedState::getState() const
+{
+    return *mState;
+}
+
+inline const SMSharedState::Level& SMSharedState::getNested() const
+{
+    return mNested;
+}
+
+inline bool SMSharedState::isNestedDropped() const
+{
+    return mNestedDropped;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SMSharedStates class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline int SMSharedStates::getCopiedCount() const
+{
+    return mCopied;
+}
+
+#endif  // LUSAN_DATA_SM_SMSHAREDSTATES_HPP
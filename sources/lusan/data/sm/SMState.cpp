@@ -19,6 +19,7 @@
 
 #include "lusan/data/sm/SMState.hpp"
 #include "lusan/common/XmlSM.hpp"
+#include "lusan/data/sm/StateMachineData.hpp"
 
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
@@ -104,6 +105,11 @@ SMStateEntry::SMStateEntry(uint32_t id, const QString& name, eStateKind kind, El
 }
 
 SMStateEntry::SMStateEntry(const SMStateEntry& src)
+    : SMStateEntry  (src, true)
+{
+}
+
+SMStateEntry::SMStateEntry(const SMStateEntry& src, bool withNested)
     : DocumentElem  (src)
     , mName         (src.mName)
     , mKind         (src.mKind)
@@ -114,7 +120,7 @@ SMStateEntry::SMStateEntry(const SMStateEntry& src)
     , mEntryList    (src.mEntryList)
     , mExitList     (src.mExitList)
     , mTransitions  (src.mTransitions)
-    , mNested       (src.mNested != nullptr ? new SMStateData(*src.mNested) : nullptr)
+    , mNested       ((withNested && (src.mNested != nullptr)) ? new SMStateData(*src.mNested) : nullptr)
 {
     mEntryList.setParent(this);
     mExitList.setParent(this);
@@ -231,6 +237,7 @@ SMStateData* SMStateEntry::getOrCreateNestedStates()
     {
         mNested = new SMStateData(this);
         mSubmachine.clear();
+        SMStateData::treeChanged(*this);
     }
 
     return mNested;
@@ -240,6 +247,7 @@ SMStateData* SMStateEntry::takeNestedStates()
 {
     SMStateData* result = mNested;
     mNested = nullptr;
+    SMStateData::treeChanged(*this);
     return result;
 }
 
@@ -249,6 +257,7 @@ void SMStateEntry::attachNestedStates(SMStateData* nested)
     {
         delete mNested;
         mNested = nested;
+        SMStateData::treeChanged(*this);
     }
 
     if (mNested != nullptr)
@@ -343,15 +352,33 @@ bool SMStateEntry::readFromXml(QXmlStreamReader& xml)
 }
 
 void SMStateEntry::writeToXml(QXmlStreamWriter& xml) const
+{
+    writeToXml(xml, true);
+}
+
+void SMStateEntry::writeToXml(QXmlStreamWriter& xml, bool withNested) const
+{
+    // A half-built painted submachine is dropped, and the attributes that only make sense
+    // with one go with it, so the file cannot reload as a plain state carrying history.
+    const bool droppingNested = (mNested != nullptr) && (mNested->hasRealState() == false);
+    writeStartToXml(xml, droppingNested);
+    // A submachine is persisted only when it owns at least one Normal state. Otherwise the state
+    // serializes as a plain leaf and its layout is dropped with it.
+    if (withNested && (mNested != nullptr) && (droppingNested == false))
+    {
+        mNested->writeToXml(xml);
+    }
+
+    xml.writeEndElement();
+}
+
+void SMStateEntry::writeStartToXml(QXmlStreamWriter& xml, bool nestedDropped) const
 {
     xml.writeStartElement(XmlSM::xmlSMElementState);
     xml.writeAttribute(XmlSM::xmlSMAttributeID, QString::number(getId()));
     xml.writeAttribute(XmlSM::xmlSMAttributeName, mName);
     xml.writeAttribute(XmlSM::xmlSMAttributeKind, SMStateEntry::toString(mKind));
-    // A half-built painted submachine is dropped below, and the attributes that only make sense
-    // with one go with it, so the file cannot reload as a plain state carrying history.
-    const bool droppingNested = (mNested != nullptr) && (mNested->hasRealState() == false);
-    if ((mHistory != eHistory::None) && (droppingNested == false))
+    if ((mHistory != eHistory::None) && (nestedDropped == false))
     {
         xml.writeAttribute(XmlSM::xmlSMAttributeHistory, SMStateEntry::toString(mHistory));
     }
@@ -359,7 +386,7 @@ void SMStateEntry::writeToXml(QXmlStreamWriter& xml) const
     {
         xml.writeAttribute(XmlSM::xmlSMAttributeSubmachine, mSubmachine);
     }
-    if ((mOnFinal.isEmpty() == false) && (droppingNested == false))
+    if ((mOnFinal.isEmpty() == false) && (nestedDropped == false))
     {
         xml.writeAttribute(XmlSM::xmlSMAttributeOnFinal, mOnFinal);
     }
@@ -368,20 +395,28 @@ void SMStateEntry::writeToXml(QXmlStreamWriter& xml) const
     mEntryList.writeToXml(xml, XmlSM::xmlSMElementEntryList);
     mExitList.writeToXml(xml, XmlSM::xmlSMElementExitList);
     mTransitions.writeToXml(xml);
-    // A submachine is persisted only when it owns at least one Normal state. Otherwise the state
-    // serializes as a plain leaf and its layout is dropped with it.
-    if ((mNested != nullptr) && mNested->hasRealState())
-    {
-        mNested->writeToXml(xml);
-    }
-
-    xml.writeEndElement();
 }
 
 //////////////////////////////////////////////////////////////////////////
 // SMStateData implementation
 //////////////////////////////////////////////////////////////////////////
 
+void SMStateData::treeChanged(const ElementBase& element)
+{
+    // Walk the element parent chain to the document root, which keeps the generation.
+    ElementBase* root = const_cast<ElementBase*>(&element);
+    while (root->getParent() != nullptr)
+    {
+        root = root->getParent();
+    }
+
+    StateMachineData* doc = dynamic_cast<StateMachineData*>(root);
+    if (doc != nullptr)
+    {
+        doc->treeChanged();
+    }
+}
+
 SMStateData::SMStateData(ElementBase* parent /*= nullptr*/)
     : TEDataContainer<SMStateEntry*, DocumentElem>(parent)
 {
@@ -571,6 +606,11 @@ bool SMStateData::hasRealState() const
     return false;
 }
 
+void SMStateData::elementsChanged()
+{
+    treeChanged(*this);
+}
+
 void SMStateData::removeAll()
 {
     for (SMStateEntry* state : getElements())
@@ -86,6 +86,11 @@ public:
     SMStateEntry(ElementBase* parent = nullptr);
     SMStateEntry(uint32_t id, const QString& name, eStateKind kind, ElementBase* parent = nullptr);
     SMStateEntry(const SMStateEntry& src);
+
+    /**
+     * \brief   Copies the state, with its nested states only if \p withNested is true.
+     **/
+    SMStateEntry(const SMStateEntry& src, bool withNested);
     SMStateEntry(SMStateEntry&& src) noexcept;
     virtual ~SMStateEntry();
 
@@ -202,6 +207,20 @@ public:
     bool readFromXml(QXmlStreamReader& xml) override;
     void writeToXml(QXmlStreamWriter& xml) const override;
 
+    /**
+     * \brief   Writes the state, with its nested states only if \p withNested is true. Without
+     *          them the state is written as its own element alone, the unit the autosave
+     *          journal records a changed state in.
+     **/
+    void writeToXml(QXmlStreamWriter& xml, bool withNested) const;
+
+    /**
+     * \brief   Writes the state up to its nested states and leaves its element open, for a writer
+     *          that writes the nested states itself. \p nestedDropped leaves out the attributes
+     *          written only with nested states, as for a painted level without a real state.
+     **/
+    void writeStartToXml(QXmlStreamWriter& xml, bool nestedDropped) const;
+
 //////////////////////////////////////////////////////////////////////////
 // Member variables
 //////////////////////////////////////////////////////////////////////////
@@ -231,6 +250,14 @@ private:
  **/
 class SMStateData : public TEDataContainer<SMStateEntry*, DocumentElem>
 {
+public:
+    /**
+     * \brief   Increases the generation of the state tree \p element belongs to, kept by the
+     *          document at the root of the tree. See StateMachineData::getTreeGeneration().
+     *          An element outside a document changes no generation.
+     **/
+    static void treeChanged(const ElementBase& element);
+
 public:
     SMStateData(ElementBase* parent = nullptr);
     SMStateData(const SMStateData& src);
@@ -302,6 +329,9 @@ public:
     bool readFromXml(QXmlStreamReader& xml) override;
     void writeToXml(QXmlStreamWriter& xml) const override;
 
+protected:
+    void elementsChanged() override;
+
 private:
     //!< Deep-copies the states of \p src into this (empty) level, re-parenting them.
     void cloneFrom(const SMStateData& src);
@@ -384,6 +384,11 @@ SMTransitionData& SMTransitionData::operator = (SMTransitionData&& other) noexce
     return *this;
 }
 
+void SMTransitionData::elementsChanged()
+{
+    SMStateData::treeChanged(*this);
+}
+
 void SMTransitionData::cloneFrom(const SMTransitionData& src)
 {
     for (const SMTransitionEntry* entry : src.getElements())
@@ -289,6 +289,9 @@ public:
     bool readFromXml(QXmlStreamReader& xml) override;
     void writeToXml(QXmlStreamWriter& xml) const override;
 
+protected:
+    void elementsChanged() override;
+
 private:
     //!< Deep-copies the transitions of \p src into this (empty) list, re-parenting them.
     void cloneFrom(const SMTransitionData& src);
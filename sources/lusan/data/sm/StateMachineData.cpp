@@ -19,7 +19,9 @@
 
 #include "lusan/data/sm/StateMachineData.hpp"
 
+#include "lusan/data/common/DocXmlWriter.hpp"
 #include "lusan/data/dt/DataTypeImportResolver.hpp"
+#include "lusan/data/sm/SMAutosaveJournal.hpp"
 #include "lusan/common/XmlSM.hpp"
 
 #include <QByteArray>
@@ -33,6 +35,8 @@
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
+#include <algorithm>
+
 namespace
 {
     const VersionNumber& currentFormatVersion()
@@ -343,25 +347,142 @@ namespace
         }
     }
 
-    QByteArray buildXmlBuffer(const StateMachineData& data)
+    //!< Writes the unknown root elements kept at the given place between the known sections.
+    void writeUnknownBucket(QXmlStreamWriter& xml, const QVector<StateMachineData::UnknownElement>& unknownRoot, int bucket)
     {
-        QByteArray buffer;
+        for (const StateMachineData::UnknownElement& unknown : unknownRoot)
         {
-            QXmlStreamWriter xml(&buffer);
-            xml.setAutoFormatting(true);
-            xml.setAutoFormattingIndent(4);
-            xml.writeStartDocument("1.0", true);
-            data.writeToXml(xml);
+            if (unknown.bucket == bucket)
+            {
+                writeRawElementXml(xml, unknown.xml);
+            }
         }
+    }
 
+    //!< The written document with the unknown elements put back, ending with a new line.
+    QByteArray finishXmlBuffer(QByteArray buffer, const QList<DocUnknownElement>& unknown)
+    {
         // An element this build cannot show goes back where it was found. Dropping it would
         // destroy the very document the author has to open elsewhere to recover.
-        buffer = DocUnknownScan::restore(DocElementTable::eDocument::StateMachine, buffer, data.getUnknownElements());
+        buffer = DocUnknownScan::restore(DocElementTable::eDocument::StateMachine, buffer, unknown);
         buffer.append('\n');
         return buffer;
     }
+
+    /**
+     * \brief   Writes what \p write writes into the root of a document whose earlier sections are
+     *          written elsewhere. The writer opens the root again, with one empty section standing
+     *          for them, so it indents exactly as the one writer of the whole document does. The
+     *          stand-in is cut off; it is closed by the first thing written after it.
+     **/
+    template <typename Write>
+    QByteArray writeInsideRoot(Write write)
+    {
+        QByteArray buffer;
+        {
+            QXmlStreamWriter xml(&buffer);
+            xml.setAutoFormatting(true);
+            xml.setAutoFormattingIndent(4);
+            xml.writeStartElement(XmlSM::xmlSMElementStateMachine);
+            xml.writeEmptyElement(XmlSM::xmlSMElementOverview);
+            write(xml);
+        }
+
+        const qsizetype cut = buffer.indexOf("/>");
+        return (cut < 0 ? QByteArray() : buffer.mid(cut + 2));
+    }
+
+    /**
+     * \brief   Appends to \p head the states as \p writeStates writes them, the layout without the
+     *          entries of the painted levels not written, and the unknown root elements around
+     *          them, and closes the root.
+     **/
+    template <typename WriteStates>
+    QByteArray appendTail( QByteArray head
+                         , WriteStates writeStates
+                         , const QSet<uint32_t>& dropOwners
+                         , const QSet<uint32_t>& dropLevels
+                         , const SMLayoutData& layout
+                         , const QVector<StateMachineData::UnknownElement>& unknownRoot)
+    {
+        const QByteArray before = writeInsideRoot([&writeStates, &unknownRoot](QXmlStreamWriter& xml)
+        {
+            writeStates(xml);
+            writeUnknownBucket(xml, unknownRoot, 10);
+        });
+
+        const QByteArray after = writeInsideRoot([&unknownRoot](QXmlStreamWriter& xml)
+        {
+            writeUnknownBucket(xml, unknownRoot, 11);
+            xml.writeEndElement();
+        });
+
+        // The document grows once, to about its size. The layout is written straight to UTF-8,
+        // in the place of the root section the writers above stopped and start at.
+        head.reserve(head.size() + before.size() + layout.estimateXmlSize() + after.size());
+        head.append(before);
+        {
+            DocXmlWriter xml(head, 1);
+            layout.writeToXml(xml, dropOwners, dropLevels);
+        }
+
+        head.append(after);
+        return head;
+    }
+
+    //!< Writes the buffer to a temporary file renamed over \p path, so a failed write leaves the file as it was.
+    bool commitBuffer(const QString& path, const QByteArray& buffer)
+    {
+        QSaveFile file(path);
+        file.setDirectWriteFallback(false);
+        if (file.open(QIODevice::WriteOnly) == false)
+        {
+            return false;
+        }
+
+        if (file.write(buffer) != buffer.size())
+        {
+            file.cancelWriting();
+            return false;
+        }
+
+        return file.commit();
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// StateMachineData::SaveSnapshot implementation
+//////////////////////////////////////////////////////////////////////////
+
+StateMachineData::SaveSnapshot::SaveSnapshot(const StateMachineData& data)
+    : mHead         (data.writeHeadToBuffer())
+    , mStates       (data.mSharedStates.freeze(data.mStates))
+    , mDropOwners   ( )
+    , mDropLevels   ( )
+    , mLayout       (data.mLayout)
+    , mUnknownRoot  (data.mUnknownRootElements)
+    , mUnknown      (data.mUnknownElements)
+{
+    collectDroppedLayout(data.mStates, mDropOwners, mDropLevels);
+    // Nothing of the copy may reach back into the document the editor goes on changing.
+    mLayout.setParent(static_cast<ElementBase*>(nullptr));
+}
+
+QByteArray StateMachineData::SaveSnapshot::writeToBuffer() const
+{
+    const auto writeStates = [this](QXmlStreamWriter& xml) { SMSharedState::writeToXml(xml, mStates); };
+    return finishXmlBuffer(appendTail(mHead, writeStates, mDropOwners, mDropLevels, mLayout, mUnknownRoot), mUnknown);
+}
+
+bool StateMachineData::SaveSnapshot::writeToFile(const QString& filePath) const
+{
+    return filePath.isEmpty() ? false : commitBuffer(filePath, writeToBuffer());
 }
 
+//////////////////////////////////////////////////////////////////////////
+// StateMachineData implementation
+//////////////////////////////////////////////////////////////////////////
+
 StateMachineData::StateMachineData()
     : ElementBase       (MINIMUM_ID, nullptr)
     , mFilePath         ( )
@@ -374,9 +495,15 @@ StateMachineData::StateMachineData()
     , mMethods          (NEMethod::stateMachine(), this)
     , mConstants        (this)
     , mIncludes         (this)
+    , mTreeGeneration   (0u)
     , mStates           (this)
     , mLayout           (this)
     , mOpenSuccess      (false)
+    , mStateIndex       ( )
+    , mTransitionIndex  ( )
+    , mIndexGeneration  (0u)
+    , mIndexBuilt       (false)
+    , mSharedStates     ( )
 {
     // A fresh document gets a valid Overview ID from the document-wide counter, mirroring ServiceInterfaceData.
     mOverview.setId(getNextId());
@@ -455,6 +582,16 @@ bool StateMachineData::writeToAutosaveFile(const QString& autosavePath) const
     return autosavePath.isEmpty() ? false : writeToPathAtomicConst(autosavePath);
 }
 
+QByteArray StateMachineData::writeToBuffer() const
+{
+    return finishXmlBuffer(writeTailToBuffer(writeHeadToBuffer(), mStates, mLayout, mUnknownRootElements), mUnknownElements);
+}
+
+std::shared_ptr<const StateMachineData::SaveSnapshot> StateMachineData::takeSaveSnapshot() const
+{
+    return std::shared_ptr<const SaveSnapshot>(new SaveSnapshot(*this));
+}
+
 QString StateMachineData::autosavePathForDocument(const QString& documentPath)
 {
     return documentPath.isEmpty() ? QString() : documentPath + QStringLiteral(".autosave");
@@ -474,39 +611,38 @@ bool StateMachineData::hasRecoverableAutosave(const QString& documentPath, QStri
         return false;
     }
 
-    QFileInfo documentInfo(documentPath);
-    if ((documentInfo.exists() == false) || (documentInfo.isFile() == false))
+    // The journal is as new as the last edit, the autosave only as new as the last compaction.
+    QDateTime autosaved = autosaveInfo.lastModified();
+    const QFileInfo journalInfo(SMAutosaveJournal::journalPathForDocument(documentPath));
+    if (journalInfo.exists() && (journalInfo.lastModified() > autosaved))
     {
-        return true;
+        autosaved = journalInfo.lastModified();
     }
 
-    return autosaveInfo.lastModified() > documentInfo.lastModified();
+    QFileInfo documentInfo(documentPath);
+    return (documentInfo.exists() == false) || (documentInfo.isFile() == false) || (autosaved > documentInfo.lastModified());
 }
 
-bool StateMachineData::removeAutosave(const QString& documentPath)
+bool StateMachineData::recoverAutosave(const QString& documentPath)
 {
-    const QString path = autosavePathForDocument(documentPath);
-    return path.isEmpty() ? true : (QFile::exists(path) == false || QFile::remove(path));
+    return documentPath.isEmpty() ? false : SMAutosaveJournal::replay(documentPath);
 }
 
-bool StateMachineData::writeToPathAtomic(const QString& path, bool updateFilePath)
+bool StateMachineData::removeAutosave(const QString& documentPath)
 {
-    const QByteArray buffer = buildXmlBuffer(*this);
-
-    QSaveFile file(path);
-    file.setDirectWriteFallback(false);
-    if (file.open(QIODevice::WriteOnly) == false)
+    const QString path = autosavePathForDocument(documentPath);
+    if (path.isEmpty())
     {
-        return false;
+        return true;
     }
 
-    if (file.write(buffer) != buffer.size())
-    {
-        file.cancelWriting();
-        return false;
-    }
+    SMAutosaveJournal::remove(documentPath);
+    return (QFile::exists(path) == false || QFile::remove(path));
+}
 
-    if (file.commit() == false)
+bool StateMachineData::writeToPathAtomic(const QString& path, bool updateFilePath)
+{
+    if (commitBuffer(path, writeToBuffer()) == false)
     {
         return false;
     }
@@ -521,22 +657,7 @@ bool StateMachineData::writeToPathAtomic(const QString& path, bool updateFilePat
 
 bool StateMachineData::writeToPathAtomicConst(const QString& path) const
 {
-    const QByteArray buffer = buildXmlBuffer(*this);
-
-    QSaveFile file(path);
-    file.setDirectWriteFallback(false);
-    if (file.open(QIODevice::WriteOnly) == false)
-    {
-        return false;
-    }
-
-    if (file.write(buffer) != buffer.size())
-    {
-        file.cancelWriting();
-        return false;
-    }
-
-    return file.commit();
+    return commitBuffer(path, writeToBuffer());
 }
 
 bool StateMachineData::readFromXml(QXmlStreamReader& xml)
@@ -545,6 +666,7 @@ bool StateMachineData::readFromXml(QXmlStreamReader& xml)
         return false;
 
     clearUnknownContent();
+    mSharedStates.reset();
     mFormatVersion = currentFormatVersion();
 
     const QXmlStreamAttributes attributes = xml.attributes();
@@ -672,16 +794,12 @@ bool StateMachineData::readFromXml(QXmlStreamReader& xml)
 
 void StateMachineData::writeToXml(QXmlStreamWriter& xml) const
 {
-    auto writeUnknownBucket = [this, &xml](int bucket) {
-        for (const UnknownElement& unknown : mUnknownRootElements)
-        {
-            if (unknown.bucket == bucket)
-            {
-                writeRawElementXml(xml, unknown.xml);
-            }
-        }
-    };
+    writeHeadToXml(xml);
+    writeTailToXml(xml, mStates, mLayout, mUnknownRootElements);
+}
 
+void StateMachineData::writeHeadToXml(QXmlStreamWriter& xml) const
+{
     xml.writeStartElement(XmlSM::xmlSMElementStateMachine);
     xml.writeAttribute(XmlSM::xmlSMAttributeFormatVersion, mFormatVersion.toString());
     for (const UnknownAttribute& attr : mUnknownRootAttributes)
@@ -689,37 +807,64 @@ void StateMachineData::writeToXml(QXmlStreamWriter& xml) const
         xml.writeAttribute(attr.name, attr.value);
     }
 
-    writeUnknownBucket(0);
+    writeUnknownBucket(xml, mUnknownRootElements, 0);
     mOverview.writeToXml(xml);
-    writeUnknownBucket(1);
+    writeUnknownBucket(xml, mUnknownRootElements, 1);
     mDataTypes.writeToXml(xml);
-    writeUnknownBucket(2);
+    writeUnknownBucket(xml, mUnknownRootElements, 2);
     mAttributes.writeToXml(xml);
-    writeUnknownBucket(3);
+    writeUnknownBucket(xml, mUnknownRootElements, 3);
     mEvents.writeToXml(xml);
-    writeUnknownBucket(4);
+    writeUnknownBucket(xml, mUnknownRootElements, 4);
     mTimers.writeToXml(xml);
-    writeUnknownBucket(5);
+    writeUnknownBucket(xml, mUnknownRootElements, 5);
     mMethods.writeToXml(xml);
-    writeUnknownBucket(6);
+    writeUnknownBucket(xml, mUnknownRootElements, 6);
     mConstants.writeToXml(xml);
-    writeUnknownBucket(7);
+    writeUnknownBucket(xml, mUnknownRootElements, 7);
     mIncludes.writeToXml(xml);
-    writeUnknownBucket(8);
-    writeUnknownBucket(9);
-    mStates.writeToXml(xml);
-    writeUnknownBucket(10);
+    writeUnknownBucket(xml, mUnknownRootElements, 8);
+    writeUnknownBucket(xml, mUnknownRootElements, 9);
+}
+
+void StateMachineData::writeTailToXml(QXmlStreamWriter& xml, const SMStateData& states, const SMLayoutData& layout, const QVector<UnknownElement>& unknownRoot)
+{
+    states.writeToXml(xml);
+    writeUnknownBucket(xml, unknownRoot, 10);
     // A not-real submachine is omitted from the StateList above, so its layout goes too. An orphan
     // node would otherwise linger and a future element could inherit it through id reuse.
     QSet<uint32_t> dropOwners;
     QSet<uint32_t> dropLevels;
-    collectDroppedLayout(mStates, dropOwners, dropLevels);
-    mLayout.writeToXml(xml, dropOwners, dropLevels);
-    writeUnknownBucket(11);
+    collectDroppedLayout(states, dropOwners, dropLevels);
+    layout.writeToXml(xml, dropOwners, dropLevels);
+    writeUnknownBucket(xml, unknownRoot, 11);
 
     xml.writeEndElement();
 }
 
+QByteArray StateMachineData::writeHeadToBuffer() const
+{
+    QByteArray buffer;
+    {
+        QXmlStreamWriter xml(&buffer);
+        xml.setAutoFormatting(true);
+        xml.setAutoFormattingIndent(4);
+        xml.writeStartDocument("1.0", true);
+        writeHeadToXml(xml);
+    }
+
+    return buffer;
+}
+
+QByteArray StateMachineData::writeTailToBuffer(QByteArray head, const SMStateData& states, const SMLayoutData& layout, const QVector<UnknownElement>& unknownRoot)
+{
+    QSet<uint32_t> dropOwners;
+    QSet<uint32_t> dropLevels;
+    collectDroppedLayout(states, dropOwners, dropLevels);
+    const auto writeStates = [&states](QXmlStreamWriter& xml) { states.writeToXml(xml); };
+    return appendTail(std::move(head), writeStates, dropOwners, dropLevels, layout, unknownRoot);
+}
+
 void StateMachineData::readLegacyImportList(QXmlStreamReader& xml)
 {
     // An older document keeps its machine imports in their own section. They become ordinary
@@ -869,17 +1014,35 @@ SMStateEntry* StateMachineData::findState(const QString& name) const
 
 SMStateEntry* StateMachineData::findStateById(uint32_t id) const
 {
-    return mStates.findStateByIdRecursive(id);
+    ensureIndex();
+    auto pos = mStateIndex.constFind(id);
+    if ((pos != mStateIndex.constEnd()) && (pos->state->getId() != id))
+    {
+        // The ID was set on the state itself, which the list does not see.
+        rebuildIndex();
+        pos = mStateIndex.constFind(id);
+    }
+
+    return (pos != mStateIndex.constEnd() ? pos->state : nullptr);
 }
 
 SMStateEntry* StateMachineData::findTransitionOwner(uint32_t transitionId) const
 {
-    return mStates.findTransitionOwnerRecursive(transitionId);
+    ensureIndex();
+    SMStateEntry* owner = mTransitionIndex.value(transitionId, nullptr);
+    if ((owner != nullptr) && (owner->getTransitions().findElement(transitionId) == nullptr))
+    {
+        // The ID was set on the transition itself, which the list does not see.
+        rebuildIndex();
+        owner = mTransitionIndex.value(transitionId, nullptr);
+    }
+
+    return owner;
 }
 
 SMTransitionEntry* StateMachineData::findTransitionById(uint32_t transitionId) const
 {
-    SMStateEntry* owner = mStates.findTransitionOwnerRecursive(transitionId);
+    SMStateEntry* owner = findTransitionOwner(transitionId);
     if (owner != nullptr)
     {
         SMTransitionEntry** slot = owner->getTransitions().findElement(transitionId);
@@ -912,7 +1075,7 @@ SMStateData* StateMachineData::findLevel(uint32_t levelId)
         return &mStates;
     }
 
-    SMStateEntry* state = mStates.findStateByIdRecursive(levelId);
+    SMStateEntry* state = findStateById(levelId);
     return (state != nullptr ? state->getNestedStates() : nullptr);
 }
 
@@ -921,41 +1084,42 @@ const SMStateData* StateMachineData::findLevel(uint32_t levelId) const
     return const_cast<StateMachineData*>(this)->findLevel(levelId);
 }
 
-namespace
+uint32_t StateMachineData::getStateLevel(uint32_t stateId) const
 {
-    //!< Depth-first search for the composite-state chain leading to a level owner.
-    bool buildLevelPath(const SMStateData& level, uint32_t levelId, QList<uint32_t>& path)
-    {
-        for (const SMStateEntry* state : level.getElements())
-        {
-            const SMStateData* nested = state->getNestedStates();
-            if (nested == nullptr)
-            {
-                continue;
-            }
-
-            path.append(state->getId());
-            if ((state->getId() == levelId) || buildLevelPath(*nested, levelId, path))
-            {
-                return true;
-            }
-
-            path.removeLast();
-        }
-
-        return false;
-    }
+    return (findStateById(stateId) != nullptr ? mStateIndex.value(stateId).levelId : 0u);
 }
 
 QList<uint32_t> StateMachineData::getLevelPath(uint32_t levelId) const
 {
-    QList<uint32_t> path{ mOverview.getId() };
-    if (levelId == mOverview.getId())
+    const uint32_t rootId = mOverview.getId();
+    if (levelId == rootId)
     {
-        return path;
+        return QList<uint32_t>{ rootId };
+    }
+
+    const SMStateEntry* state = findStateById(levelId);
+    if ((state == nullptr) || (state->getNestedStates() == nullptr))
+    {
+        return QList<uint32_t>{};
+    }
+
+    // Walk up the level owners, then turn the chain root-first.
+    QList<uint32_t> path{ levelId };
+    for (uint32_t ownerId = mStateIndex.value(levelId).levelId; ownerId != rootId; )
+    {
+        const auto pos = mStateIndex.constFind(ownerId);
+        if (pos == mStateIndex.constEnd())
+        {
+            return QList<uint32_t>{};
+        }
+
+        path.append(ownerId);
+        ownerId = pos->levelId;
     }
 
-    return buildLevelPath(mStates, levelId, path) ? path : QList<uint32_t>{};
+    path.append(rootId);
+    std::reverse(path.begin(), path.end());
+    return path;
 }
 
 const QString& StateMachineData::identifierPattern()
@@ -971,5 +1135,40 @@ bool StateMachineData::isValidIdentifier(const QString& name)
 
 int StateMachineData::getStateCount() const
 {
-    return mStates.countStatesRecursive();
+    ensureIndex();
+    return static_cast<int>(mStateIndex.size());
+}
+
+void StateMachineData::rebuildIndex() const
+{
+    mIndexGeneration = mTreeGeneration;
+    mIndexBuilt = true;
+    mStateIndex.clear();
+    mTransitionIndex.clear();
+    indexLevel(mStates, mOverview.getId());
+}
+
+void StateMachineData::indexLevel(const SMStateData& level, uint32_t levelId) const
+{
+    for (SMStateEntry* state : level.getElements())
+    {
+        if (state == nullptr)
+        {
+            continue;
+        }
+
+        mStateIndex.insert(state->getId(), StateIndexEntry{ state, levelId });
+        for (const SMTransitionEntry* transition : state->getTransitions().getElements())
+        {
+            if (transition != nullptr)
+            {
+                mTransitionIndex.insert(transition->getId(), state);
+            }
+        }
+
+        if (state->hasNestedStates())
+        {
+            indexLevel(*state->getNestedStates(), state->getId());
+        }
+    }
 }
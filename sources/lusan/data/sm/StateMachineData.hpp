@@ -36,9 +36,13 @@
 #include "lusan/data/common/IncludeDataSection.hpp"
 #include "lusan/data/sm/SMState.hpp"
 #include "lusan/data/sm/SMLayoutData.hpp"
+#include "lusan/data/sm/SMSharedStates.hpp"
 #include "lusan/model/common/DocUnknownScan.hpp"
 
+#include <QByteArray>
+#include <QHash>
 #include <QList>
+#include <QSet>
 #include <QString>
 #include <QVector>
 #include <memory>
@@ -50,6 +54,12 @@
  *          ElementBase chain and therefore owns the document-wide, monotonically
  *          increasing ID counter. It carries the editor-owned
  *          `FormatVersion` separately from the user's `Overview@Version`.
+ *
+ *          The ID lookups of states, transitions and levels go through a document-wide
+ *          index: every state by ID with the owner of its level, and every transition by
+ *          ID with its source state. The state and transition lists report every change,
+ *          so the index is rebuilt with one walk of the tree on the first lookup after an
+ *          edit, whether the edit came from an undo command or from the reader.
  **/
 class StateMachineData  : protected QObject
                         , public    ElementBase
@@ -109,6 +119,41 @@ public:
         QString xml;
     };
 
+    /**
+     * \class   SaveSnapshot
+     * \brief   The document frozen for a write on another thread, so the editor goes on while a
+     *          large machine is written. The sections before the states are small and written when
+     *          the snapshot is taken. The states are frozen apart from the document, each one
+     *          shared with the snapshot before it unless an edit reported a change to it, and the
+     *          layout is copied with its lists shared until either side changes them. The write
+     *          gives the bytes writeToFile would have given when the snapshot was taken.
+     **/
+    class SaveSnapshot
+    {
+        friend class StateMachineData;
+
+    public:
+        //!< The document exactly as writeToFile writes it. Called on any thread.
+        QByteArray writeToBuffer() const;
+
+        //!< Writes the document to \p filePath the way writeToFile does. Called on any thread.
+        bool writeToFile(const QString& filePath) const;
+
+    private:
+        explicit SaveSnapshot(const StateMachineData& data);
+        SaveSnapshot(const SaveSnapshot& /*src*/) = delete;
+        SaveSnapshot& operator = (const SaveSnapshot& /*src*/) = delete;
+
+    private:
+        QByteArray                  mHead;          //!< The document up to the states, already written.
+        SMSharedState::Level        mStates;        //!< The states, frozen apart from the document.
+        QSet<uint32_t>              mDropOwners;    //!< The layout owners of the painted levels not written.
+        QSet<uint32_t>              mDropLevels;    //!< The composite states whose painted levels are not written.
+        SMLayoutData                mLayout;        //!< The layout, copied and detached from the document.
+        QVector<UnknownElement>     mUnknownRoot;   //!< The unknown root elements, the ones after the states among them.
+        QList<DocUnknownElement>    mUnknown;       //!< The unknown elements put back into the written document.
+    };
+
 private:
     static constexpr const uint32_t     MINIMUM_ID          { 50u };    //!< Reserved-low-ID floor (as in .siml).
 
@@ -218,6 +263,43 @@ public:
      **/
     bool writeToAutosaveFile(const QString& autosavePath) const;
 
+    /**
+     * \brief   The whole `.fsml` document exactly as writeToFile writes it.
+     **/
+    QByteArray writeToBuffer() const;
+
+    /**
+     * \brief   Freezes the document for a write on another thread. Taken on the thread that edits
+     *          the document; the document may change as soon as it returns.
+     **/
+    std::shared_ptr<const SaveSnapshot> takeSaveSnapshot() const;
+
+    /**
+     * \brief   Notes that the state, transition or operation \p id was changed, added or removed.
+     *          The next save snapshot copies the state it belongs to; the states no edit reported
+     *          are shared with the snapshot taken before. Every edit of the states reports here.
+     **/
+    inline void stateElementChanged(uint32_t id);
+
+    /**
+     * \brief   Makes the next save snapshot copy every state, for an edit that cannot name them.
+     **/
+    inline void unshareStates();
+
+    /**
+     * \brief   The generation of the state tree of the document. It increases on every change of
+     *          a state list or a transition list of the document and whenever one of its states
+     *          gains or loses its nested level. The ID index is current as long as the generation
+     *          it was built at is.
+     **/
+    inline uint32_t getTreeGeneration() const;
+
+    /**
+     * \brief   Increases the generation of the state tree. The state and transition lists call it
+     *          through the root of their tree, see SMStateData::treeChanged().
+     **/
+    inline void treeChanged();
+
     /**
      * \brief   Returns the autosave sibling path for a document path.
      **/
@@ -226,11 +308,20 @@ public:
     /**
      * \brief   True if a recoverable autosave exists for \p documentPath.
      *          Recovery is offered when autosave exists and is newer than the document.
+     *          Only looks at the files; the journal is folded in by recoverAutosave().
      **/
     static bool hasRecoverableAutosave(const QString& documentPath, QString* autosavePath = nullptr);
 
     /**
-     * \brief   Removes the autosave sibling file if it exists.
+     * \brief   Folds the edits journaled since the autosave of \p documentPath was written into
+     *          the autosave file, so the autosave file is the document to recover. Called once
+     *          the user has chosen to recover it.
+     * \return  True if the autosave file holds the last committed autosave.
+     **/
+    static bool recoverAutosave(const QString& documentPath);
+
+    /**
+     * \brief   Removes the autosave sibling file and its journal if they exist.
      * \return  True if no autosave exists or it was removed.
      **/
     static bool removeAutosave(const QString& documentPath);
@@ -270,13 +361,15 @@ public:
     SMStateEntry* findState(const QString& name) const;
 
     /**
-     * \brief   Finds a state by element ID anywhere in the document.
+     * \brief   Finds a state by element ID anywhere in the document. Answered by the
+     *          document-wide ID index, so the cost does not depend on the document size.
      **/
     SMStateEntry* findStateById(uint32_t id) const;
 
     /**
      * \brief   Finds the state that owns the transition with the given ID (a transition is
      *          nested inside its source state), anywhere in the document; nullptr if none.
+     *          Answered by the document-wide ID index.
      **/
     SMStateEntry* findTransitionOwner(uint32_t transitionId) const;
 
@@ -301,6 +394,13 @@ public:
     SMStateData* findLevel(uint32_t levelId);
     const SMStateData* findLevel(uint32_t levelId) const;
 
+    /**
+     * \brief   Returns the owner ID of the level the state with the given ID sits on: the
+     *          Overview ID for the root level, otherwise the ID of the enclosing composite
+     *          state; 0 when the ID names no state.
+     **/
+    uint32_t getStateLevel(uint32_t stateId) const;
+
     /**
      * \brief   Returns the level owner IDs from the root level down to the given level,
      *          both inclusive; the root level is the Overview ID, every deeper entry is
@@ -333,6 +433,18 @@ private:
     bool writeToPathAtomic(const QString& path, bool updateFilePath);
     
     bool writeToPathAtomicConst(const QString& path) const;
+
+    //!< Writes the root element and the sections before the states, leaving the root open.
+    void writeHeadToXml(QXmlStreamWriter& xml) const;
+
+    //!< Writes the states, the layout and the unknown root elements around them, and closes the root.
+    static void writeTailToXml(QXmlStreamWriter& xml, const SMStateData& states, const SMLayoutData& layout, const QVector<UnknownElement>& unknownRoot);
+
+    //!< The document as writeToFile writes it up to the states, the root left open.
+    QByteArray writeHeadToBuffer() const;
+
+    //!< Appends to \p head what writeTailToXml writes, the layout written straight to UTF-8.
+    static QByteArray writeTailToBuffer(QByteArray head, const SMStateData& states, const SMLayoutData& layout, const QVector<UnknownElement>& unknownRoot);
     
     bool migrateFromVersion(const VersionNumber& sourceVersion);
     
@@ -345,6 +457,15 @@ private:
 
     void clearUnknownContent();
 
+    //!< Rebuilds the document-wide ID index if a state tree changed since it was built.
+    inline void ensureIndex() const;
+
+    //!< Rebuilds the document-wide ID index with one walk of the state tree.
+    void rebuildIndex() const;
+
+    //!< Adds the states and transitions of a level and of its nested levels to the index.
+    void indexLevel(const SMStateData& level, uint32_t levelId) const;
+
 //////////////////////////////////////////////////////////////////////////
 // Member variables
 //////////////////////////////////////////////////////////////////////////
@@ -360,12 +481,26 @@ private:
     MethodDataSection    mMethods;       //!< The MethodList section.
     ConstantDataSection  mConstants;     //!< The ConstantList section.
     IncludeDataSection mIncludes;   //!< The IncludeList section, machine imports included.
+    uint32_t        mTreeGeneration; //!< The generation of the state tree, declared before the states that change it.
     SMStateData     mStates;        //!< The root StateList (level 0).
     SMLayoutData    mLayout;        //!< The Layout section.
     QVector<UnknownAttribute> mUnknownRootAttributes; //!< Unknown root attributes preserved on round-trip.
     QVector<UnknownElement>   mUnknownRootElements;   //!< Unknown root elements preserved on round-trip.
     QList<DocUnknownElement>  mUnknownElements;       //!< Every element the format does not define, with its line and text.
     bool            mOpenSuccess;   //!< Whether the document opened successfully.
+
+    //!< One state of the document-wide ID index.
+    struct StateIndexEntry
+    {
+        SMStateEntry*   state   { nullptr };    //!< The state.
+        uint32_t        levelId { 0u };         //!< The owner of its level: the Overview ID or a composite state ID.
+    };
+
+    mutable QHash<uint32_t, StateIndexEntry>    mStateIndex;        //!< Every state by ID.
+    mutable QHash<uint32_t, SMStateEntry*>      mTransitionIndex;   //!< The source state of every transition by ID.
+    mutable uint32_t                            mIndexGeneration;   //!< The state tree generation the index was built at.
+    mutable bool                                mIndexBuilt;        //!< Whether the index was built at all.
+    mutable SMSharedStates                      mSharedStates;      //!< The states frozen by the last save snapshot.
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -402,6 +537,34 @@ inline void StateMachineData::setOpenSucceeded(bool succeeded)
     mOpenSuccess = succeeded;
 }
 
+inline void StateMachineData::stateElementChanged(uint32_t id)
+{
+    mSharedStates.elementChanged(id);
+}
+
+inline void StateMachineData::unshareStates()
+{
+    mSharedStates.reset();
+}
+
+inline uint32_t StateMachineData::getTreeGeneration() const
+{
+    return mTreeGeneration;
+}
+
+inline void StateMachineData::treeChanged()
+{
+    ++ mTreeGeneration;
+}
+
+inline void StateMachineData::ensureIndex() const
+{
+    if ((mIndexBuilt == false) || (mIndexGeneration != mTreeGeneration))
+    {
+        rebuildIndex();
+    }
+}
+
 inline const QList<DocUnknownElement>& StateMachineData::getUnknownElements() const
 {
     return mUnknownElements;
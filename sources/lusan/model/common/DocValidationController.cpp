@@ -19,6 +19,7 @@
 
 #include "lusan/model/common/DocValidationController.hpp"
 
+#include "lusan/data/common/DocFileWatcher.hpp"
 #include "lusan/model/common/DocModelNotifier.hpp"
 #include "lusan/model/common/IEDocumentModel.hpp"
 
@@ -28,6 +29,7 @@ DocValidationController::DocValidationController(IEDocumentModel& document, Func
     , mChecker  (std::move(checker))
     , mTimer    ( )
     , mIssues   ( )
+    , mStatCount( 0u )
 {
     mTimer.setSingleShot(true);
     mTimer.setInterval(DEFAULT_DEBOUNCE_MS);
@@ -46,7 +48,10 @@ DocValidationController::DocValidationController(IEDocumentModel& document, Func
 void DocValidationController::validateNow()
 {
     mTimer.stop();
+    // Every import is looked up on every run; with the files watched, none of that reaches the disk.
+    const quint64 stats = DocFileWatcher::getStatCount();
     mIssues = (mChecker ? mChecker() : QList<DocIssue>());
+    mStatCount = DocFileWatcher::getStatCount() - stats;
     emit validationUpdated(mIssues);
 }
 
@@ -79,6 +79,9 @@ public:
     //!< The findings of the most recent run (empty until the first run completes).
     inline const QList<DocIssue>& issues() const;
 
+    //!< How many times the most recent run checked a file on disk (see DocFileWatcher::countStat).
+    inline quint64 getLastStatCount() const;
+
     //!< Runs the engine synchronously now and publishes the result (tests and the generator path).
     void validateNow();
 
@@ -107,6 +110,7 @@ private:
     FuncValidate        mChecker;   //!< The engine run.
     QTimer              mTimer;     //!< The single-shot debounce timer.
     QList<DocIssue>     mIssues;    //!< The latest findings.
+    quint64             mStatCount; //!< The file checks of the latest run.
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -123,4 +127,9 @@ inline const QList<DocIssue>& DocValidationController::issues() const
     return mIssues;
 }
 
+inline quint64 DocValidationController::getLastStatCount() const
+{
+    return mStatCount;
+}
+
 #endif  // LUSAN_MODEL_COMMON_DOCVALIDATIONCONTROLLER_HPP
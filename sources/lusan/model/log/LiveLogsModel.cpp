@@ -18,6 +18,7 @@
  ************************************************************************/
 
 #include "lusan/model/log/LiveLogsModel.hpp"
+#include "lusan/data/log/LogIngestTelemetry.hpp"
 #include "lusan/data/log/LogObserver.hpp"
 
 #include "lusan/app/LusanApplication.hpp"
@@ -157,6 +158,7 @@ void LiveLogsModel::_setupSignals(bool doSetup)
             return;
 
         mSignalsSetup = true;
+        LogIngestTelemetry::getInstance().reset();
         mConLogs                = connect(log, &LogObserver::signalLogMessage            , this, &LiveLogsModel::slotLogMessage);
         mConInstancesDisconnect = connect(log, &LogObserver::signalLogInstancesDisconnect, this, &LiveLogsModel::slotLogInstancesDisconnect);
         
@@ -194,18 +196,26 @@ void LiveLogsModel::_setupSignals(bool doSetup)
 void LiveLogsModel::slotLogMessage(const areg::SharedBuffer& logMessage)
 {
     if (logMessage.is_empty())
+    {
+        // Counted to keep the telemetry of the received and shown messages in step.
+        LogIngestTelemetry::getInstance().messageShown(mLogCount);
         return;
+    }
 
     if (static_cast<uint32_t>(mLogs.size()) >= LiveLogsModel::LIVE_LOG_CAPACITY)
     {
         _evictOldest(LiveLogsModel::LIVE_LOG_EVICT_BLOCK);
     }
 
+    countTraffic(logMessage);
+
     const int row{ static_cast<int>(mLogs.size()) };
     beginInsertRows(QModelIndex(), row, row);
     mLogs.push_back(logMessage);
     mLogCount = static_cast<uint32_t>(mLogs.size());
     endInsertRows();
+
+    LogIngestTelemetry::getInstance().messageShown(mLogCount);
 }
 
 void LiveLogsModel::_evictOldest(uint32_t count)
@@ -222,6 +232,7 @@ void LiveLogsModel::_evictOldest(uint32_t count)
     mLogs.erase(mLogs.begin(), mLogs.begin() + count);
     mLogCount = static_cast<uint32_t>(mLogs.size());
     endRemoveRows();
+    LogIngestTelemetry::getInstance().rowsEvicted(count, mLogCount);
 
     if (selectedRow >= 0)
     {
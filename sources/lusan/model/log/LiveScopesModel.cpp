@@ -30,7 +30,13 @@
 
 LiveScopesModel::LiveScopesModel(QObject* parent)
     : LoggingScopesModelBase( parent )
+    , mPrioChanges  ( )
+    , mPrioScopes   ( )
+    , mPrioTimer    ( )
 {
+    mPrioTimer.setSingleShot(true);
+    mPrioTimer.setInterval(LiveScopesModel::PRIO_REQUEST_DELAY_MS);
+    connect(&mPrioTimer, &QTimer::timeout, this, [this]() { _sendPriorityRequests(); });
 }
 
 LiveScopesModel::~LiveScopesModel()
@@ -39,6 +45,12 @@ LiveScopesModel::~LiveScopesModel()
 
 void LiveScopesModel::setLoggingModel(LoggingModelBase* model)
 {
+    if (model != mLoggingModel)
+    {
+        _sendPriorityRequests();
+        mPrioChanges.clear();
+    }
+
     LoggingScopesModelBase::setLoggingModel(model);
 }
 
@@ -52,21 +64,10 @@ bool LiveScopesModel::setLogPriority(const QModelIndex& index, uint32_t prio)
     
     if (node->getPriority() != prio)
     {
+        mPrioChanges.beginChange(*node);
         node->setPriority(prio);
-        root->resetPrioritiesRecursive(true);
-        root->refreshPrioritiesRecursive();
-        
-        ScopeInfo scope;
-        scope.lsId = 0;
-        scope.lsPrio = node->getPriority();
-        QString path = node->makePath();
-        if (node->isLeaf() == false)
-        {
-            path += NELusanCommon::SCOPE_ALL;
-        }
-        
-        areg::copy_string(scope.lsName, LENGTH_SCOPE, path.toStdString().c_str());
-        result = LogObserver::requestChangeScopePrio(static_cast<ScopeRoot *>(root)->getRootId(), &scope, 1);
+        notifyPriorityChanged(std::vector<ScopeNodeBase*>{ node });
+        result = _queuePriorityRequest();
     }
     else
     {
@@ -86,11 +87,10 @@ bool LiveScopesModel::addLogPriority(const QModelIndex& index, uint32_t prio)
     
     if (node->canAddPriority(prio))
     {
-        node->addPriority(prio);        
-        root->resetPrioritiesRecursive(true);
-        root->refreshPrioritiesRecursive();
-        
-        result = _requestNodePriority(static_cast<const ScopeRoot &>(*root), *node);
+        mPrioChanges.beginChange(*node);
+        node->addPriority(prio);
+        notifyPriorityChanged(std::vector<ScopeNodeBase*>{ node });
+        result = _queuePriorityRequest();
     }
     else
     {
@@ -111,10 +111,10 @@ bool LiveScopesModel::removLogPriority(const QModelIndex& index, uint32_t prio)
     // if ((node->getPriority() & static_cast<uint32_t>(prio)) != 0)
     if (node->canRemovePriority(prio))
     {
+        mPrioChanges.beginChange(*node);
         node->removePriority(prio);
-        root->resetPrioritiesRecursive(true);
-        root->refreshPrioritiesRecursive();
-        result = _requestNodePriority(static_cast<const ScopeRoot &>(*root), *node);
+        notifyPriorityChanged(std::vector<ScopeNodeBase*>{ node });
+        result = _queuePriorityRequest();
     }
     else
     {
@@ -126,6 +126,7 @@ bool LiveScopesModel::removLogPriority(const QModelIndex& index, uint32_t prio)
 
 bool LiveScopesModel::saveLogScopePriority(const QModelIndex& target /*= QModelIndex()*/) const
 {
+    _sendPriorityRequests();
     if (target.isValid())
     {
         ScopeNodeBase* node = static_cast<ScopeNodeBase *>(target.internalPointer());
@@ -156,50 +157,40 @@ bool LiveScopesModel::slotInstancesAvailable(const std::vector<areg::ConnectedIn
     }
 }
 
-bool LiveScopesModel::_requestNodePriority(const ScopeRoot& root, const ScopeNodeBase& node)
+void LiveScopesModel::slotInstancesUnavailable(const std::vector<ITEM_ID>& instIds)
 {
-    bool result{false};
-    QList<ScopeNodeBase*> nodes;
-    int count = node.extractChildNodesWithPriority(nodes);
-    count += count == 0 ? 1 : 0;
-    ScopeInfo* scopes = new ScopeInfo[count];
-    if (scopes != nullptr)
+    for (ITEM_ID instId : instIds)
     {
-        int pos = 0;
-        if (nodes.isEmpty())
-        {
-            // Q_ASSERT(node.hasPrioNotset());
-            ScopeInfo& scope = scopes[0];
-            scope.lsId = 0;
-            scope.lsPrio = node.getPriority();
-            QString path = node.makePath();
-            if (node.isLeaf() == false)
-            {
-                path += NELusanCommon::SCOPE_ALL;
-            }
-
-            areg::mem_copy(scope.lsName, LENGTH_SCOPE, path.toStdString().c_str(), path.length() + 1);
-            ++pos;
-        }
+        mPrioChanges.discard(instId);
+    }
+
+    LoggingScopesModelBase::slotInstancesUnavailable(instIds);
+}
 
-        for (; pos < count; ++pos)
+bool LiveScopesModel::_queuePriorityRequest()
+{
+    // The timer is not restarted, the changes are sent at latest after the delay since the first change.
+    if (mPrioTimer.isActive() == false)
+    {
+        mPrioTimer.start();
+    }
+
+    return LogObserver::isConnected();
+}
+
+void LiveScopesModel::_sendPriorityRequests() const
+{
+    mPrioTimer.stop();
+    if ((mLoggingModel == nullptr) || mPrioChanges.isEmpty())
+        return;
+
+    const LoggingModelBase::RootList& roots = mLoggingModel->getRootList();
+    for (const ScopeRoot* root : roots)
+    {
+        Q_ASSERT(root != nullptr);
+        if (mPrioChanges.hasChanges(root->getRootId()) && (mPrioChanges.commit(*root, mPrioScopes) != 0u))
         {
-            ScopeNodeBase* nodeBase = nodes[pos];
-            ScopeInfo& scope = scopes[pos];
-            scope.lsId = 0;
-            scope.lsPrio = nodeBase->getPriority();
-            QString path = nodeBase->makePath();
-            if (nodeBase->isLeaf() == false)
-            {
-                path += NELusanCommon::SCOPE_ALL;
-            }
-
-            areg::mem_copy(scope.lsName, LENGTH_SCOPE, path.toStdString().c_str(), path.length() + 1);
+            LogObserver::requestChangeScopePrio(root->getRootId(), mPrioScopes.data(), static_cast<uint32_t>(mPrioScopes.size()));
         }
-
-        result = LogObserver::requestChangeScopePrio(root.getRootId(), scopes, count);
-        delete[] scopes;
     }
-    
-    return result;
 }
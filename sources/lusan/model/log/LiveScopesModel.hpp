@@ -23,9 +23,11 @@
  * Includes
  ************************************************************************/
 #include "lusan/model/log/LoggingScopesModelBase.hpp"
+#include "lusan/data/log/ScopePrioTransaction.hpp"
 
 #include <QList>
 #include <QMap>
+#include <QTimer>
 
 #include "areg/component/ServiceDefs.hpp"
 #include "areg/logging/areg_log.h"
@@ -40,11 +42,21 @@ class LiveLogsModel;
 
 /**
  * \brief   Log scope model to visualize scopes in the scope navigation windows.
+ *          The changes of the log priorities are collected for a short time and sent
+ *          to the target instances in one request per instance, containing only the
+ *          scopes that changed since the last request.
  **/
 class LiveScopesModel : public LoggingScopesModelBase
 {
     Q_OBJECT
 
+//////////////////////////////////////////////////////////////////////////
+// Internal constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The time in milliseconds to collect the changes of the log priorities before sending the requests.
+    static constexpr int    PRIO_REQUEST_DELAY_MS   { 50 };
+
 //////////////////////////////////////////////////////////////////////////
 // Constructor, operations
 //////////////////////////////////////////////////////////////////////////
@@ -77,7 +89,7 @@ public:
      *          If the specified node has scope priority, it will not be changed.
      * \param   index   The index of the log scope to change priority.
      * \param   prio    The new priority to set for the log scope on target.
-     * \return  True if succeeded to sent the request to update log priority on target module.
+     * \return  True if the request to update log priority on target module is queued to send.
      **/
     bool setLogPriority(const QModelIndex& index, uint32_t prio) override;
 
@@ -87,7 +99,7 @@ public:
      *          If the log scope already has this priority, it will not be added again.
      * \param   index   The index of the log scope to add priority.
      * \param   prio    The log priority to add to the log scope.
-     * \return  True if succeeded to sent the request to update log priority on target module.
+     * \return  True if the request to update log priority on target module is queued to send.
      **/
     bool addLogPriority(const QModelIndex& index, uint32_t prio) override;
 
@@ -97,13 +109,14 @@ public:
      *          If the log scope does not have this priority, it will not be removed.
      * \param   index   The index of the log scope to remove priority.
      * \param   prio    The log priority to remove from the log scope.
-     * \return  True if succeeded to sent the request to update log priority on target module.
+     * \return  True if the request to update log priority on target module is queued to send.
      **/
     bool removLogPriority(const QModelIndex& index, uint32_t prio) override;
 
     /**
      * \brief   Saves the log scope priority for the given target index.
      *          If the target index is invalid, it saves the log scope priority for all instances.
+     *          The not sent changes of the log priorities are sent before the request to save.
      * \param   target  The target index to save log scope priority. If invalid, saves for root index.
      * \return  True if succeeded to save log scope priority, false otherwise.
      **/
@@ -120,16 +133,35 @@ protected:
      * \return  Returns true if the instance was added to the root element.
      **/
     bool slotInstancesAvailable(const std::vector<areg::ConnectedInstance> & instances) override;
+
+    /**
+     * \brief   Signal emitted when one or more instances are disconnected.
+     *          The not sent changes of the log priorities of the instances are dropped.
+     * \param   instIds     The list of IDs of the disconnected instances.
+     **/
+    void slotInstancesUnavailable(const std::vector<ITEM_ID>& instIds) override;
     
 private:
 
     /**
-     * \brief   Requests the log priority for the given node.
-     * \param   root    The root of the scope.
-     * \param   node    The node to request priority.
-     * \return  True if succeeded to request the log priority, false otherwise.
+     * \brief   Starts the timer to send the collected changes of the log priorities.
+     * \return  True if the log observer is connected and the request can be sent.
      **/
-    bool _requestNodePriority(const ScopeRoot& root, const ScopeNodeBase& node);
+    bool _queuePriorityRequest();
+
+    /**
+     * \brief   Sends the collected changes of the log priorities, one request per instance.
+     **/
+    void _sendPriorityRequests() const;
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    // The members are mutable, because the not sent changes are sent before saving the priorities.
+    mutable ScopePrioTransaction                mPrioChanges;   //!< The changes of the log priorities not sent yet.
+    mutable ScopePrioTransaction::ListScopes    mPrioScopes;    //!< The scopes of the request, reused by every request.
+    mutable QTimer                              mPrioTimer;     //!< The timer to send the collected changes of the log priorities.
 };
 
 #endif  // LUSAN_MODEL_LOG_LIVESCOPESMODEL_HPP
@@ -0,0 +1,185 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/model/log/LogExportModel.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the export of the filtered log messages.
+ *
+ ************************************************************************/
+
+#include "lusan/model/log/LogExportModel.hpp"
+
+#include "aregextend/db/LogSqliteDatabase.hpp"
+#include "aregextend/db/SqliteStatement.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+LogExportModel::LogExportModel(QObject* parent)
+    : QObject               (parent)
+    , areg::ThreadConsumer  ( )
+    , mRowFilter    (nullptr)
+    , mFilterSteps  ( )
+    , mDatabasePath ( )
+    , mFilePath     ( )
+    , mFormat       (LogExportWriter::eFormat::FormatInvalid)
+    , mTimeBegin    (0u)
+    , mTimeEnd      (0u)
+    , mExporting    (false)
+    , mGeneration   (0u)
+    , mWorker       (static_cast<areg::ThreadConsumer &>(self()), "_LogExportThread_")
+    , mQuitThread   (false)
+{
+}
+
+LogExportModel::~LogExportModel()
+{
+    // The worker thread works on the members of this object, stop it first.
+    _quitThread();
+}
+
+bool LogExportModel::startExport(const LoggingModelBase& logModel, const LogViewerFilter* filter, const QString& filePath, TIME64 timeBegin /*= 0u*/, TIME64 timeEnd /*= 0u*/)
+{
+    if (mExporting)
+        return false;
+
+    const QString dbPath{ logModel.getDatabasePath() };
+    const LogExportWriter::eFormat format{ LogExportWriter::getFormat(filePath) };
+    if (dbPath.isEmpty() || (format == LogExportWriter::eFormat::FormatInvalid) || (filePath == dbPath))
+        return false;
+
+    _quitThread();
+    ++ mGeneration;
+    if (filter != nullptr)
+    {
+        mRowFilter.copyFilters(*filter);
+    }
+    else
+    {
+        mRowFilter.copyFilters(LogViewerFilter(nullptr));
+    }
+
+    mFilterSteps    = logModel.getFilterSteps();
+    mDatabasePath   = dbPath.toStdString();
+    mFilePath       = filePath;
+    mFormat         = format;
+    mTimeBegin      = timeBegin;
+    mTimeEnd        = timeEnd;
+    mExporting      = true;
+    mWorker.start(areg::DO_NOT_WAIT);
+    return true;
+}
+
+void LogExportModel::cancelExport()
+{
+    if (mExporting == false)
+        return;
+
+    _quitThread();
+    ++ mGeneration;
+    mExporting = false;
+    emit signalExportFinished(false, 0u);
+}
+
+void LogExportModel::on_run()
+{
+    // Runs in the worker thread. It reads the database with its own connection, so that
+    // neither the filters nor the reading thread of the logging model are affected.
+    const uint32_t generation{ mGeneration };
+    bool succeeded{ false };
+    quint64 exported{ 0u };
+
+    areg::ext::LogSqliteDatabase database;
+    std::unique_ptr<LogExportWriter> writer{ LogExportWriter::create(mFormat) };
+    if ((writer != nullptr) && database.connect(mDatabasePath, true) && LoggingModelBase::setupFilters(database, mFilterSteps))
+    {
+        bool canceled{ false };
+        bool failed{ writer->open(mFilePath, database) == false };
+        const bool filtered{ mRowFilter.hasFilters() };
+
+        areg::ext::SqliteStatement statement(database.database());
+        const quint64 total{ database.setup_statement_read_filter_logs(statement, areg::TARGET_ALL) };
+
+        // The batch is allocated once, the buffers of the entries are reused for every chunk.
+        std::vector<areg::SharedBuffer> batch(static_cast<size_t>(LogExportModel::EXPORT_CHUNK_SIZE));
+        quint64 scanned{ 0u };
+        int32_t readCount{ LogExportModel::EXPORT_CHUNK_SIZE };
+        while ((failed == false) && (readCount == LogExportModel::EXPORT_CHUNK_SIZE))
+        {
+            if (_isCanceled())
+            {
+                canceled = true;
+                break;
+            }
+
+            readCount = areg::ext::LogSqliteDatabase::fill_log_messages(batch, statement, 0, LogExportModel::EXPORT_CHUNK_SIZE);
+            for (int32_t i = 0; (failed == false) && (i < readCount); ++i)
+            {
+                const areg::LogEntry& entry{ *reinterpret_cast<const areg::LogEntry*>(batch[static_cast<uint32_t>(i)].buffer()) };
+                if ((mTimeBegin != 0u) && (entry.logTimestamp < mTimeBegin))
+                    continue;
+                if ((mTimeEnd != 0u) && (entry.logTimestamp > mTimeEnd))
+                    continue;
+                if (filtered && (mRowFilter.acceptsLogEntry(&entry) == false))
+                    continue;
+
+                // Only the entries the writer took are counted.
+                failed = (writer->write(entry) == false);
+                exported += failed ? 0u : 1u;
+            }
+
+            failed = failed || (writer->flush() == false);
+            scanned += static_cast<quint64>(std::max(readCount, 0));
+            QMetaObject::invokeMethod(this
+                                     , [this, generation, scanned, total, exported]()
+                                       {
+                                           _onProgress(generation, scanned, total, exported);
+                                       }
+                                     , Qt::ConnectionType::QueuedConnection);
+        }
+
+        succeeded = writer->close((canceled == false) && (failed == false));
+        if (canceled)
+        {
+            database.disconnect();
+            return;
+        }
+    }
+
+    writer.reset();
+    database.disconnect();
+    QMetaObject::invokeMethod(this
+                             , [this, generation, succeeded, exported]()
+                               {
+                                   _onFinished(generation, succeeded, exported);
+                               }
+                             , Qt::ConnectionType::QueuedConnection);
+}
+
+void LogExportModel::_onProgress(uint32_t generation, quint64 scanned, quint64 total, quint64 exported)
+{
+    if (generation == mGeneration)
+    {
+        emit signalExportProgress(scanned, total, exported);
+    }
+}
+
+void LogExportModel::_onFinished(uint32_t generation, bool succeeded, quint64 exported)
+{
+    if (generation != mGeneration)
+        return;
+
+    mExporting = false;
+    emit signalExportFinished(succeeded, exported);
+}
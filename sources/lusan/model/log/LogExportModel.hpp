@@ -0,0 +1,211 @@
+#ifndef LUSAN_MODEL_LOG_LOGEXPORTMODEL_HPP
+#define LUSAN_MODEL_LOG_LOGEXPORTMODEL_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/model/log/LogExportModel.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the export of the filtered log messages.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QObject>
+#include <QString>
+
+#include "areg/base/SyncPrimitives.hpp"
+#include "areg/base/Thread.hpp"
+#include "areg/base/ThreadConsumer.hpp"
+#include "lusan/data/log/LogExportWriter.hpp"
+#include "lusan/model/log/LoggingModelBase.hpp"
+#include "lusan/model/log/LogViewerFilter.hpp"
+
+#include <string>
+
+/**
+ * \brief   Exports the log messages of the logging model, which pass the filters of the log viewer,
+ *          to the log database, CSV or NDJSON file. The export takes the snapshot of the scope
+ *          filters of the log database, the combo and text filters of the view and the time range,
+ *          so that changing the filters during the export does not affect it. The worker thread
+ *          reads the log database with its own connection by chunks and streams the matching
+ *          messages to the writer, which commits them by batches. The used memory does not
+ *          depend on the number of exported messages.
+ **/
+class LogExportModel : public QObject
+                     , protected areg::ThreadConsumer
+{
+    Q_OBJECT
+
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The number of log messages the worker thread reads from the database in one step.
+    //!< The messages of one step are written in one batch.
+    static constexpr int32_t    EXPORT_CHUNK_SIZE   { 10000 };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructor / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    explicit LogExportModel(QObject* parent = nullptr);
+
+    virtual ~LogExportModel();
+
+//////////////////////////////////////////////////////////////////////////
+// Operations and attributes
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Starts exporting the log messages in the worker thread. The format of the file is
+     *          defined by the extension of the file path.
+     * \param   logModel    The logging model with the log database to export.
+     * \param   filter      The filter of the view to match the messages. If nullptr, the messages
+     *                      are not filtered by the combo and text filters.
+     * \param   filePath    The path of the exported file.
+     * \param   timeBegin   The earliest timestamp of the exported messages, zero if not limited.
+     * \param   timeEnd     The latest timestamp of the exported messages, zero if not limited.
+     * \return  Returns true if the export is started.
+     **/
+    bool startExport(const LoggingModelBase& logModel, const LogViewerFilter* filter, const QString& filePath, TIME64 timeBegin = 0u, TIME64 timeEnd = 0u);
+
+    /**
+     * \brief   Cancels the running export. The exported file is not created.
+     **/
+    void cancelExport();
+
+    /**
+     * \brief   Returns true if the export runs.
+     **/
+    inline bool isExporting() const;
+
+    /**
+     * \brief   Returns the path of the exported file.
+     **/
+    inline const QString& getFilePath() const;
+
+/************************************************************************
+ * Signals
+ ************************************************************************/
+signals:
+
+    /**
+     * \brief   Triggered when the worker thread completes a chunk of the log messages.
+     * \param   scanned     The number of read log messages.
+     * \param   total       The number of log messages passing the scope filters, zero if unknown.
+     * \param   exported    The number of exported log messages.
+     **/
+    void signalExportProgress(quint64 scanned, quint64 total, quint64 exported);
+
+    /**
+     * \brief   Triggered when the export completes, fails or is canceled.
+     * \param   succeeded   True if the exported file is written.
+     * \param   exported    The number of exported log messages.
+     **/
+    void signalExportFinished(bool succeeded, quint64 exported);
+
+/************************************************************************/
+// areg::ThreadConsumer interface overrides
+/************************************************************************/
+protected:
+
+    /**
+     * \brief   Runs in the worker thread, reads the log database and writes the matching messages.
+     **/
+    void on_run() override;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Receives the progress of the export from the worker thread.
+    void _onProgress(uint32_t generation, quint64 scanned, quint64 total, quint64 exported);
+
+    //!< Receives the result of the export from the worker thread.
+    void _onFinished(uint32_t generation, bool succeeded, quint64 exported);
+
+    //!< Returns true if the worker thread should quit.
+    inline bool _isCanceled();
+
+    //!< Stops the worker thread.
+    inline void _quitThread();
+
+    //!< Returns the reference to this object.
+    inline LogExportModel& self();
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    LogViewerFilter                     mRowFilter;     //!< The snapshot of the combo and text filters of the view.
+    LoggingModelBase::ListFilterSteps   mFilterSteps;   //!< The snapshot of the scope filters of the log database.
+    std::string                         mDatabasePath;  //!< The path of the log database the worker thread reads.
+    QString                             mFilePath;      //!< The path of the exported file.
+    LogExportWriter::eFormat            mFormat;        //!< The format of the exported file.
+    TIME64                              mTimeBegin;     //!< The earliest timestamp of the exported messages, zero if not limited.
+    TIME64                              mTimeEnd;       //!< The latest timestamp of the exported messages, zero if not limited.
+    bool                                mExporting;     //!< Flag, indicating whether the worker thread runs.
+    uint32_t                            mGeneration;    //!< Identifies the running export, so that the notifications of a canceled one are dropped.
+    areg::Thread                        mWorker;        //!< The worker thread to export the log messages.
+    areg::Mutex                         mQuitThread;    //!< Locked to notify the worker thread to quit.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(LogExportModel);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// LogExportModel class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline bool LogExportModel::isExporting() const
+{
+    return mExporting;
+}
+
+inline const QString& LogExportModel::getFilePath() const
+{
+    return mFilePath;
+}
+
+inline bool LogExportModel::_isCanceled()
+{
+    if (mQuitThread.try_lock() == false)
+        return true;
+
+    mQuitThread.unlock();
+    return false;
+}
+
+inline void LogExportModel::_quitThread()
+{
+    if (mWorker.is_valid())
+    {
+        mQuitThread.lock(areg::WAIT_INFINITE);
+        mWorker.shutdown(areg::WAIT_INFINITE);
+        mQuitThread.unlock();
+    }
+}
+
+inline LogExportModel& LogExportModel::self()
+{
+    return (*this);
+}
+
+#endif  // LUSAN_MODEL_LOG_LOGEXPORTMODEL_HPP
@@ -65,10 +65,29 @@ namespace
 
     constexpr uint32_t LogActive{ 0x00FF0000u };
     
+    //!< The indexes of the styles of the log messages.
+    enum eLogStyle : int
+    {
+          StyleNotset       = 0 //!< The messages without priority
+        , StyleScope            //!< The scope messages
+        , StyleScopeEnter       //!< The messages of entering the scope
+        , StyleScopeExit        //!< The messages of exiting the scope
+        , StyleDebug            //!< The debug messages
+        , StyleInfo             //!< The info messages
+        , StyleWarn             //!< The warning messages
+        , StyleError            //!< The error messages
+        , StyleFatal            //!< The fatal error messages
+        , StyleDefault          //!< The messages with unknown priority
+
+        , StyleCount            //!< The number of styles
+    };
+
     std::atomic_bool        _initialized{ false };
-    std::atomic_bool        _logInit    { false };
+    std::atomic<uint32_t>   _logTheme   { 0u };
     QMap<uint32_t, QIcon>   _mapIcons;
     QMap<uint32_t, QIcon>   _logIcons;
+    LogIconFactory::sLogStyle _logStyles[static_cast<int>(eLogStyle::StyleCount)];
+    uint32_t                _logStylesTheme{ 0u };
     
     const QColor NoColor            { Qt::transparent };
     constexpr uint32_t NoPrio       { static_cast<uint32_t>(areg::LogPriority::PrioNotset) };
@@ -308,7 +327,9 @@ namespace
     
     void _initLogIcons(uint32_t pixels)
     {
-        if (_logInit.exchange(true))
+        // The icons are created again when the theme is changed.
+        const uint32_t theme{ NELusanCommon::themeGeneration() };
+        if (_logTheme.exchange(theme) == theme)
             return;
 
         uint32_t prio = static_cast<int>(LogIconFactory::eLogIcons::PrioNotset);
@@ -357,6 +378,64 @@ namespace
         _logIcons[prio | LogActive] = _mergeIcons(_colors[static_cast<int>(LogIconFactory::eLogColor::ColorScopeExit)], exit, pixels);
     }
 
+    //!< Returns the index of the style of the log message.
+    inline eLogStyle _logStyleIndex(const areg::LogEntry& logMessage)
+    {
+        switch (logMessage.logMessagePrio)
+        {
+        case areg::LogPriority::PrioNotset:
+            return eLogStyle::StyleNotset;
+        case areg::LogPriority::PrioScope:
+            if (logMessage.logMsgType == areg::LogMessageType::ScopeEnter)
+                return eLogStyle::StyleScopeEnter;
+            else if (logMessage.logMsgType == areg::LogMessageType::ScopeExit)
+                return eLogStyle::StyleScopeExit;
+            else
+                return eLogStyle::StyleScope;
+        case areg::LogPriority::PrioDebug:
+            return eLogStyle::StyleDebug;
+        case areg::LogPriority::PrioInfo:
+            return eLogStyle::StyleInfo;
+        case areg::LogPriority::PrioWarning:
+            return eLogStyle::StyleWarn;
+        case areg::LogPriority::PrioError:
+            return eLogStyle::StyleError;
+        case areg::LogPriority::PrioFatal:
+            return eLogStyle::StyleFatal;
+        default:
+            return eLogStyle::StyleDefault;
+        }
+    }
+
+    //!< Sets the style of the log messages.
+    inline void _setLogStyle(eLogStyle style, LogIconFactory::eLogIcons icon, bool active, LogIconFactory::eLogColor foreground, LogIconFactory::eLogColor background)
+    {
+        LogIconFactory::sLogStyle& entry{ _logStyles[static_cast<int>(style)] };
+        entry.icon          = LogIconFactory::getLogIcon(icon, active);
+        entry.background    = QBrush(_colorsBkg[static_cast<int>(background)]);
+        entry.foreground    = _colors[static_cast<int>(foreground)];
+    }
+
+    //!< Creates the styles of the log messages for the current theme.
+    void _initLogStyles()
+    {
+        const uint32_t theme{ NELusanCommon::themeGeneration() };
+        if (_logStylesTheme == theme)
+            return;
+
+        _logStylesTheme = theme;
+        _setLogStyle(eLogStyle::StyleNotset    , LogIconFactory::eLogIcons::PrioNotset    , false, LogIconFactory::eLogColor::ColorNotSet    , LogIconFactory::eLogColor::ColorNotSet);
+        _setLogStyle(eLogStyle::StyleScope     , LogIconFactory::eLogIcons::PrioScope     , true , LogIconFactory::eLogColor::ColorScope     , LogIconFactory::eLogColor::ColorScope);
+        _setLogStyle(eLogStyle::StyleScopeEnter, LogIconFactory::eLogIcons::PrioScopeEnter, true , LogIconFactory::eLogColor::ColorScopeEnter, LogIconFactory::eLogColor::ColorScope);
+        _setLogStyle(eLogStyle::StyleScopeExit , LogIconFactory::eLogIcons::PrioScopeExit , true , LogIconFactory::eLogColor::ColorScopeExit , LogIconFactory::eLogColor::ColorScope);
+        _setLogStyle(eLogStyle::StyleDebug     , LogIconFactory::eLogIcons::PrioDebug     , true , LogIconFactory::eLogColor::ColorDebug     , LogIconFactory::eLogColor::ColorDebug);
+        _setLogStyle(eLogStyle::StyleInfo      , LogIconFactory::eLogIcons::PrioInfo      , true , LogIconFactory::eLogColor::ColorInfo      , LogIconFactory::eLogColor::ColorInfo);
+        _setLogStyle(eLogStyle::StyleWarn      , LogIconFactory::eLogIcons::PrioWarn      , true , LogIconFactory::eLogColor::ColorWarn      , LogIconFactory::eLogColor::ColorWarn);
+        _setLogStyle(eLogStyle::StyleError     , LogIconFactory::eLogIcons::PrioError     , true , LogIconFactory::eLogColor::ColorError     , LogIconFactory::eLogColor::ColorError);
+        _setLogStyle(eLogStyle::StyleFatal     , LogIconFactory::eLogIcons::PrioFatal     , true , LogIconFactory::eLogColor::ColorFatal     , LogIconFactory::eLogColor::ColorFatal);
+        _setLogStyle(eLogStyle::StyleDefault   , LogIconFactory::eLogIcons::PrioNotset    , false, LogIconFactory::eLogColor::ColorDefault   , LogIconFactory::eLogColor::ColorDefault);
+    }
+
     void _initialize(uint32_t pixels)
     {
         if (_initialized.exchange(true))
@@ -1160,3 +1239,9 @@ QColor LogIconFactory::getLogBackgroundColor(areg::LogPriority logPrio)
         return _colorsBkg[static_cast<int>(LogIconFactory::eLogColor::ColorDefault)];
     }
 }
+
+const LogIconFactory::sLogStyle& LogIconFactory::getLogStyle(const areg::LogEntry& logMessage)
+{
+    _initLogStyles();
+    return _logStyles[static_cast<int>(_logStyleIndex(logMessage))];
+}
@@ -26,6 +26,7 @@
 #include "lusan/common/NELusanCommon.hpp"
 #include "areg/logging/areg_log.h"
 
+#include <QBrush>
 #include <QColor>
 #include <QIcon>
 
@@ -72,6 +73,17 @@ public:
         , ColorCount        //<!< The number of log colors
     };
 
+    /**
+     * \brief   The style to display the log message: the icon of the priority,
+     *          the background and the foreground of the message.
+     **/
+    struct sLogStyle
+    {
+        QIcon   icon        { };    //!< The icon of the priority of the message.
+        QBrush  background  { };    //!< The background of the message.
+        QColor  foreground  { };    //!< The foreground color of the message.
+    };
+
     //!< Size of the icon in pixels to display in the scope navigation tree view.
     static constexpr int    IconPixels      { 16 };
 
@@ -124,6 +136,13 @@ public:
      * \param   logPrio     The log message priority.
      **/
     static QColor getLogBackgroundColor(areg::LogPriority logPrio);
+
+    /**
+     * \brief   Returns the style to display the log message, selected by the priority and the type of the message.
+     *          The styles are created once per application theme, the call is a lookup in the table of styles.
+     * \param   logMessage  The log message to get the style.
+     **/
+    static const LogIconFactory::sLogStyle& getLogStyle(const areg::LogEntry& logMessage);
 };
 
 #endif  // LUSAN_MODEL_LOG_LogIconFactory_HPP
@@ -32,6 +32,7 @@ LogSearchModel::LogSearchModel(QAbstractItemModel* logModel)
     , mIsMatchWord  (false)
     , mIsWildcard   (false)
     , mIsBackward   (false)
+    , mRegex        ( )
     , mRowBegin     (InvalidPos)
     , mRowFound     (InvalidPos)
     , mColFound     (static_cast<int>(InvalidPos))
@@ -76,6 +77,7 @@ void LogSearchModel::resetSearch()
     mIsMatchWord    = false;
     mIsWildcard     = false;
     mIsBackward     = false;
+    mRegex          = QRegularExpression();
 }
 
 LogSearchModel::sFoundPos LogSearchModel::startSearch(const QString& searchPhrase, uint32_t startAt, bool isMatchCase, bool isMatchWord, bool isWildcard, bool isBackward)
@@ -90,7 +92,8 @@ LogSearchModel::sFoundPos LogSearchModel::startSearch(const QString& searchPhras
     mIsMatchWord = isMatchWord;
     mIsWildcard  = isWildcard;
     mIsBackward  = isBackward;
-    
+    compileRegex();
+
     return nextSearch(mRowBegin);
 }
 
@@ -104,8 +107,10 @@ LogSearchModel::sFoundPos LogSearchModel::nextSearch(uint32_t lastFound)
     int32_t posStart{ static_cast<int32_t>(mPosStart) };
     int32_t posEnd  { static_cast<int32_t>(mPosEnd)   };
     bool    doSearch{ true };
-    QRegularExpression regex(createRegex());
-    
+    const bool useRegex{ isRegexSearch() };
+    if (useRegex && (mRegex.isValid() == false))
+        return result;
+
     do
     {
         bool found{false};
@@ -116,8 +121,8 @@ LogSearchModel::sFoundPos LogSearchModel::nextSearch(uint32_t lastFound)
             if (log == nullptr)
                 return result;
 
-            mCurrentText = QString::fromUtf8(log->logMessage);
-            found = mIsWildcard || mIsMatchWord ? wildcardMatch(mCurrentText, regex, posStart, posEnd) : stringMatch(mCurrentText, posStart, posEnd);
+            mCurrentText = QString::fromUtf8(log->logMessage, log->logMessageLen);
+            found = useRegex ? wildcardMatch(mCurrentText, mRegex, posStart, posEnd) : stringMatch(mCurrentText, posStart, posEnd);
             if (found)
             {
                 mRowFound       = startAt;
@@ -164,33 +169,47 @@ bool LogSearchModel::wildcardMatch(const QString& text, const QRegularExpression
     
     if (searchStart >= 0)
     {
+        // An empty match (for example, the phrase '*') marks nothing in the text, so it is skipped.
+        // Both directions find the overlapping matches as well, the same as the plain-text search
+        // does with 'indexOf' and 'lastIndexOf'.
         if (mIsBackward == false)
         {
-            // Forward search
-            QRegularExpressionMatchIterator it = regex.globalMatch(text, searchStart);
-            if (it.hasNext())
+            // Forward search: the first non-empty match at or after the start position.
+            const int length = static_cast<int>(text.length());
+            int offset = searchStart;
+            while (offset < length)
             {
-                QRegularExpressionMatch match = it.next();
-                foundStart = match.capturedStart();
-                foundEnd = match.capturedEnd();
+                QRegularExpressionMatch match = regex.match(text, offset);
+                if (match.hasMatch() == false)
+                    break;
+
+                const int s = static_cast<int>(match.capturedStart());
+                const int e = static_cast<int>(match.capturedEnd());
+                if (e > s)
+                {
+                    foundStart = s;
+                    foundEnd = e;
+                    break;
+                }
+
+                offset = s + 1;
             }
         }
         else
         {
-            // Backward search: find all matches up to searchStart, pick the last one before searchStart
-            QRegularExpressionMatchIterator it = regex.globalMatch(text);
-            while (it.hasNext())
+            // Backward search: one unanchored run finds the first match of the text. If it starts
+            // after the start position, the row has nothing to find, and that is the common case.
+            // Otherwise the match anchored at the nearest position at or before the start position
+            // is the last one; no match starts before the first one, so the scan stops there.
+            QRegularExpressionMatch first = regex.match(text);
+            const int firstStart = first.hasMatch() ? static_cast<int>(first.capturedStart()) : -1;
+            for (int offset = searchStart; (firstStart >= 0) && (offset >= firstStart); --offset)
             {
-                QRegularExpressionMatch match = it.next();
-                int s = match.capturedStart();
-                int e = match.capturedEnd();
-                if (e <= searchStart)
-                {
-                    foundStart = s;
-                    foundEnd = e;
-                }
-                else
+                QRegularExpressionMatch match = regex.match(text, offset, QRegularExpression::NormalMatch, QRegularExpression::AnchorAtOffsetMatchOption);
+                if (match.hasMatch() && (match.capturedEnd() > match.capturedStart()))
                 {
+                    foundStart = static_cast<int>(match.capturedStart());
+                    foundEnd = static_cast<int>(match.capturedEnd());
                     break;
                 }
             }
@@ -211,7 +230,7 @@ bool LogSearchModel::wildcardMatch(const QString& text, const QRegularExpression
     }
 }
 
-QRegularExpression LogSearchModel::createRegex()
+QRegularExpression LogSearchModel::createRegex() const
 {
     // Escape regex special characters except * and ?
     QString regexPattern = QRegularExpression::escape(mSearchPhrase);
@@ -230,9 +249,27 @@ QRegularExpression LogSearchModel::createRegex()
     return QRegularExpression(regexPattern, options);
 }
 
+void LogSearchModel::compileRegex()
+{
+    if (isRegexSearch())
+    {
+        mRegex = createRegex();
+        mRegex.optimize();
+    }
+    else
+    {
+        mRegex = QRegularExpression();
+    }
+}
+
 bool LogSearchModel::wildcardMatch(const QString& text, int posStart, int posEnd)
 {
-    return wildcardMatch(text, createRegex(), posStart, posEnd);
+    if (mRegex.pattern().isEmpty())
+    {
+        compileRegex();
+    }
+
+    return wildcardMatch(text, mRegex, posStart, posEnd);
 }
 
 bool LogSearchModel::stringMatch(const QString& text, int posStart, int posEnd)
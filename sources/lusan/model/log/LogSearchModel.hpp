@@ -138,6 +138,12 @@ public:
      **/
     inline bool canSearchNext() const;
 
+    /**
+     * \brief   Returns true if the search session goes through the regular expression,
+     *          i.e. the search phrase has wildcards or should match whole words only.
+     **/
+    inline bool isRegexSearch() const;
+
     /**
      * \brief   Returns true if the search has found a match.
      *          It is used to indicate whether the search was successful or not.
@@ -214,7 +220,15 @@ private:
      *          It handles case sensitivity, whole word matching, and wildcard characters.
      * \return  Returns the configured QRegularExpression object for searching.
      **/
-    QRegularExpression createRegex();
+    QRegularExpression createRegex() const;
+
+    /**
+     * \brief   Compiles the regular expression of the search session once, when the search starts.
+     *          The pattern is optimized immediately, so that the first scanned row does not pay
+     *          the JIT compilation and the next search calls reuse it without rebuilding.
+     *          The plain-text search does not need the expression and leaves it empty.
+     **/
+    void compileRegex();
 
     /**
      * \brief   Checks if the text matches the search phrase as a simple string.
@@ -247,6 +261,7 @@ private:
     bool                mIsMatchWord;   //!< Flag indicating if the search should match whole words only
     bool                mIsWildcard;    //!< Flag indicating if the search phrase contains wildcards
     bool                mIsBackward;    //!< Flag indicating if the search is backward
+    QRegularExpression  mRegex;         //!< The regular expression of the search session, compiled once per session.
     uint32_t            mRowBegin;      //!< The row index where the search started
     uint32_t            mRowFound;      //!< The row index where the search found a match
     int32_t             mColFound;      //!< The column index where the search found a match
@@ -314,6 +329,11 @@ inline bool LogSearchModel::canSearchNext() const
     return (mSearchPhrase.isEmpty() == false) && isValidPosition(mRowBegin) && isValidPosition(mRowFound);
 }
 
+inline bool LogSearchModel::isRegexSearch() const
+{
+    return (mIsWildcard || mIsMatchWord);
+}
+
 inline bool LogSearchModel::hasFound() const
 {
     return (mRowFound != InvalidPos) && (mRowFound != ReachedEnd);
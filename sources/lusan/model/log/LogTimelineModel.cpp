@@ -0,0 +1,252 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/model/log/LogTimelineModel.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the model of the log rate timeline.
+ *
+ ************************************************************************/
+
+#include "lusan/model/log/LogTimelineModel.hpp"
+#include "lusan/model/log/LoggingModelBase.hpp"
+
+#include "aregextend/db/LogSqliteDatabase.hpp"
+#include "aregextend/db/SqliteStatement.hpp"
+
+#include <QDateTime>
+#include <QFileInfo>
+
+#include <algorithm>
+
+LogTimelineModel::LogTimelineModel(QObject* parent)
+    : QObject               (parent)
+    , areg::ThreadConsumer  ( )
+    , mLogModel     (nullptr)
+    , mTimeline     ( )
+    , mDatabasePath ( )
+    , mWorkerPath   ( )
+    , mWorkerSidecar( )
+    , mWorkerSource ( )
+    , mBuilding     (false)
+    , mGeneration   (0u)
+    , mRefreshTimer (this)
+    , mSourceConnect( )
+    , mWorker       (static_cast<areg::ThreadConsumer &>(self()), "_LogTimelineThread_")
+    , mQuitThread   (false)
+{
+    mRefreshTimer.setSingleShot(true);
+    mRefreshTimer.setInterval(LogTimelineModel::REFRESH_INTERVAL_MS);
+    connect(&mRefreshTimer, &QTimer::timeout, this, [this]() { emit signalTimelineChanged(); });
+}
+
+LogTimelineModel::~LogTimelineModel()
+{
+    // The worker thread works on the members of this object, stop it first.
+    _quitThread();
+    for (const QMetaObject::Connection& conn : mSourceConnect)
+    {
+        disconnect(conn);
+    }
+
+    mSourceConnect.clear();
+}
+
+void LogTimelineModel::setLoggingModel(LoggingModelBase* logModel)
+{
+    if (mLogModel == logModel)
+        return;
+
+    for (const QMetaObject::Connection& conn : mSourceConnect)
+    {
+        disconnect(conn);
+    }
+
+    mSourceConnect.clear();
+    mLogModel = logModel;
+    if (mLogModel != nullptr)
+    {
+        mSourceConnect.append(connect(mLogModel, &QAbstractItemModel::rowsInserted, this
+                                    , [this](const QModelIndex& /*parent*/, int first, int last) {
+                                        _onSourceRowsInserted(first, last);
+                                    }));
+        // The rows dropped from the live logs stay in the timeline, it shows the whole session.
+        mSourceConnect.append(connect(mLogModel, &QAbstractItemModel::modelReset, this
+                                    , [this]() {
+                                        _onSourceReset();
+                                    }));
+    }
+
+    _restart();
+}
+
+void LogTimelineModel::on_run()
+{
+    // Runs in the worker thread. It reads the database with its own connection, so that
+    // neither the filters nor the reading thread of the logging model are affected.
+    const uint32_t generation{ mGeneration };
+    LogRateTimeline timeline;
+    bool complete{ false };
+    bool quit{ false };
+
+    areg::ext::LogSqliteDatabase database;
+    if (database.connect(mWorkerPath, true))
+    {
+        areg::ext::SqliteStatement statement(database.database());
+        database.setup_statement_read_logs(statement, areg::TARGET_ALL, -1, 0u);
+
+        std::vector<areg::SharedBuffer> batch(static_cast<size_t>(LogTimelineModel::SCAN_CHUNK_SIZE));
+        uint32_t progress{ 0u };
+        int32_t  readCount{ 0 };
+        do
+        {
+            if (mQuitThread.try_lock() == false)
+            {
+                quit = true;
+                break;
+            }
+
+            mQuitThread.unlock();
+
+            readCount = areg::ext::LogSqliteDatabase::fill_log_messages(batch, statement, 0, LogTimelineModel::SCAN_CHUNK_SIZE);
+            for (int32_t i = 0; i < readCount; ++i)
+            {
+                timeline.append(*reinterpret_cast<const areg::LogEntry*>(batch[static_cast<uint32_t>(i)].buffer()));
+            }
+
+            progress += static_cast<uint32_t>(std::max(readCount, 0));
+            if ((progress >= LogTimelineModel::SCAN_PROGRESS_ROWS) && (readCount == LogTimelineModel::SCAN_CHUNK_SIZE))
+            {
+                progress = 0u;
+                QMetaObject::invokeMethod(this
+                                         , [this, generation, partial = LogRateTimeline(timeline)]() mutable
+                                           {
+                                               _applyTimeline(std::move(partial), generation, false);
+                                           }
+                                         , Qt::ConnectionType::QueuedConnection);
+            }
+        } while (readCount == LogTimelineModel::SCAN_CHUNK_SIZE);
+
+        complete = (quit == false);
+    }
+
+    database.disconnect();
+    if (quit)
+        return;
+
+    if (complete && (timeline.isEmpty() == false))
+    {
+        timeline.save(mWorkerSidecar, mWorkerSource);
+    }
+
+    QMetaObject::invokeMethod(this
+                             , [this, generation, timeline = std::move(timeline)]() mutable
+                               {
+                                   _applyTimeline(std::move(timeline), generation, true);
+                               }
+                             , Qt::ConnectionType::QueuedConnection);
+}
+
+void LogTimelineModel::_restart()
+{
+    _quitThread();
+    ++ mGeneration;
+    mRefreshTimer.stop();
+    mTimeline.clear();
+    mDatabasePath.clear();
+    mBuilding = false;
+
+    if (mLogModel != nullptr)
+    {
+        if (mLogModel->isOfflineLogging())
+        {
+            mDatabasePath = mLogModel->getDatabasePath();
+            if (mDatabasePath.isEmpty() == false)
+            {
+                mWorkerSidecar = LogRateTimeline::getSidecarPath(mDatabasePath);
+                mWorkerSource  = _sourceInfo(mDatabasePath);
+                if (mTimeline.load(mWorkerSidecar, mWorkerSource) == false)
+                {
+                    mWorkerPath = mDatabasePath.toStdString();
+                    mBuilding   = true;
+                    mWorker.start(areg::DO_NOT_WAIT);
+                }
+            }
+        }
+        else
+        {
+            const int count{ mLogModel->rowCount() };
+            for (int row = 0; row < count; ++row)
+            {
+                const areg::LogEntry* log = mLogModel->getLogData(row);
+                if (log != nullptr)
+                {
+                    mTimeline.append(*log);
+                }
+            }
+        }
+    }
+
+    emit signalTimelineChanged();
+}
+
+void LogTimelineModel::_onSourceReset()
+{
+    // The log file is reloaded when the filters change, the timeline of the file stays the same.
+    if ((mLogModel != nullptr) && mLogModel->isOfflineLogging() && (mDatabasePath.isEmpty() == false) && (mLogModel->getDatabasePath() == mDatabasePath))
+        return;
+
+    _restart();
+}
+
+void LogTimelineModel::_onSourceRowsInserted(int first, int last)
+{
+    if ((mLogModel == nullptr) || mLogModel->isOfflineLogging())
+        return;
+
+    for (int row = first; row <= last; ++row)
+    {
+        const areg::LogEntry* log = mLogModel->getLogData(row);
+        if (log != nullptr)
+        {
+            mTimeline.append(*log);
+        }
+    }
+
+    if (mRefreshTimer.isActive() == false)
+    {
+        mRefreshTimer.start();
+    }
+}
+
+void LogTimelineModel::_applyTimeline(LogRateTimeline&& timeline, uint32_t generation, bool complete)
+{
+    if (generation != mGeneration)
+        return;
+
+    mTimeline = std::move(timeline);
+    if (complete)
+    {
+        mBuilding = false;
+    }
+
+    emit signalTimelineChanged();
+}
+
+LogRateTimeline::sSourceInfo LogTimelineModel::_sourceInfo(const QString& dbPath)
+{
+    const QFileInfo info(dbPath);
+    LogRateTimeline::sSourceInfo result;
+    result.fileSize = static_cast<int64_t>(info.size());
+    result.modified = static_cast<int64_t>(info.lastModified().toMSecsSinceEpoch());
+    return result;
+}
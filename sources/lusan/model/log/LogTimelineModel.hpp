@@ -0,0 +1,205 @@
+#ifndef LUSAN_MODEL_LOG_LOGTIMELINEMODEL_HPP
+#define LUSAN_MODEL_LOG_LOGTIMELINEMODEL_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/model/log/LogTimelineModel.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the model of the log rate timeline.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include "areg/base/SyncPrimitives.hpp"
+#include "areg/base/Thread.hpp"
+#include "areg/base/ThreadConsumer.hpp"
+#include "lusan/data/log/LogRateTimeline.hpp"
+
+#include <string>
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class LoggingModelBase;
+
+/**
+ * \brief   Keeps the timeline of the number of log messages per time and priority of the logging model.
+ *          The timeline of a log file covers the whole file and does not depend on the filters of
+ *          the view. It is loaded from the sidecar file of the database, or built in the worker
+ *          thread, which reads the database with its own connection and saves the sidecar file
+ *          when it completes. The timeline of the live logs is updated as the messages arrive.
+ **/
+class LogTimelineModel  : public QObject
+                        , protected areg::ThreadConsumer
+{
+    Q_OBJECT
+
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The number of log messages the worker thread reads from the database in one step.
+    static constexpr int32_t    SCAN_CHUNK_SIZE     { 10000 };
+
+    //!< The number of log messages the worker thread reads before it shows the intermediate timeline.
+    static constexpr uint32_t   SCAN_PROGRESS_ROWS  { 1000000u };
+
+    //!< The interval in milliseconds to notify the changes of the timeline of the live logs.
+    static constexpr int        REFRESH_INTERVAL_MS { 250 };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructor / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    explicit LogTimelineModel(QObject* parent = nullptr);
+
+    virtual ~LogTimelineModel();
+
+//////////////////////////////////////////////////////////////////////////
+// Operations and attributes
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Sets the logging model to build the timeline. Pass nullptr to clear the timeline.
+     * \param   logModel    The logging model with the log messages.
+     **/
+    void setLoggingModel(LoggingModelBase* logModel);
+
+    /**
+     * \brief   Returns the logging model of the timeline, or nullptr if not set.
+     **/
+    inline LoggingModelBase* getLoggingModel() const;
+
+    /**
+     * \brief   Returns the timeline of the log messages.
+     **/
+    inline const LogRateTimeline& getTimeline() const;
+
+    /**
+     * \brief   Returns true if the worker thread builds the timeline of the log file.
+     **/
+    inline bool isBuilding() const;
+
+/************************************************************************
+ * Signals
+ ************************************************************************/
+signals:
+
+    /**
+     * \brief   Triggered when the timeline is changed.
+     **/
+    void signalTimelineChanged();
+
+/************************************************************************/
+// areg::ThreadConsumer interface overrides
+/************************************************************************/
+protected:
+
+    /**
+     * \brief   Runs in the worker thread, reads the log database and counts the messages.
+     **/
+    void on_run() override;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Clears the timeline and builds it again from the logging model.
+    void _restart();
+
+    //!< Triggered when the logging model is reset.
+    void _onSourceReset();
+
+    //!< Counts the new log messages of the live logs.
+    void _onSourceRowsInserted(int first, int last);
+
+    //!< Receives the timeline built in the worker thread.
+    void _applyTimeline(LogRateTimeline&& timeline, uint32_t generation, bool complete);
+
+    //!< Returns the state of the log database file.
+    static LogRateTimeline::sSourceInfo _sourceInfo(const QString& dbPath);
+
+    //!< Stops the worker thread.
+    inline void _quitThread();
+
+    //!< Returns the reference to this object.
+    inline LogTimelineModel& self();
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    LoggingModelBase*               mLogModel;      //!< The logging model with the log messages.
+    LogRateTimeline                 mTimeline;      //!< The timeline of the log messages.
+    QString                         mDatabasePath;  //!< The path of the log file of the timeline.
+    std::string                     mWorkerPath;    //!< The path of the log file the worker thread reads.
+    QString                         mWorkerSidecar; //!< The path of the sidecar file the worker thread writes.
+    LogRateTimeline::sSourceInfo    mWorkerSource;  //!< The state of the log file the worker thread reads.
+    bool                            mBuilding;      //!< Flag, indicating whether the worker thread runs.
+    uint32_t                        mGeneration;    //!< Identifies the running build, so that the result of an abandoned one is dropped.
+    QTimer                          mRefreshTimer;  //!< The timer to notify the changes of the live timeline.
+    QList<QMetaObject::Connection>  mSourceConnect; //!< The connections to the signals of the logging model.
+    areg::Thread                    mWorker;        //!< The worker thread to build the timeline of the log file.
+    areg::Mutex                     mQuitThread;    //!< Locked to notify the worker thread to quit.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(LogTimelineModel);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// LogTimelineModel class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline LoggingModelBase* LogTimelineModel::getLoggingModel() const
+{
+    return mLogModel;
+}
+
+inline const LogRateTimeline& LogTimelineModel::getTimeline() const
+{
+    return mTimeline;
+}
+
+inline bool LogTimelineModel::isBuilding() const
+{
+    return mBuilding;
+}
+
+inline void LogTimelineModel::_quitThread()
+{
+    if (mWorker.is_valid())
+    {
+        mQuitThread.lock(areg::WAIT_INFINITE);
+        mWorker.shutdown(areg::WAIT_INFINITE);
+        mQuitThread.unlock();
+    }
+}
+
+inline LogTimelineModel& LogTimelineModel::self()
+{
+    return (*this);
+}
+
+#endif  // LUSAN_MODEL_LOG_LOGTIMELINEMODEL_HPP
@@ -131,6 +131,22 @@ void LogViewerFilter::clearFilters()
     invalidateRowFilter();
 }
 
+void LogViewerFilter::copyFilters(const LogViewerFilter& source)
+{
+    mComboFilters   = source.mComboFilters;
+    mTextFilters    = source.mTextFilters;
+    mRePattern      = source.mRePattern;
+    mReExpression   = source.mReExpression;
+    invalidateRowFilter();
+}
+
+bool LogViewerFilter::acceptsLogEntry(const areg::LogEntry* msg) const
+{
+    return  (msg != nullptr) &&
+            (matchesComboFilters(nullptr, msg) != NELusanCommon::eMatchType::NoMatch) &&
+            (matchesTextFilters(nullptr, msg)  != NELusanCommon::eMatchType::NoMatch);
+}
+
 bool LogViewerFilter::filterExactMatch(const QModelIndex& index) const
 {
     LoggingModelBase* model = static_cast<LoggingModelBase*>(sourceModel());
@@ -74,6 +74,30 @@ public slots:
     void setTextFilter(int logicalColumn, const QString& text, bool isCaseSensitive, bool isWholeWord, bool isWildCard);
     void setTextFilter(int logicalColumn, const NELusanCommon::FilterString& filter);
 
+//////////////////////////////////////////////////////////////////////////
+// Attributes
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   Copies the combo and text filters of the other filter object. Used to take the
+     *          snapshot of the filters, which are matched in the other thread.
+     * \param   source  The filter object to copy the filters.
+     **/
+    void copyFilters(const LogViewerFilter& source);
+
+    /**
+     * \brief   Returns true if the log message passes the combo and text filters. The method does
+     *          not access the source model, it is safe to call in the other thread as long as the
+     *          filters are not changed.
+     * \param   msg     The log message to check.
+     **/
+    bool acceptsLogEntry(const areg::LogEntry* msg) const;
+
+    /**
+     * \brief   Returns true if any combo or text filter is set.
+     **/
+    inline bool hasFilters() const;
+
 //////////////////////////////////////////////////////////////////////////
 // Operations
 //////////////////////////////////////////////////////////////////////////
@@ -218,4 +242,13 @@ private:
     AREG_NOCOPY_NOMOVE(LogViewerFilter);
 };
 
+//////////////////////////////////////////////////////////////////////////
+// LogViewerFilter class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline bool LogViewerFilter::hasFilters() const
+{
+    return (mComboFilters.isEmpty() == false) || (mTextFilters.isEmpty() == false);
+}
+
 #endif // LUSAN_MODEL_LOG_LOGVIEWERFILTER_HPP
@@ -33,6 +33,7 @@
 #include <QIcon>
 #include <QSize>
 
+#include <algorithm>
 #include <iterator>
 
 const QStringList& LoggingModelBase::getHeaderList()
@@ -100,6 +101,7 @@ LoggingModelBase::LoggingModelBase(LoggingModelBase::eLogging logsType, QObject*
     , mReadThread   (static_cast<areg::ThreadConsumer &>(self()), "_LogReadingThread_")
     , mQuitThread   (false)
     , mScopeFilter  (nullptr)
+    , mFilterSteps  ( )
 {
 }
 
@@ -583,6 +585,7 @@ void LoggingModelBase::readLogsAsynchronous(int maxEntries)
     beginResetModel();
     cleanLogs();
     endResetModel();
+    recountTraffic();
     mLogChunk = maxEntries;
 
     uint32_t count = setupLogStatement(areg::TARGET_ALL, mLogChunk, 0u);
@@ -594,6 +597,20 @@ void LoggingModelBase::readLogsAsynchronous(int maxEntries)
     mReadThread.start(areg::DO_NOT_WAIT);
 }
 
+void LoggingModelBase::recountTraffic()
+{
+    for (ScopeRoot* root : mRootList)
+    {
+        Q_ASSERT(root != nullptr);
+        root->resetTrafficRecursive();
+    }
+
+    for (const areg::SharedBuffer& logMessage : mLogs)
+    {
+        countTraffic(logMessage);
+    }
+}
+
 uint32_t LoggingModelBase::setupLogStatement(ITEM_ID instId, int32_t limit, uint32_t offset)
 {
     return mDatabase.setup_statement_read_logs(mStatement, instId, limit, offset);
@@ -601,17 +618,71 @@ uint32_t LoggingModelBase::setupLogStatement(ITEM_ID instId, int32_t limit, uint
 
 bool LoggingModelBase::applyFilters(uint32_t instId, const areg::ArrayList<areg::ext::LogSqliteDatabase::ScopeFilter>& filter)
 {
-    return mDatabase.setup_filter_logs(instId, filter);
+    if (mDatabase.setup_filter_logs(instId, filter) == false)
+        return false;
+
+    _addFilterStep(sFilterStep::eStep::StepApply, instId, filter);
+    return true;
 }
 
 bool LoggingModelBase::resetFilters(uint32_t instId)
 {
-    return mDatabase.reset(instId);
+    if (mDatabase.reset(instId) == false)
+        return false;
+
+    _addFilterStep(sFilterStep::eStep::StepReset, instId, areg::ArrayList<areg::ext::LogSqliteDatabase::ScopeFilter>{});
+    return true;
 }
 
 bool LoggingModelBase::disableFilters(uint32_t instId)
 {
-    return mDatabase.disable_filter_mask(instId);
+    if (mDatabase.disable_filter_mask(instId) == false)
+        return false;
+
+    _addFilterStep(sFilterStep::eStep::StepDisable, instId, areg::ArrayList<areg::ext::LogSqliteDatabase::ScopeFilter>{});
+    return true;
+}
+
+bool LoggingModelBase::setupFilters(areg::ext::LogSqliteDatabase& database, const LoggingModelBase::ListFilterSteps& steps)
+{
+    bool result{ database.setup_filter_logs(areg::TARGET_ALL, areg::ArrayList<areg::ext::LogSqliteDatabase::ScopeFilter>{}) };
+    for (const sFilterStep& entry : steps)
+    {
+        switch (entry.step)
+        {
+        case sFilterStep::eStep::StepApply:
+            result = database.setup_filter_logs(entry.instId, entry.filter) && result;
+            break;
+
+        case sFilterStep::eStep::StepReset:
+            result = database.reset(entry.instId) && result;
+            break;
+
+        case sFilterStep::eStep::StepDisable:
+            result = database.disable_filter_mask(entry.instId) && result;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return result;
+}
+
+void LoggingModelBase::_addFilterStep(LoggingModelBase::sFilterStep::eStep step, uint32_t instId, const areg::ArrayList<areg::ext::LogSqliteDatabase::ScopeFilter>& filter)
+{
+    if (step != sFilterStep::eStep::StepApply)
+    {
+        // Resetting or disabling overwrites the filters set up before, the list does not grow.
+        mFilterSteps.erase(std::remove_if(mFilterSteps.begin(), mFilterSteps.end()
+                                         , [instId](const sFilterStep& entry) {
+                                               return (instId == areg::TARGET_ALL) || (entry.instId == instId);
+                                           })
+                          , mFilterSteps.end());
+    }
+
+    mFilterSteps.push_back(sFilterStep{ step, instId, filter });
 }
 
 QString LoggingModelBase::getDisplayData(const areg::LogEntry* logMessage, eColumn column) const
@@ -659,44 +730,20 @@ QBrush LoggingModelBase::getBackgroundData(const areg::LogEntry* logMessage, eCo
 {
     Q_UNUSED(column)
     Q_ASSERT(logMessage != nullptr);
-    return QBrush(LogIconFactory::getLogBackgroundColor(*logMessage));
+    return LogIconFactory::getLogStyle(*logMessage).background;
 }
 
 QColor LoggingModelBase::getForegroundData(const areg::LogEntry* logMessage, eColumn column) const
 {
     Q_UNUSED(column)
     Q_ASSERT(logMessage != nullptr);
-    return LogIconFactory::getLogColor(*logMessage);
+    return LogIconFactory::getLogStyle(*logMessage).foreground;
 }
 
 QIcon LoggingModelBase::getDecorationData(const areg::LogEntry* logMessage, eColumn column) const
 {
     Q_ASSERT(logMessage != nullptr);
-    if (column != eColumn::LogColumnPriority)
-        return QIcon();
-
-    switch (logMessage->logMessagePrio)
-    {
-    case areg::LogPriority::PrioScope:
-        if (logMessage->logMsgType == areg::LogMessageType::ScopeEnter)
-            return LogIconFactory::getLogIcon(LogIconFactory::eLogIcons::PrioScopeEnter, true);
-        else if (logMessage->logMsgType == areg::LogMessageType::ScopeExit)
-            return LogIconFactory::getLogIcon(LogIconFactory::eLogIcons::PrioScopeExit, true);
-        else
-            return LogIconFactory::getLogIcon(LogIconFactory::eLogIcons::PrioScope, true);
-    case areg::LogPriority::PrioDebug:
-        return LogIconFactory::getLogIcon(LogIconFactory::eLogIcons::PrioDebug, true);
-    case areg::LogPriority::PrioInfo:
-        return LogIconFactory::getLogIcon(LogIconFactory::eLogIcons::PrioInfo, true);
-    case areg::LogPriority::PrioWarning:
-        return LogIconFactory::getLogIcon(LogIconFactory::eLogIcons::PrioWarn, true);
-    case areg::LogPriority::PrioError:
-        return LogIconFactory::getLogIcon(LogIconFactory::eLogIcons::PrioError, true);
-    case areg::LogPriority::PrioFatal:
-        return LogIconFactory::getLogIcon(LogIconFactory::eLogIcons::PrioFatal, true);
-    default:
-        return LogIconFactory::getLogIcon(LogIconFactory::eLogIcons::PrioNotset, false);
-    }
+    return (column == eColumn::LogColumnPriority ? LogIconFactory::getLogStyle(*logMessage).icon : QIcon());
 }
 
 int LoggingModelBase::getAlignmentData(eColumn column) const
@@ -738,12 +785,36 @@ void LoggingModelBase::appendLogBatch(std::vector<areg::SharedBuffer>&& logs, ui
     const int first{ static_cast<int>(mLogs.size()) };
     const int last { first + static_cast<int>(logs.size()) - 1 };
 
+    for (const areg::SharedBuffer& logMessage : logs)
+    {
+        countTraffic(logMessage);
+    }
+
     beginInsertRows(QModelIndex(), first, last);
     mLogs.insert(mLogs.end(), std::make_move_iterator(logs.begin()), std::make_move_iterator(logs.end()));
     mLogCount = static_cast<uint32_t>(mLogs.size());
     endInsertRows();
 }
 
+void LoggingModelBase::countTraffic(const areg::SharedBuffer& logMessage)
+{
+    const areg::LogEntry* entry = reinterpret_cast<const areg::LogEntry*>(logMessage.buffer());
+    if (entry == nullptr)
+        return;
+
+    for (ScopeRoot* root : mRootList)
+    {
+        Q_ASSERT(root != nullptr);
+        if (root->getRootId() == entry->logCookie)
+        {
+            ScopeLeaf* leaf = root->findLeaf(entry->logScopeId);
+            ScopeNodeBase* node = leaf != nullptr ? static_cast<ScopeNodeBase*>(leaf) : static_cast<ScopeNodeBase*>(root);
+            node->countTraffic(entry->logMessageLen, entry->logTimestamp);
+            break;
+        }
+    }
+}
+
 void LoggingModelBase::on_run()
 {
     // Runs in the reading thread. It reads from the database only, the entries are handed
@@ -104,6 +104,28 @@ public:
     using   ListExpanded    = std::vector<QModelIndex>;
     using   RootList        = std::vector<ScopeRoot*>;
 
+    /**
+     * \brief   The step of setting up the scope filters of the log database. The steps are kept
+     *          in the order of the calls, so that the same filters can be set up in the other
+     *          connection to the log database, like the one of the export of the logs.
+     **/
+    struct sFilterStep
+    {
+        //!< The type of the step.
+        enum class eStep : int
+        {
+              StepApply     = 0 //!< Applies the scope filters.
+            , StepReset         //!< Resets the scope filters.
+            , StepDisable       //!< Disables the scope filters.
+        };
+
+        eStep       step    { eStep::StepApply };   //!< The type of the step.
+        uint32_t    instId  { areg::TARGET_ALL };   //!< The ID of the instance of the step.
+        areg::ArrayList<areg::ext::LogSqliteDatabase::ScopeFilter> filter;  //!< The scope filters of the step `StepApply`.
+    };
+
+    using   ListFilterSteps = std::vector<sFilterStep>;
+
 //////////////////////////////////////////////////////////////////////////
 // Static methods
 //////////////////////////////////////////////////////////////////////////
@@ -130,6 +152,15 @@ public:
      **/
     static const QList<LoggingModelBase::eColumn>& getDefaultColumns();
 
+    /**
+     * \brief   Sets up the scope filters of the log database in the order of the steps.
+     *          The filters of the database are cleared before.
+     * \param   database    The connected log database to set up the filters.
+     * \param   steps       The steps of setting up the scope filters.
+     * \return  Returns true if all filters are set up.
+     **/
+    static bool setupFilters(areg::ext::LogSqliteDatabase& database, const LoggingModelBase::ListFilterSteps& steps);
+
 //////////////////////////////////////////////////////////////////////////
 // Constructor / Destructor
 //////////////////////////////////////////////////////////////////////////
@@ -334,6 +365,11 @@ public:
     inline areg::ext::LogSqliteDatabase& getDatabase();
     inline const areg::ext::LogSqliteDatabase& getDatabase() const;
 
+    /**
+     * \brief   Returns the steps of setting up the scope filters of the log database since it is opened.
+     **/
+    inline const LoggingModelBase::ListFilterSteps& getFilterSteps() const;
+
 /************************************************************************
  * Signals
  ************************************************************************/
@@ -589,6 +625,12 @@ public:
      **/
     virtual void readLogsAsynchronous(int maxEntries = -1);
 
+    /**
+     * \brief   Resets the traffic statistics of the scope trees and counts again the log messages held by the model.
+     *          Called when the scope trees are replaced, the new nodes have no statistics.
+     **/
+    void recountTraffic();
+
     /**
      * \brief   Sets up the logging query to run. By default, it reads all logs without filter.
      * \param   instId  The ID of the instance to read logs. Reads logs of all instances it `areg::TARGET_ALL`.
@@ -643,6 +685,13 @@ protected:
      **/
     void appendLogBatch(std::vector<areg::SharedBuffer>&& logs, uint32_t generation);
 
+    /**
+     * \brief   Counts the log message in the traffic statistics of its scope and of the parent nodes up to the instance.
+     *          The message without known scope is counted by the instance.
+     * \param   logMessage  The log message to count.
+     **/
+    void countTraffic(const areg::SharedBuffer& logMessage);
+
     /**
      * \brief   Closes currently opened log database file without triggering signal.
      **/
@@ -705,6 +754,10 @@ private:
     //!< Cleans the nodes of root list and deletes them.
     inline void _cleanNodes();
 
+    //!< Adds the step of setting up the scope filters. Resetting or disabling the filters
+    //!< replaces the earlier steps of the instance.
+    void _addFilterStep(LoggingModelBase::sFilterStep::eStep step, uint32_t instId, const areg::ArrayList<areg::ext::LogSqliteDatabase::ScopeFilter>& filter);
+
     inline LoggingModelBase& self();
 
 //////////////////////////////////////////////////////////////////////////
@@ -729,6 +782,7 @@ protected:
     areg::Thread            mReadThread;    //!< The thread to run the model operations.
     areg::Mutex             mQuitThread;    //!< The event to notify when data is ready.
     ScopeLogViewerFilter*   mScopeFilter;   //<!< The filter for scope logs, can be nullptr.
+    ListFilterSteps         mFilterSteps;   //!< The steps of setting up the scope filters of the log database.
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -874,6 +928,7 @@ inline void LoggingModelBase::_closeDatabase()
 {
     _quitThread();
     mDatabase.disconnect();
+    mFilterSteps.clear();
     dataReset();
 }
 
@@ -907,6 +962,11 @@ inline const areg::ext::LogSqliteDatabase& LoggingModelBase::getDatabase() const
     return mDatabase;
 }
 
+inline const LoggingModelBase::ListFilterSteps& LoggingModelBase::getFilterSteps() const
+{
+    return mFilterSteps;
+}
+
 inline LoggingModelBase& LoggingModelBase::self()
 {
     return (*this);
@@ -27,6 +27,24 @@
 #include "lusan/data/log/ScopeNodes.hpp"
 #include "lusan/common/NELusanCommon.hpp"
 
+#include "areg/base/DateTime.hpp"
+
+#include <QDateTime>
+#include <QLocale>
+#include <QSet>
+
+#include <algorithm>
+
+namespace
+{
+    //!< Compares the values, returns negative, zero or positive value.
+    template<typename Value>
+    inline int compareValues(Value lhs, Value rhs)
+    {
+        return (lhs < rhs ? -1 : (rhs < lhs ? 1 : 0));
+    }
+}
+
 LoggingScopesModelBase::LoggingScopesModelBase(QObject* parent)
     : QAbstractItemModel( parent )
     , mRootIndex        ( )
@@ -39,8 +57,19 @@ LoggingScopesModelBase::LoggingScopesModelBase(QObject* parent)
     , mConInstUnavailable   ( )
     , mConScopesAvailable   ( )
     , mConScopesUnavailable ( )
+    , mTrafficColumns       ( false )
+    , mSortColumn           ( eColumn::ColumnScope )
+    , mSortOrder            ( Qt::SortOrder::AscendingOrder )
+    , mTrafficTimer         ( )
+    , mSortedRows           ( )
 {
     mRootIndex = createIndex(0, 0, nullptr);
+    mTrafficTimer.setInterval(TRAFFIC_REFRESH_MS);
+    connect(&mTrafficTimer, &QTimer::timeout, this, [this]() { _refreshTraffic(); });
+
+    // The nodes of the removed rows may be deleted, the sorted rows are built again.
+    connect(this, &QAbstractItemModel::modelReset , this, [this]() { mSortedRows.clear(); });
+    connect(this, &QAbstractItemModel::rowsRemoved, this, [this]() { mSortedRows.clear(); });
 }
 
 LoggingScopesModelBase::~LoggingScopesModelBase()
@@ -142,6 +171,29 @@ void LoggingScopesModelBase::nodeTreeCollapsed(const QModelIndex& idxNode)
     }
 }
 
+void LoggingScopesModelBase::setTrafficColumns(bool show)
+{
+    if (show == mTrafficColumns)
+        return;
+
+    constexpr int lastColumn{ static_cast<int>(eColumn::ColumnCount) - 1 };
+    if (show)
+    {
+        beginInsertColumns(QModelIndex(), 1, lastColumn);
+        mTrafficColumns = true;
+        endInsertColumns();
+        mTrafficTimer.start();
+    }
+    else
+    {
+        mTrafficTimer.stop();
+        beginRemoveColumns(QModelIndex(), 1, lastColumn);
+        mTrafficColumns = false;
+        endRemoveColumns();
+        sort(static_cast<int>(eColumn::ColumnScope), Qt::SortOrder::AscendingOrder);
+    }
+}
+
 void LoggingScopesModelBase::setLoggingModel(LoggingModelBase* model)
 {
     if (model != nullptr)
@@ -158,30 +210,29 @@ void LoggingScopesModelBase::setLoggingModel(LoggingModelBase* model)
         mLoggingModel = model;
         _setupSignals(true);        
         slotLogServiceConnected();
+        emit signalLoggingModelChanged(mLoggingModel);
     }
     else if (mLoggingModel != nullptr)
     {
         _setupSignals(false);
         mLoggingModel = nullptr;
+        emit signalLoggingModelChanged(nullptr);
     }
 }
 
 QModelIndex LoggingScopesModelBase::index(int row, int column, const QModelIndex& parent) const
 {
-    if ((hasIndex(row, column, parent) == false) || (column != 0) || (mLoggingModel == nullptr))
+    if ((hasIndex(row, column, parent) == false) || (mLoggingModel == nullptr))
         return QModelIndex();
 
-    const LoggingModelBase::RootList& roots = mLoggingModel->getRootList();
     ScopeNodeBase* parentNode = parent.isValid() ? static_cast<ScopeNodeBase*>(parent.internalPointer()) : nullptr;
-    
+    ScopeNodeBase* childNode = _childAt(parentNode, row);
     if (parentNode == nullptr)
     {
-        ScopeRoot* root = (row >= 0) && (row < static_cast<int>(roots.size())) ? roots[row] : nullptr;
-        return (root != nullptr ? createIndex(row, column, root) : mRootIndex);
+        return (childNode != nullptr ? createIndex(row, column, childNode) : mRootIndex);
     }
     else
     {
-        ScopeNodeBase* childNode = parentNode->getChildAt(row);
         return (childNode != nullptr ? createIndex(row, column, childNode) : QModelIndex());
     }
 }
@@ -198,40 +249,72 @@ QModelIndex LoggingScopesModelBase::parent(const QModelIndex& child) const
 
     ScopeNodeBase* parentNode = childNode->getParent();
     Q_ASSERT(parentNode != nullptr);
-    if (parentNode->isRoot())
+    int pos = _rowOfNode(parentNode);
+    Q_ASSERT(pos != static_cast<int>(areg::INVALID_INDEX));
+    return createIndex(pos, 0, parentNode);
+}
+
+int LoggingScopesModelBase::rowCount(const QModelIndex& parent) const
+{
+    // Only the scope column has children.
+    if (parent.column() > 0)
+        return 0;
+
+    ScopeNodeBase* node = parent.isValid() ? static_cast<ScopeNodeBase*>(parent.internalPointer()) : nullptr;
+    if (node == nullptr)
     {
-        int pos = findRoot(static_cast<ScopeRoot*>(parentNode)->getRootId());
-        Q_ASSERT(pos != static_cast<int>(areg::INVALID_INDEX));
-        return createIndex(pos, 0, parentNode);
+        // Root level - return number of instances
+        return (mLoggingModel != nullptr ? static_cast<int>(mLoggingModel->getRootList().size()) : 0);
     }
     else
     {
-        ScopeNodeBase* grandParent = parentNode->getParent();
-        int pos = grandParent->getChildPosition(parentNode->getNodeName());
-        Q_ASSERT(pos != static_cast<int>(areg::INVALID_INDEX));
-        return createIndex(pos, 0, parentNode);
+        // Child level - the child nodes and the fetched leafs
+        return node->getFetchedCount();
     }
 }
 
-int LoggingScopesModelBase::rowCount(const QModelIndex& parent) const
+bool LoggingScopesModelBase::hasChildren(const QModelIndex& parent) const
 {
+    if (parent.column() > 0)
+        return false;
+
     ScopeNodeBase* node = parent.isValid() ? static_cast<ScopeNodeBase*>(parent.internalPointer()) : nullptr;
     if (node == nullptr)
     {
-        // Root level - return number of instances
-        return (mLoggingModel != nullptr ? static_cast<int>(mLoggingModel->getRootList().size()) : 0);
+        return (mLoggingModel != nullptr) && (mLoggingModel->getRootList().empty() == false);
     }
     else
     {
-        // Child level - get from the node
-        return node->getChildCount();
+        return node->hasChildren();
+    }
+}
+
+bool LoggingScopesModelBase::canFetchMore(const QModelIndex& parent) const
+{
+    ScopeNodeBase* node = parent.isValid() ? static_cast<ScopeNodeBase*>(parent.internalPointer()) : nullptr;
+    return (node != nullptr) && (node->getFetchedCount() < node->getChildCount());
+}
+
+void LoggingScopesModelBase::fetchMore(const QModelIndex& parent)
+{
+    ScopeNodeBase* node = parent.isValid() ? static_cast<ScopeNodeBase*>(parent.internalPointer()) : nullptr;
+    if (node == nullptr)
+        return;
+
+    const int first{ node->getFetchedCount() };
+    const int count{ std::min(FETCH_LEAFS_COUNT, node->getChildCount() - first) };
+    if (count > 0)
+    {
+        beginInsertRows(parent, first, first + count - 1);
+        node->fetchChildren(count);
+        endInsertRows();
     }
 }
 
 int LoggingScopesModelBase::columnCount(const QModelIndex& parent) const
 {
     Q_UNUSED(parent);
-    return 1;
+    return (mTrafficColumns ? static_cast<int>(eColumn::ColumnCount) : 1);
 }
 
 QVariant LoggingScopesModelBase::data(const QModelIndex& index, int role) const
@@ -244,25 +327,21 @@ QVariant LoggingScopesModelBase::data(const QModelIndex& index, int role) const
         return (static_cast<Qt::ItemDataRole>(role) == Qt::ItemDataRole::DisplayRole ? QVariant(tr("Scopes")) : QVariant());
     }
     
+    ScopeNodeBase* entry{ static_cast<ScopeNodeBase*>(index.internalPointer()) };
+    const eColumn column{ static_cast<eColumn>(index.column()) };
     switch (static_cast<Qt::ItemDataRole>(role))
     {
     case Qt::ItemDataRole::DisplayRole:
-    {
-        ScopeNodeBase* entry{ static_cast<ScopeNodeBase*>(index.internalPointer()) };
-        return entry->getDisplayName();
-    }
+        return (column == eColumn::ColumnScope ? entry->getDisplayName() : _trafficText(*entry, column));
     
     case Qt::ItemDataRole::DecorationRole:
-    {
-        ScopeNodeBase* entry{ static_cast<ScopeNodeBase*>(index.internalPointer()) };
-        return LogIconFactory::getIcon(entry->getPriority());
-    }
+        return (column == eColumn::ColumnScope ? QVariant(LogIconFactory::getIcon(entry->getPriority())) : QVariant());
+
+    case Qt::ItemDataRole::TextAlignmentRole:
+        return (column == eColumn::ColumnScope ? QVariant() : QVariant(static_cast<int>(Qt::AlignRight | Qt::AlignVCenter)));
     
     case Qt::ItemDataRole::UserRole:
-    {
-        ScopeNodeBase* entry{ static_cast<ScopeNodeBase*>(index.internalPointer()) };
         return QVariant::fromValue<ScopeNodeBase *>(entry);
-    }
         
     default:
         return QVariant();
@@ -271,12 +350,24 @@ QVariant LoggingScopesModelBase::data(const QModelIndex& index, int role) const
 
 QVariant LoggingScopesModelBase::headerData(int section, Qt::Orientation orientation, int role) const
 {
-    if ((orientation == Qt::Horizontal) && (role == Qt::DisplayRole) && (section == 0))
+    if ((orientation != Qt::Horizontal) || (role != Qt::DisplayRole))
+        return QVariant();
+
+    switch (static_cast<eColumn>(section))
     {
+    case eColumn::ColumnScope:
         return QString("Scopes");
+    case eColumn::ColumnRate:
+        return tr("Msg/s");
+    case eColumn::ColumnMessages:
+        return tr("Messages");
+    case eColumn::ColumnBytes:
+        return tr("Bytes");
+    case eColumn::ColumnLastSeen:
+        return tr("Last Seen");
+    default:
+        return QVariant();
     }
-
-    return QVariant();
 }
 
 Qt::ItemFlags LoggingScopesModelBase::flags(const QModelIndex& index) const
@@ -299,6 +390,18 @@ Qt::ItemFlags LoggingScopesModelBase::flags(const QModelIndex& index) const
     }
 }
 
+void LoggingScopesModelBase::sort(int column, Qt::SortOrder order /*= Qt::AscendingOrder*/)
+{
+    const bool isTraffic{ (column > 0) && (column < columnCount(QModelIndex())) };
+    const eColumn sortColumn{ isTraffic ? static_cast<eColumn>(column) : eColumn::ColumnScope };
+    if ((sortColumn == mSortColumn) && (order == mSortOrder))
+        return;
+
+    mSortColumn = sortColumn;
+    mSortOrder  = order;
+    _resort();
+}
+
 void LoggingScopesModelBase::buildScope(ScopeRoot& root, QString& scopePath, uint32_t scopePrio, uint32_t scopeId)
 {
     root.addChildRecursive(scopePath, scopePrio, scopeId);
@@ -406,7 +509,8 @@ void LoggingScopesModelBase::slotInstancesUnavailable(const std::vector<ITEM_ID>
                 if (root->getRootId() == rootId)
                 {
                     removed = true;
-                    beginRemoveRows(mRootIndex, i, i);
+                    const int row{ _rowOfNode(root) };
+                    beginRemoveRows(mRootIndex, row, row);
                     roots.erase(roots.begin() + i);
                     endRemoveRows();
                     break;
@@ -429,7 +533,7 @@ void LoggingScopesModelBase::slotScopesAvailable(ITEM_ID instId, const std::vect
         Q_ASSERT(mLoggingModel != nullptr);
         LoggingModelBase::RootList& roots = mLoggingModel->getRootList();
         int count = static_cast<int>(scopes.size());
-        QModelIndex idxInstance = index(pos, 0, mRootIndex);
+        QModelIndex idxInstance = indexOfNode(roots[pos]);
         beginInsertRows(idxInstance, 0, count);
         // beginResetModel();
 
@@ -442,9 +546,7 @@ void LoggingScopesModelBase::slotScopesAvailable(ITEM_ID instId, const std::vect
             buildScope(*root, scopePath, scopes[i].scopePrio, scopes[i].scopeId);
         }
 
-        root->resetPrioritiesRecursive(true);
-        root->refreshPrioritiesRecursive();
-
+        mSortedRows.clear();
         endInsertRows();
         // endResetModel();
         emit signalScopesInserted(idxInstance);
@@ -458,23 +560,148 @@ void LoggingScopesModelBase::slotScopesUpdated(ITEM_ID instId, const std::vector
     {
         Q_ASSERT(mLoggingModel != nullptr);
         LoggingModelBase::RootList& roots = mLoggingModel->getRootList();
-        QModelIndex idxInstance = index(pos, 0, mRootIndex);
+        QModelIndex idxInstance = indexOfNode(roots[pos]);
         int count = static_cast<int>(scopes.size());
         ScopeRoot* root = roots[pos];
         Q_ASSERT(root != nullptr);
+        std::vector<ScopeNodeBase*> changed;
         for (int i = 0; i < count; ++i)
         {
             const areg::ScopeEntry & scope = scopes[i];
-            QString scopeName{ scope.scopeName };
-            root->addChildPriorityRecursive(scopeName, scope.scopePrio);
+            ScopeNodeBase* leaf = root->findLeaf(scope.scopeId);
+            if (leaf == nullptr)
+            {
+                QString scopeName{ scope.scopeName };
+                leaf = root->findChildByPath(scopeName);
+            }
+
+            if ((leaf == nullptr) || (leaf->isLeaf() == false))
+            {
+                // A scope the instance did not report before, it is added with its priority.
+                _insertScope(*root, scope);
+                leaf = root->findLeaf(scope.scopeId);
+                if (leaf != nullptr)
+                {
+                    changed.push_back(leaf);
+                }
+            }
+            // The nodes on the path of the leaf are updated together with the leaf.
+            else if (leaf->getPriority() != scope.scopePrio)
+            {
+                const uint32_t oldPrio{ leaf->getPriority() };
+                leaf->setPriority(scope.scopePrio);
+                if (leaf->getPriority() != oldPrio)
+                {
+                    changed.push_back(leaf);
+                }
+            }
         }
 
-        root->resetPrioritiesRecursive(true);
-        root->refreshPrioritiesRecursive();
+        if (changed.empty() == false)
+        {
+            notifyPriorityChanged(changed);
+            emit signalScopesUpdated(idxInstance);
+        }
+    }
+}
 
-        QModelIndex entry = index(pos, 0, mRootIndex);
-        emit signalScopesUpdated(idxInstance);
-        emit dataChanged(entry, entry, { Qt::ItemDataRole::DecorationRole, Qt::ItemDataRole::DisplayRole });
+QModelIndex LoggingScopesModelBase::indexOfNode(const ScopeNodeBase* node) const
+{
+    const int row{ _rowOfNode(node) };
+    return (row != static_cast<int>(areg::INVALID_INDEX) ? createIndex(row, 0, const_cast<ScopeNodeBase*>(node)) : QModelIndex());
+}
+
+void LoggingScopesModelBase::notifyPriorityChanged(const std::vector<ScopeNodeBase*>& nodes)
+{
+    // The paths of the nodes share the parents, every node is notified once.
+    QSet<const ScopeNodeBase*> notified;
+    for (const ScopeNodeBase* node : nodes)
+    {
+        for ( ; (node != nullptr) && (notified.contains(node) == false); node = node->getParent())
+        {
+            notified.insert(node);
+            QModelIndex idxNode{ indexOfNode(node) };
+            if (idxNode.isValid())
+            {
+                emit dataChanged(idxNode, idxNode, { Qt::ItemDataRole::DecorationRole, Qt::ItemDataRole::DisplayRole });
+            }
+        }
+    }
+
+    for (const ScopeNodeBase* node : nodes)
+    {
+        if ((node != nullptr) && (node->isLeaf() == false))
+        {
+            _notifySubtree(node);
+        }
+    }
+}
+
+void LoggingScopesModelBase::_insertScope(ScopeRoot& root, const areg::ScopeEntry& scope)
+{
+    QString scopePath{ scope.scopeName };
+    QStringList names;
+    if (root.splitScopePath(scopePath, names) == 0)
+        return;
+
+    // The deepest node of the path, which exists already, gets the new child.
+    ScopeNode* parent{ &root };
+    int level{ 0 };
+    for (; level < static_cast<int>(names.size()) - 1; ++level)
+    {
+        ScopeNodeBase* child{ parent->findChild(names[level]) };
+        if ((child == nullptr) || (child->isNode() == false))
+            break;
+
+        parent = static_cast<ScopeNode*>(child);
+    }
+
+    const bool isNode{ level < static_cast<int>(names.size()) - 1 };
+    const int treeRow{ parent->getInsertRow(names[level], isNode) };
+    const QModelIndex idxParent{ indexOfNode(parent) };
+    if ((treeRow == static_cast<int>(areg::INVALID_INDEX)) || (idxParent.isValid() == false))
+    {
+        // The new child is not shown yet, it is fetched as the rest of the leafs.
+        buildScope(root, scopePath, scope.scopePrio, scope.scopeId);
+        return;
+    }
+
+    // The sorted rows place the new child after the rows already shown, until the next sort.
+    const bool sorted{ _isSorted() };
+    const int row{ sorted ? static_cast<int>(_sortedChildren(parent).size()) : treeRow };
+    beginInsertRows(idxParent, row, row);
+    buildScope(root, scopePath, scope.scopePrio, scope.scopeId);
+    if (sorted)
+    {
+        std::vector<ScopeNodeBase*>& rows{ mSortedRows[parent] };
+        if (static_cast<int>(rows.size()) == row)
+        {
+            rows.push_back(parent->getChildAt(treeRow));
+        }
+        else
+        {
+            rows.clear();
+        }
+    }
+
+    endInsertRows();
+}
+
+void LoggingScopesModelBase::_notifySubtree(const ScopeNodeBase* node)
+{
+    const int count{ node->getFetchedCount() };
+    const QModelIndex idxNode{ indexOfNode(node) };
+    if ((count == 0) || (idxNode.isValid() == false))
+        return;
+
+    emit dataChanged(index(0, 0, idxNode), index(count - 1, 0, idxNode), { Qt::ItemDataRole::DecorationRole, Qt::ItemDataRole::DisplayRole });
+    for (int i = 0; i < count; ++i)
+    {
+        const ScopeNodeBase* child{ node->getChildAt(i) };
+        if ((child != nullptr) && (child->isLeaf() == false))
+        {
+            _notifySubtree(child);
+        }
     }
 }
 
@@ -518,6 +745,191 @@ void LoggingScopesModelBase::_setupSignals(bool doSetup)
     }
 }
 
+const std::vector<ScopeNodeBase*>& LoggingScopesModelBase::_sortedChildren(const ScopeNodeBase* parent) const
+{
+    Q_ASSERT(mLoggingModel != nullptr);
+    const LoggingModelBase::RootList& roots = mLoggingModel->getRootList();
+    std::vector<ScopeNodeBase*>& rows{ mSortedRows[parent] };
+    const int count{ parent != nullptr ? parent->getFetchedCount() : static_cast<int>(roots.size()) };
+    if (static_cast<int>(rows.size()) > count)
+    {
+        rows.clear();
+    }
+
+    // The fetched leafs are appended to the end, as the rows are inserted.
+    const bool doSort{ rows.empty() };
+    rows.reserve(count);
+    for (int i = static_cast<int>(rows.size()); i < count; ++i)
+    {
+        rows.push_back(parent != nullptr ? parent->getChildAt(i) : roots[i]);
+    }
+
+    if (doSort && (count > 1))
+    {
+        // The children are in the order of the tree, the nodes before the leafs and sorted by name.
+        // The stable sort keeps the order by name of the equal values.
+        const TIME64 now{ _trafficNow() };
+        const bool ascending{ mSortOrder == Qt::SortOrder::AscendingOrder };
+        std::stable_sort(rows.begin(), rows.end(), [this, now, ascending](const ScopeNodeBase* lhs, const ScopeNodeBase* rhs) -> bool {
+            if (lhs->isLeaf() != rhs->isLeaf())
+                return rhs->isLeaf();
+
+            const int result{ _compareNodes(*lhs, *rhs, now) };
+            return (ascending ? result < 0 : result > 0);
+        });
+    }
+
+    return rows;
+}
+
+ScopeNodeBase* LoggingScopesModelBase::_childAt(const ScopeNodeBase* parent, int row) const
+{
+    if (_isSorted())
+    {
+        const std::vector<ScopeNodeBase*>& rows{ _sortedChildren(parent) };
+        return ((row >= 0) && (row < static_cast<int>(rows.size())) ? rows[row] : nullptr);
+    }
+    else if (parent == nullptr)
+    {
+        const LoggingModelBase::RootList& roots = mLoggingModel->getRootList();
+        return ((row >= 0) && (row < static_cast<int>(roots.size())) ? roots[row] : nullptr);
+    }
+    else
+    {
+        return parent->getChildAt(row);
+    }
+}
+
+int LoggingScopesModelBase::_rowOfNode(const ScopeNodeBase* node) const
+{
+    const ScopeNodeBase* parent{ (node != nullptr) && (node->isRoot() == false) ? node->getParent() : nullptr };
+    if ((node == nullptr) || (mLoggingModel == nullptr) || ((node->isRoot() == false) && (parent == nullptr)))
+        return static_cast<int>(areg::INVALID_INDEX);
+
+    int row{ static_cast<int>(areg::INVALID_INDEX) };
+    if (_isSorted())
+    {
+        const std::vector<ScopeNodeBase*>& rows{ _sortedChildren(parent) };
+        auto pos = std::find(rows.begin(), rows.end(), node);
+        row = pos != rows.end() ? static_cast<int>(pos - rows.begin()) : static_cast<int>(areg::INVALID_INDEX);
+    }
+    else if (parent == nullptr)
+    {
+        row = findRoot(static_cast<const ScopeRoot*>(node)->getRootId());
+    }
+    else
+    {
+        // The leafs, which are not fetched yet, have no rows in the model.
+        row = parent->getChildRow(*node);
+        row = row < parent->getFetchedCount() ? row : static_cast<int>(areg::INVALID_INDEX);
+    }
+
+    return row;
+}
+
+int LoggingScopesModelBase::_compareNodes(const ScopeNodeBase& lhs, const ScopeNodeBase& rhs, TIME64 now) const
+{
+    const ScopeTraffic& left{ lhs.getTraffic() };
+    const ScopeTraffic& right{ rhs.getTraffic() };
+    switch (mSortColumn)
+    {
+    case eColumn::ColumnRate:
+        return compareValues(left.getRate(now), right.getRate(now));
+    case eColumn::ColumnMessages:
+        return compareValues(left.getMessages(), right.getMessages());
+    case eColumn::ColumnBytes:
+        return compareValues(left.getBytes(), right.getBytes());
+    case eColumn::ColumnLastSeen:
+        return compareValues(left.getLastSeen(), right.getLastSeen());
+    case eColumn::ColumnScope:
+    default:
+        return lhs.getNodeName().compare(rhs.getNodeName());
+    }
+}
+
+void LoggingScopesModelBase::_resort()
+{
+    emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::LayoutChangeHint::VerticalSortHint);
+
+    const QModelIndexList oldList{ persistentIndexList() };
+    mSortedRows.clear();
+    QModelIndexList newList;
+    newList.reserve(oldList.size());
+    for (const QModelIndex& idxOld : oldList)
+    {
+        ScopeNodeBase* node{ static_cast<ScopeNodeBase*>(idxOld.internalPointer()) };
+        const int row{ node != nullptr ? _rowOfNode(node) : static_cast<int>(areg::INVALID_INDEX) };
+        newList.append(row != static_cast<int>(areg::INVALID_INDEX) ? createIndex(row, idxOld.column(), node) : idxOld);
+    }
+
+    changePersistentIndexList(oldList, newList);
+    emit layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::LayoutChangeHint::VerticalSortHint);
+}
+
+void LoggingScopesModelBase::_refreshTraffic()
+{
+    if ((mTrafficColumns == false) || (mLoggingModel == nullptr))
+        return;
+
+    if (mSortColumn != eColumn::ColumnScope)
+    {
+        // The order depends on the statistics, the changed layout repaints the rows.
+        _resort();
+    }
+    else
+    {
+        _refreshTrafficRows(QModelIndex());
+    }
+}
+
+void LoggingScopesModelBase::_refreshTrafficRows(const QModelIndex& parent)
+{
+    const int count{ rowCount(parent) };
+    if (count == 0)
+        return;
+
+    emit dataChanged( index(0, static_cast<int>(eColumn::ColumnRate), parent)
+                    , index(count - 1, static_cast<int>(eColumn::ColumnLastSeen), parent)
+                    , { Qt::ItemDataRole::DisplayRole });
+
+    // The child nodes are placed before the leafs, the rows of the collapsed nodes are not visible.
+    const ScopeNodeBase* parentNode{ parent.isValid() ? static_cast<const ScopeNodeBase*>(parent.internalPointer()) : nullptr };
+    const int nodes{ parentNode != nullptr ? std::min(parentNode->getChildNodesCount(), count) : count };
+    for (int row = 0; row < nodes; ++row)
+    {
+        const ScopeNodeBase* node{ _childAt(parentNode, row) };
+        if ((node != nullptr) && (node->isLeaf() == false) && node->isNodeExpanded())
+        {
+            _refreshTrafficRows(index(row, 0, parent));
+        }
+    }
+}
+
+TIME64 LoggingScopesModelBase::_trafficNow() const
+{
+    // The timestamps of the messages are in microseconds.
+    const bool offline{ (mLoggingModel == nullptr) || mLoggingModel->isOfflineLogging() };
+    return (offline ? 0u : static_cast<TIME64>(QDateTime::currentMSecsSinceEpoch()) * 1000u);
+}
+
+QString LoggingScopesModelBase::_trafficText(const ScopeNodeBase& node, eColumn column) const
+{
+    const ScopeTraffic& traffic{ node.getTraffic() };
+    switch (column)
+    {
+    case eColumn::ColumnRate:
+        return QString::number(traffic.getRate(_trafficNow()), 'f', 1);
+    case eColumn::ColumnMessages:
+        return QString::number(traffic.getMessages());
+    case eColumn::ColumnBytes:
+        return QLocale().formattedDataSize(static_cast<qint64>(traffic.getBytes()));
+    case eColumn::ColumnLastSeen:
+        return (traffic.getLastSeen() != 0u ? QString::fromStdString(areg::DateTime(traffic.getLastSeen()).format_time().data()) : QString());
+    default:
+        return QString();
+    }
+}
+
 void LoggingScopesModelBase::buildScopes()
 {
     if (mLoggingModel == nullptr)
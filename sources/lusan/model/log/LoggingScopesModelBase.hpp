@@ -23,8 +23,12 @@
  * Includes
  ************************************************************************/
 #include <QAbstractItemModel>
+#include <QHash>
 #include <QList>
 #include <QMap>
+#include <QTimer>
+
+#include <vector>
 
 #include "areg/component/ServiceDefs.hpp"
 #include "areg/logging/areg_log.h"
@@ -45,6 +49,30 @@ class LoggingScopesModelBase : public QAbstractItemModel
 {
     Q_OBJECT
 
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The number of the leafs of the node fetched at once, when the node is expanded or scrolled to the end.
+    static constexpr int    FETCH_LEAFS_COUNT   { 256 };
+
+    //!< The timeout in milliseconds to refresh the traffic statistics of the scopes.
+    static constexpr int    TRAFFIC_REFRESH_MS  { 1000 };
+
+    /**
+     * \brief   The columns of the scope tree. The columns of the traffic statistics are optional.
+     **/
+    enum class eColumn : int
+    {
+          ColumnScope       = 0 //!< The name of the scope, the column of the tree.
+        , ColumnRate            //!< The number of messages per second.
+        , ColumnMessages        //!< The number of messages.
+        , ColumnBytes           //!< The number of bytes of the message texts.
+        , ColumnLastSeen        //!< The time of the last message.
+
+        , ColumnCount           //!< The number of columns.
+    };
+
 //////////////////////////////////////////////////////////////////////////
 // Constructor / Destructor
 //////////////////////////////////////////////////////////////////////////
@@ -107,6 +135,26 @@ public:
      * \param   idxNode     The index of the collapsed scope node.
      **/
     void nodeTreeCollapsed(const QModelIndex& idxNode);
+
+    /**
+     * \brief   Shows or hides the columns of the traffic statistics of the scopes. While the columns
+     *          are shown, the statistics are refreshed every TRAFFIC_REFRESH_MS milliseconds.
+     *          When the columns are hidden, the scopes are sorted by name again.
+     * \param   show    If true, shows the columns. Otherwise, hides the columns.
+     **/
+    void setTrafficColumns(bool show);
+
+    /**
+     * \brief   Returns true if the columns of the traffic statistics are shown.
+     **/
+    inline bool hasTrafficColumns() const;
+
+    /**
+     * \brief   Returns the index of the node of the scope tree, or invalid index if the node is not in the model
+     *          or is a leaf, which is not fetched yet.
+     * \param   node    The node of the scope tree.
+     **/
+    QModelIndex indexOfNode(const ScopeNodeBase* node) const;
     
 /************************************************************************
  * Signals
@@ -130,6 +178,12 @@ signals:
      * \param   parent  The index of the parent instance item that is updated.
      **/
     void signalScopesUpdated(const QModelIndex& parent);
+
+    /**
+     * \brief   Signal emitted when the logging model of the scopes is set or cleared.
+     * \param   model   The new logging model, or nullptr if the model is cleared.
+     **/
+    void signalLoggingModelChanged(LoggingModelBase* model);
     
 //////////////////////////////////////////////////////////////////////////
 // LoggingScopesModelBase overrides
@@ -241,6 +295,24 @@ public:
      **/
     int rowCount(const QModelIndex& parent) const override;
 
+    /**
+     * \brief   Returns true if the parent has children, including the leafs that are not fetched yet.
+     * \param   parent  The parent index.
+     **/
+    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+
+    /**
+     * \brief   Returns true if the parent node has leafs that are not fetched yet.
+     * \param   parent  The parent index.
+     **/
+    bool canFetchMore(const QModelIndex& parent) const override;
+
+    /**
+     * \brief   Fetches the next FETCH_LEAFS_COUNT leafs of the parent node and inserts them as rows.
+     * \param   parent  The parent index.
+     **/
+    void fetchMore(const QModelIndex& parent) override;
+
     /**
      * \brief   Returns the number of columns for the children of the given parent.
      * \param   parent  The parent index.
@@ -271,6 +343,14 @@ public:
      * \return  The flags of the item.
      **/
     Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    /**
+     * \brief   Sorts the child nodes and leafs of every node by the given column. The child nodes
+     *          are always placed before the leafs, the scopes with equal values keep the order by name.
+     * \param   column  The column to sort.
+     * \param   order   The sort order.
+     **/
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
     
 //////////////////////////////////////////////////////////////////////////
 // Internal overrides
@@ -314,6 +394,14 @@ protected:
      **/
     int findRoot(ITEM_ID rootId) const;
 
+    /**
+     * \brief   Notifies that the priorities of the nodes and of their parent nodes up to the instance are changed.
+     *          Every node of the paths is notified once. A node, which is not a leaf, changes the priorities
+     *          of its leafs, so the fetched rows of its subtree are notified as well.
+     * \param   nodes   The list of nodes with changed priority.
+     **/
+    void notifyPriorityChanged(const std::vector<ScopeNodeBase*>& nodes);
+
 //////////////////////////////////////////////////////////////////////////
 // Slots
 //////////////////////////////////////////////////////////////////////////
@@ -378,6 +466,44 @@ private:
      **/
     void _setupSignals(bool doSetup);
 
+    //!< Returns true if the rows are not in the order of the scope tree.
+    inline bool _isSorted() const;
+
+    //!< Adds the scope, which is not in the tree of the root yet. The first missing node or leaf of
+    //!< its path is the only new row, it is inserted if its parent shows it.
+    void _insertScope(ScopeRoot& root, const areg::ScopeEntry& scope);
+
+    //!< Notifies the fetched rows of the subtree of the node, which priorities follow the node.
+    void _notifySubtree(const ScopeNodeBase* node);
+
+    //!< Returns the sorted fetched children of the node, or the sorted roots if the node is nullptr.
+    //!< The rows fetched after sorting are appended and sorted on the next refresh.
+    const std::vector<ScopeNodeBase*>& _sortedChildren(const ScopeNodeBase* parent) const;
+
+    //!< Returns the node at the row of the parent node, or the root at the row if the parent is nullptr.
+    ScopeNodeBase* _childAt(const ScopeNodeBase* parent, int row) const;
+
+    //!< Returns the row of the node in the model, or NECommon::INVALID_INDEX if the node has no row.
+    int _rowOfNode(const ScopeNodeBase* node) const;
+
+    //!< Compares the nodes by the value of the sorted column, returns negative, zero or positive value.
+    int _compareNodes(const ScopeNodeBase& lhs, const ScopeNodeBase& rhs, TIME64 now) const;
+
+    //!< Sorts the rows again and updates the persistent indexes.
+    void _resort();
+
+    //!< Refreshes the traffic statistics. Triggered by the timer.
+    void _refreshTraffic();
+
+    //!< Notifies the change of the traffic statistics of the children of the parent and of the expanded child nodes.
+    void _refreshTrafficRows(const QModelIndex& parent);
+
+    //!< Returns the current time to calculate the rate of the messages. In offline mode returns zero to get the average rate.
+    TIME64 _trafficNow() const;
+
+    //!< Returns the text of the traffic statistics of the node to display in the column.
+    QString _trafficText(const ScopeNodeBase& node, eColumn column) const;
+
 //////////////////////////////////////////////////////////////////////////
 // Protected member variables
 //////////////////////////////////////////////////////////////////////////
@@ -396,6 +522,12 @@ private:
     QMetaObject::Connection mConInstUnavailable;    // The connection to instances unavailable signal
     QMetaObject::Connection mConScopesAvailable;    // The connection to scopes available signal
     QMetaObject::Connection mConScopesUnavailable;  // The connection to scopes unavailable signal
+    bool                    mTrafficColumns;        // The flag, indicating whether the columns of the traffic statistics are shown
+    eColumn                 mSortColumn;            // The sorted column
+    Qt::SortOrder           mSortOrder;             // The sort order
+    QTimer                  mTrafficTimer;          // The timer to refresh the traffic statistics
+    //!< Per parent node, the sorted children. The key nullptr is the list of roots.
+    mutable QHash<const ScopeNodeBase*, std::vector<ScopeNodeBase*>>   mSortedRows;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -404,7 +536,17 @@ private:
 
 inline bool LoggingScopesModelBase::isValidIndex(const QModelIndex& index) const
 {
-    return (index.isValid() && (index.row() >= 0) && (index.column() == 0) && (index.model() == this));
+    return (index.isValid() && (index.row() >= 0) && (index.column() >= 0) && (index.column() < columnCount(QModelIndex())) && (index.model() == this));
+}
+
+inline bool LoggingScopesModelBase::hasTrafficColumns() const
+{
+    return mTrafficColumns;
+}
+
+inline bool LoggingScopesModelBase::_isSorted() const
+{
+    return (mSortColumn != eColumn::ColumnScope) || (mSortOrder != Qt::SortOrder::AscendingOrder);
 }
 
 inline const QModelIndex& LoggingScopesModelBase::getRootIndex() const
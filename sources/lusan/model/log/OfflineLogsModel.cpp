@@ -28,13 +28,20 @@
 
 #include <QFileInfo>
 
+#include <memory>
+
 OfflineLogsModel::OfflineLogsModel(QObject *parent)
     : LoggingModelBase(LoggingModelBase::eLogging::LoggingOffline, parent)
+    , mTreeBuilder      ( )
+    , mScopeTrees       ( )
+    , mTreeGeneration   ( 0u )
+    , mBuildingTrees    ( false )
 {
 }
 
 OfflineLogsModel::~OfflineLogsModel()
 {
+    _stopScopeTrees();
     _closeDatabase();
 }
 
@@ -43,6 +50,7 @@ void OfflineLogsModel::openDatabase(const QString& filePath, bool readOnly)
     if (mDatabase.is_operable() && (mLogs.empty() == false) && (mDatabase.database_path() == filePath))
         return;
 
+    _stopScopeTrees();
     _closeDatabase(); // Close any existing database    
     if (filePath.isEmpty())
         return;
@@ -60,14 +68,15 @@ void OfflineLogsModel::openDatabase(const QString& filePath, bool readOnly)
         mDatabase.log_instance_infos(mInstances);
         emit signalInstanceAvailable(mInstances);
         
+        // The scopes are read and the trees are built in the worker threads. Until they are
+        // received, the instances have no scopes, and nothing reads them in this thread.
         mScopes.clear();
-        for (const auto & inst : mInstances)
+        for (const auto& inst : mInstances)
         {
-            std::vector<areg::ScopeEntry> scopes;
-            mDatabase.log_inst_scopes(scopes, inst.ciCookie);
-            mScopes[inst.ciCookie] = scopes;
-            emit signalScopesAvailable(inst.ciCookie, scopes);
+            mScopes[inst.ciCookie] = std::vector<areg::ScopeEntry>{};
         }
+
+        _buildScopeTrees();
         
         mDatabase.setup_filter_logs(areg::TARGET_ALL, areg::ArrayList<areg::ext::LogSqliteDatabase::ScopeFilter>{});
         readLogsAsynchronous(OfflineLogsModel::DEFAULT_LOG_CHUNK);
@@ -81,7 +90,60 @@ uint32_t OfflineLogsModel::setupLogStatement(ITEM_ID instId /*= areg::TARGET_ALL
 
 void OfflineLogsModel::closeDatabase()
 {
+    _stopScopeTrees();
     _closeDatabase();
     emit signalDatabaseIsClosed(QString::fromStdString(mDatabase.database_path().data()));
 }
 
+void OfflineLogsModel::_buildScopeTrees()
+{
+    ScopeTreeBuilder::ListTrees trees(mInstances.size());
+    for (uint32_t i = 0u; i < static_cast<uint32_t>(mInstances.size()); ++i)
+    {
+        trees[i].instance = mInstances[i];
+    }
+
+    const uint32_t generation{ ++ mTreeGeneration };
+    mBuildingTrees = mTreeBuilder.start(mDatabase.database_path().data(), std::move(trees), OfflineLogsModel::INIT_SCOPE_PRIO
+                                        , [this, generation](ScopeTreeBuilder::ListTrees& built)
+                                          {
+                                              // Runs in the worker thread, the trees are handed over to the thread of the model.
+                                              std::shared_ptr<ScopeTreeBuilder::ListTrees> result{ std::make_shared<ScopeTreeBuilder::ListTrees>(std::move(built)) };
+                                              QMetaObject::invokeMethod(this
+                                                                       , [this, generation, result]()
+                                                                         {
+                                                                             _applyScopeTrees(std::move(*result), generation);
+                                                                         }
+                                                                       , Qt::ConnectionType::QueuedConnection);
+                                          });
+}
+
+void OfflineLogsModel::_applyScopeTrees(ScopeTreeBuilder::ListTrees&& trees, uint32_t generation)
+{
+    if (generation != mTreeGeneration)
+        return; // the database is closed or opened again, the trees are outdated
+
+    mBuildingTrees = false;
+    mTreeBuilder.wait();
+    for (const ScopeTreeBuilder::sScopeTree& tree : trees)
+    {
+        mScopes[tree.instance.ciCookie] = tree.scopes;
+    }
+
+    mScopeTrees = std::move(trees);
+    emit signalScopeTreesBuilt();
+
+    // The trees are adopted, the rest of the views learn the scopes of every instance.
+    for (const auto& inst : mInstances)
+    {
+        emit signalScopesAvailable(inst.ciCookie, mScopes[inst.ciCookie]);
+    }
+}
+
+void OfflineLogsModel::_stopScopeTrees()
+{
+    ++ mTreeGeneration;
+    mTreeBuilder.cancel();
+    mScopeTrees.clear();
+    mBuildingTrees = false;
+}
@@ -23,11 +23,14 @@
  * Includes
  ************************************************************************/
 #include "lusan/model/log/LoggingModelBase.hpp"
+#include "lusan/data/log/ScopeTreeBuilder.hpp"
 
 /**
  * \brief   The offline log navigation model for reading log data from local database files.
  *          This model provides offline access to historical log data stored in database files
  *          using the LogSqliteDatabase class from the Areg Framework.
+ *          The scopes of the instances are read and their trees are built in the worker threads
+ *          while the file opens, the built trees are taken by the scopes model at once.
  **/
 class OfflineLogsModel : public LoggingModelBase
 {
@@ -36,6 +39,10 @@ class OfflineLogsModel : public LoggingModelBase
 //////////////////////////////////////////////////////////////////////////
 // Internal types and constants
 //////////////////////////////////////////////////////////////////////////
+public:
+    //!< The priority of the scopes of the built trees, initially the offline logs of all priorities are shown.
+    static  constexpr   uint32_t    INIT_SCOPE_PRIO { static_cast<uint32_t>(areg::LogPriority::PrioScopeLogs) };
+
 private:
     static  constexpr   int DEFAULT_LOG_CHUNK   { 1000 };   // The default size of the log chunk to read in one loop from database.
 
@@ -70,6 +77,26 @@ public:
      **/
     uint32_t setupLogStatement(ITEM_ID instId = areg::TARGET_ALL, int32_t limit = -1, uint32_t offset = 0u) override;
 
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Returns true if the scope trees of the opened database are being built.
+     **/
+    inline bool isBuildingScopeTrees() const;
+
+    /**
+     * \brief   Returns true if there are built scope trees, which are not taken yet.
+     **/
+    inline bool hasScopeTrees() const;
+
+    /**
+     * \brief   Takes the built scope trees. The caller owns the roots of the trees.
+     **/
+    inline ScopeTreeBuilder::ListTrees takeScopeTrees();
+
 //////////////////////////////////////////////////////////////////////////
 // Signals
 //////////////////////////////////////////////////////////////////////////
@@ -87,6 +114,55 @@ signals:
      **/
     void signalDatabaseIsClosed(const QString& dbPath);
 
+    /**
+     * \brief   Signal, triggered when the scope trees of the instances of the opened database are built.
+     *          The trees are taken by calling takeScopeTrees().
+     **/
+    void signalScopeTreesBuilt();
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Starts building the scope trees of the instances in the worker threads.
+    void _buildScopeTrees();
+
+    //!< Receives the built scope trees in the thread of the model.
+    void _applyScopeTrees(ScopeTreeBuilder::ListTrees&& trees, uint32_t generation);
+
+    //!< Cancels building the scope trees and drops the built trees.
+    void _stopScopeTrees();
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    ScopeTreeBuilder            mTreeBuilder;       //!< Builds the scope trees in the worker threads.
+    ScopeTreeBuilder::ListTrees mScopeTrees;        //!< The built scope trees, not taken yet.
+    uint32_t                    mTreeGeneration;    //!< Identifies the running build, so that the trees of a closed database are dropped.
+    bool                        mBuildingTrees;     //!< Flag, indicating whether the scope trees are being built.
 };
 
+//////////////////////////////////////////////////////////////////////////
+// OfflineLogsModel class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline bool OfflineLogsModel::isBuildingScopeTrees() const
+{
+    return mBuildingTrees;
+}
+
+inline bool OfflineLogsModel::hasScopeTrees() const
+{
+    return (mScopeTrees.empty() == false);
+}
+
+inline ScopeTreeBuilder::ListTrees OfflineLogsModel::takeScopeTrees()
+{
+    ScopeTreeBuilder::ListTrees result;
+    result.swap(mScopeTrees);
+    return result;
+}
+
 #endif // LUSAN_MODEL_LOG_OFFLINELOGSMODEL_HPP
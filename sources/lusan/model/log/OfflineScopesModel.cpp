@@ -35,12 +35,14 @@
 OfflineScopesModel::OfflineScopesModel(QObject* parent)
     : LoggingScopesModelBase(parent)
     , mMapScopeFilter       ( )
+    , mConTreesBuilt        ( )
 {
     mRootIndex = createIndex(0, 0, nullptr);
 }
 
 OfflineScopesModel::~OfflineScopesModel()
 {
+    disconnect(mConTreesBuilt);
 }
 
 bool OfflineScopesModel::setLogPriority(const QModelIndex& index, uint32_t prio)
@@ -205,10 +207,27 @@ bool OfflineScopesModel::saveLogScopePriority(const QModelIndex& target) const
 
 void OfflineScopesModel::setLoggingModel(LoggingModelBase* model)
 {
+    disconnect(mConTreesBuilt);
     LoggingScopesModelBase::setLoggingModel(model);
+    OfflineLogsModel* offline{ qobject_cast<OfflineLogsModel*>(model) };
+    if (offline != nullptr)
+    {
+        mConTreesBuilt = connect(offline, &OfflineLogsModel::signalScopeTreesBuilt, this, [this]() { _adoptScopeTrees(); });
+    }
+
     if ((model != nullptr) && model->isOperable())
     {
-        if (model->rootCount() == 0)
+        if ((offline != nullptr) && (offline->isBuildingScopeTrees() || offline->hasScopeTrees()))
+        {
+            // The instances are listed until the trees built in the worker threads are adopted.
+            if (model->rootCount() == 0)
+            {
+                slotInstancesAvailable(model->getLogInstances());
+            }
+
+            _adoptScopeTrees();
+        }
+        else if (model->rootCount() == 0)
         {
             const std::vector<areg::ConnectedInstance>& instances = model->getLogInstances();
             slotInstancesAvailable(instances);
@@ -231,6 +250,16 @@ void OfflineScopesModel::setLoggingModel(LoggingModelBase* model)
     }
 }
 
+void OfflineScopesModel::slotScopesAvailable(ITEM_ID instId, const std::vector<areg::ScopeEntry>& scopes)
+{
+    // The scope trees of the offline logs are built in the worker threads and adopted at once,
+    // the scopes received for each instance afterwards are already in the tree.
+    if (qobject_cast<OfflineLogsModel*>(mLoggingModel) != nullptr)
+        return;
+
+    LoggingScopesModelBase::slotScopesAvailable(instId, scopes);
+}
+
 void OfflineScopesModel::buildScope(ScopeRoot& root, QString& scopePath, uint32_t scopePrio, uint32_t scopeId)
 {
     scopePrio = INIT_LOG_PRIO; // change scope prio
@@ -265,6 +294,49 @@ void OfflineScopesModel::_buildScopeTree()
     endResetModel();
 }
 
+void OfflineScopesModel::_adoptScopeTrees()
+{
+    OfflineLogsModel* offline{ qobject_cast<OfflineLogsModel*>(mLoggingModel) };
+    if ((offline == nullptr) || (offline->hasScopeTrees() == false))
+        return;
+
+    static_assert(OfflineScopesModel::INIT_LOG_PRIO == OfflineLogsModel::INIT_SCOPE_PRIO, "The scopes of the built trees must have the initial filter priority");
+    ScopeTreeBuilder::ListTrees trees{ offline->takeScopeTrees() };
+    beginResetModel();
+    LoggingModelBase::RootList& roots = mLoggingModel->getRootList();
+    for (ScopeTreeBuilder::sScopeTree& tree : trees)
+    {
+        ScopeRoot* root = tree.root.release();
+        if (root == nullptr)
+            continue;
+
+        const ITEM_ID instId{ root->getRootId() };
+        auto pos = mMapScopeFilter.add_if_unique(instId, ScopeFilters{}, false).first;
+        ASSERT(mMapScopeFilter.is_valid_position(pos));
+        ScopeFilters& filterPrio = mMapScopeFilter.value_at(pos);
+        for (const areg::ScopeEntry& scope : tree.scopes)
+        {
+            filterPrio[scope.scopeId] = INIT_LOG_PRIO;
+        }
+
+        const int row{ findRoot(instId) };
+        if (row != static_cast<int>(areg::INVALID_INDEX))
+        {
+            delete roots[row];
+            roots[row] = root;
+        }
+        else
+        {
+            roots.push_back(root);
+        }
+    }
+
+    // The logs read before the trees are adopted are counted again in the new nodes.
+    mLoggingModel->recountTraffic();
+    endResetModel();
+    emit signalRootUpdated(mRootIndex);
+}
+
 uint32_t OfflineScopesModel::_logFilterPrio(uint32_t prio) const
 {
     std::function funcPrio = [](areg::LogPriority prio) -> uint32_t {
@@ -42,7 +42,8 @@ class OfflineLogsModel;
 /**
  * \brief   Offline log scope model to visualize scopes in the scope navigation windows for offline mode.
  *          This model reads scope information from OfflineLogsModel and builds a tree structure
- *          using ScopeNodes for navigation in offline mode.
+ *          using ScopeNodes for navigation in offline mode. The trees built by OfflineLogsModel
+ *          in the worker threads are adopted at once, replacing the roots of the instances.
  **/
 class OfflineScopesModel : public LoggingScopesModelBase
 {
@@ -136,6 +137,12 @@ protected:
      **/
     void buildScope(ScopeRoot& root, QString& scopePath, uint32_t scopePrio, uint32_t scopeId) override;
 
+    /**
+     * \brief   Receives the scopes of the instance. The scopes of the offline logs model are
+     *          already in the trees adopted from the worker threads and are not added again.
+     **/
+    void slotScopesAvailable(ITEM_ID instId, const std::vector<areg::ScopeEntry>& scopes) override;
+
 //////////////////////////////////////////////////////////////////////////
 // Hidden methods
 //////////////////////////////////////////////////////////////////////////
@@ -146,6 +153,12 @@ private:
      **/
     void _buildScopeTree();
 
+    /**
+     * \brief   Takes the scope trees built by the offline logging model and replaces the roots
+     *          of the instances in one reset of the model.
+     **/
+    void _adoptScopeTrees();
+
     //!< Returns the combined allowed log priority for the given priority.
     uint32_t _logFilterPrio(uint32_t prio) const;
     
@@ -153,7 +166,8 @@ private:
 // Member variables
 //////////////////////////////////////////////////////////////////////////
 private:
-    MapScopeFilter  mMapScopeFilter;    //<!< The map of scope filters, where key is the instance ID and values is the pair of scope ID and message prio.
+    MapScopeFilter          mMapScopeFilter;    //<!< The map of scope filters, where key is the instance ID and values is the pair of scope ID and message prio.
+    QMetaObject::Connection mConTreesBuilt;     //!< The connection to the signal of the built scope trees.
 };
 
 //////////////////////////////////////////////////////////////////////////
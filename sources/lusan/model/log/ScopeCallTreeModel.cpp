@@ -0,0 +1,371 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/model/log/ScopeCallTreeModel.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the model of the call tree of scopes.
+ *
+ ************************************************************************/
+
+#include "lusan/model/log/ScopeCallTreeModel.hpp"
+#include "lusan/common/NELusanCommon.hpp"
+#include "lusan/model/log/LoggingModelBase.hpp"
+
+namespace
+{
+    //!< The bit of the internal ID of the index, which marks the item of a thread.
+    constexpr quintptr  _threadFlag { static_cast<quintptr>(1u) << (sizeof(quintptr) * 8u - 1u) };
+}
+
+ScopeCallTreeModel::ScopeCallTreeModel(QObject* parent)
+    : QAbstractItemModel(parent)
+    , mLogModel     (nullptr)
+    , mCallTree     ( )
+    , mScopeNames   ( )
+    , mSourceConnect( )
+    , mClosedCalls  ( )
+{
+}
+
+ScopeCallTreeModel::~ScopeCallTreeModel()
+{
+    setLoggingModel(nullptr);
+}
+
+void ScopeCallTreeModel::setLoggingModel(LoggingModelBase* logModel)
+{
+    if (mLogModel == logModel)
+        return;
+
+    for (const QMetaObject::Connection& conn : mSourceConnect)
+    {
+        disconnect(conn);
+    }
+
+    mSourceConnect.clear();
+    mLogModel = logModel;
+    if (mLogModel != nullptr)
+    {
+        mSourceConnect.append(connect(mLogModel, &QAbstractItemModel::rowsInserted, this
+                                    , [this](const QModelIndex& /*parent*/, int first, int last) {
+                                        _onSourceRowsInserted(first, last);
+                                    }));
+        mSourceConnect.append(connect(mLogModel, &QAbstractItemModel::rowsRemoved, this
+                                    , [this](const QModelIndex& /*parent*/, int first, int last) {
+                                        _onSourceRowsRemoved(first, last);
+                                    }));
+        mSourceConnect.append(connect(mLogModel, &QAbstractItemModel::modelReset, this
+                                    , [this]() {
+                                        _rebuildCallTree();
+                                    }));
+        mSourceConnect.append(connect(mLogModel, &LoggingModelBase::signalScopesAvailable, this
+                                    , [this](ITEM_ID instId, const std::vector<areg::ScopeEntry>& /*scopes*/) {
+                                        mScopeNames.remove(instId);
+                                    }));
+        mSourceConnect.append(connect(mLogModel, &LoggingModelBase::signalScopesUpdated, this
+                                    , [this](ITEM_ID instId, const std::vector<areg::ScopeEntry>& /*scopes*/) {
+                                        mScopeNames.remove(instId);
+                                    }));
+    }
+
+    _rebuildCallTree();
+}
+
+int ScopeCallTreeModel::getCallNode(const QModelIndex& index) const
+{
+    return (index.isValid() && (_isThreadId(index.internalId()) == false) ? static_cast<int>(index.internalId()) : ScopeCallTree::InvalidIndex);
+}
+
+int ScopeCallTreeModel::getCallThread(const QModelIndex& index) const
+{
+    if (index.isValid() == false)
+        return ScopeCallTree::InvalidIndex;
+
+    const quintptr id{ index.internalId() };
+    return (_isThreadId(id) ? static_cast<int>(id & ~_threadFlag) : mCallTree.getCall(static_cast<int>(id)).thread);
+}
+
+QModelIndex ScopeCallTreeModel::indexOfCall(int node, int column) const
+{
+    if ((node < 0) || (node >= mCallTree.getCallCount()))
+        return QModelIndex();
+
+    return createIndex(mCallTree.getCall(node).position, column, static_cast<quintptr>(node));
+}
+
+QModelIndex ScopeCallTreeModel::indexOfThread(int thread, int column) const
+{
+    if ((thread < 0) || (thread >= mCallTree.getThreadCount()))
+        return QModelIndex();
+
+    return createIndex(thread, column, _threadFlag | static_cast<quintptr>(thread));
+}
+
+QModelIndex ScopeCallTreeModel::getLogIndex(const QModelIndex& index) const
+{
+    const int node{ getCallNode(index) };
+    if ((node == ScopeCallTree::InvalidIndex) || (mLogModel == nullptr))
+        return QModelIndex();
+
+    return mLogModel->index(mCallTree.getCall(node).enterRow, 0);
+}
+
+QString ScopeCallTreeModel::getScopeName(ITEM_ID instId, uint32_t scopeId) const
+{
+    auto pos = mScopeNames.find(instId);
+    if ((pos == mScopeNames.end()) && (mLogModel != nullptr))
+    {
+        // Resolved once per instance, the list of scopes is queried from the logging model.
+        ScopeNames names;
+        const std::vector<areg::ScopeEntry>& scopes = mLogModel->getLogInstScopes(instId);
+        for (const areg::ScopeEntry& scope : scopes)
+        {
+            names.insert(scope.scopeId, QString::fromStdString(scope.scopeName.data()));
+        }
+
+        pos = mScopeNames.insert(instId, names);
+    }
+
+    if (pos != mScopeNames.end())
+    {
+        auto name = pos.value().constFind(scopeId);
+        if (name != pos.value().constEnd())
+            return name.value();
+    }
+
+    return tr("Scope %1").arg(scopeId);
+}
+
+QString ScopeCallTreeModel::getThreadName(int thread) const
+{
+    const ScopeCallTree::sThreadCalls& calls = mCallTree.getThread(thread);
+    return QString("%1 (%2) / %3 (%4)").arg(calls.module).arg(calls.instId).arg(calls.name).arg(calls.threadId);
+}
+
+QModelIndex ScopeCallTreeModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if ((row < 0) || (column < 0) || (column >= static_cast<int>(eColumn::ColumnCount)))
+        return QModelIndex();
+
+    if (parent.isValid() == false)
+        return indexOfThread(row, column);
+
+    const int node{ getCallNode(parent) };
+    const std::vector<int>& children = node == ScopeCallTree::InvalidIndex
+                                     ? mCallTree.getThread(getCallThread(parent)).roots
+                                     : mCallTree.getCall(node).children;
+    return (row < static_cast<int>(children.size()) ? indexOfCall(children[static_cast<uint32_t>(row)], column) : QModelIndex());
+}
+
+QModelIndex ScopeCallTreeModel::parent(const QModelIndex& child) const
+{
+    const int node{ getCallNode(child) };
+    if (node == ScopeCallTree::InvalidIndex)
+        return QModelIndex();
+
+    const ScopeCallTree::sCallNode& call = mCallTree.getCall(node);
+    return (call.parent != ScopeCallTree::InvalidIndex ? indexOfCall(call.parent) : indexOfThread(call.thread));
+}
+
+int ScopeCallTreeModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid() == false)
+        return mCallTree.getThreadCount();
+    else if (parent.column() != 0)
+        return 0;
+
+    const int node{ getCallNode(parent) };
+    return static_cast<int>(node == ScopeCallTree::InvalidIndex
+                            ? mCallTree.getThread(getCallThread(parent)).roots.size()
+                            : mCallTree.getCall(node).children.size());
+}
+
+int ScopeCallTreeModel::columnCount(const QModelIndex& /*parent*/) const
+{
+    return static_cast<int>(eColumn::ColumnCount);
+}
+
+QVariant ScopeCallTreeModel::data(const QModelIndex& index, int role) const
+{
+    if (index.isValid() == false)
+        return QVariant();
+
+    const int node{ getCallNode(index) };
+    const eColumn column{ static_cast<eColumn>(index.column()) };
+    switch (static_cast<Qt::ItemDataRole>(role))
+    {
+    case Qt::ItemDataRole::DisplayRole:
+    {
+        if (node == ScopeCallTree::InvalidIndex)
+            return (column == eColumn::ColumnScope ? QVariant(getThreadName(getCallThread(index))) : QVariant());
+
+        const ScopeCallTree::sCallNode& call = mCallTree.getCall(node);
+        switch (column)
+        {
+        case eColumn::ColumnScope:
+            return getScopeName(call.instId, call.scopeId);
+        case eColumn::ColumnSession:
+            return QString::number(call.sessionId);
+        case eColumn::ColumnInclusive:
+            return (call.closed ? NELusanCommon::formatDuration(call.inclusive) : QString("> %1").arg(NELusanCommon::formatDuration(mCallTree.getInclusive(node))));
+        case eColumn::ColumnExclusive:
+            return (call.closed ? NELusanCommon::formatDuration(call.exclusive()) : QString("> %1").arg(NELusanCommon::formatDuration(mCallTree.getExclusive(node))));
+        default:
+            return QVariant();
+        }
+    }
+
+    case Qt::ItemDataRole::ToolTipRole:
+    {
+        if ((node == ScopeCallTree::InvalidIndex) || (column != eColumn::ColumnScope))
+            return QVariant();
+
+        const ScopeCallTree::sCallNode& call = mCallTree.getCall(node);
+        return tr("%1, session %2\nInclusive: %3 ms\nExclusive: %4 ms%5")
+                    .arg(getScopeName(call.instId, call.scopeId))
+                    .arg(call.sessionId)
+                    .arg(NELusanCommon::formatDuration(mCallTree.getInclusive(node)))
+                    .arg(NELusanCommon::formatDuration(mCallTree.getExclusive(node)))
+                    .arg(call.closed ? QString() : tr("\nThe call is not ended"));
+    }
+
+    case Qt::ItemDataRole::TextAlignmentRole:
+        return (column == eColumn::ColumnScope ? QVariant() : QVariant(static_cast<int>(Qt::AlignRight | Qt::AlignVCenter)));
+
+    case Qt::ItemDataRole::UserRole:
+        return QVariant(node);
+
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ScopeCallTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if ((orientation != Qt::Orientation::Horizontal) || (role != static_cast<int>(Qt::ItemDataRole::DisplayRole)))
+        return QVariant();
+
+    switch (static_cast<eColumn>(section))
+    {
+    case eColumn::ColumnScope:
+        return tr("Scope");
+    case eColumn::ColumnSession:
+        return tr("Session");
+    case eColumn::ColumnInclusive:
+        return tr("Inclusive (ms)");
+    case eColumn::ColumnExclusive:
+        return tr("Exclusive (ms)");
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags ScopeCallTreeModel::flags(const QModelIndex& index) const
+{
+    return (index.isValid() ? Qt::ItemIsEnabled | Qt::ItemIsSelectable : Qt::NoItemFlags);
+}
+
+void ScopeCallTreeModel::_rebuildCallTree()
+{
+    beginResetModel();
+    mCallTree.clear();
+    mScopeNames.clear();
+    if (mLogModel != nullptr)
+    {
+        const int count{ mLogModel->rowCount() };
+        for (int row = 0; row < count; ++row)
+        {
+            const areg::LogEntry* log = mLogModel->getLogData(row);
+            if (log != nullptr)
+            {
+                mCallTree.append(*log);
+            }
+        }
+    }
+
+    endResetModel();
+}
+
+void ScopeCallTreeModel::_onSourceRowsInserted(int first, int last)
+{
+    if ((mLogModel == nullptr) || (first != mCallTree.getRowCount()))
+    {
+        // The rows are inserted in the middle of the log, the rows of the calls are shifted.
+        _rebuildCallTree();
+        return;
+    }
+
+    for (int row = first; row <= last; ++row)
+    {
+        const areg::LogEntry* log = mLogModel->getLogData(row);
+        if (log != nullptr)
+        {
+            _appendLog(*log);
+        }
+    }
+}
+
+void ScopeCallTreeModel::_onSourceRowsRemoved(int first, int last)
+{
+    if ((first != 0) || (last >= mCallTree.getRowCount()))
+    {
+        // The rows are removed in the middle of the log, the calls are collected again.
+        _rebuildCallTree();
+        return;
+    }
+
+    // The live logs drop the oldest messages in blocks, only the calls of the block are dropped.
+    // The indexes of the calls are the internal IDs of the items, so the views are reset.
+    beginResetModel();
+    mCallTree.removeFront(last + 1);
+    endResetModel();
+}
+
+void ScopeCallTreeModel::_appendLog(const areg::LogEntry& entry)
+{
+    if (entry.logMsgType == areg::LogMessageType::ScopeEnter)
+    {
+        const int thread{ mCallTree.findThread(entry.logCookie, entry.logThreadId) };
+        if (thread == ScopeCallTree::InvalidIndex)
+        {
+            // The first call of the thread adds the thread, the call is its only child.
+            const int row{ mCallTree.getThreadCount() };
+            beginInsertRows(QModelIndex(), row, row);
+            mCallTree.append(entry);
+            endInsertRows();
+        }
+        else
+        {
+            const int open{ mCallTree.getOpenCall(thread) };
+            const QModelIndex parent{ open != ScopeCallTree::InvalidIndex ? indexOfCall(open) : indexOfThread(thread) };
+            const int row{ rowCount(parent) };
+            beginInsertRows(parent, row, row);
+            mCallTree.append(entry);
+            endInsertRows();
+        }
+    }
+    else
+    {
+        mClosedCalls.clear();
+        mCallTree.append(entry, &mClosedCalls);
+        for (int node : mClosedCalls)
+        {
+            emit dataChanged(indexOfCall(node, static_cast<int>(eColumn::ColumnInclusive)), indexOfCall(node, static_cast<int>(eColumn::ColumnExclusive)));
+        }
+    }
+}
+
+inline bool ScopeCallTreeModel::_isThreadId(quintptr id)
+{
+    return ((id & _threadFlag) != 0u);
+}
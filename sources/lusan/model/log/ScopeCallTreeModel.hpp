@@ -0,0 +1,212 @@
+#ifndef LUSAN_MODEL_LOG_SCOPECALLTREEMODEL_HPP
+#define LUSAN_MODEL_LOG_SCOPECALLTREEMODEL_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/model/log/ScopeCallTreeModel.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the model of the call tree of scopes.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QAbstractItemModel>
+#include <QHash>
+#include <QList>
+
+#include "lusan/data/log/ScopeCallTree.hpp"
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class LoggingModelBase;
+
+/**
+ * \brief   The model of the call tree of scopes, rebuilt from the scope enter and scope exit
+ *          messages of the logging model. The top level items are the threads of the instances,
+ *          the children are the calls of the scopes nested in the order of calls. The model is
+ *          built in one pass when the logs are loaded or reset, and grows message by message
+ *          with the live logs.
+ **/
+class ScopeCallTreeModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   The columns of the call tree.
+     **/
+    enum eColumn
+    {
+          ColumnScope       = 0 //!< The name of the scope or the thread.
+        , ColumnSession         //!< The ID of the scope session.
+        , ColumnInclusive       //!< The time of the call, including the nested calls, in milliseconds.
+        , ColumnExclusive       //!< The time of the call, excluding the nested calls, in milliseconds.
+        , ColumnCount           //!< The number of columns.
+    };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructor / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    explicit ScopeCallTreeModel(QObject* parent = nullptr);
+
+    virtual ~ScopeCallTreeModel();
+
+//////////////////////////////////////////////////////////////////////////
+// Operations and attributes
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Sets the logging model to rebuild the call tree. Pass nullptr to clear the model.
+     * \param   logModel    The logging model with the log messages.
+     **/
+    void setLoggingModel(LoggingModelBase* logModel);
+
+    /**
+     * \brief   Returns the logging model of the call tree, or nullptr if not set.
+     **/
+    inline LoggingModelBase* getLoggingModel() const;
+
+    /**
+     * \brief   Returns the call tree of the model.
+     **/
+    inline const ScopeCallTree& getCallTree() const;
+
+    /**
+     * \brief   Returns the index of the call of the given item, or ScopeCallTree::InvalidIndex if the item is a thread.
+     * \param   index   The index of the item in the model.
+     **/
+    int getCallNode(const QModelIndex& index) const;
+
+    /**
+     * \brief   Returns the index of the thread of the given item, or ScopeCallTree::InvalidIndex if the index is invalid.
+     * \param   index   The index of the item in the model.
+     **/
+    int getCallThread(const QModelIndex& index) const;
+
+    /**
+     * \brief   Returns the index of the item of the given call.
+     * \param   node    The index of the call in the call tree.
+     * \param   column  The column of the item.
+     **/
+    QModelIndex indexOfCall(int node, int column = 0) const;
+
+    /**
+     * \brief   Returns the index of the item of the given thread.
+     * \param   thread  The index of the thread in the call tree.
+     * \param   column  The column of the item.
+     **/
+    QModelIndex indexOfThread(int thread, int column = 0) const;
+
+    /**
+     * \brief   Returns the index in the logging model of the scope enter message of the call,
+     *          or invalid index if the item is not a call.
+     * \param   index   The index of the item in the model.
+     **/
+    QModelIndex getLogIndex(const QModelIndex& index) const;
+
+    /**
+     * \brief   Returns the name of the scope of the instance. If the scope is not registered,
+     *          returns the ID of the scope.
+     * \param   instId  The ID of the instance (cookie).
+     * \param   scopeId The ID of the scope.
+     **/
+    QString getScopeName(ITEM_ID instId, uint32_t scopeId) const;
+
+    /**
+     * \brief   Returns the display name of the thread.
+     * \param   thread  The index of the thread in the call tree.
+     **/
+    QString getThreadName(int thread) const;
+
+//////////////////////////////////////////////////////////////////////////
+// QAbstractItemModel overrides
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+
+    QModelIndex parent(const QModelIndex& child) const override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Rebuilds the call tree from all log messages of the logging model.
+    void _rebuildCallTree();
+
+    //!< Adds the new log messages of the logging model to the call tree.
+    void _onSourceRowsInserted(int first, int last);
+
+    //!< Drops the calls of the removed log messages from the call tree.
+    void _onSourceRowsRemoved(int first, int last);
+
+    //!< Adds the log message to the call tree and notifies the views about the changes.
+    void _appendLog(const areg::LogEntry& entry);
+
+    //!< Returns true if the internal ID of the index refers to a thread.
+    inline static bool _isThreadId(quintptr id);
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    using ScopeNames    = QHash<uint32_t, QString>;
+    using InstScopes    = QHash<ITEM_ID, ScopeNames>;
+
+    LoggingModelBase*               mLogModel;      //!< The logging model with the log messages.
+    ScopeCallTree                   mCallTree;      //!< The call tree rebuilt from the log messages.
+    mutable InstScopes              mScopeNames;    //!< Per instance, the cached names of the scopes.
+    QList<QMetaObject::Connection>  mSourceConnect; //!< The connections to the signals of the logging model.
+    std::vector<int>                mClosedCalls;   //!< The calls ended by the last added message.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(ScopeCallTreeModel);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ScopeCallTreeModel class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline LoggingModelBase* ScopeCallTreeModel::getLoggingModel() const
+{
+    return mLogModel;
+}
+
+inline const ScopeCallTree& ScopeCallTreeModel::getCallTree() const
+{
+    return mCallTree;
+}
+
+#endif  // LUSAN_MODEL_LOG_SCOPECALLTREEMODEL_HPP
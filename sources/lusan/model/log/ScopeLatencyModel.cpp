@@ -0,0 +1,366 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/model/log/ScopeLatencyModel.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the model of the latency statistics of the scopes.
+ *
+ ************************************************************************/
+
+#include "lusan/model/log/ScopeLatencyModel.hpp"
+#include "lusan/common/NELusanCommon.hpp"
+#include "lusan/model/log/LoggingModelBase.hpp"
+
+namespace
+{
+    //!< The number of durations the worker thread aggregates between the checks of the quit request.
+    constexpr uint32_t  _quitCheckStep  { 1024u };
+
+    //!< Returns the value of the histogram shown in the column.
+    uint64_t _columnValue(const LatencyHistogram& histogram, ScopeLatencyModel::eColumn column)
+    {
+        switch (column)
+        {
+        case ScopeLatencyModel::eColumn::ColumnCalls:
+            return histogram.getCount();
+        case ScopeLatencyModel::eColumn::ColumnMin:
+            return histogram.getMin();
+        case ScopeLatencyModel::eColumn::ColumnP50:
+            return histogram.getValueAtPercentile(50.0);
+        case ScopeLatencyModel::eColumn::ColumnP90:
+            return histogram.getValueAtPercentile(90.0);
+        case ScopeLatencyModel::eColumn::ColumnP99:
+            return histogram.getValueAtPercentile(99.0);
+        case ScopeLatencyModel::eColumn::ColumnP999:
+            return histogram.getValueAtPercentile(99.9);
+        case ScopeLatencyModel::eColumn::ColumnMax:
+            return histogram.getMax();
+        default:
+            return 0u;
+        }
+    }
+}
+
+ScopeLatencyModel::ScopeLatencyModel(QObject* parent)
+    : QAbstractTableModel   (parent)
+    , areg::ThreadConsumer  ( )
+    , mLogModel     (nullptr)
+    , mStats        ( )
+    , mScopeNames   ( )
+    , mRowCount     (0)
+    , mWorkerStats  ( )
+    , mWorkerSamples( )
+    , mPending      ( )
+    , mCalculating  (false)
+    , mGeneration   (0u)
+    , mRefreshTimer (this)
+    , mSourceConnect( )
+    , mWorker       (static_cast<areg::ThreadConsumer &>(self()), "_ScopeLatencyThread_")
+    , mQuitThread   (false)
+{
+    mRefreshTimer.setSingleShot(true);
+    mRefreshTimer.setInterval(ScopeLatencyModel::REFRESH_INTERVAL_MS);
+    connect(&mRefreshTimer, &QTimer::timeout, this, [this]() { _refreshRows(); });
+}
+
+ScopeLatencyModel::~ScopeLatencyModel()
+{
+    // The worker thread works on the members of this object, stop it first.
+    _quitThread();
+    for (const QMetaObject::Connection& conn : mSourceConnect)
+    {
+        disconnect(conn);
+    }
+
+    mSourceConnect.clear();
+}
+
+void ScopeLatencyModel::setLoggingModel(LoggingModelBase* logModel)
+{
+    if (mLogModel == logModel)
+        return;
+
+    for (const QMetaObject::Connection& conn : mSourceConnect)
+    {
+        disconnect(conn);
+    }
+
+    mSourceConnect.clear();
+    mLogModel = logModel;
+    if (mLogModel != nullptr)
+    {
+        mSourceConnect.append(connect(mLogModel, &QAbstractItemModel::rowsInserted, this
+                                    , [this](const QModelIndex& /*parent*/, int first, int last) {
+                                        _onSourceRowsInserted(first, last);
+                                    }));
+        // The rows dropped from the live logs are not removed from the statistics, they are cumulative.
+        mSourceConnect.append(connect(mLogModel, &QAbstractItemModel::modelReset, this
+                                    , [this]() {
+                                        _restart();
+                                    }));
+        mSourceConnect.append(connect(mLogModel, &LoggingModelBase::signalScopesAvailable, this
+                                    , [this](ITEM_ID instId, const std::vector<areg::ScopeEntry>& /*scopes*/) {
+                                        mScopeNames.remove(instId);
+                                        if (mRowCount > 0)
+                                            emit dataChanged(index(0, eColumn::ColumnScope), index(mRowCount - 1, eColumn::ColumnScope));
+                                    }));
+        mSourceConnect.append(connect(mLogModel, &LoggingModelBase::signalScopesUpdated, this
+                                    , [this](ITEM_ID instId, const std::vector<areg::ScopeEntry>& /*scopes*/) {
+                                        mScopeNames.remove(instId);
+                                        if (mRowCount > 0)
+                                            emit dataChanged(index(0, eColumn::ColumnScope), index(mRowCount - 1, eColumn::ColumnScope));
+                                    }));
+    }
+
+    _restart();
+}
+
+int ScopeLatencyModel::rowCount(const QModelIndex& parent) const
+{
+    return (parent.isValid() ? 0 : mRowCount);
+}
+
+int ScopeLatencyModel::columnCount(const QModelIndex& parent) const
+{
+    return (parent.isValid() ? 0 : static_cast<int>(eColumn::ColumnCount));
+}
+
+QVariant ScopeLatencyModel::data(const QModelIndex& index, int role) const
+{
+    if ((index.isValid() == false) || (index.row() >= mRowCount))
+        return QVariant();
+
+    const ScopeLatencyStats::sScopeLatency& scope = mStats.getScope(index.row());
+    const eColumn column{ static_cast<eColumn>(index.column()) };
+    switch (static_cast<Qt::ItemDataRole>(role))
+    {
+    case Qt::ItemDataRole::DisplayRole:
+        if (column == eColumn::ColumnScope)
+            return _scopeName(scope.instId, scope.scopeId);
+        else if (column == eColumn::ColumnCalls)
+            return QString::number(scope.histogram.getCount());
+        else
+            return NELusanCommon::formatDuration(_columnValue(scope.histogram, column));
+
+    case Qt::ItemDataRole::ToolTipRole:
+        return tr("%1\nInstance %2, scope ID %3\nCalls: %4, max: %5 ms")
+                    .arg(_scopeName(scope.instId, scope.scopeId))
+                    .arg(scope.instId)
+                    .arg(scope.scopeId)
+                    .arg(scope.histogram.getCount())
+                    .arg(NELusanCommon::formatDuration(scope.histogram.getMax()));
+
+    case Qt::ItemDataRole::TextAlignmentRole:
+        return (column == eColumn::ColumnScope ? QVariant() : QVariant(static_cast<int>(Qt::AlignRight | Qt::AlignVCenter)));
+
+    case Qt::ItemDataRole::UserRole:
+        if (column == eColumn::ColumnScope)
+            return _scopeName(scope.instId, scope.scopeId);
+        else
+            return QVariant(static_cast<qulonglong>(_columnValue(scope.histogram, column)));
+
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ScopeLatencyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if ((orientation != Qt::Orientation::Horizontal) || (role != static_cast<int>(Qt::ItemDataRole::DisplayRole)))
+        return QVariant();
+
+    switch (static_cast<eColumn>(section))
+    {
+    case eColumn::ColumnScope:
+        return tr("Scope");
+    case eColumn::ColumnCalls:
+        return tr("Calls");
+    case eColumn::ColumnMin:
+        return tr("Min (ms)");
+    case eColumn::ColumnP50:
+        return tr("p50 (ms)");
+    case eColumn::ColumnP90:
+        return tr("p90 (ms)");
+    case eColumn::ColumnP99:
+        return tr("p99 (ms)");
+    case eColumn::ColumnP999:
+        return tr("p99.9 (ms)");
+    case eColumn::ColumnMax:
+        return tr("Max (ms)");
+    default:
+        return QVariant();
+    }
+}
+
+void ScopeLatencyModel::on_run()
+{
+    // Runs in the worker thread. The thread that owns the model does not touch the worker
+    // statistics and durations until the result is handed over.
+    const uint32_t generation{ mGeneration };
+    ScopeLatencyStats stats(std::move(mWorkerStats));
+    const uint32_t count{ static_cast<uint32_t>(mWorkerSamples.size()) };
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if ((i % _quitCheckStep) == 0u)
+        {
+            if (mQuitThread.try_lock() == false)
+                return;
+
+            mQuitThread.unlock();
+        }
+
+        stats.record(mWorkerSamples[i]);
+    }
+
+    QMetaObject::invokeMethod(this
+                             , [this, generation, stats = std::move(stats)]() mutable
+                               {
+                                   _applyStats(std::move(stats), generation);
+                               }
+                             , Qt::ConnectionType::QueuedConnection);
+}
+
+void ScopeLatencyModel::_restart()
+{
+    _quitThread();
+    ++ mGeneration;
+    mRefreshTimer.stop();
+
+    beginResetModel();
+    mStats.clear();
+    mScopeNames.clear();
+    mRowCount = 0;
+    mWorkerStats.clear();
+    mWorkerSamples.clear();
+    mPending.clear();
+    mCalculating = false;
+    endResetModel();
+
+    if (mLogModel != nullptr)
+    {
+        const int count{ mLogModel->rowCount() };
+        if (count > 0)
+        {
+            _onSourceRowsInserted(0, count - 1);
+        }
+    }
+}
+
+void ScopeLatencyModel::_onSourceRowsInserted(int first, int last)
+{
+    if (mLogModel == nullptr)
+        return;
+
+    // Only the durations are captured here, it is cheap enough for the thread that owns the logs.
+    ScopeLatencyStats::ListSamples samples;
+    ScopeLatencyStats::sLatencySample sample;
+    for (int row = first; row <= last; ++row)
+    {
+        const areg::LogEntry* log = mLogModel->getLogData(row);
+        if ((log != nullptr) && ScopeLatencyStats::getSample(*log, sample))
+        {
+            samples.push_back(sample);
+        }
+    }
+
+    _addSamples(std::move(samples));
+}
+
+void ScopeLatencyModel::_addSamples(ScopeLatencyStats::ListSamples&& samples)
+{
+    if (samples.empty())
+        return;
+
+    if (mCalculating)
+    {
+        mPending.insert(mPending.end(), samples.begin(), samples.end());
+    }
+    else if (samples.size() >= ScopeLatencyModel::WORKER_BATCH_SIZE)
+    {
+        // The previous run has handed over the result, wait until the thread exits to restart it.
+        _quitThread();
+        mWorkerStats    = mStats;
+        mWorkerSamples  = std::move(samples);
+        mCalculating    = true;
+        mWorker.start(areg::DO_NOT_WAIT);
+    }
+    else
+    {
+        for (const ScopeLatencyStats::sLatencySample& entry : samples)
+        {
+            mStats.record(entry);
+        }
+
+        if (mRefreshTimer.isActive() == false)
+        {
+            mRefreshTimer.start();
+        }
+    }
+}
+
+void ScopeLatencyModel::_applyStats(ScopeLatencyStats&& stats, uint32_t generation)
+{
+    if (generation != mGeneration)
+        return;
+
+    mStats = std::move(stats);
+    mWorkerSamples.clear();
+    mCalculating = false;
+    _refreshRows();
+
+    ScopeLatencyStats::ListSamples pending(std::move(mPending));
+    mPending.clear();
+    _addSamples(std::move(pending));
+}
+
+void ScopeLatencyModel::_refreshRows()
+{
+    mRefreshTimer.stop();
+    if (mRowCount > 0)
+    {
+        emit dataChanged(index(0, eColumn::ColumnCalls), index(mRowCount - 1, eColumn::ColumnMax));
+    }
+
+    const int count{ mStats.getScopeCount() };
+    if (count > mRowCount)
+    {
+        beginInsertRows(QModelIndex(), mRowCount, count - 1);
+        mRowCount = count;
+        endInsertRows();
+    }
+}
+
+QString ScopeLatencyModel::_scopeName(ITEM_ID instId, uint32_t scopeId) const
+{
+    auto pos = mScopeNames.find(instId);
+    if ((pos == mScopeNames.end()) && (mLogModel != nullptr))
+    {
+        ScopeNames names;
+        const std::vector<areg::ScopeEntry>& scopes = mLogModel->getLogInstScopes(instId);
+        for (const areg::ScopeEntry& scope : scopes)
+        {
+            names.insert(scope.scopeId, QString::fromStdString(scope.scopeName.data()));
+        }
+
+        pos = mScopeNames.insert(instId, names);
+    }
+
+    if (pos != mScopeNames.end())
+    {
+        auto name = pos.value().constFind(scopeId);
+        if (name != pos.value().constEnd())
+            return name.value();
+    }
+
+    return tr("Scope %1").arg(scopeId);
+}
@@ -0,0 +1,223 @@
+#ifndef LUSAN_MODEL_LOG_SCOPELATENCYMODEL_HPP
+#define LUSAN_MODEL_LOG_SCOPELATENCYMODEL_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/model/log/ScopeLatencyModel.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the model of the latency statistics of the scopes.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QTimer>
+
+#include "areg/base/SyncPrimitives.hpp"
+#include "areg/base/Thread.hpp"
+#include "areg/base/ThreadConsumer.hpp"
+#include "lusan/data/log/ScopeLatencyStats.hpp"
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class LoggingModelBase;
+
+/**
+ * \brief   The table of the latency statistics of the scopes of the logging model: per scope
+ *          of every instance the number of calls, the minimum, the maximum and the percentiles
+ *          of the durations logged by the scope exit messages.
+ *          The durations of the loaded logs and of the big batches of logs are aggregated in
+ *          the worker thread, the durations of the live logs are added as they arrive, and the
+ *          table is refreshed periodically.
+ **/
+class ScopeLatencyModel : public QAbstractTableModel
+                        , protected areg::ThreadConsumer
+{
+    Q_OBJECT
+
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    /**
+     * \brief   The columns of the latency statistics.
+     **/
+    enum eColumn
+    {
+          ColumnScope       = 0 //!< The name of the scope.
+        , ColumnCalls           //!< The number of calls of the scope.
+        , ColumnMin             //!< The shortest call.
+        , ColumnP50             //!< The median duration.
+        , ColumnP90             //!< The 90th percentile of durations.
+        , ColumnP99             //!< The 99th percentile of durations.
+        , ColumnP999            //!< The 99.9th percentile of durations.
+        , ColumnMax             //!< The longest call.
+        , ColumnCount           //!< The number of columns.
+    };
+
+    //!< The number of the scope exit messages of one batch to aggregate in the worker thread.
+    static constexpr uint32_t   WORKER_BATCH_SIZE   { 4096u };
+
+    //!< The interval in milliseconds to refresh the table while the live logs arrive.
+    static constexpr int        REFRESH_INTERVAL_MS { 500 };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructor / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    explicit ScopeLatencyModel(QObject* parent = nullptr);
+
+    virtual ~ScopeLatencyModel();
+
+//////////////////////////////////////////////////////////////////////////
+// Operations and attributes
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Sets the logging model to aggregate the durations of the scopes. Pass nullptr to clear the model.
+     * \param   logModel    The logging model with the log messages.
+     **/
+    void setLoggingModel(LoggingModelBase* logModel);
+
+    /**
+     * \brief   Returns the logging model of the statistics, or nullptr if not set.
+     **/
+    inline LoggingModelBase* getLoggingModel() const;
+
+    /**
+     * \brief   Returns true if the worker thread aggregates the durations.
+     **/
+    inline bool isCalculating() const;
+
+//////////////////////////////////////////////////////////////////////////
+// QAbstractTableModel overrides
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    /**
+     * \brief   Returns the data of the cell. The Qt::UserRole returns the numeric value of the cell
+     *          to sort the table: the number of calls or the duration in microseconds.
+     **/
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+/************************************************************************/
+// areg::ThreadConsumer interface overrides
+/************************************************************************/
+protected:
+
+    /**
+     * \brief   Runs in the worker thread, aggregates the captured durations and hands over
+     *          the statistics to the thread that owns the model.
+     **/
+    void on_run() override;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Clears the statistics and aggregates the durations of all log messages of the logging model.
+    void _restart();
+
+    //!< Aggregates the durations of the new log messages of the logging model.
+    void _onSourceRowsInserted(int first, int last);
+
+    //!< Aggregates the durations in the worker thread if there are many, otherwise records them directly.
+    void _addSamples(ScopeLatencyStats::ListSamples&& samples);
+
+    //!< Receives the statistics aggregated in the worker thread.
+    void _applyStats(ScopeLatencyStats&& stats, uint32_t generation);
+
+    //!< Inserts the rows of the new scopes and updates the values of the table.
+    void _refreshRows();
+
+    //!< Returns the name of the scope of the instance, the names are cached per instance.
+    QString _scopeName(ITEM_ID instId, uint32_t scopeId) const;
+
+    //!< Stops the worker thread.
+    inline void _quitThread();
+
+    //!< Returns the reference to this object.
+    inline ScopeLatencyModel& self();
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    using ScopeNames    = QHash<uint32_t, QString>;
+    using InstScopes    = QHash<ITEM_ID, ScopeNames>;
+
+    LoggingModelBase*               mLogModel;      //!< The logging model with the log messages.
+    ScopeLatencyStats               mStats;         //!< The statistics shown in the table.
+    mutable InstScopes              mScopeNames;    //!< Per instance, the cached names of the scopes.
+    int                             mRowCount;      //!< The number of rows in the table.
+    ScopeLatencyStats               mWorkerStats;   //!< The statistics the worker thread continues.
+    ScopeLatencyStats::ListSamples  mWorkerSamples; //!< The durations the worker thread aggregates.
+    ScopeLatencyStats::ListSamples  mPending;       //!< The durations received while the worker thread runs.
+    bool                            mCalculating;   //!< Flag, indicating whether the worker thread runs.
+    uint32_t                        mGeneration;    //!< Identifies the running aggregation, so that the result of an abandoned one is dropped.
+    QTimer                          mRefreshTimer;  //!< The timer to refresh the table.
+    QList<QMetaObject::Connection>  mSourceConnect; //!< The connections to the signals of the logging model.
+    areg::Thread                    mWorker;        //!< The worker thread to aggregate the durations.
+    areg::Mutex                     mQuitThread;    //!< Locked to notify the worker thread to quit.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(ScopeLatencyModel);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ScopeLatencyModel class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline LoggingModelBase* ScopeLatencyModel::getLoggingModel() const
+{
+    return mLogModel;
+}
+
+inline bool ScopeLatencyModel::isCalculating() const
+{
+    return mCalculating;
+}
+
+inline void ScopeLatencyModel::_quitThread()
+{
+    if (mWorker.is_valid())
+    {
+        mQuitThread.lock(areg::WAIT_INFINITE);
+        mWorker.shutdown(areg::WAIT_INFINITE);
+        mQuitThread.unlock();
+    }
+}
+
+inline ScopeLatencyModel& ScopeLatencyModel::self()
+{
+    return (*this);
+}
+
+#endif  // LUSAN_MODEL_LOG_SCOPELATENCYMODEL_HPP
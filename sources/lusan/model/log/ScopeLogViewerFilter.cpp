@@ -39,6 +39,9 @@ ScopeLogViewerFilter::ScopeLogViewerFilter(uint32_t scopeId /*= 0u*/, LoggingMod
     , mActiveFilter     (eDataFilter::NoFilter)
     , mIndexStart       ( )
     , mIndexEnd         ( )
+    , mSessionIndex     ( )
+    , mSelSession       ( )
+    , mSourceConnect    ( )
 {
 }
 
@@ -82,8 +85,10 @@ void ScopeLogViewerFilter::setScopeFilter(LoggingModelBase* model, uint32_t scop
         mSelInstanceData.data = instanceId;
         mSelInstanceData.isSet = true;
         mInstanceData = mSelInstanceData;
-        
+
+        mSelSession = ScopeSessionIndex::sSessionKey{ instanceId, threadId, scopeId, sessionId };
         setSourceModel(model);
+        _updateSelectedSession(true);
     }
 }
 
@@ -163,16 +168,40 @@ QModelIndex ScopeLogViewerFilter::getIndexPrevScope(const QModelIndex& startAt,
 
 void ScopeLogViewerFilter::setSourceModel(QAbstractItemModel *sourceModel)
 {
-    if (sourceModel != nullptr)
+    for (const QMetaObject::Connection& conn : mSourceConnect)
     {
-        static_cast<LoggingModelBase *>(sourceModel)->setScopeFiler(this);
+        disconnect(conn);
     }
-    else if (this->sourceModel() != nullptr)
+
+    mSourceConnect.clear();
+    if (this->sourceModel() != nullptr)
     {
         static_cast<LoggingModelBase *>(this->sourceModel())->setScopeFiler(nullptr);
     }
-    
+
+    if (sourceModel != nullptr)
+    {
+        static_cast<LoggingModelBase *>(sourceModel)->setScopeFiler(this);
+
+        // Connected before the proxy model connects to the source model, so that the new rows
+        // are indexed before the proxy model filters them.
+        mSourceConnect.append(connect(sourceModel, &QAbstractItemModel::rowsInserted, this
+                                    , [this](const QModelIndex& /*parent*/, int first, int last) {
+                                        _onSourceRowsInserted(first, last);
+                                    }));
+        mSourceConnect.append(connect(sourceModel, &QAbstractItemModel::rowsRemoved, this
+                                    , [this](const QModelIndex& /*parent*/, int first, int last) {
+                                        _onSourceRowsRemoved(first, last);
+                                    }));
+        mSourceConnect.append(connect(sourceModel, &QAbstractItemModel::modelReset, this
+                                    , [this]() {
+                                        _rebuildSessionIndex();
+                                        _updateSelectedSession(false);
+                                    }));
+    }
+
     LogViewerFilter::setSourceModel(sourceModel);
+    _rebuildSessionIndex();
 }
 
 void ScopeLogViewerFilter::clearFilters()
@@ -222,11 +251,8 @@ NELusanCommon::eMatchType ScopeLogViewerFilter::matchesScopeFilter(const QModelI
 
     if ((logMessage->logScopeId != mScopeData.value()) && mScopeData.valid())
     {
-        if (mActiveFilter == eDataFilter::FilterSublogs)
-        {
-            if ((mIndexStart.isValid() && (mIndexEnd.isValid() == false)) || ((mIndexStart.row() < index.row()) && (index.row() < mIndexEnd.row())))
-                return NELusanCommon::eMatchType::PartialOutput;
-        }
+        if ((mActiveFilter == eDataFilter::FilterSublogs) && mSessionIndex.isInside(mSelSession, index.row()))
+            return NELusanCommon::eMatchType::PartialOutput;
 
         return NELusanCommon::eMatchType::NoMatch;
     }
@@ -247,7 +273,7 @@ NELusanCommon::eMatchType ScopeLogViewerFilter::matchesScopeFilter(const QModelI
         if (mActiveFilter == eDataFilter::FilterSublogs)
         {
             Q_ASSERT(logMessage->logThreadId == mThreadData.value());
-            if ((mIndexStart.isValid() && (mIndexEnd.isValid() == false)) || ((mIndexStart.row() < index.row()) && (index.row() < mIndexEnd.row())))
+            if (mSessionIndex.isInside(mSelSession, index.row()))
                 return NELusanCommon::eMatchType::PartialOutput;
         }
         
@@ -259,39 +285,11 @@ NELusanCommon::eMatchType ScopeLogViewerFilter::matchesScopeFilter(const QModelI
     }
 
     Q_ASSERT(logMessage->logSessionId == mSelSessionData.value());
-    if (logMessage->logMsgType == areg::LogMessageType::ScopeEnter)
-    {
-        mIndexStart = index;
-        if (mIndexEnd.isValid() == false)
-        {
-            emit const_cast<ScopeLogViewerFilter *>(this)->signalFilterSelected(mIndexStart, mIndexEnd);
-        }
-    }
-    else if (logMessage->logMsgType == areg::LogMessageType::MessageText)
-    {
-        if (mIndexStart.isValid() == false)
-        {
-            mIndexStart = index;
-            if (mIndexEnd.isValid() == false)
-            {
-                emit const_cast<ScopeLogViewerFilter *>(this)->signalFilterSelected(mIndexStart, mIndexEnd);
-            }
-        }
-    }
-    else if (logMessage->logMsgType == areg::LogMessageType::ScopeExit)
-    {
-        mIndexEnd = index;
-        emit const_cast<ScopeLogViewerFilter *>(this)->signalFilterSelected(mIndexStart, mIndexEnd);
-    }
-        
     return NELusanCommon::eMatchType::ExactMatch;
 }
 
 void ScopeLogViewerFilter::filterData(ScopeLogViewerFilter::eDataFilter dataFilter)
 {
-    mIndexStart = QModelIndex();
-    mIndexEnd   = QModelIndex();
-    
     switch (dataFilter)
     {
     case ScopeLogViewerFilter::eDataFilter::FilterSession:
@@ -344,10 +342,92 @@ void ScopeLogViewerFilter::filterData(ScopeLogViewerFilter::eDataFilter dataFilt
         break;
     }
 
-    emit signalFilterSelected(mIndexStart, mIndexEnd);
+    _updateSelectedSession(true);
     invalidateRowFilter();
 }
 
+void ScopeLogViewerFilter::_rebuildSessionIndex()
+{
+    mSessionIndex.clear();
+    const LoggingModelBase* model = static_cast<const LoggingModelBase*>(sourceModel());
+    if ((model == nullptr) || (mSelScopeData.valid() == false))
+        return;
+
+    const int count{ model->rowCount() };
+    for (int row = 0; row < count; ++row)
+    {
+        const areg::LogEntry* log = model->getLogData(row);
+        if (log != nullptr)
+        {
+            mSessionIndex.append(*log);
+        }
+    }
+}
+
+void ScopeLogViewerFilter::_onSourceRowsInserted(int first, int last)
+{
+    const LoggingModelBase* model = static_cast<const LoggingModelBase*>(sourceModel());
+    if ((model == nullptr) || (mSelScopeData.valid() == false))
+        return;
+
+    if (first != mSessionIndex.getRowCount())
+    {
+        // The rows are inserted in the middle of the log, the rows of the sessions are shifted.
+        _rebuildSessionIndex();
+    }
+    else
+    {
+        for (int row = first; row <= last; ++row)
+        {
+            const areg::LogEntry* log = model->getLogData(row);
+            if (log != nullptr)
+            {
+                mSessionIndex.append(*log);
+            }
+        }
+    }
+
+    _updateSelectedSession(false);
+}
+
+void ScopeLogViewerFilter::_onSourceRowsRemoved(int first, int last)
+{
+    if (mSelScopeData.valid() == false)
+        return;
+
+    if (first == 0)
+    {
+        mSessionIndex.removeFront(last + 1);
+    }
+    else
+    {
+        _rebuildSessionIndex();
+    }
+
+    _updateSelectedSession(false);
+}
+
+void ScopeLogViewerFilter::_updateSelectedSession(bool forceSignal)
+{
+    QAbstractItemModel* model = sourceModel();
+    QModelIndex indexStart;
+    QModelIndex indexEnd;
+    if ((model != nullptr) && mSelScopeData.valid())
+    {
+        const int rowStart{ mSessionIndex.getEnterRow(mSelSession) };
+        const int rowEnd  { mSessionIndex.getExitRow(mSelSession)  };
+        indexStart  = rowStart != ScopeSessionIndex::InvalidRow ? model->index(rowStart, 0) : QModelIndex();
+        indexEnd    = rowEnd   != ScopeSessionIndex::InvalidRow ? model->index(rowEnd  , 0) : QModelIndex();
+    }
+
+    if (forceSignal || (indexStart != mIndexStart) || (indexEnd != mIndexEnd))
+    {
+        mIndexStart = indexStart;
+        mIndexEnd   = indexEnd;
+        emit signalFilterSelected(mIndexStart, mIndexEnd);
+    }
+}
+
 inline void ScopeLogViewerFilter::_clearData()
 {
     mSelScopeData.clear();
@@ -362,6 +442,8 @@ inline void ScopeLogViewerFilter::_clearData()
     mPriorityData.clear();
     
     mActiveFilter = eDataFilter::NoFilter;
+    mSelSession = ScopeSessionIndex::sSessionKey{};
+    mSessionIndex.clear();
     mIndexStart = QModelIndex();
     mIndexEnd   = QModelIndex();
     emit signalFilterSelected(mIndexStart, mIndexEnd);
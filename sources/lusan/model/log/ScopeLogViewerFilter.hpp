@@ -23,6 +23,9 @@
  * Includes
  ************************************************************************/
 #include "lusan/model/log/LogViewerFilter.hpp"
+#include "lusan/data/log/ScopeSessionIndex.hpp"
+
+#include <QList>
 
 /**
  * \brief   The scope logs filter proxy model to filter logging messages by scope ID, session IDs and log priority.
@@ -213,11 +216,40 @@ private:
 
     /**
      * \brief   Checks if the given index matches the scope filter.
+     *          The method does not modify the filter, the boundaries of the selected session
+     *          are taken from the session index, so the rows can be checked in any order.
      * \param   index   The index in the source model to check.
      * \return  Returns the match type of the index against the scope filter.
      **/
     NELusanCommon::eMatchType matchesScopeFilter(const QModelIndex& index) const;
 
+    /**
+     * \brief   Rebuilds the scope session index from all log messages of the source model.
+     **/
+    void _rebuildSessionIndex();
+
+    /**
+     * \brief   Called when the log messages are appended to the source model, indexes them.
+     * \param   first   The first appended row in the source model.
+     * \param   last    The last appended row in the source model.
+     **/
+    void _onSourceRowsInserted(int first, int last);
+
+    /**
+     * \brief   Called when the log messages are removed from the source model.
+     *          Dropping the oldest messages keeps the index, any other removal rebuilds it.
+     * \param   first   The first removed row in the source model.
+     * \param   last    The last removed row in the source model.
+     **/
+    void _onSourceRowsRemoved(int first, int last);
+
+    /**
+     * \brief   Updates the start and the end indexes of the selected session from the session index.
+     *          Emits signalFilterSelected if the indexes changed or if \p forceSignal is true.
+     * \param   forceSignal     If true, the signal is emitted even if the indexes did not change.
+     **/
+    void _updateSelectedSession(bool forceSignal);
+
     /**
      * \brief   Clears all filter data.
      *          The method resets scope ID, session IDs, instance IDs, and priority bits.
@@ -239,8 +271,11 @@ private:
     PriorityData    mSelPriorityData;   //!< The selected priority data to filter
     PriorityData    mPriorityData;      //!< The priority data to filter
     eDataFilter     mActiveFilter;      //!< Active filter type
-    mutable QModelIndex mIndexStart;    //!< The first selected index of filtered data, index is based on the source model
-    mutable QModelIndex mIndexEnd;      //<! The last selected index of filtered data, index is based on the source model
+    QModelIndex     mIndexStart;        //!< The first selected index of filtered data, index is based on the source model
+    QModelIndex     mIndexEnd;          //<! The last selected index of filtered data, index is based on the source model
+    ScopeSessionIndex               mSessionIndex;  //!< The intervals of the scope sessions in the source model.
+    ScopeSessionIndex::sSessionKey  mSelSession;    //!< The key of the selected scope session.
+    QList<QMetaObject::Connection>  mSourceConnect; //!< The connections to the signals of the source model.
 
 //////////////////////////////////////////////////////////////////////////
 // Forbidden calls
@@ -651,28 +651,37 @@ QString SMGuardRender::guardText(const StateMachineData& data, uint32_t transiti
     return QString();
 }
 
-void SMGuardRender::refreshNames(const StateMachineData& data, uint32_t transitionId, SMGuardNode& node)
+bool SMGuardRender::refreshNames(const StateMachineData& data, uint32_t transitionId, SMGuardNode& node)
 {
+    QString name{ node.getCacheName() };
     switch (node.getKind())
     {
-    case eKind::Attr:   node.setCacheName(SMGuardSymbols::attributeName(data, node.getSymbolId()));         break;
-    case eKind::Const:  node.setCacheName(SMGuardSymbols::constantName(data, node.getSymbolId()));          break;
-    case eKind::Param:  node.setCacheName(SMGuardSymbols::paramName(data, transitionId, node.getSymbolId())); break;
+    case eKind::Attr:   name = SMGuardSymbols::attributeName(data, node.getSymbolId());           break;
+    case eKind::Const:  name = SMGuardSymbols::constantName(data, node.getSymbolId());            break;
+    case eKind::Param:  name = SMGuardSymbols::paramName(data, transitionId, node.getSymbolId()); break;
     case eKind::Call:
         {
             const MethodEntry* method = SMGuardSymbols::method(data, node.getSymbolId());
-            node.setCacheName((method != nullptr) ? method->getName() : QString());
+            name = (method != nullptr) ? method->getName() : QString();
         }
         break;
     default:
         break;
     }
 
+    bool changed{ name != node.getCacheName() };
+    if (changed)
+    {
+        node.setCacheName(name);
+    }
+
     for (SMGuardNode* child : node.getChildren())
     {
-        if (child != nullptr)
+        if ((child != nullptr) && refreshNames(data, transitionId, *child))
         {
-            refreshNames(data, transitionId, *child);
+            changed = true;
         }
     }
+
+    return changed;
 }
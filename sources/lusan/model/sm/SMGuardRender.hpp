@@ -148,8 +148,9 @@ public:
      *          save so the human-readable `name` written to `.fsml` is never stale -- the name is
      *          never read back, resolution is always by id. A symbol that no longer resolves
      *          yields an empty name, and the attribute is then omitted.
+     * \return  True if a name changed.
      **/
-    static void refreshNames(const StateMachineData& data, uint32_t transitionId, SMGuardNode& node);
+    static bool refreshNames(const StateMachineData& data, uint32_t transitionId, SMGuardNode& node);
 
     /**
      * \brief   A SHORT, structural summary of \p guard for the FSM canvas label, where the full
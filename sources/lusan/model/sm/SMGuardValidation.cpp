@@ -241,7 +241,7 @@ QList<SMGuardValidation::Finding> SMGuardValidation::validateTransition(const St
 
     // The canvas asks this per edge while it repaints, so it looks the transition up instead of
     // walking every level to find one id.
-    const SMStateEntry* owner = data.getStates().findTransitionOwnerRecursive(transitionId);
+    const SMStateEntry* owner = data.findTransitionOwner(transitionId);
     const SMTransitionEntry* transition = data.findTransitionById(transitionId);
     if ((owner != nullptr) && (transition != nullptr))
     {
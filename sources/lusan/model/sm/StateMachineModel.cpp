@@ -22,6 +22,7 @@
 #include "lusan/data/common/AttributeEntry.hpp"
 #include "lusan/data/common/ConstantEntry.hpp"
 #include "lusan/data/common/IncludeEntry.hpp"
+#include "lusan/data/sm/SMDocumentCache.hpp"
 #include "lusan/data/sm/SMEventData.hpp"
 #include "lusan/data/sm/SMImportResolver.hpp"
 #include "lusan/data/sm/SMState.hpp"
@@ -31,6 +32,7 @@
 #include "lusan/model/sm/SMRenameCommands.hpp"
 #include "lusan/model/sm/SMValidator.hpp"
 
+#include <QCoreApplication>
 #include <QUndoCommand>
 
 namespace
@@ -72,7 +74,7 @@ namespace
      * \brief   Refreshes the advisory `name` on every guard tree before a save, so the names
      *          written to the file follow renames. The name is never read back; the id binds.
      **/
-    void refreshGuardNames(const StateMachineData& data, SMStateData& level)
+    void refreshGuardNames(StateMachineData& data, SMStateData& level)
     {
         for (SMStateEntry* state : level.getElements())
         {
@@ -84,9 +86,10 @@ namespace
             for (SMTransitionEntry* transition : state->getTransitions().getElements())
             {
                 SMGuardNode* tree = (transition != nullptr) ? transition->getGuard().getTree() : nullptr;
-                if (tree != nullptr)
+                if ((tree != nullptr) && SMGuardRender::refreshNames(data, transition->getId(), *tree))
                 {
-                    SMGuardRender::refreshNames(data, transition->getId(), *tree);
+                    // The names are written, so the next snapshot takes the transition again.
+                    data.stateElementChanged(transition->getId());
                 }
             }
 
@@ -104,6 +107,8 @@ StateMachineModel::StateMachineModel(QObject* parent /*= nullptr*/)
     , mNotifier      (this)
     , mUndoStack     (this)
     , mAutosaveTimer (this)
+    , mAutosaveJournal( )
+    , mAutosaveChanges( )
     , mOverviewModel (*this)
     , mDataTypeModel (*this)
     , mAttributeModel(*this)
@@ -116,13 +121,50 @@ StateMachineModel::StateMachineModel(QObject* parent /*= nullptr*/)
     , mOpenSuccess   (false)
     , mReadOnlyOrigin( )
     , mValidationController(*this, [this]() { return SMValidator::validate(getData()); }, this)
+    , mSavesPending  (0)
+    , mHistoryMoves  (0)
+    , mSavePool      ( )
 {
+    // One thread, so the files are written in the order the saves were asked for.
+    mSavePool.setMaxThreadCount(1);
     mUndoStack.setUndoLimit(100);
     mAutosaveTimer.setSingleShot(false);
     mAutosaveTimer.setInterval(AutosaveIntervalMs);
 
     connect(&mAutosaveTimer, &QTimer::timeout, this, &StateMachineModel::onAutosaveTimeout);
     connect(&mUndoStack, &QUndoStack::cleanChanged, this, &StateMachineModel::onUndoCleanChanged);
+    connect(&mUndoStack, &QUndoStack::indexChanged, this, [this](int /*idx*/) { ++ mHistoryMoves; });
+
+    // The autosave journals what the edits report. The order of the states is compared at each
+    // autosave, so a reordered level needs no record here.
+    connect(&mNotifier, &DocModelNotifier::elementAdded, this, &StateMachineModel::onElementEdited);
+    connect(&mNotifier, &DocModelNotifier::elementRemoved, this, &StateMachineModel::onElementEdited);
+    connect(&mNotifier, &DocModelNotifier::elementChanged, this, &StateMachineModel::onElementEdited);
+    connect(&mNotifier, &DocModelNotifier::listReordered, this, [this](uint32_t ownerId, eDocElementKind kind) {
+        if (kind != eDocElementKind::State)
+        {
+            onElementEdited(ownerId, kind);
+        }
+    });
+    connect(&mNotifier, &DocModelNotifier::layoutChanged, this, &StateMachineModel::onLayoutEdited);
+    connect(&mNotifier, &DocModelNotifier::nameChanged, this, [this](uint32_t id, const QString& /*oldName*/, const QString& /*newName*/) {
+        mAutosaveChanges.elements.insert(id);
+        if (mData != nullptr)
+        {
+            mData->stateElementChanged(id);
+        }
+    });
+    connect(&mNotifier, &DocModelNotifier::documentReloaded, this, [this]() {
+        mAutosaveJournal.reset();
+        mAutosaveChanges.clear();
+        mAutosaveChanges.full = true;
+    });
+}
+
+StateMachineModel::~StateMachineModel()
+{
+    // A save still being written is finished, not lost with the window.
+    mSavePool.waitForDone();
 }
 
 bool StateMachineModel::createNewDocument(const QString& machineName)
@@ -152,6 +194,9 @@ bool StateMachineModel::loadFromFile(const QString& documentPath, const QString&
         return false;
     }
 
+    // A save still being written goes first, so a reload reads what the editor wrote.
+    mSavePool.waitForDone();
+
     const QString pathToRead = sourcePath.isEmpty() ? documentPath : sourcePath;
     std::unique_ptr<StateMachineData> loaded{ std::make_unique<StateMachineData>() };
     if (loaded->readFromFile(pathToRead) == false)
@@ -163,6 +208,9 @@ bool StateMachineModel::loadFromFile(const QString& documentPath, const QString&
     convertLegacyGuards(loaded->getStates());
     mData = std::move(loaded);
     mOpenSuccess = true;
+    // The imports are read in parallel from here on; the version check below and the first
+    // validation pass collect them instead of reading them one by one.
+    SMDocumentCache::getInstance().prefetchImports(*mData);
 
     // A pin that only drifted at the PATCH level is corrected silently: nothing an import
     // provides can change at that level, so there is nothing for the author to decide. MAJOR
@@ -229,6 +277,8 @@ bool StateMachineModel::saveToFile(const QString& filePath /*= QString()*/)
         return false;
     }
 
+    // The saves and autosaves still being written go first, so none of them lands after this one.
+    mSavePool.waitForDone();
     refreshGuardNames(*mData, mData->getStates());
 
     const QString previousPath = mData->getFilePath();
@@ -238,12 +288,53 @@ bool StateMachineModel::saveToFile(const QString& filePath /*= QString()*/)
     }
 
     mUndoStack.setClean();
+    mAutosaveJournal.reset();
+    mAutosaveChanges.clear();
     StateMachineData::removeAutosave(previousPath);
     StateMachineData::removeAutosave(mData->getFilePath());
     updateAutosaveTimer();
     return true;
 }
 
+bool StateMachineModel::saveInBackground(const QString& filePath /*= QString()*/)
+{
+    if ((mData == nullptr) || isReadOnly())
+    {
+        return false;
+    }
+
+    const QString previousPath = mData->getFilePath();
+    const QString path = filePath.isEmpty() ? previousPath : filePath;
+    if (path.isEmpty())
+    {
+        return false;
+    }
+
+    refreshGuardNames(*mData, mData->getStates());
+    std::shared_ptr<const StateMachineData::SaveSnapshot> snapshot{ mData->takeSaveSnapshot() };
+
+    // The autosave files go once the document is on disk, and not before: a failed save leaves
+    // them as the only copy of the edits. The document stays dirty until the outcome is known.
+    ++mSavesPending;
+    const uint32_t historyMoves = mHistoryMoves;
+    mSavePool.start([this, snapshot, path, previousPath, historyMoves]() {
+        const bool saved = snapshot->writeToFile(path);
+        if (saved)
+        {
+            StateMachineData::removeAutosave(previousPath);
+            StateMachineData::removeAutosave(path);
+        }
+
+        QMetaObject::invokeMethod(this, [this, path, saved, historyMoves]() { onSaveFinished(path, saved, historyMoves); }, Qt::QueuedConnection);
+    });
+
+    mData->setFilePath(path);
+    mAutosaveJournal.reset();
+    mAutosaveChanges.clear();
+    updateAutosaveTimer();
+    return true;
+}
+
 bool StateMachineModel::writeAutosave()
 {
     if ((mData == nullptr) || isReadOnly() || mUndoStack.isClean())
@@ -257,13 +348,57 @@ bool StateMachineModel::writeAutosave()
         return true;
     }
 
+    // The snapshot of the last autosave is still being written; the changes wait for the next.
+    if (mAutosaveJournal.isCompacting())
+    {
+        return true;
+    }
+
     refreshGuardNames(*mData, mData->getStates());
-    return mData->writeToAutosaveFile(StateMachineData::autosavePathForDocument(documentPath));
+    if (mAutosaveJournal.appendChanges(*mData, documentPath, mAutosaveChanges))
+    {
+        mAutosaveChanges.clear();
+        return true;
+    }
+
+    // A new snapshot is due. It is written on the save thread from a frozen copy, as a save is.
+    std::shared_ptr<const StateMachineData::SaveSnapshot> snapshot{ mData->takeSaveSnapshot() };
+    const uint32_t ticket = mAutosaveJournal.beginCompaction(*mData, documentPath);
+    mAutosaveChanges.clear();
+    mSavePool.start([this, snapshot, documentPath, ticket]() {
+        const QByteArray buffer = snapshot->writeToBuffer();
+        qint64 journalSize{ 0 };
+        const bool written = SMAutosaveJournal::writeSnapshot(buffer, documentPath, journalSize);
+        const qint64 snapshotSize = buffer.size();
+        QMetaObject::invokeMethod(this, [this, ticket, written, snapshotSize, journalSize]() {
+            onAutosaveWritten(ticket, written, snapshotSize, journalSize);
+        }, Qt::QueuedConnection);
+    });
+
+    return true;
 }
 
 bool StateMachineModel::removeAutosave()
 {
-    return (mData != nullptr ? StateMachineData::removeAutosave(mData->getFilePath()) : true);
+    mAutosaveJournal.reset();
+    if (mData == nullptr)
+    {
+        return true;
+    }
+
+    // Not before the saves and autosaves still being written are done: none of them may bring the
+    // files back, and a save that fails must find them still there.
+    mSavePool.waitForDone();
+    StateMachineData::removeAutosave(mData->getFilePath());
+    return true;
+}
+
+bool StateMachineModel::finishSaves()
+{
+    mSavePool.waitForDone();
+    // The outcomes are queued to this object; delivered now, the caller sees them on return.
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+    return (isDirty() == false);
 }
 
 void StateMachineModel::publishStateNamePreview(uint32_t stateId, const QString& text)
@@ -399,7 +534,8 @@ void StateMachineModel::onAutosaveTimeout()
 
 void StateMachineModel::onUndoCleanChanged(bool clean)
 {
-    if (clean)
+    // A save being written removes the autosave itself, once the document is on disk.
+    if (clean && (mSavesPending == 0))
     {
         removeAutosave();
     }
@@ -408,6 +544,75 @@ void StateMachineModel::onUndoCleanChanged(bool clean)
     updateAutosaveTimer();
 }
 
+void StateMachineModel::onElementEdited(uint32_t id, eDocElementKind kind)
+{
+    switch (kind)
+    {
+    case eDocElementKind::Overview:
+        mAutosaveChanges.sections.insert(static_cast<int>(SMAutosaveJournal::eSection::Overview));
+        break;
+    case eDocElementKind::DataType:
+        mAutosaveChanges.sections.insert(static_cast<int>(SMAutosaveJournal::eSection::DataTypes));
+        break;
+    case eDocElementKind::Attribute:
+        mAutosaveChanges.sections.insert(static_cast<int>(SMAutosaveJournal::eSection::Attributes));
+        break;
+    case eDocElementKind::Event:
+        mAutosaveChanges.sections.insert(static_cast<int>(SMAutosaveJournal::eSection::Events));
+        break;
+    case eDocElementKind::Timer:
+        mAutosaveChanges.sections.insert(static_cast<int>(SMAutosaveJournal::eSection::Timers));
+        break;
+    case eDocElementKind::Method:
+        mAutosaveChanges.sections.insert(static_cast<int>(SMAutosaveJournal::eSection::Methods));
+        break;
+    case eDocElementKind::Constant:
+        mAutosaveChanges.sections.insert(static_cast<int>(SMAutosaveJournal::eSection::Constants));
+        break;
+    case eDocElementKind::Include:
+    case eDocElementKind::Import:
+        mAutosaveChanges.sections.insert(static_cast<int>(SMAutosaveJournal::eSection::Includes));
+        break;
+    case eDocElementKind::State:
+    case eDocElementKind::Transition:
+    case eDocElementKind::Condition:
+    case eDocElementKind::Operation:
+        mAutosaveChanges.elements.insert(id);
+        if (mData != nullptr)
+        {
+            mData->stateElementChanged(id);
+        }
+        break;
+    case eDocElementKind::Note:
+        mAutosaveChanges.notes.insert(id);
+        break;
+    case eDocElementKind::Layout:
+        mAutosaveChanges.owners.insert(id);
+        break;
+    default:
+        mAutosaveChanges.full = true;
+        if (mData != nullptr)
+        {
+            mData->unshareStates();
+        }
+        break;
+    }
+}
+
+void StateMachineModel::onLayoutEdited(const QList<uint32_t>& ownerIds)
+{
+    // No owner is the grid, which is the only layout setting not kept per owner.
+    if (ownerIds.isEmpty())
+    {
+        mAutosaveChanges.grid = true;
+    }
+
+    for (uint32_t owner : ownerIds)
+    {
+        mAutosaveChanges.owners.insert(owner);
+    }
+}
+
 void StateMachineModel::markDirty()
 {
     if (mUndoStack.isClean())
@@ -430,3 +635,34 @@ void StateMachineModel::updateAutosaveTimer()
         mAutosaveTimer.stop();
     }
 }
+
+void StateMachineModel::onSaveFinished(const QString& filePath, bool succeeded, uint32_t historyMoves)
+{
+    --mSavesPending;
+    if (succeeded)
+    {
+        // An edit made while the file was written is not in it, so the document stays dirty.
+        if (historyMoves == mHistoryMoves)
+        {
+            mUndoStack.setClean();
+        }
+    }
+    else
+    {
+        // The edits are on disk nowhere but in the autosave, which the next autosave rewrites whole.
+        mAutosaveJournal.reset();
+        mAutosaveChanges.full = true;
+        updateAutosaveTimer();
+    }
+
+    emit signalSaveFinished(filePath, succeeded);
+}
+
+void StateMachineModel::onAutosaveWritten(uint32_t ticket, bool written, qint64 snapshotSize, qint64 journalSize)
+{
+    mAutosaveJournal.endCompaction(ticket, written, snapshotSize, journalSize);
+    if (written == false)
+    {
+        mAutosaveChanges.full = true;
+    }
+}
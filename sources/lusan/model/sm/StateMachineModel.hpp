@@ -19,6 +19,7 @@
  *
  ************************************************************************/
 
+#include "lusan/data/sm/SMAutosaveJournal.hpp"
 #include "lusan/data/sm/StateMachineData.hpp"
 #include "lusan/model/common/DocModelNotifier.hpp"
 #include "lusan/model/common/DocUndoStack.hpp"
@@ -35,6 +36,7 @@
 #include "lusan/model/common/DocValidationController.hpp"
 
 #include <QObject>
+#include <QThreadPool>
 #include <QTimer>
 #include <memory>
 
@@ -48,7 +50,7 @@ class StateMachineModel : public QObject
 //////////////////////////////////////////////////////////////////////////
 public:
     explicit StateMachineModel(QObject* parent = nullptr);
-    virtual ~StateMachineModel() = default;
+    virtual ~StateMachineModel();
 
 //////////////////////////////////////////////////////////////////////////
 // Attributes and operations
@@ -57,12 +59,31 @@ public:
     bool createNewDocument(const QString& machineName);
     bool loadFromFile(const QString& documentPath, const QString& sourcePath = QString());
     bool saveToFile(const QString& filePath = QString());
+
+    /**
+     * \brief   Saves the document on the save thread, so the editor goes on while a large machine
+     *          is written. The document is frozen first; signalSaveFinished() reports the outcome.
+     *          It counts as saved once the file is written, and only if no edit came meanwhile.
+     * \param   filePath    The destination path, or empty to reuse the document's path.
+     * \return  True if the write started.
+     **/
+    bool saveInBackground(const QString& filePath = QString());
     bool writeAutosave();
     bool removeAutosave();
+
+    /**
+     * \brief   Waits for the saves still being written and takes their outcome, so a closing
+     *          window knows whether its document is on disk before it lets the autosave go.
+     * \return  True if the document is saved, i.e. no longer dirty.
+     **/
+    bool finishSaves();
     void publishStateNamePreview(uint32_t stateId, const QString& text);
 
     inline bool openSucceeded() const;
     inline bool isDirty() const;
+
+    //!< True while a save is being written on the save thread.
+    inline bool isSaving() const;
     inline const QString& getFilePath() const;
 
     /**
@@ -167,19 +188,36 @@ signals:
     void signalDirtyChanged(bool dirty);
     void signalStateNamePreview(uint32_t stateId, const QString& text);
 
+    //!< A save started by saveInBackground() has written \p filePath, or failed to.
+    void signalSaveFinished(const QString& filePath, bool succeeded);
+
 private slots:
     void onAutosaveTimeout();
     void onUndoCleanChanged(bool clean);
 
+    //!< Records an edited element for the next autosave.
+    void onElementEdited(uint32_t id, eDocElementKind kind);
+
+    //!< Records the edited layout of the given owners for the next autosave.
+    void onLayoutEdited(const QList<uint32_t>& ownerIds);
+
 private:
     void markDirty();
     void updateAutosaveTimer();
 
+    //!< Takes the outcome of a save written on the save thread.
+    void onSaveFinished(const QString& filePath, bool succeeded, uint32_t historyMoves);
+
+    //!< Takes the outcome of an autosave snapshot written on the save thread.
+    void onAutosaveWritten(uint32_t ticket, bool written, qint64 snapshotSize, qint64 journalSize);
+
 private:
     std::unique_ptr<StateMachineData> mData;
     DocModelNotifier mNotifier;
     DocUndoStack    mUndoStack;
     QTimer          mAutosaveTimer;
+    SMAutosaveJournal mAutosaveJournal;             //!< The autosave snapshot and the journal of the edits since.
+    SMAutosaveJournal::Changes mAutosaveChanges;    //!< What changed since the last autosave.
     SMOverviewModel mOverviewModel;
     DataTypeModel mDataTypeModel;
     AttributeModel mAttributeModel;
@@ -192,6 +230,9 @@ private:
     bool            mOpenSuccess;
     QString         mReadOnlyOrigin;    //!< Non-empty only for a read-only import view.
     DocValidationController mValidationController; //!< Background structural/reference validation.
+    int             mSavesPending;      //!< The saves written on the save thread and not yet reported.
+    uint32_t        mHistoryMoves;      //!< Counts the moves of the undo history, so a save knows whether an edit came while it was written.
+    QThreadPool     mSavePool;          //!< The save thread: writes the saves, the autosave snapshots and their removal in order.
 };
 
 inline bool StateMachineModel::openSucceeded() const
@@ -204,6 +245,11 @@ inline bool StateMachineModel::isDirty() const
     return mUndoStack.isClean() == false;
 }
 
+inline bool StateMachineModel::isSaving() const
+{
+    return (mSavesPending > 0);
+}
+
 inline const QString& StateMachineModel::getFilePath() const
 {
     static const QString _empty;
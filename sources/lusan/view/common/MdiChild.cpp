@@ -280,7 +280,7 @@ void MdiChild::rememberFileState()
 
 void MdiChild::checkFileChangedOnDisk()
 {
-    if (mIsClosing || mReloadAsked || mCurFile.isEmpty() || (mMainWindow == nullptr))
+    if (mIsClosing || mReloadAsked || mCurFile.isEmpty() || (mMainWindow == nullptr) || isWritingFile())
     {
         return;
     }
@@ -323,6 +323,11 @@ void MdiChild::checkFileChangedOnDisk()
     }
 }
 
+bool MdiChild::isWritingFile() const
+{
+    return false;
+}
+
 void MdiChild::onWindowClosing(bool /*isActive*/)
 {
 }
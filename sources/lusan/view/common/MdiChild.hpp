@@ -429,6 +429,12 @@ protected:
      **/
     void rememberFileState();
 
+    /**
+     * \brief   True while the document writes its file in the background. The file changes then
+     *          without anybody else touching it, so no change on disk is reported meanwhile.
+     **/
+    virtual bool isWritingFile() const;
+
 private slots:
     /**
      * \brief   Slot called when the document is modified.
@@ -367,6 +367,11 @@ ScopeOutputViewer& MdiMainWindow::getOutputScopeLogs()
     return mOutputDock.getScopeLogsView();
 }
 
+ScopeCallTreeViewer& MdiMainWindow::getOutputCallTree()
+{
+    return mOutputDock.getCallTreeView();
+}
+
 void MdiMainWindow::setTabBarTooltip(QMdiSubWindow* subWindow, const QString& tooltip)
 {
     if (subWindow == nullptr)
@@ -1390,6 +1395,8 @@ StateMachine* MdiMainWindow::createStateMachineView(const QString& filePath /*=
             }
             else if (recovery.clickedButton() == restore)
             {
+                // The autosave is opened as it was last committed, with the journal folded in.
+                StateMachineData::recoverAutosave(filePath);
                 sourcePath = autosavePath;
             }
             else if (recovery.clickedButton() == discard)
@@ -45,6 +45,7 @@ class NaviDesignPanel;
 class LiveLogViewer;
 class OfflineLogViewer;
 class ScopeOutputViewer;
+class ScopeCallTreeViewer;
 class SourceViewer;
 
 QT_BEGIN_NAMESPACE
@@ -305,6 +306,11 @@ public:
      **/
     ScopeOutputViewer& getOutputScopeLogs();
 
+    /**
+     * \brief   Returns the Output Window for the call tree of scopes.
+     **/
+    ScopeCallTreeViewer& getOutputCallTree();
+
     /**
      * \brief   Sets the tooltip text for the tab bar of the given MDI sub-window.
      * \param   subWindow   The MDI sub-window to set the tooltip for.
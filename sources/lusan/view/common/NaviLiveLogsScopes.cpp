@@ -469,8 +469,9 @@ void NaviLiveLogsScopes::onScopesUpdated(const QModelIndex & parent)
 
 void NaviLiveLogsScopes::onScopesDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles /*= QList<int>()*/)
 {
+    // The model notifies the changed nodes and the shown rows of their subtrees, the tree repaints
+    // them, only the buttons are updated.
     enableButtons(ctrlTable()->currentIndex());
-    updateExpanded(ctrlTable()->rootIndex());
 }
 
 void NaviLiveLogsScopes::optionOpenning()
@@ -595,6 +596,10 @@ void NaviLiveLogsScopes::onTreeViewContextMenuRequested(const QPoint& pos)
     mMenuActions[static_cast<int>(eLogActions::SavePrioAll)]->setCheckable(false);
     mMenuActions[static_cast<int>(eLogActions::SavePrioAll)]->setEnabled(LogObserver::isConnected());
 
+    menu.addSeparator();
+    mMenuActions[static_cast<int>(eLogActions::ShowTraffic)] = menu.addAction(tr("Show &Traffic Statistics"));
+    mMenuActions[static_cast<int>(eLogActions::ShowTraffic)]->setCheckable(true);
+    mMenuActions[static_cast<int>(eLogActions::ShowTraffic)]->setChecked(isTrafficShown());
 
     QAction* selectedAction = menu.exec(ctrlTable()->viewport()->mapToGlobal(pos));
     if (nullptr == selectedAction)
@@ -655,6 +660,10 @@ void NaviLiveLogsScopes::onTreeViewContextMenuRequested(const QPoint& pos)
     {
         mScopesModel->saveLogScopePriority(mScopesModel != nullptr ? mScopesModel->getRootIndex() : QModelIndex());
     }
+    else if (selectedAction == mMenuActions[eLogActions::ShowTraffic])
+    {
+        showTrafficColumns(selectedAction->isChecked());
+    }
 }
 
 void NaviLiveLogsScopes::onWindowCreated(MdiChild* mdiChild)
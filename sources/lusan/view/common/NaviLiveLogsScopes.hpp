@@ -74,6 +74,7 @@ private:
         , CollapseAll       //!< Collapse all nodes
         , SavePrioTarget    //!< Save priority settings of the selected target
         , SavePrioAll       //!< Save priority settings of all targets
+        , ShowTraffic       //!< Show / hide the traffic statistics
 
         , PrioCount         //!< The number of entries in the menu
     };
@@ -22,10 +22,16 @@
 #include "lusan/data/log/ScopeNodeBase.hpp"
 #include "lusan/model/log/LogIconFactory.hpp"
 #include "lusan/model/log/LoggingScopesModelBase.hpp"
+#include "lusan/model/log/ScopeLatencyModel.hpp"
 #include "lusan/view/common/MdiMainWindow.hpp"
 
+#include <QHeaderView>
 #include <QItemSelectionModel>
+#include <QLayout>
 #include <QSize>
+#include <QSortFilterProxyModel>
+#include <QSplitter>
+#include <QTableView>
 #include <QToolButton>
 #include <QTreeView>
 
@@ -34,6 +40,9 @@ NaviLogScopeBase::NaviLogScopeBase(int naviWindow, MdiMainWindow* wndMain, QWidg
     , mScopesModel(nullptr)
     , mSelModel(nullptr)
     , mNaviTree(nullptr)
+    , mLatencyModel(new ScopeLatencyModel(this))
+    , mLatencyProxy(nullptr)
+    , mLatencyTable(nullptr)
 {
 }
 
@@ -48,6 +57,11 @@ void NaviLogScopeBase::setupModel(LoggingScopesModelBase* model)
         mNaviTree->setModel(mScopesModel);
         connect(mSelModel   , &QItemSelectionModel::currentRowChanged,this, [this](const QModelIndex &current, const QModelIndex &previous) {onRowChanged(current, previous);});
     }
+
+    if (mScopesModel != nullptr)
+    {
+        connect(mScopesModel, &LoggingScopesModelBase::signalLoggingModelChanged, mLatencyModel, [this](LoggingModelBase* logModel) {mLatencyModel->setLoggingModel(logModel);});
+    }
 }
 
 void NaviLogScopeBase::setupControls(QTreeView* treeView, QToolButton* prioError, QToolButton* prioWarning, QToolButton* prioInfo, QToolButton* prioDebug, QToolButton* prioScopes)
@@ -83,6 +97,8 @@ void NaviLogScopeBase::setupControls(QTreeView* treeView, QToolButton* prioError
         mNaviTree->setSelectionModel(mSelModel);
         connect(mSelModel   , &QItemSelectionModel::currentRowChanged,this, [this](const QModelIndex &current, const QModelIndex &previous) {onRowChanged(current, previous);});
     }
+
+    setupLatencyTable();
 }
 
 void NaviLogScopeBase::capToolButtonIconSizes(int iconExtent /*= 12*/)
@@ -95,6 +111,31 @@ void NaviLogScopeBase::capToolButtonIconSizes(int iconExtent /*= 12*/)
     }
 }
 
+void NaviLogScopeBase::showTrafficColumns(bool show)
+{
+    if ((mNaviTree == nullptr) || (mScopesModel == nullptr))
+        return;
+
+    mScopesModel->setTrafficColumns(show);
+    mNaviTree->setHeaderHidden(show == false);
+    mNaviTree->setSortingEnabled(show);
+    if (show)
+    {
+        mNaviTree->header()->setStretchLastSection(false);
+        mNaviTree->header()->setSectionResizeMode(static_cast<int>(LoggingScopesModelBase::eColumn::ColumnScope), QHeaderView::ResizeMode::Stretch);
+        mNaviTree->sortByColumn(static_cast<int>(LoggingScopesModelBase::eColumn::ColumnScope), Qt::SortOrder::AscendingOrder);
+    }
+    else
+    {
+        mNaviTree->header()->setStretchLastSection(true);
+    }
+}
+
+bool NaviLogScopeBase::isTrafficShown() const
+{
+    return (mScopesModel != nullptr) && mScopesModel->hasTrafficColumns();
+}
+
 inline void NaviLogScopeBase::validateControls()
 {
     Q_ASSERT(mPrioDebug     != nullptr);
@@ -106,6 +147,45 @@ inline void NaviLogScopeBase::validateControls()
     Q_ASSERT(mScopesModel   != nullptr);
 }
 
+void NaviLogScopeBase::setupLatencyTable()
+{
+    QWidget* container = mNaviTree->parentWidget();
+    QLayout* layout = container != nullptr ? container->layout() : nullptr;
+    if ((layout == nullptr) || (mLatencyTable != nullptr))
+        return;
+
+    QSplitter* splitter = new QSplitter(Qt::Orientation::Vertical, container);
+    QLayoutItem* item = layout->replaceWidget(mNaviTree, splitter);
+    if (item == nullptr)
+    {
+        delete splitter;
+        return;
+    }
+
+    delete item;
+    mLatencyProxy = new QSortFilterProxyModel(this);
+    mLatencyProxy->setSourceModel(mLatencyModel);
+    mLatencyProxy->setSortRole(Qt::ItemDataRole::UserRole);
+    mLatencyProxy->setDynamicSortFilter(true);
+
+    mLatencyTable = new QTableView(splitter);
+    mLatencyTable->setModel(mLatencyProxy);
+    mLatencyTable->setSortingEnabled(true);
+    mLatencyTable->sortByColumn(static_cast<int>(ScopeLatencyModel::eColumn::ColumnP99), Qt::SortOrder::DescendingOrder);
+    mLatencyTable->setSelectionBehavior(QAbstractItemView::SelectionBehavior::SelectRows);
+    mLatencyTable->setSelectionMode(QAbstractItemView::SelectionMode::SingleSelection);
+    mLatencyTable->setEditTriggers(QAbstractItemView::EditTrigger::NoEditTriggers);
+    mLatencyTable->setWordWrap(false);
+    mLatencyTable->verticalHeader()->setVisible(false);
+    mLatencyTable->horizontalHeader()->setSectionResizeMode(static_cast<int>(ScopeLatencyModel::eColumn::ColumnScope), QHeaderView::ResizeMode::Stretch);
+    mLatencyTable->setToolTip(tr("The durations of the calls of the scopes"));
+
+    splitter->addWidget(mNaviTree);
+    splitter->addWidget(mLatencyTable);
+    splitter->setStretchFactor(0, 3);
+    splitter->setStretchFactor(1, 1);
+}
+
 bool NaviLogScopeBase::areRootsCollapsed() const
 {
     bool result{ false };
@@ -263,7 +343,7 @@ void NaviLogScopeBase::expandChildNodesRecursive(const QModelIndex& idxNode, con
         Q_ASSERT(child != nullptr);
         if (child->isNodeExpanded())
         {
-            QModelIndex idxChild{ mScopesModel->index(row, 0, idxNode) };
+            QModelIndex idxChild{ mScopesModel->indexOfNode(child) };
             Q_ASSERT(idxChild.isValid());
             navi->expand(idxChild);
             if (child->isNode())
@@ -35,8 +35,11 @@ class LoggingModelBase;
 class ScopeNodeBase;
 class QItemSelectionModel;
 class QModelIndex;
+class QSortFilterProxyModel;
+class QTableView;
 class QToolButton;
 class QTreeView;
+class ScopeLatencyModel;
 
 class NaviLogScopeBase : public NavigationWindow
 {
@@ -72,7 +75,10 @@ public:
     //!< Sets up the model for the log scopes navigation.
     void setupModel(LoggingScopesModelBase* model);
 
-    //!< Sets up the controls for the log scopes navigation.
+    /**
+     * \brief   Sets up the controls for the log scopes navigation. The scope tree view shares
+     *          its place with the table of the latency statistics of the scopes.
+     **/
     void setupControls(QTreeView* treeView, QToolButton* prioError, QToolButton* prioWarning, QToolButton* prioInfo, QToolButton* prioDebug, QToolButton* prioScopes);
 
     /**
@@ -86,6 +92,18 @@ public:
      **/
     void capToolButtonIconSizes(int iconExtent = 12);
 
+    /**
+     * \brief   Shows or hides the sortable columns of the traffic statistics of the scopes
+     *          (messages per second, messages, bytes and the time of the last message).
+     * \param   show    If true, shows the columns and the header of the scope tree.
+     **/
+    void showTrafficColumns(bool show);
+
+    /**
+     * \brief   Returns true if the columns of the traffic statistics of the scopes are shown.
+     **/
+    bool isTrafficShown() const;
+
 public:
     /**
      * \brief   Enables or disables lot priority tool buttons based on selection index.
@@ -171,6 +189,9 @@ private:
     //!< Validates the object by checking with assertions.
     inline void validateControls();
 
+    //!< Creates the table of the latency statistics of the scopes under the scope tree view.
+    void setupLatencyTable();
+
 protected:
     LoggingScopesModelBase* mScopesModel;   //!< The model of the log scopes
     QItemSelectionModel*    mSelModel;      //!< Selection model
@@ -182,6 +203,9 @@ private:
     QToolButton*            mPrioInfo;      //!< The tool button for info log priority
     QToolButton*            mPrioDebug;     //!< The tool button for debug log priority
     QToolButton*            mPrioScopes;    //!< The tool button for scopes log priority
+    ScopeLatencyModel*      mLatencyModel;  //!< The model of the latency statistics of the scopes
+    QSortFilterProxyModel*  mLatencyProxy;  //!< The proxy to sort the latency statistics
+    QTableView*             mLatencyTable;  //!< The table view of the latency statistics
 };
 
 inline void NaviLogScopeBase::setNaviTree(QTreeView* treeView)
@@ -296,7 +296,6 @@ void NaviOfflineLogsScopes::restoreView()
     if (logModel != nullptr)
     {
         const LoggingModelBase::RootList& roots{ logModel->getRootList() };
-        const QModelIndex& idxRoot{ mScopesModel->getRootIndex() };
         int rootCount{static_cast<int>(roots.size())};
         QTreeView* navi = ctrlTable();
         for (int row = 0; row < rootCount; ++row)
@@ -304,7 +303,7 @@ void NaviOfflineLogsScopes::restoreView()
             const ScopeRoot* root{roots[row]};
             if (root->isNodeExpanded())
             {
-                QModelIndex idxNode{ mScopesModel->index(row, 0, idxRoot) };
+                QModelIndex idxNode{ mScopesModel->indexOfNode(root) };
                 navi->expand(idxNode);
                 expandChildNodesRecursive(idxNode, *root);
             }
@@ -460,6 +459,11 @@ void NaviOfflineLogsScopes::onTreeViewContextMenuRequested(const QPoint& pos)
     mMenuActions[static_cast<int>(eLogActions::CollapseAll)]->setEnabled(areRootsCollapsed() == false);
     mMenuActions[static_cast<int>(eLogActions::CollapseAll)]->setCheckable(false);
 
+    menu.addSeparator();
+    mMenuActions[static_cast<int>(eLogActions::ShowTraffic)] = menu.addAction(tr("Show &Traffic Statistics"));
+    mMenuActions[static_cast<int>(eLogActions::ShowTraffic)]->setCheckable(true);
+    mMenuActions[static_cast<int>(eLogActions::ShowTraffic)]->setChecked(isTrafficShown());
+
     QAction* selectedAction = menu.exec(ctrlTable()->viewport()->mapToGlobal(pos));
     if (nullptr == selectedAction)
         return;
@@ -515,6 +519,10 @@ void NaviOfflineLogsScopes::onTreeViewContextMenuRequested(const QPoint& pos)
     {
         onCollapseClicked(false, ctrlCollapse());
     }
+    else if (selectedAction == mMenuActions[eLogActions::ShowTraffic])
+    {
+        showTrafficColumns(selectedAction->isChecked());
+    }
     else
     {
         processed = false;
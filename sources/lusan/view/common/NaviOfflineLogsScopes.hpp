@@ -73,6 +73,7 @@ class NaviOfflineLogsScopes : public NaviLogScopeBase
         , CollapseSelected  //!< Collapse selected node
         , ExpandAll         //!< Expand all nodes
         , CollapseAll       //!< Collapse all nodes
+        , ShowTraffic       //!< Show / hide the traffic statistics
 
         , PrioCount         //!< The number of entries in the menu
     };
@@ -32,6 +32,7 @@
 
 const QString   OutputDock::TabNameLogging{ tr("Log analyzes") };
 const QString   OutputDock::TabNameValidation{ tr("Validation") };
+const QString   OutputDock::TabNameCallTree{ tr("Call Tree") };
 
 const QString& OutputDock::getTabName(OutputDock::eOutputDock wndOutput)
 {
@@ -42,6 +43,8 @@ const QString& OutputDock::getTabName(OutputDock::eOutputDock wndOutput)
         return OutputDock::TabNameLogging;
     case OutputDock::eOutputDock::OutputValidation:
         return OutputDock::TabNameValidation;
+    case OutputDock::eOutputDock::OutputCallTree:
+        return OutputDock::TabNameCallTree;
     default:
         return _empty;
     }
@@ -53,6 +56,8 @@ OutputDock::eOutputDock OutputDock::getOutputDock(const QString& tabName)
         return OutputDock::eOutputDock::OutputLogging;
     else if (tabName == OutputDock::TabNameValidation)
         return OutputDock::eOutputDock::OutputValidation;
+    else if (tabName == OutputDock::TabNameCallTree)
+        return OutputDock::eOutputDock::OutputCallTree;
     else
         return OutputDock::eOutputDock::OutputUnknown;
 }
@@ -62,6 +67,7 @@ OutputDock::OutputDock(MdiMainWindow* parent)
     , mMainWindow   (parent)
     , mTabs         (this)
     , mScopeOutput  (parent, this)
+    , mCallTree     (parent, this)
     , mValidationTab(nullptr)
     , mValidationBody(nullptr)
     , mValidationView(nullptr)
@@ -69,6 +75,7 @@ OutputDock::OutputDock(MdiMainWindow* parent)
     , mBoundDocs    ( )
 {
     mTabs.addTab(&mScopeOutput, QIcon(), tr("Scopes Analyzes"));
+    mTabs.addTab(&mCallTree, QIcon(), OutputDock::TabNameCallTree);
 
     // The findings of the active state machine document, one per row, worst severity first. A
     // build-style diagnostic list belongs in the output window rather than a per-document panel.
@@ -94,7 +101,8 @@ OutputDock::OutputDock(MdiMainWindow* parent)
 
 OutputDock::~OutputDock()
 {
-    mTabs.removeTab(0);
+    mTabs.removeTab(mTabs.indexOf(&mCallTree));
+    mTabs.removeTab(mTabs.indexOf(&mScopeOutput));
     mTabs.setParent(nullptr);
 }
 
@@ -25,6 +25,7 @@
 #include <QWidget>
 #include "areg/base/areg_global.h"
 
+#include "lusan/view/log/ScopeCallTreeViewer.hpp"
 #include "lusan/view/log/ScopeOutputViewer.hpp"
 
 #include <QPointer>
@@ -59,6 +60,7 @@ public:
           OutputUnknown     //!< Unknown output window
         , OutputLogging     //!< Status window for log analyzes
         , OutputValidation  //!< Validation findings of the open documents
+        , OutputCallTree    //!< Call tree of the scopes of the log window
     };
 
     //!< The tab name for the logging output window
@@ -67,6 +69,9 @@ public:
     //!< The tab name for the validation findings window
     static const QString    TabNameValidation;
 
+    //!< The tab name for the call tree of the scopes
+    static const QString    TabNameCallTree;
+
     //!< Returns the tab name of the specified output window
     static const QString& getTabName(OutputDock::eOutputDock wndStatus);
 
@@ -96,6 +101,11 @@ public:
      **/
     inline ScopeOutputViewer& getScopeLogsView();
 
+    /**
+     * \brief   Returns the call tree viewer of the scopes.
+     **/
+    inline ScopeCallTreeViewer& getCallTreeView();
+
     /**
      * \brief   Points the Validation tab at the open documents that carry validation, or at a
      *          placeholder when there are none. The list is rebuilt whenever the set of open
@@ -145,6 +155,7 @@ private:
     MdiMainWindow*          mMainWindow;    //!< Main window
     QTabWidget              mTabs;          //!< The tab widget of the output windows.
     ScopeOutputViewer       mScopeOutput;   //<!< The scope output viewer for displaying logs from scopes.
+    ScopeCallTreeViewer     mCallTree;      //!< The call tree viewer of the scopes of the log window.
     QWidget*                mValidationTab; //!< The Validation tab body, host of the findings panel.
     QVBoxLayout*            mValidationBody;//!< The single-child layout of the Validation tab.
     QWidget*                mValidationView;//!< The hosted findings panel, or the placeholder note.
@@ -172,6 +183,11 @@ inline ScopeOutputViewer& OutputDock::getScopeLogsView()
     return mScopeOutput;
 }
 
+inline ScopeCallTreeViewer& OutputDock::getCallTreeView()
+{
+    return mCallTree;
+}
+
 inline DocValidationPanel* OutputDock::getValidationView() const
 {
     return mValidation;
@@ -23,6 +23,7 @@
 #include "lusan/view/common/MdiMainWindow.hpp"
 #include "lusan/view/common/NaviLiveLogsScopes.hpp"
 #include "lusan/data/log/LogObserver.hpp"
+#include "lusan/view/log/LogIngestPanel.hpp"
 #include "lusan/model/log/LiveLogsModel.hpp"
 #include "lusan/model/log/LogViewerFilter.hpp"
 
@@ -38,6 +39,7 @@ const QString   LiveLogViewer::_tooltipRestartLogging   (tr("Restart logging in
 LiveLogViewer::LiveLogViewer(MdiMainWindow *wndMain, QWidget *parent)
     : LogViewerBase (MdiChild::eMdiWindow::MdiLogViewer, nullptr, wndMain, parent)
     , ui            (new Ui::LiveLogViewer)
+    , mIngestPanel  (nullptr)
 {
     ui->setupUi(mMdiWindow);
     mLogModel   = new LiveLogsModel(this);
@@ -45,6 +47,17 @@ LiveLogViewer::LiveLogViewer(MdiMainWindow *wndMain, QWidget *parent)
     mLogSearch  = ui->textSearch;
     
     setupWidgets();
+
+    // The telemetry panel is shown under the log table on request.
+    QWidget* logPane = mLogTable->parentWidget();
+    if ((logPane != nullptr) && (logPane->layout() != nullptr))
+    {
+        mIngestPanel = new LogIngestPanel(logPane);
+        logPane->layout()->addWidget(mIngestPanel);
+        mIngestPanel->hide();
+    }
+
+    ctrlTelemetry()->setEnabled(mIngestPanel != nullptr);
     
     ctrlFile()->setSizePolicy(QSizePolicy::Policy::Preferred, QSizePolicy::Policy::Expanding);
     updateToolbuttons(false, false);
@@ -159,6 +172,11 @@ QToolButton* LiveLogViewer::ctrlClear()
     return ui->toolClear;
 }
 
+QToolButton* LiveLogViewer::ctrlTelemetry()
+{
+    return ui->toolTelemetry;
+}
+
 QLabel* LiveLogViewer::ctrlFile()
 {
     return ui->labelFile;
@@ -250,6 +268,14 @@ void LiveLogViewer::onClearClicked()
     mLogModel->dataReset();
 }
 
+void LiveLogViewer::onTelemetryClicked(bool checked)
+{
+    if (mIngestPanel != nullptr)
+    {
+        mIngestPanel->setVisible(checked);
+    }
+}
+
 QString LiveLogViewer::getDatabasePath() const
 {
     Q_ASSERT(mLogModel != nullptr);
@@ -278,6 +304,7 @@ void LiveLogViewer::setupSignals(bool doSetup)
         connect(ctrlPause()     , &QToolButton::clicked         , this, &LiveLogViewer::onPauseClicked);
         connect(ctrlStop()      , &QToolButton::clicked         , this, &LiveLogViewer::onStopClicked);
         connect(ctrlClear()     , &QToolButton::clicked         , this, &LiveLogViewer::onClearClicked);
+        connect(ctrlTelemetry() , &QToolButton::toggled         , this, &LiveLogViewer::onTelemetryClicked);
     }
     else
     {
@@ -285,6 +312,7 @@ void LiveLogViewer::setupSignals(bool doSetup)
         disconnect(ctrlPause()  , &QToolButton::clicked         , this, &LiveLogViewer::onPauseClicked);
         disconnect(ctrlStop()   , &QToolButton::clicked         , this, &LiveLogViewer::onStopClicked);
         disconnect(ctrlClear()  , &QToolButton::clicked         , this, &LiveLogViewer::onClearClicked);
+        disconnect(ctrlTelemetry(), &QToolButton::toggled       , this, &LiveLogViewer::onTelemetryClicked);
     }
 }
 
@@ -321,6 +349,7 @@ void LiveLogViewer::cleanResources()
     mLogSearch = nullptr;
     mHighlight = nullptr;
     mHighlightColumn = -1;
+    mIngestPanel = nullptr;
     
     delete mFilter;
     mFilter = nullptr;
@@ -28,6 +28,7 @@
 class QToolButton;
 class QLabel;
 class QWidget;
+class LogIngestPanel;
 class MdiMainWindow;
 
 namespace Ui {
@@ -157,6 +158,12 @@ private slots:
      **/
     void onClearClicked();
 
+    /**
+     * \brief   Slot, triggered when Telemetry toolbutton is toggled.
+     * \param   checked     If true, shows the panel of the telemetry of the live log messages. Otherwise, hides.
+     **/
+    void onTelemetryClicked(bool checked);
+
 private:
     //!< Returns Pause / Resume toolbutton
     QToolButton* ctrlPause();
@@ -167,6 +174,9 @@ private:
     //!< Returns Clear logs toolbutton
     QToolButton* ctrlClear();
 
+    //!< Returns Telemetry toolbutton
+    QToolButton* ctrlTelemetry();
+
     //!< Returns Logging File name label widget.
     QLabel* ctrlFile();
         
@@ -199,6 +209,7 @@ private:
 //////////////////////////////////////////////////////////////////////////
 private:
     Ui::LiveLogViewer*      ui;             //!< User interface object, generated by Qt Designer.
+    LogIngestPanel*         mIngestPanel;   //!< The panel of the telemetry of the live log messages.
 };
 
 #endif // LUSAN_VIEW_LOG_LIVELOGVIEWER_HPP
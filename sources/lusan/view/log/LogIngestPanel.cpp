@@ -0,0 +1,153 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/view/log/LogIngestPanel.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the panel of the telemetry of the live log messages.
+ *
+ ************************************************************************/
+
+#include "lusan/view/log/LogIngestPanel.hpp"
+
+#include <QDateTime>
+#include <QFileDialog>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+LogIngestPanel::LogIngestPanel(QWidget* parent)
+    : QWidget   (parent)
+    , mLabels   { }
+    , mTimer    ( )
+{
+    const QString names[static_cast<int>(LogIngestTelemetry::eMetric::MetricCount)]
+    {
+          tr("Received messages per second")
+        , tr("Queued to the observer thread")
+        , tr("Queued to the UI thread")
+        , tr("UI flush latency, ms")
+        , tr("Delivery lag, ms")
+        , tr("Rows of the log model")
+        , tr("Evicted rows")
+    };
+
+    QGridLayout* grid = new QGridLayout();
+    grid->setContentsMargins(0, 0, 0, 0);
+    grid->setHorizontalSpacing(12);
+    grid->setVerticalSpacing(2);
+    grid->addWidget(new QLabel(tr("Current"), this), 0, 1, Qt::AlignRight);
+    grid->addWidget(new QLabel(tr("High-water (%1 s)").arg(LogIngestTelemetry::HIGH_WATER_SAMPLES * SAMPLE_INTERVAL_MS / 1000), this), 0, 2, Qt::AlignRight);
+    grid->addWidget(new QLabel(tr("Session max"), this), 0, 3, Qt::AlignRight);
+    for (int i = 0; i < static_cast<int>(LogIngestTelemetry::eMetric::MetricCount); ++i)
+    {
+        sMetricLabels& labels{ mLabels[i] };
+        labels.current  = new QLabel(this);
+        labels.highWater= new QLabel(this);
+        labels.session  = new QLabel(this);
+        grid->addWidget(new QLabel(names[i], this), i + 1, 0);
+        grid->addWidget(labels.current  , i + 1, 1, Qt::AlignRight);
+        grid->addWidget(labels.highWater, i + 1, 2, Qt::AlignRight);
+        grid->addWidget(labels.session  , i + 1, 3, Qt::AlignRight);
+    }
+
+    grid->setColumnStretch(4, 1);
+
+    QPushButton* btnExport = new QPushButton(tr("Export CSV..."), this);
+    QPushButton* btnReset  = new QPushButton(tr("Reset"), this);
+    btnExport->setToolTip(tr("Export the history of the telemetry as CSV"));
+    btnReset->setToolTip(tr("Clear the history and the high-water marks"));
+
+    QHBoxLayout* buttons = new QHBoxLayout();
+    buttons->setContentsMargins(0, 0, 0, 0);
+    buttons->addWidget(btnExport);
+    buttons->addWidget(btnReset);
+    buttons->addStretch(1);
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(3, 3, 3, 3);
+    layout->addLayout(grid);
+    layout->addLayout(buttons);
+    setSizePolicy(QSizePolicy::Policy::Expanding, QSizePolicy::Policy::Fixed);
+    setToolTip(tr("The telemetry of the live log messages, from receiving to showing them."));
+
+    connect(btnExport, &QPushButton::clicked, this, [this]() {exportCsv();});
+    connect(btnReset , &QPushButton::clicked, this, [this]() {
+        LogIngestTelemetry::getInstance().reset();
+        _updateValues();
+    });
+    connect(&mTimer, &QTimer::timeout, this, [this]() {_onSample();});
+    mTimer.start(SAMPLE_INTERVAL_MS);
+    _updateValues();
+}
+
+void LogIngestPanel::exportCsv()
+{
+    const QString suggested{ QString("ingest_%1.csv").arg(QDateTime::currentDateTime().toString("yyyy_MM_dd_hh_mm_ss")) };
+    const QString filePath{ QFileDialog::getSaveFileName(this, tr("Export Telemetry"), suggested, tr("CSV Files (*.csv)\nAll Files(*.*)")) };
+    if (filePath.isEmpty())
+        return;
+
+    if (LogIngestTelemetry::getInstance().exportCsv(filePath) == false)
+    {
+        QMessageBox::warning(this, tr("Error"), tr("Cannot export telemetry to file: %1.").arg(filePath));
+    }
+}
+
+void LogIngestPanel::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    _updateValues();
+}
+
+void LogIngestPanel::_onSample()
+{
+    LogIngestTelemetry::getInstance().takeSample();
+    if (isVisible())
+    {
+        _updateValues();
+    }
+}
+
+void LogIngestPanel::_updateValues()
+{
+    const LogIngestTelemetry& telemetry{ LogIngestTelemetry::getInstance() };
+    const LogIngestTelemetry::sIngestSample current{ telemetry.getLastSample() };
+    const LogIngestTelemetry::sIngestSample highWater{ telemetry.getHighWater() };
+    const LogIngestTelemetry::sIngestSample& session{ telemetry.getSessionHighWater() };
+    for (int i = 0; i < static_cast<int>(LogIngestTelemetry::eMetric::MetricCount); ++i)
+    {
+        const LogIngestTelemetry::eMetric metric{ static_cast<LogIngestTelemetry::eMetric>(i) };
+        mLabels[i].current->setText(_valueText(metric, current.get(metric)));
+        mLabels[i].highWater->setText(_valueText(metric, highWater.get(metric)));
+        mLabels[i].session->setText(_valueText(metric, session.get(metric)));
+    }
+}
+
+QString LogIngestPanel::_valueText(LogIngestTelemetry::eMetric metric, double value)
+{
+    switch (metric)
+    {
+    case LogIngestTelemetry::eMetric::MetricFlushLatency:
+    case LogIngestTelemetry::eMetric::MetricDeliveryLag:
+        return QString::number(value, 'f', 2);
+
+    case LogIngestTelemetry::eMetric::MetricRate:
+        return QString::number(value, 'f', 1);
+
+    default:
+        return QString::number(static_cast<qulonglong>(value));
+    }
+}
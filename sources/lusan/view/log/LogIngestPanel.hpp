@@ -0,0 +1,116 @@
+#ifndef LUSAN_VIEW_LOG_LOGINGESTPANEL_HPP
+#define LUSAN_VIEW_LOG_LOGINGESTPANEL_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/view/log/LogIngestPanel.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the panel of the telemetry of the live log messages.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QWidget>
+#include <QTimer>
+#include "lusan/data/log/LogIngestTelemetry.hpp"
+#include "areg/base/areg_global.h"
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class QLabel;
+
+/**
+ * \brief   Shows the telemetry of the pipeline of the live log messages: the received messages
+ *          per second, the messages queued to the log observer and the UI threads, the latency
+ *          of showing the messages, the lag of the log database, the rows of the live log model
+ *          and the evicted rows. Every metric is shown with its current value, the rolling
+ *          high-water mark and the maximum of the session. The panel takes the sample of the
+ *          telemetry every second, also when it is hidden, so that the history is complete
+ *          when it is exported as CSV.
+ **/
+class LogIngestPanel : public QWidget
+{
+    Q_OBJECT
+
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The interval of taking the samples of the telemetry, in milliseconds.
+    static constexpr int    SAMPLE_INTERVAL_MS  { 1000 };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructor / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    explicit LogIngestPanel(QWidget* parent = nullptr);
+
+    virtual ~LogIngestPanel() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Asks the file name and exports the history of the telemetry as CSV.
+     **/
+    void exportCsv();
+
+//////////////////////////////////////////////////////////////////////////
+// QWidget overrides
+//////////////////////////////////////////////////////////////////////////
+protected:
+
+    virtual void showEvent(QShowEvent* event) override;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Takes the sample of the telemetry and updates the shown values, if the panel is visible.
+    void _onSample();
+
+    //!< Updates the shown values.
+    void _updateValues();
+
+    //!< Returns the text of the value of the metric.
+    static QString _valueText(LogIngestTelemetry::eMetric metric, double value);
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    //!< The labels of the values of a metric.
+    struct sMetricLabels
+    {
+        QLabel* current     { nullptr };    //!< The current value.
+        QLabel* highWater   { nullptr };    //!< The rolling high-water mark.
+        QLabel* session     { nullptr };    //!< The maximum of the session.
+    };
+
+    sMetricLabels   mLabels[static_cast<int>(LogIngestTelemetry::eMetric::MetricCount)];   //!< The labels of the metrics.
+    QTimer          mTimer;     //!< The timer to take the samples.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(LogIngestPanel);
+};
+
+#endif  // LUSAN_VIEW_LOG_LOGINGESTPANEL_HPP
@@ -13,67 +13,177 @@
  *  \file        lusan/view/log/LogTextHighlight.cpp
  *  \ingroup     Lusan - GUI Tool for Areg SDK
  *  \author      Artak Avetyan
- *  \brief       Lusan application, Styling class to highlight search elements.
+ *  \brief       Lusan application, the delegate to paint the log rows and highlight search elements.
  *
  ************************************************************************/
 
 #include "lusan/view/log/LogTextHighlight.hpp"
 
+#include <QFontMetrics>
+#include <QFontMetricsF>
+#include <QIcon>
 #include <QPainter>
-#include <QTextLayout>
-#include <QTextLine>
-#include <QList>
+#include <QRegion>
+#include <QStyle>
+#include <QTransform>
+
+#include <algorithm>
 
 LogTextHighlight::LogTextHighlight(const LogSearchModel::sFoundPos& foundPos, QObject* parent /*= nullptr*/)
     : QStyledItemDelegate(parent)
     , mFoundPos(foundPos)
+    , mCache   ( )
+    , mFont    ( )
+{
+}
+
+int LogTextHighlight::rowHeight(const QFont& font)
 {
+    return QFontMetrics(font).height() + 2 * ROW_PADDING;
 }
 
 void LogTextHighlight::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
 {
-    const int foundColumn = static_cast<int>(mFoundPos.colFound);
-    if ((static_cast<int>(mFoundPos.rowFound) != index.row()) ||
-        ((foundColumn >= 0) && (foundColumn != index.column())) ||
-        (mFoundPos.posStart < 0) || (mFoundPos.posEnd <= mFoundPos.posStart))
+    const bool selected{ option.state.testFlag(QStyle::State_Selected) };
+    const QPalette::ColorGroup group{ option.state.testFlag(QStyle::State_Active) ? QPalette::Active : QPalette::Inactive };
+    if (selected)
+    {
+        painter->fillRect(option.rect, option.palette.brush(group, QPalette::Highlight));
+    }
+    else
+    {
+        const QVariant background{ index.data(Qt::BackgroundRole) };
+        if (background.canConvert<QBrush>())
+        {
+            const QBrush brush{ qvariant_cast<QBrush>(background) };
+            if (brush.style() != Qt::NoBrush)
+            {
+                painter->fillRect(option.rect, brush);
+            }
+        }
+    }
+
+    QRect rect{ option.rect.adjusted(CELL_MARGIN, 0, -CELL_MARGIN, 0) };
+    const QVariant decoration{ index.data(Qt::DecorationRole) };
+    if (decoration.isValid())
     {
-        QStyledItemDelegate::paint(painter, option, index);
+        const QIcon icon{ qvariant_cast<QIcon>(decoration) };
+        if (icon.isNull() == false)
+        {
+            const int extent{ option.decorationSize.isValid() ? std::min(option.decorationSize.height(), rect.height()) : rect.height() };
+            const QRect iconRect(rect.left(), rect.top() + (rect.height() - extent) / 2, extent, extent);
+            icon.paint(painter, iconRect, Qt::AlignCenter, selected ? QIcon::Selected : QIcon::Normal);
+            rect.setLeft(iconRect.right() + 1 + CELL_MARGIN);
+        }
+    }
+
+    const QString text{ index.data(Qt::DisplayRole).toString() };
+    if (text.isEmpty() || (rect.width() <= 0))
         return;
+
+    if (option.font != mFont)
+    {
+        mCache.clear();
+        mFont = option.font;
+    }
+
+    const sCachedCell& cell{ _cachedCell(index, text, rect.width(), option.font) };
+    const QVariant alignment{ index.data(Qt::TextAlignmentRole) };
+    const int flags{ alignment.isValid() ? alignment.toInt() : static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter) };
+    const QSizeF size{ cell.glyphs.size() };
+    qreal posX{ static_cast<qreal>(rect.left()) };
+    if ((flags & Qt::AlignHCenter) != 0)
+    {
+        posX += (rect.width() - size.width()) / 2.0;
     }
-    
-    int start{ mFoundPos.posStart };
-    int end{ mFoundPos.posEnd };
-    QString cellText = index.data(Qt::DisplayRole).toString();
+    else if ((flags & Qt::AlignRight) != 0)
+    {
+        posX += rect.width() - size.width();
+    }
+
+    const QPointF pos(posX, rect.top() + (rect.height() - size.height()) / 2.0);
+    QColor color{ option.palette.color(group, selected ? QPalette::HighlightedText : QPalette::Text) };
+    if (selected == false)
+    {
+        const QVariant foreground{ index.data(Qt::ForegroundRole) };
+        if (foreground.canConvert<QColor>())
+        {
+            color = qvariant_cast<QColor>(foreground);
+        }
+    }
+
     painter->save();
+    painter->setFont(option.font);
+    painter->setPen(color);
+    if (_isFound(index))
+    {
+        _drawFound(painter, option.rect, pos, cell, option.font);
+    }
+    else
+    {
+        painter->drawStaticText(pos, cell.glyphs);
+    }
 
-    // Prepare text layout
-    QTextLayout layout(cellText, option.font);
-    QList<QTextLayout::FormatRange> formats;
+    painter->restore();
+}
 
-    QTextLayout::FormatRange highlightRange;
-    highlightRange.start = start;
-    highlightRange.length = end - start;
-    highlightRange.format.setBackground(Qt::yellow);
-    highlightRange.format.setForeground(Qt::red);
+QSize LogTextHighlight::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    return QSize(QStyledItemDelegate::sizeHint(option, index).width(), LogTextHighlight::rowHeight(option.font));
+}
 
-    formats.append(highlightRange);
-    layout.setFormats(formats);
+const LogTextHighlight::sCachedCell& LogTextHighlight::_cachedCell(const QModelIndex& index, const QString& text, int width, const QFont& font) const
+{
+    const quint64 key{ (static_cast<quint64>(static_cast<quint32>(index.row())) << 16) | static_cast<quint64>(index.column() & 0xFFFF) };
+    auto pos = mCache.find(key);
+    if ((pos != mCache.end()) && (pos->width == width) && (pos->text == text))
+        return *pos;
 
-    layout.beginLayout();
-    QTextLine line = layout.createLine();
+    if (mCache.size() >= MAX_CACHED_CELLS)
+    {
+        mCache.clear();
+    }
 
-    // Set the line width to match the highlighted text only
-    line.setLineWidth(option.rect.width());
-    layout.endLayout();
+    sCachedCell cell;
+    cell.text   = text;
+    cell.width  = width;
+    cell.elided = QFontMetrics(font).elidedText(text, Qt::ElideRight, width);
+    cell.glyphs.setTextFormat(Qt::PlainText);
+    cell.glyphs.setPerformanceHint(QStaticText::AggressiveCaching);
+    cell.glyphs.setText(cell.elided);
+    cell.glyphs.prepare(QTransform(), font);
+    return *mCache.insert(key, std::move(cell));
+}
 
-    painter->setFont(option.font);
+bool LogTextHighlight::_isFound(const QModelIndex& index) const
+{
+    const int foundColumn = static_cast<int>(mFoundPos.colFound);
+    return  (static_cast<int>(mFoundPos.rowFound) == index.row()) &&
+            ((foundColumn < 0) || (foundColumn == index.column())) &&
+            (mFoundPos.posStart >= 0) && (mFoundPos.posEnd > mFoundPos.posStart);
+}
 
-    // Calculate vertical alignment (centered)
-    float textHeight = static_cast<int>(line.height());
-    float yOffset = static_cast<float>(option.rect.top()) + static_cast<float>(option.rect.height() - textHeight) / 2;
+void LogTextHighlight::_drawFound(QPainter* painter, const QRect& rect, const QPointF& pos, const sCachedCell& cell, const QFont& font) const
+{
+    // The found phrase, which is cut by the elision, is highlighted up to the ellipsis.
+    const int length{ static_cast<int>(cell.elided.length()) };
+    const int start{ std::min(static_cast<int>(mFoundPos.posStart), length) };
+    const int end{ std::min(static_cast<int>(mFoundPos.posEnd), length) };
+    if (end <= start)
+    {
+        painter->drawStaticText(pos, cell.glyphs);
+        return;
+    }
 
-    QPointF textPos(option.rect.left() + 2, yOffset + 1);
+    const QFontMetricsF metrics(font);
+    const qreal left{ pos.x() + metrics.horizontalAdvance(cell.elided.left(start)) };
+    const qreal right{ pos.x() + metrics.horizontalAdvance(cell.elided.left(end)) };
+    const QRect found{ QRectF(left, rect.top(), right - left, rect.height()).toAlignedRect().intersected(rect) };
 
-    layout.draw(painter, textPos);
-    painter->restore();
+    painter->fillRect(found, Qt::yellow);
+    painter->setClipRegion(QRegion(rect).subtracted(QRegion(found)));
+    painter->drawStaticText(pos, cell.glyphs);
+    painter->setClipRect(found);
+    painter->setPen(Qt::red);
+    painter->drawStaticText(pos, cell.glyphs);
 }
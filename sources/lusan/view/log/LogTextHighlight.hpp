@@ -15,7 +15,7 @@
  *  \file        lusan/view/log/LogTextHighlight.hpp
  *  \ingroup     Lusan - GUI Tool for Areg SDK
  *  \author      Artak Avetyan
- *  \brief       Lusan application, Styling class to highlight search elements.
+ *  \brief       Lusan application, the delegate to paint the log rows and highlight search elements.
  *
  ************************************************************************/
 
@@ -26,6 +26,11 @@
 #include "lusan/model/log/LogSearchModel.hpp"
 #include "areg/base/areg_global.h"
 
+#include <QFont>
+#include <QHash>
+#include <QStaticText>
+#include <QString>
+
 /************************************************************************
  * Dependencies
  ************************************************************************/
@@ -34,10 +39,28 @@ class QStyleOptionViewItem;
 class QModelIndex;
 
 /**
- * \brief   LogTextHighlight class is a custom item delegate that highlights the search results in the log viewer.
+ * \brief   LogTextHighlight class is a custom item delegate that paints the cells of the log viewer
+ *          and highlights the search results. The delegate draws the background, the icon and
+ *          the text of the cell directly, without the style machinery of the default delegate.
+ *          The elided text of the cells is prepared once and cached per row and column, the
+ *          cached text is reused while the text and the width of the cell are not changed.
+ *          All rows have the same height, calculated from the font.
  **/
 class LogTextHighlight : public QStyledItemDelegate
 {
+//////////////////////////////////////////////////////////////////////////
+// Internal constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The maximum number of cached cells. The cache is cleared when it is full.
+    static constexpr int    MAX_CACHED_CELLS    { 8192 };
+
+    //!< The horizontal margin of the text and the icon in the cell, in pixels.
+    static constexpr int    CELL_MARGIN         { 3 };
+
+    //!< The vertical padding of the text in the row, in pixels.
+    static constexpr int    ROW_PADDING         { 2 };
+
 //////////////////////////////////////////////////////////////////////////
 // Constructor / Destructor
 //////////////////////////////////////////////////////////////////////////
@@ -45,17 +68,65 @@ public:
     LogTextHighlight(const LogSearchModel::sFoundPos& foundPos, QObject* parent = nullptr);
     virtual ~LogTextHighlight() = default;
 
+//////////////////////////////////////////////////////////////////////////
+// Attributes and operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Returns the uniform height of the log rows for the given font.
+     **/
+    static int rowHeight(const QFont& font);
+
+    /**
+     * \brief   Clears the cached texts of the cells.
+     **/
+    inline void clearCache();
+
+    /**
+     * \brief   Returns the number of cached cells.
+     **/
+    inline int getCachedCells() const;
+
 //////////////////////////////////////////////////////////////////////////
 // Overrides
 //////////////////////////////////////////////////////////////////////////
-protected:
+public:
     void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
 
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden types and methods
+//////////////////////////////////////////////////////////////////////////
+private:
+    /**
+     * \brief   The cached text of a cell, prepared to draw.
+     **/
+    struct sCachedCell
+    {
+        QString     text    { };    //!< The text of the cell.
+        int         width   { 0 };  //!< The width of the text area of the cell.
+        QString     elided  { };    //!< The text elided to fit the width.
+        QStaticText glyphs  { };    //!< The elided text laid out to draw.
+    };
+
+    //!< Returns the cached text of the cell, prepares the text if it is not cached or changed.
+    const LogTextHighlight::sCachedCell& _cachedCell(const QModelIndex& index, const QString& text, int width, const QFont& font) const;
+
+    //!< Returns true if the cell contains the found search phrase.
+    bool _isFound(const QModelIndex& index) const;
+
+    //!< Draws the cached text and highlights the range of the found search phrase.
+    void _drawFound(QPainter* painter, const QRect& rect, const QPointF& pos, const sCachedCell& cell, const QFont& font) const;
+
 //////////////////////////////////////////////////////////////////////////
 // Member variables
 //////////////////////////////////////////////////////////////////////////
 private:
-    const LogSearchModel::sFoundPos& mFoundPos;
+    const LogSearchModel::sFoundPos&    mFoundPos;  //!< The position of the found search phrase.
+    mutable QHash<quint64, sCachedCell> mCache;     //!< Per row and column, the cached text of the cells.
+    mutable QFont                       mFont;      //!< The font of the cached texts.
 
 //////////////////////////////////////////////////////////////////////////
 // Forbidden calls
@@ -63,4 +134,18 @@ private:
     AREG_NOCOPY_NOMOVE(LogTextHighlight);
 };
 
+//////////////////////////////////////////////////////////////////////////
+// LogTextHighlight class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline void LogTextHighlight::clearCache()
+{
+    mCache.clear();
+}
+
+inline int LogTextHighlight::getCachedCells() const
+{
+    return static_cast<int>(mCache.size());
+}
+
 #endif  // LUSAN_VIEW_LOG_LOGTEXTHIGHLIGHT_HPP
@@ -0,0 +1,297 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/view/log/LogTimelineStrip.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the strip of the log rate timeline above the log table.
+ *
+ ************************************************************************/
+
+#include "lusan/view/log/LogTimelineStrip.hpp"
+#include "lusan/model/log/LogIconFactory.hpp"
+#include "lusan/model/log/LogTimelineModel.hpp"
+
+#include "areg/base/DateTime.hpp"
+
+#include <QHelpEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+#include <QWheelEvent>
+
+#include <algorithm>
+
+namespace
+{
+    //!< The zoom factor of one step of the mouse wheel.
+    constexpr double    _zoomFactor     { 0.8 };
+
+    //!< The priorities, which colors paint the groups of the timeline, from the bottom to the top.
+    constexpr areg::LogPriority _ratePriorities[static_cast<int>(LogRateTimeline::eRate::RateCount)]
+    {
+          areg::LogPriority::PrioError
+        , areg::LogPriority::PrioWarning
+        , areg::LogPriority::PrioInfo
+        , areg::LogPriority::PrioDebug
+        , areg::LogPriority::PrioScope
+    };
+
+    //!< Returns the text of the time to show in the strip.
+    inline QString _formatTime(TIME64 time)
+    {
+        return QString::fromStdString(areg::DateTime(time).format_time().data());
+    }
+}
+
+LogTimelineStrip::LogTimelineStrip(QWidget* parent)
+    : QWidget       (parent)
+    , mModel        (nullptr)
+    , mConnect      ( )
+    , mViewBegin    (0u)
+    , mViewEnd      (0u)
+    , mZoomed       (false)
+{
+    setMouseTracking(false);
+    setBackgroundRole(QPalette::ColorRole::Base);
+    setAutoFillBackground(true);
+    setSizePolicy(QSizePolicy::Policy::Expanding, QSizePolicy::Policy::Fixed);
+    setFixedHeight(LogTimelineStrip::STRIP_HEIGHT);
+    setToolTip(tr("The number of log messages per time. Click to show the logs, scroll to zoom, double click to show all."));
+}
+
+void LogTimelineStrip::setTimelineModel(LogTimelineModel* model)
+{
+    if (mModel != nullptr)
+    {
+        disconnect(mConnect);
+    }
+
+    mModel = model;
+    if (mModel != nullptr)
+    {
+        mConnect = connect(mModel, &LogTimelineModel::signalTimelineChanged, this, [this]() { _onTimelineChanged(); });
+    }
+
+    resetZoom();
+}
+
+void LogTimelineStrip::resetZoom()
+{
+    mZoomed = false;
+    _onTimelineChanged();
+}
+
+QSize LogTimelineStrip::sizeHint() const
+{
+    return QSize(400, LogTimelineStrip::STRIP_HEIGHT);
+}
+
+bool LogTimelineStrip::event(QEvent* event)
+{
+    if (event->type() == QEvent::Type::ToolTip)
+    {
+        QHelpEvent* help = static_cast<QHelpEvent*>(event);
+        const uint32_t level{ _level() };
+        const int index{ _hitTest(help->pos(), level) };
+        if (index >= 0)
+        {
+            const LogRateTimeline& timeline = mModel->getTimeline();
+            const LogRateTimeline::sRateBucket& bucket = timeline.getBucket(level, index);
+            const TIME64 begin{ timeline.getBucketTime(level, index) };
+            QToolTip::showText(help->globalPos()
+                              , tr("%1 - %2\nMessages: %3\nErrors: %4, warnings: %5\nInfo: %6, debug: %7, scopes: %8")
+                                    .arg(_formatTime(begin))
+                                    .arg(_formatTime(begin + LogRateTimeline::getBucketWidth(level)))
+                                    .arg(bucket.total())
+                                    .arg(bucket.counts[LogRateTimeline::eRate::RateError])
+                                    .arg(bucket.counts[LogRateTimeline::eRate::RateWarning])
+                                    .arg(bucket.counts[LogRateTimeline::eRate::RateInfo])
+                                    .arg(bucket.counts[LogRateTimeline::eRate::RateDebug])
+                                    .arg(bucket.counts[LogRateTimeline::eRate::RateScope])
+                              , this);
+        }
+        else
+        {
+            QToolTip::showText(help->globalPos(), toolTip(), this);
+        }
+
+        return true;
+    }
+
+    return QWidget::event(event);
+}
+
+void LogTimelineStrip::paintEvent(QPaintEvent* event)
+{
+    QWidget::paintEvent(event);
+    QPainter painter(this);
+    const QRect area{ rect() };
+    const LogRateTimeline* timeline = mModel != nullptr ? &mModel->getTimeline() : nullptr;
+    if ((timeline == nullptr) || timeline->isEmpty() || (mViewEnd <= mViewBegin))
+    {
+        if ((mModel != nullptr) && mModel->isBuilding())
+        {
+            painter.setPen(palette().color(QPalette::ColorRole::PlaceholderText));
+            painter.drawText(area, Qt::AlignCenter, tr("Counting the log messages..."));
+        }
+
+        return;
+    }
+
+    const uint32_t level{ _level() };
+    const TIME64 width{ LogRateTimeline::getBucketWidth(level) };
+    const int count{ timeline->getBucketCount(level) };
+    const int first{ mViewBegin > timeline->getOrigin() ? static_cast<int>((mViewBegin - timeline->getOrigin()) / width) : 0 };
+    const int last { std::min(count - 1, static_cast<int>((mViewEnd - timeline->getOrigin()) / width)) };
+
+    // The bars are scaled to the fullest visible bucket.
+    uint32_t maxTotal{ 1u };
+    for (int i = first; i <= last; ++i)
+    {
+        maxTotal = std::max(maxTotal, timeline->getBucket(level, i).total());
+    }
+
+    QColor colors[static_cast<int>(LogRateTimeline::eRate::RateCount)];
+    for (int rate = 0; rate < static_cast<int>(LogRateTimeline::eRate::RateCount); ++rate)
+    {
+        colors[rate] = LogIconFactory::getColor(_ratePriorities[rate]);
+    }
+
+    const double scale{ static_cast<double>(area.height() - 1) / static_cast<double>(maxTotal) };
+    for (int i = first; i <= last; ++i)
+    {
+        const LogRateTimeline::sRateBucket& bucket = timeline->getBucket(level, i);
+        if (bucket.total() == 0u)
+            continue;
+
+        const TIME64 begin{ timeline->getBucketTime(level, i) };
+        const int left { static_cast<int>(_toX(begin)) };
+        const int right{ std::max(static_cast<int>(_toX(begin + width)), left + 1) };
+        int bottom{ area.bottom() + 1 };
+        uint32_t stacked{ 0u };
+        for (int rate = 0; rate < static_cast<int>(LogRateTimeline::eRate::RateCount); ++rate)
+        {
+            if (bucket.counts[rate] == 0u)
+                continue;
+
+            stacked += bucket.counts[rate];
+            const int top{ area.bottom() + 1 - std::max(static_cast<int>(static_cast<double>(stacked) * scale), 1) };
+            if (top < bottom)
+            {
+                painter.fillRect(QRect(left, top, right - left, bottom - top), colors[rate]);
+                bottom = top;
+            }
+        }
+    }
+
+    painter.setPen(palette().color(QPalette::ColorRole::Text));
+    const QRect text{ area.adjusted(3, 1, -3, 0) };
+    painter.drawText(text, Qt::AlignLeft  | Qt::AlignTop, _formatTime(mViewBegin));
+    painter.drawText(text, Qt::AlignRight | Qt::AlignTop, _formatTime(mViewEnd));
+}
+
+void LogTimelineStrip::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::MouseButton::LeftButton)
+    {
+        const uint32_t level{ _level() };
+        const int index{ _hitTest(event->pos(), level) };
+        if (index >= 0)
+        {
+            const LogRateTimeline& timeline = mModel->getTimeline();
+            emit signalTimeSelected(std::max(timeline.getBucketTime(level, index), timeline.getBeginTime()));
+        }
+    }
+
+    QWidget::mousePressEvent(event);
+}
+
+void LogTimelineStrip::mouseDoubleClickEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::MouseButton::LeftButton)
+    {
+        resetZoom();
+    }
+
+    QWidget::mouseDoubleClickEvent(event);
+}
+
+void LogTimelineStrip::wheelEvent(QWheelEvent* event)
+{
+    const int delta{ event->angleDelta().y() };
+    if ((delta == 0) || (mModel == nullptr) || (mViewEnd <= mViewBegin))
+    {
+        QWidget::wheelEvent(event);
+        return;
+    }
+
+    // Zoom around the time under the cursor, not finer than a bucket of the first level.
+    const LogRateTimeline& timeline = mModel->getTimeline();
+    const double x{ event->position().x() };
+    const TIME64 pivot{ _toTime(x) };
+    const double factor{ delta > 0 ? _zoomFactor : 1.0 / _zoomFactor };
+    const double span{ std::max(static_cast<double>(mViewEnd - mViewBegin) * factor, static_cast<double>(LogRateTimeline::BaseBucketWidth)) };
+    const double ratio{ width() > 0 ? x / static_cast<double>(width()) : 0.0 };
+    const double begin{ std::max(static_cast<double>(pivot) - span * ratio, static_cast<double>(timeline.getBeginTime())) };
+    mViewBegin = static_cast<TIME64>(begin);
+    mViewEnd = std::min(static_cast<TIME64>(begin + span), std::max(timeline.getEndTime(), mViewBegin + 1u));
+    mZoomed = true;
+    event->accept();
+    update();
+}
+
+inline uint32_t LogTimelineStrip::_level() const
+{
+    return (mModel != nullptr ? mModel->getTimeline().selectLevel(mViewEnd - mViewBegin, width()) : 0u);
+}
+
+inline double LogTimelineStrip::_toX(TIME64 time) const
+{
+    const double span{ static_cast<double>(mViewEnd - mViewBegin) };
+    return (static_cast<double>(time) - static_cast<double>(mViewBegin)) * static_cast<double>(width()) / span;
+}
+
+inline TIME64 LogTimelineStrip::_toTime(double x) const
+{
+    const double span{ static_cast<double>(mViewEnd - mViewBegin) };
+    const double time{ static_cast<double>(mViewBegin) + (width() > 0 ? x * span / static_cast<double>(width()) : 0.0) };
+    return static_cast<TIME64>(std::max(time, 0.0));
+}
+
+int LogTimelineStrip::_hitTest(const QPoint& pos, uint32_t level) const
+{
+    if ((mModel == nullptr) || mModel->getTimeline().isEmpty() || (mViewEnd <= mViewBegin))
+        return -1;
+
+    const LogRateTimeline& timeline = mModel->getTimeline();
+    const int index{ timeline.findBucket(level, _toTime(static_cast<double>(pos.x()))) };
+    return ((index >= 0) && (timeline.getBucket(level, index).total() != 0u) ? index : -1);
+}
+
+void LogTimelineStrip::_onTimelineChanged()
+{
+    const LogRateTimeline* timeline = mModel != nullptr ? &mModel->getTimeline() : nullptr;
+    if ((timeline == nullptr) || timeline->isEmpty())
+    {
+        mViewBegin = mViewEnd = 0u;
+        mZoomed = false;
+    }
+    else if (mZoomed == false)
+    {
+        // The whole timeline is shown, it grows with the live logs.
+        mViewBegin = timeline->getBeginTime();
+        mViewEnd = std::max(timeline->getEndTime(), mViewBegin + LogRateTimeline::BaseBucketWidth);
+    }
+
+    update();
+}
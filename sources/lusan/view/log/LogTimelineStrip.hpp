@@ -0,0 +1,153 @@
+#ifndef LUSAN_VIEW_LOG_LOGTIMELINESTRIP_HPP
+#define LUSAN_VIEW_LOG_LOGTIMELINESTRIP_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/view/log/LogTimelineStrip.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the strip of the log rate timeline above the log table.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QWidget>
+#include "areg/base/areg_global.h"
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class LogTimelineModel;
+
+/**
+ * \brief   Paints the number of log messages per time bucket as bars stacked by priority, the
+ *          errors at the bottom. The size of the buckets follows the zoom: the finest level of
+ *          the timeline, which fits the width of the strip, is painted. The mouse wheel zooms
+ *          the time axis, the double click shows the whole timeline, and the click on a bucket
+ *          selects the time of the bucket to show the logs.
+ **/
+class LogTimelineStrip : public QWidget
+{
+    Q_OBJECT
+
+//////////////////////////////////////////////////////////////////////////
+// Internal types and constants
+//////////////////////////////////////////////////////////////////////////
+public:
+    //!< The height of the strip in pixels.
+    static constexpr int    STRIP_HEIGHT    { 48 };
+
+//////////////////////////////////////////////////////////////////////////
+// Constructor / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    explicit LogTimelineStrip(QWidget* parent = nullptr);
+
+    virtual ~LogTimelineStrip() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Operations and attributes
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Sets the model of the timeline to paint. Pass nullptr to clear the strip.
+     **/
+    void setTimelineModel(LogTimelineModel* model);
+
+    /**
+     * \brief   Returns the model of the painted timeline.
+     **/
+    inline LogTimelineModel* getTimelineModel() const;
+
+    /**
+     * \brief   Shows the whole timeline. The strip follows the new log messages until it is zoomed.
+     **/
+    void resetZoom();
+
+    virtual QSize sizeHint() const override;
+
+/************************************************************************
+ * Signals
+ ************************************************************************/
+signals:
+
+    /**
+     * \brief   Triggered when the user clicks on the bucket of the timeline.
+     * \param   timestamp   The time where the bucket starts, not earlier than the first log message.
+     **/
+    void signalTimeSelected(TIME64 timestamp);
+
+//////////////////////////////////////////////////////////////////////////
+// QWidget overrides
+//////////////////////////////////////////////////////////////////////////
+protected:
+
+    virtual bool event(QEvent* event) override;
+
+    virtual void paintEvent(QPaintEvent* event) override;
+
+    virtual void mousePressEvent(QMouseEvent* event) override;
+
+    virtual void mouseDoubleClickEvent(QMouseEvent* event) override;
+
+    virtual void wheelEvent(QWheelEvent* event) override;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Returns the level of the timeline to paint.
+    inline uint32_t _level() const;
+
+    //!< Converts the time to the horizontal position in the widget.
+    inline double _toX(TIME64 time) const;
+
+    //!< Converts the horizontal position in the widget to the time.
+    inline TIME64 _toTime(double x) const;
+
+    //!< Returns the index of the bucket at the position, or -1 if there is no bucket.
+    int _hitTest(const QPoint& pos, uint32_t level) const;
+
+    //!< Triggered when the timeline is changed.
+    void _onTimelineChanged();
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    LogTimelineModel*       mModel;     //!< The model of the timeline.
+    QMetaObject::Connection mConnect;   //!< The connection to the changes of the timeline.
+    TIME64                  mViewBegin; //!< The time at the left border of the widget.
+    TIME64                  mViewEnd;   //!< The time at the right border of the widget.
+    bool                    mZoomed;    //!< Flag, indicating whether the strip shows a part of the timeline.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(LogTimelineStrip);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// LogTimelineStrip class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline LogTimelineModel* LogTimelineStrip::getTimelineModel() const
+{
+    return mModel;
+}
+
+#endif  // LUSAN_VIEW_LOG_LOGTIMELINESTRIP_HPP
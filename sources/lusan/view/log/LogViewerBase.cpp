@@ -21,21 +21,31 @@
 #include "lusan/view/common/SearchLineEdit.hpp"
 #include "lusan/view/common/MdiMainWindow.hpp"
 #include "lusan/view/log/LogTableHeader.hpp"
+#include "lusan/view/log/LogTimelineStrip.hpp"
+#include "lusan/view/log/ScopeCallTreeViewer.hpp"
 #include "lusan/view/log/ScopeOutputViewer.hpp"
 
 #include "lusan/model/log/LogViewerFilter.hpp"
 #include "lusan/model/log/LoggingModelBase.hpp"
+#include "lusan/model/log/LogTimelineModel.hpp"
 #include "lusan/view/log/LogTextHighlight.hpp"
 
 #include <QVBoxLayout>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHeaderView>
 #include <QKeyEvent>
 #include <QMdiSubWindow>
 #include <QMenu>
 #include <QMessageBox>
 #include <QPoint>
+#include <QProgressDialog>
 #include <QShortcut>
+#include <QStatusBar>
 #include <QTableView>
 
+#include <algorithm>
+
 
 const QString& LogViewerBase::fileExtension()
 {
@@ -55,7 +65,17 @@ LogViewerBase::LogViewerBase(MdiChild::eMdiWindow windowType, LoggingModelBase*
     , mFoundPos ()
     , mHighlight(nullptr)
     , mHighlightColumn(-1)
+    , mExport   ( )
+    , mExportProgress(nullptr)
 {
+    connect(&mExport, &LogExportModel::signalExportProgress, this
+            , [this](quint64 scanned, quint64 total, quint64 exported) {
+                _onExportProgress(scanned, total, exported);
+            });
+    connect(&mExport, &LogExportModel::signalExportFinished, this
+            , [this](bool succeeded, quint64 exported) {
+                _onExportFinished(succeeded, exported);
+            });
 }
 
 LogViewerBase::~LogViewerBase()
@@ -161,6 +181,33 @@ void LogViewerBase::setupWidgets()
     mLogTable->setVerticalScrollMode(QTableView::ScrollPerItem);
     mLogTable->setContextMenuPolicy(Qt::CustomContextMenu);
 
+    // The timeline of the log rate is shown above the log table.
+    QWidget* tableParent = mLogTable->parentWidget();
+    if ((tableParent != nullptr) && (tableParent->layout() != nullptr))
+    {
+        QWidget* logPane = new QWidget(tableParent);
+        QLayoutItem* item = tableParent->layout()->replaceWidget(mLogTable, logPane);
+        if (item != nullptr)
+        {
+            delete item;
+            QVBoxLayout* paneLayout = new QVBoxLayout(logPane);
+            paneLayout->setContentsMargins(0, 0, 0, 0);
+            paneLayout->setSpacing(2);
+
+            LogTimelineStrip* strip = new LogTimelineStrip(logPane);
+            LogTimelineModel* timeline = new LogTimelineModel(strip);
+            timeline->setLoggingModel(mLogModel);
+            strip->setTimelineModel(timeline);
+            paneLayout->addWidget(strip);
+            paneLayout->addWidget(mLogTable);
+            connect(strip, &LogTimelineStrip::signalTimeSelected, this, [this](TIME64 timestamp) {onTimeSelected(timestamp);});
+        }
+        else
+        {
+            delete logPane;
+        }
+    }
+
     // Set the layout
     QVBoxLayout* layout = new QVBoxLayout(this);
     layout->addWidget(mMdiWindow);
@@ -173,6 +220,9 @@ void LogViewerBase::setupWidgets()
     {
         mHighlight = new LogTextHighlight(mFoundPos, mLogTable);
         mLogTable->setItemDelegate(mHighlight);
+        // The rows have the uniform height, the table does not measure the rows.
+        mLogTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+        mLogTable->verticalHeader()->setDefaultSectionSize(LogTextHighlight::rowHeight(mLogTable->font()));
     }
     _updateHighlightColumn();
 
@@ -227,6 +277,15 @@ void LogViewerBase::onWindowClosing(bool isActive)
     Q_UNUSED(isActive);
     ScopeOutputViewer& viewScope = mMainWindow->getOutputScopeLogs();
     viewScope.releaseWindow(*this);
+    ScopeCallTreeViewer& viewCalls = mMainWindow->getOutputCallTree();
+    viewCalls.releaseWindow(*this);
+}
+
+void LogViewerBase::onWindowActivated()
+{
+    ScopeCallTreeViewer& viewCalls = mMainWindow->getOutputCallTree();
+    viewCalls.bindWindow(*this);
+    viewCalls.setLoggingModel(mLogModel);
 }
 
 bool LogViewerBase::saveFile(const QString& fileName)
@@ -417,6 +476,34 @@ void LogViewerBase::moveToRow(int row, bool select)
     }
 }
 
+void LogViewerBase::onTimeSelected(TIME64 timestamp)
+{
+    if ((mFilter == nullptr) || (mLogModel == nullptr))
+        return;
+
+    // The logs are in the order of time, search the first visible log at or after the time.
+    int first{ 0 };
+    int count{ mFilter->rowCount(QModelIndex()) };
+    while (count > 0)
+    {
+        const int step{ count / 2 };
+        const QModelIndex source{ mFilter->mapToSource(mFilter->index(first + step, 0, QModelIndex())) };
+        const areg::LogEntry* log = mLogModel->getLogData(source.row());
+        if ((log != nullptr) && (log->logTimestamp < timestamp))
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    const int rows{ mFilter->rowCount(QModelIndex()) };
+    moveToRow(std::min(first, rows - 1), true);
+}
+
 void LogViewerBase::selectSourceElement(const QModelIndex & index)
 {
     if (index.isValid() && (mFilter != nullptr) && (mLogModel != nullptr))
@@ -460,6 +547,44 @@ void LogViewerBase::resetFilters()
     mLogTable->setModel(mFilter);
 }
 
+void LogViewerBase::exportLogs(TIME64 timeBegin, TIME64 timeEnd)
+{
+    if ((mLogModel == nullptr) || mExport.isExporting())
+        return;
+
+    const QString dbPath{ mLogModel->getDatabasePath() };
+    if (dbPath.isEmpty())
+    {
+        QMessageBox::warning(this, tr("Error"), tr("There is no log database to export."));
+        return;
+    }
+
+    const QFileInfo info(dbPath);
+    const QString suggested{ info.absoluteDir().filePath(info.completeBaseName() + QStringLiteral("_filtered.csv")) };
+    QString filePath{ QFileDialog::getSaveFileName(this, tr("Export Filtered Logs"), suggested, LogExportWriter::getFileFilter()) };
+    if (filePath.isEmpty())
+        return;
+
+    if (LogExportWriter::getFormat(filePath) == LogExportWriter::eFormat::FormatInvalid)
+    {
+        filePath += QStringLiteral(".csv");
+    }
+
+    if (mExport.startExport(*mLogModel, mFilter, filePath, timeBegin, timeEnd) == false)
+    {
+        QMessageBox::warning(this, tr("Error"), tr("Cannot export logs to file: %1.").arg(filePath));
+        return;
+    }
+
+    mExportProgress = new QProgressDialog(tr("Exporting logs to %1 ...").arg(QFileInfo(filePath).fileName()), tr("Cancel"), 0, 100, this);
+    mExportProgress->setWindowModality(Qt::WindowModal);
+    mExportProgress->setAutoClose(false);
+    mExportProgress->setAutoReset(false);
+    mExportProgress->setMinimumDuration(500);
+    mExportProgress->setValue(0);
+    connect(mExportProgress, &QProgressDialog::canceled, this, [this]() { mExport.cancelExport(); });
+}
+
 void LogViewerBase::onHeaderContextMenu(const QPoint& pos)
 {
     QMenu menu(this);
@@ -474,6 +599,8 @@ void LogViewerBase::onTableContextMenu(const QPoint& pos)
     QMenu* columnsMenu = menu.addMenu(tr("Columns"));
     QModelIndex idx{ ctrlTable()->currentIndex() };
     _populateColumnsMenu(columnsMenu, idx.isValid() ? idx.row() : -1);
+    QMenu* exportMenu = menu.addMenu(tr("Export Filtered Logs"));
+    _populateExportMenu(exportMenu, idx);
     menu.exec(ctrlTable()->viewport()->mapToGlobal(pos));
 }
 
@@ -536,6 +663,58 @@ void LogViewerBase::_updateHighlightColumn()
     mHighlightColumn = mHeader->getColumnIndex(LoggingModelBase::eColumn::LogColumnMessage);
 }
 
+void LogViewerBase::_populateExportMenu(QMenu* menu, const QModelIndex& current)
+{
+    const QModelIndex source{ current.isValid() && (mFilter != nullptr) ? mFilter->mapToSource(current) : QModelIndex() };
+    const areg::LogEntry* log{ source.isValid() ? mLogModel->getLogData(source.row()) : nullptr };
+    const TIME64 timestamp{ log != nullptr ? log->logTimestamp : 0u };
+    const bool canExport{ (mExport.isExporting() == false) && (mLogModel->getDatabasePath().isEmpty() == false) };
+
+    QAction* actAll = menu->addAction(tr("All Messages..."));
+    actAll->setEnabled(canExport);
+    connect(actAll, &QAction::triggered, this, [this]() { exportLogs(0u, 0u); });
+
+    QAction* actFrom = menu->addAction(tr("From Selected Message..."));
+    actFrom->setEnabled(canExport && (timestamp != 0u));
+    connect(actFrom, &QAction::triggered, this, [this, timestamp]() { exportLogs(timestamp, 0u); });
+
+    QAction* actUpTo = menu->addAction(tr("Up To Selected Message..."));
+    actUpTo->setEnabled(canExport && (timestamp != 0u));
+    connect(actUpTo, &QAction::triggered, this, [this, timestamp]() { exportLogs(0u, timestamp); });
+}
+
+void LogViewerBase::_onExportProgress(quint64 scanned, quint64 total, quint64 exported)
+{
+    if (mExportProgress == nullptr)
+        return;
+
+    if (total != 0u)
+    {
+        mExportProgress->setValue(static_cast<int>(std::min<quint64>(scanned * 100u / total, 99u)));
+    }
+
+    mExportProgress->setLabelText(tr("Exported %1 of %2 scanned log messages ...").arg(exported).arg(scanned));
+}
+
+void LogViewerBase::_onExportFinished(bool succeeded, quint64 exported)
+{
+    if (mExportProgress == nullptr)
+        return;
+
+    const bool canceled{ mExportProgress->wasCanceled() };
+    mExportProgress->deleteLater();
+    mExportProgress = nullptr;
+    if (succeeded)
+    {
+        if (mMainWindow != nullptr)
+            mMainWindow->statusBar()->showMessage(tr("Exported %1 log messages to %2").arg(exported).arg(mExport.getFilePath()), 5000);
+    }
+    else if (canceled == false)
+    {
+        QMessageBox::warning(this, tr("Error"), tr("Cannot export logs to file: %1.").arg(mExport.getFilePath()));
+    }
+}
+
 void LogViewerBase::_populateColumnsMenu(QMenu* menu, int curRow)
 {
     // Get current active columns from the model
@@ -19,6 +19,7 @@
  *
  ************************************************************************/
 #include "lusan/view/common/MdiChild.hpp"
+#include "lusan/model/log/LogExportModel.hpp"
 #include "lusan/model/log/LogSearchModel.hpp"
 #include "areg/base/areg_global.h"
 
@@ -34,6 +35,7 @@ class LogTextHighlight;
 class QHeaderView;
 class QModelIndex;
 class QPoint;
+class QProgressDialog;
 class QString;
 class QTableView;
 class QToolButton;
@@ -148,6 +150,12 @@ protected:
      **/
     void onWindowClosing(bool isActive) override;
 
+    /**
+     * \brief   Called when the MDI child window is activated.
+     *          Binds the call tree of scopes in the output window with the logs of the window.
+     **/
+    void onWindowActivated() override;
+
     /**
      * \brief   Returns the default file filter.
      **/
@@ -204,6 +212,13 @@ protected:
      * \brief   Slot. which triggered when the selection in the log scopes navigation is changed.
      **/
     virtual void onCurrentRowChanged(const QModelIndex &current, const QModelIndex &previous);
+
+    /**
+     * \brief   Slot, triggered when the time is selected in the timeline of the logs.
+     *          Selects the first visible log message logged at or after the time.
+     * \param   timestamp   The selected time.
+     **/
+    virtual void onTimeSelected(TIME64 timestamp);
     
 //////////////////////////////////////////////////////////////////////////
 // Operations
@@ -217,6 +232,14 @@ protected:
      **/
     void resetFilters();
 
+    /**
+     * \brief   Asks the file name and exports the log messages passing the filters of the view
+     *          in the background. The format of the file is defined by its extension.
+     * \param   timeBegin   The earliest timestamp of the exported messages, zero if not limited.
+     * \param   timeEnd     The latest timestamp of the exported messages, zero if not limited.
+     **/
+    void exportLogs(TIME64 timeBegin, TIME64 timeEnd);
+
 //////////////////////////////////////////////////////////////////////////
 // attributes
 //////////////////////////////////////////////////////////////////////////
@@ -259,6 +282,19 @@ private:
      **/
     void _populateColumnsMenu(QMenu* menu, int curRow);
 
+    /**
+     * \brief   Populates the menu to export the filtered log messages.
+     * \param   menu        The menu to populate.
+     * \param   current     The selected log message, used to limit the time range of the export.
+     **/
+    void _populateExportMenu(QMenu* menu, const QModelIndex& current);
+
+    //!< Updates the progress dialog of the running export.
+    void _onExportProgress(quint64 scanned, quint64 total, quint64 exported);
+
+    //!< Closes the progress dialog and notifies the failed export.
+    void _onExportFinished(bool succeeded, quint64 exported);
+
     /**
      * \brief   Updates the current logical index of the "Message" column.
      **/
@@ -297,6 +333,8 @@ protected:
     LogSearchModel::sFoundPos   mFoundPos;  //!< The found position of the search in the log viewer.
     LogTextHighlight*           mHighlight; //!< The text highlight object, used for highlighting the search results in the log viewer.
     int                         mHighlightColumn; //!< The current logical column index where highlight delegate is installed.
+    LogExportModel              mExport;    //!< The export of the filtered log messages.
+    QProgressDialog*            mExportProgress;    //!< The progress dialog of the running export, nullptr if no export runs.
 
 //////////////////////////////////////////////////////////////////////////
 // Forbidden calls.
@@ -102,6 +102,7 @@ void OfflineLogViewer::onWindowClosing(bool isActive)
 void OfflineLogViewer::onWindowActivated()
 {
     Q_ASSERT(mMainWindow != nullptr);
+    LogViewerBase::onWindowActivated();
     if (mMainWindow->getNaviOfflineScopes().getLoggingModel() != mLogModel)
     {
         mMainWindow->getNaviOfflineScopes().setLoggingModel(nullptr);
@@ -0,0 +1,169 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/view/log/ScopeCallTreeViewer.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the output window of the call tree of scopes.
+ *
+ ************************************************************************/
+#include "lusan/view/log/ScopeCallTreeViewer.hpp"
+
+#include "lusan/model/log/ScopeCallTreeModel.hpp"
+#include "lusan/view/common/OutputDock.hpp"
+#include "lusan/view/log/LogViewerBase.hpp"
+#include "lusan/view/log/ScopeFlameGraph.hpp"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QSplitter>
+#include <QToolButton>
+#include <QTreeView>
+#include <QVBoxLayout>
+
+ScopeCallTreeViewer::ScopeCallTreeViewer(MdiMainWindow* wndMain, QWidget* parent)
+    : OutputWindow  (static_cast<int>(OutputDock::eOutputDock::OutputCallTree), wndMain, parent)
+    , mModel        (new ScopeCallTreeModel(this))
+    , mSummary      (nullptr)
+    , mResetZoom    (nullptr)
+    , mTree         (nullptr)
+    , mFlameGraph   (nullptr)
+{
+    QVBoxLayout* outer = new QVBoxLayout(this);
+    outer->setContentsMargins(0, 0, 0, 0);
+    outer->setSpacing(2);
+
+    QHBoxLayout* bar = new QHBoxLayout();
+    bar->setContentsMargins(4, 2, 4, 0);
+    mSummary = new QLabel(this);
+    mResetZoom = new QToolButton(this);
+    mResetZoom->setText(tr("Reset Zoom"));
+    mResetZoom->setToolTip(tr("Show the whole thread in the flame graph"));
+    bar->addWidget(mSummary, 1);
+    bar->addWidget(mResetZoom);
+    outer->addLayout(bar);
+
+    QSplitter* splitter = new QSplitter(Qt::Orientation::Horizontal, this);
+    mTree = new QTreeView(splitter);
+    mTree->setModel(mModel);
+    mTree->setUniformRowHeights(true);
+    mTree->setAlternatingRowColors(true);
+    mTree->setSelectionBehavior(QAbstractItemView::SelectionBehavior::SelectRows);
+    mTree->setSelectionMode(QAbstractItemView::SelectionMode::SingleSelection);
+    mTree->header()->setStretchLastSection(false);
+    mTree->header()->setSectionResizeMode(static_cast<int>(ScopeCallTreeModel::eColumn::ColumnScope), QHeaderView::ResizeMode::Stretch);
+    mFlameGraph = new ScopeFlameGraph(splitter);
+    mFlameGraph->setCallTreeModel(mModel);
+    splitter->addWidget(mTree);
+    splitter->addWidget(mFlameGraph);
+    splitter->setStretchFactor(0, 1);
+    splitter->setStretchFactor(1, 2);
+    outer->addWidget(splitter, 1);
+
+    connect(mTree->selectionModel(), &QItemSelectionModel::currentChanged, this
+            , [this](const QModelIndex& current, const QModelIndex& /*previous*/) {
+                onCurrentCallChanged(current);
+            });
+    connect(mTree       , &QTreeView::doubleClicked                 , this, [this](const QModelIndex& index) {onShowLog(index);});
+    connect(mFlameGraph , &ScopeFlameGraph::signalCallSelected      , this, [this](int node) {onCallSelected(node);});
+    connect(mResetZoom  , &QToolButton::clicked                     , this, [this]() {mFlameGraph->resetZoom();});
+    connect(mModel      , &QAbstractItemModel::modelReset           , this, [this]() {updateSummary();});
+    connect(mModel      , &QAbstractItemModel::rowsInserted         , this, [this]() {updateSummary();});
+
+    updateSummary();
+}
+
+ScopeCallTreeViewer::~ScopeCallTreeViewer()
+{
+    mFlameGraph->setCallTreeModel(nullptr);
+    mTree->setModel(nullptr);
+    mModel->setLoggingModel(nullptr);
+}
+
+bool ScopeCallTreeViewer::releaseWindow(MdiChild& mdiChild)
+{
+    bool result = OutputWindow::releaseWindow(mdiChild);
+    if (result)
+    {
+        setLoggingModel(nullptr);
+    }
+
+    return result;
+}
+
+void ScopeCallTreeViewer::setLoggingModel(LoggingModelBase* logModel)
+{
+    if (mModel->getLoggingModel() != logModel)
+    {
+        mModel->setLoggingModel(logModel);
+        mFlameGraph->setThread(mModel->getCallTree().getThreadCount() > 0 ? 0 : ScopeCallTree::InvalidIndex);
+    }
+}
+
+void ScopeCallTreeViewer::onCurrentCallChanged(const QModelIndex& current)
+{
+    const int node{ mModel->getCallNode(current) };
+    if (node != ScopeCallTree::InvalidIndex)
+    {
+        mFlameGraph->setSelectedCall(node);
+    }
+    else
+    {
+        const int thread{ mModel->getCallThread(current) };
+        if ((thread != ScopeCallTree::InvalidIndex) && (thread != mFlameGraph->getThread()))
+        {
+            mFlameGraph->setThread(thread);
+        }
+
+        mFlameGraph->setSelectedCall(ScopeCallTree::InvalidIndex);
+    }
+}
+
+void ScopeCallTreeViewer::onCallSelected(int node)
+{
+    const QModelIndex index{ mModel->indexOfCall(node) };
+    if (index.isValid())
+    {
+        mTree->scrollTo(index);
+        mTree->selectionModel()->setCurrentIndex(index, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+    }
+}
+
+void ScopeCallTreeViewer::onShowLog(const QModelIndex& index)
+{
+    const QModelIndex logIndex{ mModel->getLogIndex(index) };
+    if ((mMdiChild != nullptr) && logIndex.isValid())
+    {
+        static_cast<LogViewerBase*>(mMdiChild)->selectSourceElement(logIndex);
+    }
+}
+
+void ScopeCallTreeViewer::updateSummary()
+{
+    const ScopeCallTree& tree = mModel->getCallTree();
+    if (mModel->getLoggingModel() == nullptr)
+    {
+        mSummary->setText(tr("Activate a log window to see the calls of the scopes."));
+    }
+    else if (tree.getUnmatchedCount() == 0)
+    {
+        mSummary->setText(tr("%1 calls in %2 threads").arg(tree.getCallCount()).arg(tree.getThreadCount()));
+    }
+    else
+    {
+        mSummary->setText(tr("%1 calls in %2 threads, %3 scope exits without scope enter")
+                            .arg(tree.getCallCount()).arg(tree.getThreadCount()).arg(tree.getUnmatchedCount()));
+    }
+
+    mResetZoom->setEnabled(tree.getCallCount() > 0);
+}
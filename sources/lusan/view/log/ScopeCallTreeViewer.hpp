@@ -0,0 +1,119 @@
+#ifndef LUSAN_VIEW_LOG_SCOPECALLTREEVIEWER_HPP
+#define LUSAN_VIEW_LOG_SCOPECALLTREEVIEWER_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/view/log/ScopeCallTreeViewer.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the output window of the call tree of scopes.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include "lusan/view/common/OutputWindow.hpp"
+#include "areg/base/areg_global.h"
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class LoggingModelBase;
+class QLabel;
+class QModelIndex;
+class QToolButton;
+class QTreeView;
+class ScopeCallTreeModel;
+class ScopeFlameGraph;
+
+/**
+ * \brief   The output window to analyze the calls of the scopes of the active log window.
+ *          It shows the call tree of the scopes with the inclusive and exclusive time of
+ *          every call and the flame graph of the thread of the selected call.
+ **/
+class ScopeCallTreeViewer : public OutputWindow
+{
+    Q_OBJECT
+
+//////////////////////////////////////////////////////////////////////////
+// Constructor / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    ScopeCallTreeViewer(MdiMainWindow* wndMain, QWidget* parent = nullptr);
+    virtual ~ScopeCallTreeViewer();
+
+//////////////////////////////////////////////////////////////////////////
+// Overrides
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Releases the MDI window previously bind with the output window and returns true if succeeded to release.
+     *          The call tree of the released window is cleared.
+     * \param   mdiChild    The MDI child window to release
+     * \return  Returns true if succeeded to release the window and returns false if the window is not bound.
+     **/
+    bool releaseWindow(MdiChild& mdiChild) override;
+
+//////////////////////////////////////////////////////////////////////////
+// Operations
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Sets the logging model to rebuild the call tree of the scopes.
+     *          Nothing happens if the call tree is already built from the same model.
+     * \param   logModel    The logging model of the bound log window, or nullptr to clear the call tree.
+     **/
+    void setLoggingModel(LoggingModelBase* logModel);
+
+//////////////////////////////////////////////////////////////////////////
+// Slots
+//////////////////////////////////////////////////////////////////////////
+private slots:
+
+    //!< Triggered when the current item of the call tree is changed, shows the call in the flame graph.
+    void onCurrentCallChanged(const QModelIndex& current);
+
+    //!< Triggered when the call is selected in the flame graph, selects the call in the call tree.
+    void onCallSelected(int node);
+
+    //!< Shows and selects the scope enter message of the call in the bound log window.
+    void onShowLog(const QModelIndex& index);
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Updates the summary text of the call tree.
+    void updateSummary();
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    ScopeCallTreeModel* mModel;     //!< The model of the call tree.
+    QLabel*             mSummary;   //!< The summary of the call tree.
+    QToolButton*        mResetZoom; //!< The tool button to show the whole thread in the flame graph.
+    QTreeView*          mTree;      //!< The view of the call tree.
+    ScopeFlameGraph*    mFlameGraph;//!< The flame graph of the thread of the selected call.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(ScopeCallTreeViewer);
+};
+
+#endif  // LUSAN_VIEW_LOG_SCOPECALLTREEVIEWER_HPP
@@ -0,0 +1,343 @@
+﻿/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/view/log/ScopeFlameGraph.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the flame graph of the calls of scopes of a thread.
+ *
+ ************************************************************************/
+
+#include "lusan/view/log/ScopeFlameGraph.hpp"
+#include "lusan/model/log/ScopeCallTreeModel.hpp"
+
+#include <QHelpEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+    //!< The smallest width of the bar in pixels to paint the call.
+    constexpr double    _minBarWidth    { 1.0 };
+    //!< The smallest width of the bar in pixels to paint the name of the scope.
+    constexpr int       _minTextWidth   { 24 };
+    //!< The zoom factor of one step of the mouse wheel.
+    constexpr double    _zoomFactor     { 0.8 };
+
+    //!< Returns the position of the first call in the list that may end after the given time.
+    //!< The calls in the list are in the order of calls and do not overlap.
+    inline std::vector<int>::const_iterator _firstVisible(const ScopeCallTree& tree, const std::vector<int>& calls, uint64_t time)
+    {
+        auto pos = std::upper_bound(calls.begin(), calls.end(), time, [&tree](uint64_t value, int node) {
+            return (value < tree.getCall(node).enterTime);
+        });
+
+        return (pos != calls.begin() ? std::prev(pos) : pos);
+    }
+}
+
+ScopeFlameGraph::ScopeFlameGraph(QWidget* parent)
+    : QWidget       (parent)
+    , mModel        (nullptr)
+    , mThread       (ScopeCallTree::InvalidIndex)
+    , mSelected     (ScopeCallTree::InvalidIndex)
+    , mThreadBegin  (0u)
+    , mThreadEnd    (0u)
+    , mViewBegin    (0u)
+    , mViewEnd      (0u)
+{
+    setMouseTracking(false);
+    setBackgroundRole(QPalette::ColorRole::Base);
+    setAutoFillBackground(true);
+    setSizePolicy(QSizePolicy::Policy::Expanding, QSizePolicy::Policy::Expanding);
+}
+
+void ScopeFlameGraph::setCallTreeModel(ScopeCallTreeModel* model)
+{
+    if (mModel != nullptr)
+    {
+        disconnect(mModel, nullptr, this, nullptr);
+    }
+
+    mModel = model;
+    mThread = ScopeCallTree::InvalidIndex;
+    mSelected = ScopeCallTree::InvalidIndex;
+    if (mModel != nullptr)
+    {
+        connect(mModel, &QAbstractItemModel::modelReset, this, [this]() {
+            mSelected = ScopeCallTree::InvalidIndex;
+            setThread(mThread < mModel->getCallTree().getThreadCount() ? mThread : ScopeCallTree::InvalidIndex);
+        });
+        connect(mModel, &QAbstractItemModel::rowsInserted, this, [this]() {
+            _updateTimeRange();
+            update();
+        });
+        connect(mModel, &QAbstractItemModel::dataChanged, this, [this]() {
+            _updateTimeRange();
+            update();
+        });
+    }
+
+    resetZoom();
+}
+
+void ScopeFlameGraph::setThread(int thread)
+{
+    mThread = (mModel != nullptr) && (thread >= 0) && (thread < mModel->getCallTree().getThreadCount()) ? thread : ScopeCallTree::InvalidIndex;
+    resetZoom();
+}
+
+void ScopeFlameGraph::setSelectedCall(int node)
+{
+    const ScopeCallTree* tree = mModel != nullptr ? &mModel->getCallTree() : nullptr;
+    if ((tree == nullptr) || (node < 0) || (node >= tree->getCallCount()))
+    {
+        mSelected = ScopeCallTree::InvalidIndex;
+        update();
+        return;
+    }
+
+    mSelected = node;
+    const ScopeCallTree::sCallNode& call = tree->getCall(node);
+    if (call.thread != mThread)
+    {
+        setThread(call.thread);
+    }
+    else if ((call.enterTime > mViewEnd) || (_endTime(node) < mViewBegin))
+    {
+        // The call is outside of the zoomed area, move the area to the call.
+        const uint64_t span{ mViewEnd - mViewBegin };
+        mViewBegin = std::max(mThreadBegin, call.enterTime > span / 2u ? call.enterTime - span / 2u : 0u);
+        mViewEnd = mViewBegin + span;
+    }
+
+    update();
+}
+
+void ScopeFlameGraph::resetZoom()
+{
+    mThreadBegin = 0u;
+    mThreadEnd = 0u;
+    _updateTimeRange();
+    mViewBegin = mThreadBegin;
+    mViewEnd = mThreadEnd;
+    update();
+}
+
+QSize ScopeFlameGraph::sizeHint() const
+{
+    return QSize(400, _barHeight() * 8);
+}
+
+bool ScopeFlameGraph::event(QEvent* event)
+{
+    if (event->type() == QEvent::Type::ToolTip)
+    {
+        QHelpEvent* help = static_cast<QHelpEvent*>(event);
+        const int node{ _hitTest(help->pos()) };
+        if (node != ScopeCallTree::InvalidIndex)
+        {
+            QToolTip::showText(help->globalPos(), mModel->data(mModel->indexOfCall(node), Qt::ItemDataRole::ToolTipRole).toString(), this);
+        }
+        else
+        {
+            QToolTip::hideText();
+            event->ignore();
+        }
+
+        return true;
+    }
+
+    return QWidget::event(event);
+}
+
+void ScopeFlameGraph::paintEvent(QPaintEvent* event)
+{
+    QWidget::paintEvent(event);
+    if ((mModel == nullptr) || (mThread == ScopeCallTree::InvalidIndex) || (mViewEnd <= mViewBegin))
+        return;
+
+    const ScopeCallTree& tree = mModel->getCallTree();
+    const std::vector<int>& roots = tree.getThread(mThread).roots;
+    QPainter painter(this);
+    const QRect area{ rect() };
+    for (auto it = _firstVisible(tree, roots, mViewBegin); it != roots.end(); ++it)
+    {
+        if (tree.getCall(*it).enterTime > mViewEnd)
+            break;
+
+        _paintCall(painter, *it, area);
+    }
+}
+
+void ScopeFlameGraph::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::MouseButton::LeftButton)
+    {
+        const int node{ _hitTest(event->pos()) };
+        mSelected = node;
+        update();
+        if (node != ScopeCallTree::InvalidIndex)
+        {
+            emit signalCallSelected(node);
+        }
+    }
+
+    QWidget::mousePressEvent(event);
+}
+
+void ScopeFlameGraph::mouseDoubleClickEvent(QMouseEvent* event)
+{
+    const int node{ event->button() == Qt::MouseButton::LeftButton ? _hitTest(event->pos()) : ScopeCallTree::InvalidIndex };
+    if (node != ScopeCallTree::InvalidIndex)
+    {
+        mViewBegin = mModel->getCallTree().getCall(node).enterTime;
+        mViewEnd = std::max(_endTime(node), mViewBegin + 1u);
+        update();
+    }
+    else
+    {
+        resetZoom();
+    }
+}
+
+void ScopeFlameGraph::wheelEvent(QWheelEvent* event)
+{
+    const int delta{ event->angleDelta().y() };
+    if ((delta == 0) || (mViewEnd <= mViewBegin))
+    {
+        QWidget::wheelEvent(event);
+        return;
+    }
+
+    // Zoom around the time under the cursor.
+    const double x{ event->position().x() };
+    const uint64_t pivot{ _toTime(x) };
+    const double factor{ delta > 0 ? _zoomFactor : 1.0 / _zoomFactor };
+    const double span{ std::max(static_cast<double>(mViewEnd - mViewBegin) * factor, 1.0) };
+    const double ratio{ width() > 0 ? x / static_cast<double>(width()) : 0.0 };
+    const double begin{ std::max(static_cast<double>(pivot) - span * ratio, static_cast<double>(mThreadBegin)) };
+    mViewBegin = static_cast<uint64_t>(begin);
+    mViewEnd = std::min(static_cast<uint64_t>(begin + span), std::max(mThreadEnd, mViewBegin + 1u));
+    event->accept();
+    update();
+}
+
+inline int ScopeFlameGraph::_barHeight() const
+{
+    return fontMetrics().height() + 4;
+}
+
+inline double ScopeFlameGraph::_toX(uint64_t time) const
+{
+    const double span{ static_cast<double>(mViewEnd - mViewBegin) };
+    return (static_cast<double>(time) - static_cast<double>(mViewBegin)) * static_cast<double>(width()) / span;
+}
+
+inline uint64_t ScopeFlameGraph::_toTime(double x) const
+{
+    const double span{ static_cast<double>(mViewEnd - mViewBegin) };
+    const double time{ static_cast<double>(mViewBegin) + (width() > 0 ? x * span / static_cast<double>(width()) : 0.0) };
+    return static_cast<uint64_t>(std::max(time, 0.0));
+}
+
+inline uint64_t ScopeFlameGraph::_endTime(int node) const
+{
+    const ScopeCallTree& tree = mModel->getCallTree();
+    const ScopeCallTree::sCallNode& call = tree.getCall(node);
+    return (call.enterTime + tree.getInclusive(node));
+}
+
+int ScopeFlameGraph::_hitTest(const QPoint& pos) const
+{
+    if ((mModel == nullptr) || (mThread == ScopeCallTree::InvalidIndex) || (mViewEnd <= mViewBegin))
+        return ScopeCallTree::InvalidIndex;
+
+    const ScopeCallTree& tree = mModel->getCallTree();
+    const int depth{ pos.y() / _barHeight() };
+    const uint64_t time{ _toTime(static_cast<double>(pos.x())) };
+    const std::vector<int>* calls = &tree.getThread(mThread).roots;
+    for (int level = 0; level <= depth; ++level)
+    {
+        auto it = _firstVisible(tree, *calls, time);
+        if ((it == calls->end()) || (tree.getCall(*it).enterTime > time) || (_endTime(*it) < time))
+            return ScopeCallTree::InvalidIndex;
+        else if (level == depth)
+            return *it;
+
+        calls = &tree.getCall(*it).children;
+    }
+
+    return ScopeCallTree::InvalidIndex;
+}
+
+void ScopeFlameGraph::_paintCall(QPainter& painter, int node, const QRect& area) const
+{
+    const ScopeCallTree& tree = mModel->getCallTree();
+    const ScopeCallTree::sCallNode& call = tree.getCall(node);
+    const int height{ _barHeight() };
+    const int top{ call.depth * height };
+    const double left{ _toX(call.enterTime) };
+    const double right{ _toX(_endTime(node)) };
+    // The nested calls are inside of the call, they are neither wider, nor higher.
+    if ((right - left < _minBarWidth) || (top > area.bottom()) || (right < area.left()) || (left > area.right()))
+        return;
+
+    const int x{ static_cast<int>(std::max(left, static_cast<double>(area.left() - 1))) };
+    const int w{ static_cast<int>(std::min(right, static_cast<double>(area.right() + 1))) - x };
+    const QRect bar(x, top, std::max(w, 1), height - 1);
+    const bool selected{ node == mSelected };
+    const QColor color{ selected ? palette().color(QPalette::ColorRole::Highlight) : QColor::fromHsv(static_cast<int>((call.scopeId * 47u) % 360u), call.closed ? 90 : 40, 235) };
+    painter.fillRect(bar, color);
+    painter.setPen(palette().color(QPalette::ColorRole::Mid));
+    painter.drawRect(bar.adjusted(0, 0, -1, -1));
+    if (bar.width() >= _minTextWidth)
+    {
+        painter.setPen(palette().color(selected ? QPalette::ColorRole::HighlightedText : QPalette::ColorRole::Text));
+        const QRect text{ bar.adjusted(3, 0, -3, 0) };
+        painter.drawText(text, Qt::AlignLeft | Qt::AlignVCenter, fontMetrics().elidedText(mModel->getScopeName(call.instId, call.scopeId), Qt::ElideRight, text.width()));
+    }
+
+    for (auto it = _firstVisible(tree, call.children, mViewBegin); it != call.children.end(); ++it)
+    {
+        if (tree.getCall(*it).enterTime > mViewEnd)
+            break;
+
+        _paintCall(painter, *it, area);
+    }
+}
+
+void ScopeFlameGraph::_updateTimeRange()
+{
+    const bool showsEnd{ mViewEnd == mThreadEnd };
+    if ((mModel == nullptr) || (mThread == ScopeCallTree::InvalidIndex))
+    {
+        mThreadBegin = mThreadEnd = 0u;
+        mViewBegin = mViewEnd = 0u;
+        return;
+    }
+
+    const ScopeCallTree& tree = mModel->getCallTree();
+    const ScopeCallTree::sThreadCalls& calls = tree.getThread(mThread);
+    mThreadBegin = calls.firstTime;
+    mThreadEnd = std::max(calls.lastTime, calls.roots.empty() ? mThreadBegin : _endTime(calls.roots.back()));
+    if (showsEnd)
+    {
+        // The graph of the live logs follows the new calls, unless the user zoomed to the older calls.
+        mViewEnd = mThreadEnd;
+    }
+}
@@ -0,0 +1,178 @@
+#ifndef LUSAN_VIEW_LOG_SCOPEFLAMEGRAPH_HPP
+#define LUSAN_VIEW_LOG_SCOPEFLAMEGRAPH_HPP
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   © 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        lusan/view/log/ScopeFlameGraph.hpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Lusan application, the flame graph of the calls of scopes of a thread.
+ *
+ ************************************************************************/
+
+/************************************************************************
+ * Includes
+ ************************************************************************/
+#include <QWidget>
+#include "areg/base/areg_global.h"
+
+/************************************************************************
+ * Dependencies
+ ************************************************************************/
+class ScopeCallTreeModel;
+class QPainter;
+
+/**
+ * \brief   Paints the calls of scopes of one thread as a flame graph: the time runs from left
+ *          to right, the nested calls are painted under the calling scope, and the width of
+ *          a bar is the inclusive time of the call. The calls narrower than a pixel are not
+ *          painted, together with their nested calls. The mouse wheel zooms the time axis,
+ *          the double click on a call zooms to the call, and the double click on the empty
+ *          area shows the whole thread.
+ **/
+class ScopeFlameGraph : public QWidget
+{
+    Q_OBJECT
+
+//////////////////////////////////////////////////////////////////////////
+// Constructor / Destructor
+//////////////////////////////////////////////////////////////////////////
+public:
+    explicit ScopeFlameGraph(QWidget* parent = nullptr);
+
+    virtual ~ScopeFlameGraph() = default;
+
+//////////////////////////////////////////////////////////////////////////
+// Operations and attributes
+//////////////////////////////////////////////////////////////////////////
+public:
+
+    /**
+     * \brief   Sets the model of the call tree to paint. Pass nullptr to clear the graph.
+     **/
+    void setCallTreeModel(ScopeCallTreeModel* model);
+
+    /**
+     * \brief   Sets the thread of the call tree to paint, the time axis shows the whole thread.
+     * \param   thread  The index of the thread in the call tree, or ScopeCallTree::InvalidIndex to clear the graph.
+     **/
+    void setThread(int thread);
+
+    /**
+     * \brief   Returns the index of the painted thread.
+     **/
+    inline int getThread() const;
+
+    /**
+     * \brief   Selects the call. If the call is in another thread, paints the thread of the call.
+     * \param   node    The index of the call in the call tree, or ScopeCallTree::InvalidIndex to reset the selection.
+     **/
+    void setSelectedCall(int node);
+
+    /**
+     * \brief   Returns the index of the selected call.
+     **/
+    inline int getSelectedCall() const;
+
+    /**
+     * \brief   Shows the whole time of the painted thread.
+     **/
+    void resetZoom();
+
+    virtual QSize sizeHint() const override;
+
+/************************************************************************
+ * Signals
+ ************************************************************************/
+signals:
+
+    /**
+     * \brief   Triggered when the user clicks on the call in the flame graph.
+     * \param   node    The index of the selected call in the call tree.
+     **/
+    void signalCallSelected(int node);
+
+//////////////////////////////////////////////////////////////////////////
+// QWidget overrides
+//////////////////////////////////////////////////////////////////////////
+protected:
+
+    virtual bool event(QEvent* event) override;
+
+    virtual void paintEvent(QPaintEvent* event) override;
+
+    virtual void mousePressEvent(QMouseEvent* event) override;
+
+    virtual void mouseDoubleClickEvent(QMouseEvent* event) override;
+
+    virtual void wheelEvent(QWheelEvent* event) override;
+
+//////////////////////////////////////////////////////////////////////////
+// Hidden methods
+//////////////////////////////////////////////////////////////////////////
+private:
+
+    //!< Returns the height of a bar of the graph.
+    inline int _barHeight() const;
+
+    //!< Converts the time to the horizontal position in the widget.
+    inline double _toX(uint64_t time) const;
+
+    //!< Converts the horizontal position in the widget to the time.
+    inline uint64_t _toTime(double x) const;
+
+    //!< Returns the time when the call ends, the call not ended yet lasts until the last message of the thread.
+    inline uint64_t _endTime(int node) const;
+
+    //!< Returns the index of the call painted at the position, or ScopeCallTree::InvalidIndex if there is no call.
+    int _hitTest(const QPoint& pos) const;
+
+    //!< Paints the call and its nested calls.
+    void _paintCall(QPainter& painter, int node, const QRect& area) const;
+
+    //!< Calculates the time range of the painted thread.
+    void _updateTimeRange();
+
+//////////////////////////////////////////////////////////////////////////
+// Member variables
+//////////////////////////////////////////////////////////////////////////
+private:
+    ScopeCallTreeModel* mModel;         //!< The model of the call tree.
+    int                 mThread;        //!< The index of the painted thread.
+    int                 mSelected;      //!< The index of the selected call.
+    uint64_t            mThreadBegin;   //!< The time when the first call of the thread starts.
+    uint64_t            mThreadEnd;     //!< The time when the last call of the thread ends.
+    uint64_t            mViewBegin;     //!< The time at the left border of the widget.
+    uint64_t            mViewEnd;       //!< The time at the right border of the widget.
+
+//////////////////////////////////////////////////////////////////////////
+// Forbidden calls
+//////////////////////////////////////////////////////////////////////////
+private:
+    AREG_NOCOPY_NOMOVE(ScopeFlameGraph);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// ScopeFlameGraph class inline methods
+//////////////////////////////////////////////////////////////////////////
+
+inline int ScopeFlameGraph::getThread() const
+{
+    return mThread;
+}
+
+inline int ScopeFlameGraph::getSelectedCall() const
+{
+    return mSelected;
+}
+
+#endif  // LUSAN_VIEW_LOG_SCOPEFLAMEGRAPH_HPP
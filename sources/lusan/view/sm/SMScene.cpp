@@ -1305,8 +1305,8 @@ void SMScene::refreshCompositeBoxes()
 
 bool SMScene::isOnThisLevel(uint32_t stateId) const
 {
-    const SMStateData* level = mModel.getData().findLevel(mLevelId);
-    return (level != nullptr) && (level->findStateById(stateId) != nullptr);
+    const uint32_t levelId = mModel.getData().getStateLevel(stateId);
+    return (levelId != 0u) && (levelId == mLevelId);
 }
 
 void SMScene::updateConnHighlights()
@@ -119,6 +119,19 @@ StateMachine::StateMachine(MdiMainWindow* wndMain, const QString& filePath /*= Q
     // last saved at, and whether the field the caret sits in still holds text of its own.
     connect(&mModel, &StateMachineModel::signalDirtyChanged, this, &StateMachine::refreshModified);
     connect(&mPendingEdits, &PendingEditWatcher::signalPendingEditChanged, this, &StateMachine::refreshModified);
+    // A save is written on the save thread, so whether it failed is known only when it is done.
+    connect(&mModel, &StateMachineModel::signalSaveFinished, this, [this](const QString& filePath, bool succeeded) {
+        refreshModified();
+        if (succeeded)
+        {
+            rememberFileState();
+        }
+        else
+        {
+            QMessageBox::warning(this, tr("Save")
+                                , tr("The file '%1' could not be written. The document keeps its changes.").arg(QDir::toNativeSeparators(filePath)));
+        }
+    });
     // A reload replaces what the pages show, so whatever a field holds afterwards came from the file.
     connect(&mModel.getNotifier(), &DocModelNotifier::documentReloaded, this, [this]() { mPendingEdits.acceptPendingEdit(); });
     connect(&mModel.getUndoStack(), &QUndoStack::canUndoChanged, this, &MdiChild::signalCanUndoChanged);
@@ -682,7 +695,12 @@ bool StateMachine::writeToFile(const QString& filePath)
         return false;
     }
 
-    return mModel.saveToFile(filePath);
+    return mModel.saveInBackground(filePath);
+}
+
+bool StateMachine::isWritingFile() const
+{
+    return mModel.isSaving();
 }
 
 void StateMachine::commitPendingEdits(void)
@@ -716,6 +734,9 @@ void StateMachine::openReadOnly(const QString& origin)
 
 bool StateMachine::maybeSave()
 {
+    // A save still being written decides whether anything is left to save.
+    mModel.finishSaves();
+    refreshModified();
     if (isModified() == false)
     {
         return true;
@@ -729,7 +750,8 @@ bool StateMachine::maybeSave()
     switch (ret)
     {
     case QMessageBox::Save:
-        return save();
+        // The window goes once the file is on disk; a failed save keeps it open with its autosave.
+        return save() && mModel.finishSaves();
     case QMessageBox::Discard:
         mModel.removeAutosave();
         return true;
@@ -743,6 +765,9 @@ bool StateMachine::maybeSave()
 void StateMachine::onWindowClosing(bool isActive)
 {
     Q_UNUSED(isActive);
+    // The autosave goes only with a document known to be on disk.
+    mModel.finishSaves();
+    refreshModified();
     if (isModified() == false)
     {
         mModel.removeAutosave();
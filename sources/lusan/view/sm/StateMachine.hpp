@@ -139,6 +139,11 @@ protected:
      **/
     QTabWidget* pageTabWidget() override;
 
+    /**
+     * \brief   True while a save is being written on the save thread.
+     **/
+    bool isWritingFile() const override;
+
 private slots:
     /**
      * \brief   Switches to the page owning the requested declaration kind (building it if
@@ -0,0 +1,1337 @@
+/************************************************************************
+ *  This file is part of the Lusan project, an official component of the Areg SDK.
+ *  Lusan is a graphical user interface (GUI) tool designed to support the development,
+ *  debugging, and testing of applications built with the Areg Framework.
+ *
+ *  Lusan is available as free and open-source software under the Apache version 2.0 License,
+ *  providing essential features for developers.
+ *
+ *  For detailed licensing terms, please refer to the LICENSE file included
+ *  with this distribution or contact us at info[at]areg.tech.
+ *
+ *  \copyright   (c) 2023-2026 Aregtech (Artak Avetyan).
+ *  \file        tests/log/LogPerformanceTests.cpp
+ *  \ingroup     Lusan - GUI Tool for Areg SDK
+ *  \author      Artak Avetyan
+ *  \brief       Log viewer responsiveness gate: builds a large synthetic log in memory and
+ *               measures the headless log operations over it. The search of a phrase that
+ *               sits at the far end of the log is the worst case the user can trigger, and
+ *               the wildcard and whole-word paths are compared against the plain-text path.
+ *               The scope session index is built over the same number of rows and the
+ *               intervals it reports are checked against the generated sessions, and so is
+ *               the call tree of scopes with the inclusive and exclusive time of the calls.
+ *               The latency statistics of the scopes are built from the same log and the
+ *               percentiles of the histograms are checked against the known durations.
+ *               The rate timeline counts the same number of messages per time bucket and
+ *               priority, its levels and its sidecar file are checked against the known counts.
+ *               The ingest telemetry counts the same number of messages passing the threads,
+ *               the queued messages, the high-water marks and the exported CSV are checked.
+ *               The scope trees of many instances with one million scopes in total are built
+ *               and their priorities are refreshed, the lookups by name, position and scope ID
+ *               are checked on the built trees. The leafs of a node with 5000 scopes are
+ *               fetched by pages and the rows of the children are checked, and so is the traffic
+ *               of the scopes counted up to the instance. The changes of the priorities are
+ *               committed as the requests to the instances, the diffed and compressed scopes are checked.
+ *               The scope trees of 200 instances are built in the worker threads, the delivered
+ *               trees and the canceled build are checked.
+ *               The rows of a log with one million messages are painted page by page into
+ *               an image while scrolling and jumping, every page is judged against the frame
+ *               budget of 60 frames per second.
+ *
+ *  Usage: lusan_log_perf
+ *
+ ************************************************************************/
+
+#include "lusan/data/log/LatencyHistogram.hpp"
+#include "lusan/data/log/LogExportWriter.hpp"
+#include "lusan/data/log/LogIngestTelemetry.hpp"
+#include "lusan/data/log/LogRateTimeline.hpp"
+#include "lusan/data/log/ScopeCallTree.hpp"
+#include "lusan/data/log/ScopeLatencyStats.hpp"
+#include "lusan/data/log/ScopeNodes.hpp"
+#include "lusan/data/log/ScopePrioTransaction.hpp"
+#include "lusan/data/log/ScopeSessionIndex.hpp"
+#include "lusan/data/log/ScopeTreeBuilder.hpp"
+#include "lusan/model/log/LogSearchModel.hpp"
+#include "lusan/view/log/LogTextHighlight.hpp"
+#include "areg/logging/areg_log.h"
+
+#include <QAbstractTableModel>
+#include <QApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QPainter>
+#include <QStyle>
+#include <QStyleOptionViewItem>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    //!< A one-off operation over the whole log (a search that scans every row) is paid once
+    //!< per gesture on a large log, the budget is generous enough for a debug build.
+    constexpr qint64 BUDGET_ONESHOT_MS  { 3000 };
+    //!< The regular expression path may cost more than the plain-text path per row, but not
+    //!< by an order of magnitude: the expression is compiled once per search session.
+    constexpr qint64 MAX_REGEX_RATIO    { 8 };
+
+    //!< The scope trees of all instances are built once when the instances connect, the
+    //!< budget is for one million scopes in a debug build.
+    constexpr qint64 BUDGET_SCOPE_TREE_MS   { 15000 };
+    //!< A change of the priority of one scope updates the nodes on the path of the scope,
+    //!< the budget is for all changes in a debug build.
+    constexpr qint64 BUDGET_SCOPE_TOGGLES_MS{ 1000 };
+    //!< The change of the priority of the whole tree of every instance is collected and
+    //!< committed as one request per instance, the budget is for all instances in a debug build.
+    constexpr qint64 BUDGET_SCOPE_REQUESTS_MS{ 2000 };
+    //!< The scope trees of the instances of the opened file are built in the worker threads,
+    //!< the budget is for one million scopes in a debug build.
+    constexpr qint64 BUDGET_SCOPE_BUILDER_MS{ 15000 };
+    //!< The telemetry is counted per live log message in three threads, its cost must stay
+    //!< far below the cost of the message itself, the budget is for all messages in a debug build.
+    constexpr qint64 BUDGET_TELEMETRY_MS    { 1000 };
+    //!< The export streams the matching messages of the whole log to the file, it is paid once
+    //!< per export, the budget is for every text format in a debug build.
+    constexpr qint64 BUDGET_EXPORT_MS       { BUDGET_ONESHOT_MS };
+    //!< One page of the log table is painted per frame, 60 frames per second.
+    constexpr qint64 BUDGET_FRAME_MS        { 16 };
+
+    //!< The number of log messages in the synthetic log.
+    constexpr int LOG_ROWS              { 200000 };
+
+    //!< The number of instances and the number of scopes of every instance of the scope trees.
+    constexpr int SCOPE_INSTANCES       { 40 };
+    constexpr int SCOPES_PER_INSTANCE   { 25000 };
+    //!< The number of the changes of the priorities of single scopes.
+    constexpr int SCOPE_TOGGLES         { 200000 };
+    //!< The number of instances and the number of scopes of every instance built in the worker threads.
+    constexpr int BUILD_INSTANCES       { 200 };
+    constexpr int SCOPES_PER_BUILD      { 5000 };
+    //!< The number of rows of the painted log, the number of the scrolled and jumped frames,
+    //!< the number of rows scrolled per frame and the size of the painted page.
+    constexpr int PAINT_ROWS            { 1000000 };
+    constexpr int PAINT_SCROLL_FRAMES   { 600 };
+    constexpr int PAINT_JUMP_FRAMES     { 120 };
+    constexpr int PAINT_SCROLL_STEP     { 3 };
+    constexpr int PAINT_WIDTH           { 1280 };
+    constexpr int PAINT_HEIGHT          { 720 };
+
+    int gChecks = 0;
+    int gFailures = 0;
+
+    void check(bool condition, const char* what)
+    {
+        ++gChecks;
+        if (condition == false)
+        {
+            ++gFailures;
+            std::printf("  [FAIL] %s\n", what);
+        }
+    }
+
+#define CHECK(cond)  check((cond), #cond)
+
+    void report(const char* what, qint64 elapsed, qint64 budget)
+    {
+        ++gChecks;
+        const bool ok = (elapsed <= budget);
+        if (ok == false)
+        {
+            ++gFailures;
+        }
+
+        std::printf("  %-46s %6lld ms   (budget %lld ms) %s\n",
+                    what, static_cast<long long>(elapsed), static_cast<long long>(budget),
+                    ok ? "ok" : "OVER");
+    }
+
+    //!< The regex path is judged against the plain-text path of the same scan. Both are
+    //!< floored at a few milliseconds, a faster machine should not fail on timer noise.
+    void reportRatio(const char* what, qint64 elapsed, qint64 plain)
+    {
+        ++gChecks;
+        const qint64 budget = std::max<qint64>(plain, 5) * MAX_REGEX_RATIO;
+        const bool ok = (elapsed <= budget);
+        if (ok == false)
+        {
+            ++gFailures;
+        }
+
+        std::printf("  %-46s %6lld ms   (plain %lld ms, budget %lld ms) %s\n",
+                    what, static_cast<long long>(elapsed), static_cast<long long>(plain),
+                    static_cast<long long>(budget), ok ? "ok" : "OVER");
+    }
+
+    void setMessage(areg::LogEntry& entry, const char* text)
+    {
+        const size_t length = std::min(std::strlen(text), sizeof(entry.logMessage) - 1);
+        std::memcpy(entry.logMessage, text, length);
+        entry.logMessage[length] = '\0';
+        entry.logMessageLen = static_cast<decltype(entry.logMessageLen)>(length);
+    }
+
+    /**
+     * \brief   The smallest log model the search runs on: one column, the log entry in the
+     *          user role, the same contract the live and offline logging models fulfill.
+     **/
+    class SyntheticLogModel : public QAbstractTableModel
+    {
+    public:
+        explicit SyntheticLogModel(int rows)
+            : QAbstractTableModel()
+            , mEntries(static_cast<size_t>(rows))
+        {
+            char buffer[128];
+            for (int i = 0; i < rows; ++i)
+            {
+                std::snprintf(buffer, sizeof(buffer), "Component_%d processed request %d of session %d, state is OK", i % 97, i, i % 13);
+                setMessage(mEntries[static_cast<size_t>(i)], buffer);
+            }
+        }
+
+        void setRowMessage(int row, const char* text)
+        {
+            setMessage(mEntries[static_cast<size_t>(row)], text);
+        }
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override
+        {
+            return (parent.isValid() ? 0 : static_cast<int>(mEntries.size()));
+        }
+
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override
+        {
+            return (parent.isValid() ? 0 : 1);
+        }
+
+        QVariant data(const QModelIndex& index, int role) const override
+        {
+            if ((role != Qt::UserRole) || (index.isValid() == false))
+                return QVariant();
+
+            const areg::LogEntry* entry = &mEntries[static_cast<size_t>(index.row())];
+            return QVariant::fromValue(entry);
+        }
+
+    private:
+        std::vector<areg::LogEntry> mEntries;
+    };
+
+    /**
+     * \brief   The display model of the painted log: the time, the priority and the message
+     *          columns, the texts are made on request, the same way the logging models make them.
+     **/
+    class PaintLogModel : public QAbstractTableModel
+    {
+    public:
+        explicit PaintLogModel(int rows)
+            : QAbstractTableModel()
+            , mRows(rows)
+        {
+        }
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override
+        {
+            return (parent.isValid() ? 0 : mRows);
+        }
+
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override
+        {
+            return (parent.isValid() ? 0 : 3);
+        }
+
+        QVariant data(const QModelIndex& index, int role) const override
+        {
+            if (index.isValid() == false)
+                return QVariant();
+
+            const int row{ index.row() };
+            if (role == Qt::TextAlignmentRole)
+            {
+                return QVariant(static_cast<int>((index.column() == 1 ? Qt::AlignHCenter : Qt::AlignLeft) | Qt::AlignVCenter));
+            }
+            else if (role != Qt::DisplayRole)
+            {
+                return QVariant();
+            }
+
+            switch (index.column())
+            {
+            case 0:
+                return QString::asprintf("2026-01-01 10:%02d:%02d.%03d", (row / 60000) % 60, (row / 1000) % 60, row % 1000);
+            case 1:
+                return QString::fromLatin1((row % 7) == 0 ? "WARNING" : "DEBUG");
+            default:
+                return QString::asprintf("Component_%d processed request %d of session %d, the state of the handler is OK and the queue has %d events"
+                                        , row % 97, row, row % 13, row % 31);
+            }
+        }
+
+    private:
+        int mRows;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    // Search: plain text, wildcard and whole word over the whole log
+    //////////////////////////////////////////////////////////////////////////
+    void testSearch()
+    {
+        std::printf("[log] search over %d rows\n", LOG_ROWS);
+
+        SyntheticLogModel model(LOG_ROWS);
+        const int target { LOG_ROWS - 3 };
+        model.setRowMessage(target, "Component_7 reported fatal_error in handler Watchdog, restarting");
+
+        LogSearchModel search(&model);
+        QElapsedTimer timer;
+
+        // Plain text, forward from the top: scans the whole log up to the target.
+        timer.start();
+        LogSearchModel::sFoundPos found = search.startSearch(QStringLiteral("fatal_error"), 0u, false, false, false, false);
+        const qint64 plain = timer.elapsed();
+        report("plain text, forward", plain, BUDGET_ONESHOT_MS);
+        CHECK(found.rowFound == static_cast<uint32_t>(target));
+        CHECK(search.getFoundPhrase() == QStringLiteral("fatal_error"));
+
+        // Wildcard, forward: the same scan through the compiled expression.
+        timer.start();
+        found = search.startSearch(QStringLiteral("fatal*Watch?og"), 0u, false, false, true, false);
+        const qint64 wildcard = timer.elapsed();
+        reportRatio("wildcard, forward", wildcard, plain);
+        CHECK(found.rowFound == static_cast<uint32_t>(target));
+        CHECK(search.getFoundPhrase() == QStringLiteral("fatal_error in handler Watchdog"));
+
+        // Whole word, forward: '_' is a word boundary, so 'error' is a whole word in 'fatal_error'.
+        timer.start();
+        found = search.startSearch(QStringLiteral("error"), 0u, false, true, false, false);
+        const qint64 wholeWord = timer.elapsed();
+        reportRatio("whole word, forward", wholeWord, plain);
+        CHECK(found.rowFound == static_cast<uint32_t>(target));
+        CHECK(search.getFoundPhrase() == QStringLiteral("error"));
+
+        // Backward from the top wraps to the end of the log, the target is found almost immediately.
+        found = search.startSearch(QStringLiteral("re*ing"), 0u, false, false, true, true);
+        CHECK(found.rowFound == static_cast<uint32_t>(target));
+        CHECK(search.getFoundPhrase() == QStringLiteral("restarting"));
+
+        // Backward from the row before the target scans the whole log once around.
+        timer.start();
+        found = search.startSearch(QStringLiteral("Watchdog"), static_cast<uint32_t>(target - 1), true, true, false, true);
+        reportRatio("whole word, backward", timer.elapsed(), plain);
+        CHECK(found.rowFound == static_cast<uint32_t>(target));
+
+        // A wildcard backward over the whole log: nearly every row is one without a match.
+        timer.start();
+        found = search.startSearch(QStringLiteral("fatal*Watch?og"), static_cast<uint32_t>(target - 1), false, false, true, true);
+        reportRatio("wildcard, backward", timer.elapsed(), plain);
+        CHECK(found.rowFound == static_cast<uint32_t>(target));
+        CHECK(search.getFoundPhrase() == QStringLiteral("fatal_error in handler Watchdog"));
+
+        // A wildcard that covers the whole message is found from its first character.
+        found = search.startSearch(QStringLiteral("*_*"), static_cast<uint32_t>(target), false, false, true, false);
+        CHECK(found.rowFound == static_cast<uint32_t>(target));
+        CHECK(found.posStart == 0);
+
+        // A phrase that is nowhere in the log ends the session after one full round.
+        timer.start();
+        found = search.startSearch(QStringLiteral("no*such?phrase"), 0u, false, false, true, false);
+        reportRatio("wildcard, not found", timer.elapsed(), plain);
+        CHECK(search.isValidPosition(found) == false);
+        CHECK(search.hasFound() == false);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Scope session index: intervals, nesting depth, dropped rows
+    //////////////////////////////////////////////////////////////////////////
+    areg::LogEntry makeEntry(areg::LogMessageType type, ITEM_ID thread, uint32_t scope, uint32_t session)
+    {
+        areg::LogEntry entry{};
+        entry.logMsgType    = type;
+        entry.logCookie     = 256u;
+        entry.logThreadId   = thread;
+        entry.logScopeId    = scope;
+        entry.logSessionId  = session;
+        return entry;
+    }
+
+    //!< Two threads interleave their calls: an outer scope (1) with a nested scope (2) that
+    //!< logs a message. Every call of both threads together takes 10 rows.
+    std::vector<areg::LogEntry> makeScopeLog()
+    {
+        std::vector<areg::LogEntry> entries;
+        entries.reserve(LOG_ROWS);
+        for (uint32_t session = 1u; static_cast<int>(entries.size()) + 10 <= LOG_ROWS; ++session)
+        {
+            for (ITEM_ID thread : { ITEM_ID{ 1u }, ITEM_ID{ 2u } })
+            {
+                entries.push_back(makeEntry(areg::LogMessageType::ScopeEnter , thread, 1u, session));
+                entries.push_back(makeEntry(areg::LogMessageType::ScopeEnter , thread, 2u, session));
+            }
+
+            for (ITEM_ID thread : { ITEM_ID{ 1u }, ITEM_ID{ 2u } })
+            {
+                entries.push_back(makeEntry(areg::LogMessageType::MessageText, thread, 2u, session));
+                entries.push_back(makeEntry(areg::LogMessageType::ScopeExit  , thread, 2u, session));
+            }
+
+            for (ITEM_ID thread : { ITEM_ID{ 1u }, ITEM_ID{ 2u } })
+            {
+                entries.push_back(makeEntry(areg::LogMessageType::ScopeExit  , thread, 1u, session));
+            }
+        }
+
+        return entries;
+    }
+
+    void testSessionIndex()
+    {
+        std::printf("[log] scope session index over %d rows\n", LOG_ROWS);
+
+        const std::vector<areg::LogEntry> entries{ makeScopeLog() };
+        ScopeSessionIndex index;
+        QElapsedTimer timer;
+        timer.start();
+        for (const areg::LogEntry& entry : entries)
+        {
+            index.append(entry);
+        }
+
+        report("session index build", timer.elapsed(), BUDGET_ONESHOT_MS);
+        CHECK(index.getRowCount() == static_cast<int>(entries.size()));
+
+        // Session 1 of thread 2 covers rows 2..9, the nested scope covers rows 3..7.
+        const ScopeSessionIndex::sSessionKey outer{ 256u, 2u, 1u, 1u };
+        const ScopeSessionIndex::sSessionKey inner{ 256u, 2u, 2u, 1u };
+        CHECK(index.getEnterRow(outer) == 2);
+        CHECK(index.getExitRow(outer) == 9);
+        CHECK(index.getDepth(outer) == 0);
+        CHECK(index.getEnterRow(inner) == 3);
+        CHECK(index.getExitRow(inner) == 7);
+        CHECK(index.getDepth(inner) == 1);
+        CHECK(index.isInside(outer, 5));
+        CHECK(index.isInside(outer, 2) == false);
+        CHECK(index.isInside(outer, 9) == false);
+        CHECK(index.isInside(inner, 8) == false);
+
+        // The lookups do not depend on the order of the queried rows.
+        bool sameResult{ true };
+        for (int row = static_cast<int>(entries.size()) - 1; row >= 0; --row)
+        {
+            sameResult = sameResult && (index.isInside(outer, row) == ((row > 2) && (row < 9)));
+        }
+
+        CHECK(sameResult);
+
+        // Dropping the first call keeps the rows of the next call valid, moved up by the dropped rows.
+        const ScopeSessionIndex::sSessionKey second{ 256u, 1u, 1u, 2u };
+        const int enterSecond{ index.getEnterRow(second) };
+        index.removeFront(10);
+        CHECK(index.contains(outer) == false);
+        CHECK(index.getEnterRow(second) == enterSecond - 10);
+        CHECK(index.getRowCount() == static_cast<int>(entries.size()) - 10);
+    }
+
+    void testCallTree()
+    {
+        std::printf("[log] scope call tree over %d rows\n", LOG_ROWS);
+
+        // A message every 10 microseconds. The nested scope reports its measured duration,
+        // the duration of the outer scope is the time between its enter and exit messages.
+        std::vector<areg::LogEntry> entries{ makeScopeLog() };
+        for (uint32_t row = 0; row < static_cast<uint32_t>(entries.size()); ++row)
+        {
+            entries[row].logTimestamp = static_cast<TIME64>(row) * 10u;
+            if ((entries[row].logMsgType == areg::LogMessageType::ScopeExit) && (entries[row].logScopeId == 2u))
+            {
+                entries[row].logDuration = 25u;
+            }
+        }
+
+        ScopeCallTree tree;
+        QElapsedTimer timer;
+        timer.start();
+        for (const areg::LogEntry& entry : entries)
+        {
+            tree.append(entry);
+        }
+
+        report("call tree build", timer.elapsed(), BUDGET_ONESHOT_MS);
+        const int sessions{ static_cast<int>(entries.size()) / 10 };
+        CHECK(tree.getRowCount() == static_cast<int>(entries.size()));
+        CHECK(tree.getThreadCount() == 2);
+        CHECK(tree.getCallCount() == sessions * 4);
+        CHECK(tree.getUnmatchedCount() == 0);
+
+        // Session 1 of thread 2: the outer call covers rows 2..9, the nested call rows 3..7.
+        const int thread{ tree.findThread(256u, 2u) };
+        CHECK(thread != ScopeCallTree::InvalidIndex);
+        const ScopeCallTree::sThreadCalls& calls = tree.getThread(thread);
+        CHECK(static_cast<int>(calls.roots.size()) == sessions);
+        CHECK(calls.stack.empty());
+
+        const ScopeCallTree::sCallNode& outer = tree.getCall(calls.roots.front());
+        CHECK(outer.enterRow == 2 && outer.exitRow == 9);
+        CHECK(outer.closed && (outer.children.size() == 1u));
+        CHECK(outer.inclusive == 70u);
+        CHECK(outer.exclusive() == 45u);
+
+        const ScopeCallTree::sCallNode& inner = tree.getCall(outer.children.front());
+        CHECK(inner.enterRow == 3 && inner.exitRow == 7);
+        CHECK((inner.depth == 1) && (inner.parent == calls.roots.front()));
+        CHECK(inner.inclusive == 25u);
+        CHECK(inner.exclusive() == 25u);
+
+        // The nested call, which exit is lost, ends with the calling scope, and the exit
+        // without enter is ignored. The open call lasts until the last message of its thread.
+        ScopeCallTree lost;
+        areg::LogEntry entry{ makeEntry(areg::LogMessageType::ScopeEnter, 1u, 1u, 1u) };
+        lost.append(entry);
+        entry = makeEntry(areg::LogMessageType::ScopeEnter, 1u, 2u, 1u);
+        entry.logTimestamp = 10u;
+        lost.append(entry);
+        entry = makeEntry(areg::LogMessageType::ScopeExit, 1u, 3u, 1u);
+        entry.logTimestamp = 20u;
+        lost.append(entry);
+        CHECK(lost.getUnmatchedCount() == 1);
+        CHECK(lost.getInclusive(0) == 10u);
+        CHECK(lost.getExclusive(0) == 10u);
+
+        std::vector<int> closed;
+        entry = makeEntry(areg::LogMessageType::ScopeExit, 1u, 1u, 1u);
+        entry.logTimestamp = 40u;
+        CHECK(lost.append(entry, &closed) == 0);
+        CHECK((closed.size() == 2u) && (closed.front() == 1) && (closed.back() == 0));
+        CHECK(lost.getCall(1).closed && (lost.getCall(1).exitRow == ScopeCallTree::InvalidIndex));
+        CHECK(lost.getCall(1).inclusive == 30u);
+        CHECK(lost.getCall(0).inclusive == 40u);
+        CHECK(lost.getCall(0).exclusive() == 10u);
+
+        // Dropping the first rows drops the calls entered there, the nested call of thread 2
+        // entered at row 3 becomes its first root and keeps its times.
+        timer.restart();
+        tree.removeFront(3);
+        report("call tree trim", timer.elapsed(), BUDGET_INTERACTION_MS);
+        CHECK(tree.getRowCount() == static_cast<int>(entries.size()) - 3);
+        CHECK(tree.getThreadCount() == 2);
+        CHECK(tree.getCallCount() == sessions * 4 - 3);
+        const ScopeCallTree::sThreadCalls& trimmed = tree.getThread(tree.findThread(256u, 2u));
+        CHECK(static_cast<int>(trimmed.roots.size()) == sessions);
+        const ScopeCallTree::sCallNode& promoted = tree.getCall(trimmed.roots.front());
+        CHECK((promoted.enterRow == 0) && (promoted.exitRow == 4));
+        CHECK((promoted.depth == 0) && (promoted.parent == ScopeCallTree::InvalidIndex) && (promoted.position == 0));
+        CHECK(promoted.inclusive == 25u);
+        CHECK(trimmed.firstTime == 30u);
+
+        // The second session of thread 2 is where the first one was, moved up by the dropped rows.
+        const ScopeCallTree::sCallNode& next = tree.getCall(trimmed.roots[1]);
+        CHECK((next.enterRow == 9) && (next.exitRow == 16) && (next.position == 1));
+        CHECK((next.children.size() == 1u) && (tree.getCall(next.children.front()).parent == trimmed.roots[1]));
+        CHECK(tree.getCall(next.children.front()).depth == 1);
+        CHECK(static_cast<int>(tree.getThread(tree.findThread(256u, 1u)).roots.size()) == sessions - 1);
+
+        // The nested call of the dropped call becomes a root, and dropping every row empties the tree.
+        lost.removeFront(1);
+        CHECK((lost.getThreadCount() == 1) && (lost.getCallCount() == 1));
+        CHECK((lost.getCall(0).depth == 0) && (lost.getCall(0).thread == 0));
+        lost.removeFront(lost.getRowCount());
+        CHECK((lost.getThreadCount() == 0) && (lost.getCallCount() == 0) && (lost.getRowCount() == 0));
+
+        // A thread without calls left is dropped, the next thread takes its place.
+        ScopeCallTree threads;
+        threads.append(makeEntry(areg::LogMessageType::ScopeEnter, 1u, 1u, 1u));
+        threads.append(makeEntry(areg::LogMessageType::ScopeExit , 1u, 1u, 1u));
+        threads.append(makeEntry(areg::LogMessageType::ScopeEnter, 2u, 1u, 1u));
+        threads.removeFront(2);
+        CHECK((threads.getThreadCount() == 1) && (threads.findThread(256u, 1u) == ScopeCallTree::InvalidIndex));
+        CHECK((threads.findThread(256u, 2u) == 0) && (threads.getCall(0).thread == 0));
+        CHECK((threads.getOpenCall(0) == 0) && (threads.getCall(0).enterRow == 0));
+    }
+
+    //!< Returns true if the value reported by the histogram is within its relative precision.
+    bool isNear(uint64_t value, uint64_t expected)
+    {
+        const uint64_t diff{ value > expected ? value - expected : expected - value };
+        return (diff * LatencyHistogram::SubBucketCount <= expected * 2u);
+    }
+
+    void testLatency()
+    {
+        std::printf("[log] scope latency statistics over %d rows\n", LOG_ROWS);
+
+        // The small values are counted exactly.
+        LatencyHistogram exact;
+        for (uint64_t value = 0u; value < 100u; ++value)
+        {
+            exact.record(value);
+        }
+
+        CHECK(exact.getCount() == 100u);
+        CHECK((exact.getMin() == 0u) && (exact.getMax() == 99u));
+        CHECK(exact.getValueAtPercentile(50.0) == 49u);
+        CHECK(exact.getValueAtPercentile(99.0) == 98u);
+        CHECK(exact.getValueAtPercentile(100.0) == 99u);
+
+        // The big values are reported within the relative precision, the merge adds the counts.
+        LatencyHistogram wide;
+        LatencyHistogram half;
+        for (uint64_t value = 1u; value <= 100000u; ++value)
+        {
+            (value <= 50000u ? wide : half).record(value);
+        }
+
+        wide.merge(half);
+        CHECK(wide.getCount() == 100000u);
+        CHECK((wide.getMin() == 1u) && (wide.getMax() == 100000u));
+        CHECK(isNear(wide.getValueAtPercentile(50.0), 50000u));
+        CHECK(isNear(wide.getValueAtPercentile(99.0), 99000u));
+        CHECK(isNear(wide.getValueAtPercentile(99.9), 99900u));
+        CHECK(wide.getValueAtPercentile(100.0) == 100000u);
+
+        // The outer scope always takes 5 ms, the nested scope takes from 0 to 999 microseconds.
+        std::vector<areg::LogEntry> entries{ makeScopeLog() };
+        for (areg::LogEntry& entry : entries)
+        {
+            if (entry.logMsgType == areg::LogMessageType::ScopeExit)
+            {
+                entry.logDuration = (entry.logScopeId == 1u ? 5000u : entry.logSessionId % 1000u);
+            }
+        }
+
+        ScopeLatencyStats stats;
+        QElapsedTimer timer;
+        timer.start();
+        for (const areg::LogEntry& entry : entries)
+        {
+            stats.append(entry);
+        }
+
+        report("latency statistics build", timer.elapsed(), BUDGET_ONESHOT_MS);
+        const uint64_t sessions{ static_cast<uint64_t>(entries.size()) / 10u };
+        CHECK(stats.getScopeCount() == 2);
+        const int outer{ stats.findScope(256u, 1u) };
+        const int inner{ stats.findScope(256u, 2u) };
+        CHECK((outer != -1) && (inner != -1) && (outer != inner));
+        CHECK(stats.findScope(256u, 3u) == -1);
+
+        const LatencyHistogram& outerTime = stats.getScope(outer).histogram;
+        CHECK(outerTime.getCount() == sessions * 2u);
+        CHECK(outerTime.getValueAtPercentile(50.0) == 5000u);
+        CHECK(outerTime.getValueAtPercentile(99.9) == 5000u);
+
+        const LatencyHistogram& innerTime = stats.getScope(inner).histogram;
+        CHECK(innerTime.getCount() == sessions * 2u);
+        CHECK((innerTime.getMin() == 0u) && (innerTime.getMax() == 999u));
+        CHECK(isNear(innerTime.getValueAtPercentile(50.0), 500u));
+        CHECK(isNear(innerTime.getValueAtPercentile(99.0), 990u));
+
+        // The copy of the statistics is continued as the worker thread does, the result does not differ.
+        ScopeLatencyStats first;
+        const size_t middle{ entries.size() / 2u };
+        for (size_t i = 0u; i < middle; ++i)
+        {
+            first.append(entries[i]);
+        }
+
+        ScopeLatencyStats continued(first);
+        for (size_t i = middle; i < entries.size(); ++i)
+        {
+            continued.append(entries[i]);
+        }
+
+        CHECK(continued.getScopeCount() == stats.getScopeCount());
+        CHECK(continued.getScope(inner).histogram.getValueAtPercentile(99.0) == innerTime.getValueAtPercentile(99.0));
+        CHECK(continued.getScope(outer).histogram.getCount() == outerTime.getCount());
+    }
+
+    void testTimeline()
+    {
+        std::printf("[log] rate timeline over %d rows\n", LOG_ROWS);
+
+        // One message per millisecond, the priorities rotate over error, warning, info and debug.
+        constexpr TIME64 begin{ 1760000000000000u };
+        constexpr areg::LogPriority prios[]{ areg::LogPriority::PrioError, areg::LogPriority::PrioWarning
+                                           , areg::LogPriority::PrioInfo , areg::LogPriority::PrioDebug };
+
+        LogRateTimeline timeline;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < LOG_ROWS; ++i)
+        {
+            timeline.append(begin + static_cast<TIME64>(i) * 1000u, prios[i % 4]);
+        }
+
+        report("rate timeline build", timer.elapsed(), BUDGET_ONESHOT_MS);
+        CHECK(timeline.getTotalCount() == static_cast<uint64_t>(LOG_ROWS));
+        CHECK(timeline.getBeginTime() == begin);
+        CHECK(timeline.getEndTime() == begin + static_cast<TIME64>(LOG_ROWS - 1) * 1000u);
+        CHECK(timeline.getOrigin() <= begin);
+        CHECK(timeline.getFinestLevel() == 0u);
+
+        // Every level counts all messages, the finest buckets count 100 messages of 0.1 second.
+        bool totals{ true };
+        for (uint32_t level = timeline.getFinestLevel(); level < LogRateTimeline::LevelCount; ++level)
+        {
+            uint64_t total{ 0u };
+            uint64_t errors{ 0u };
+            for (int i = 0; i < timeline.getBucketCount(level); ++i)
+            {
+                total  += timeline.getBucket(level, i).total();
+                errors += timeline.getBucket(level, i).counts[LogRateTimeline::RateError];
+            }
+
+            totals = totals && (total == static_cast<uint64_t>(LOG_ROWS)) && (errors == static_cast<uint64_t>(LOG_ROWS / 4));
+        }
+
+        CHECK(totals);
+        const int first{ timeline.findBucket(0u, begin) };
+        CHECK(first != -1);
+        CHECK(timeline.getBucketTime(0u, first) <= begin);
+        CHECK(timeline.getBucket(0u, first + 1).total() == 100u);
+        CHECK(timeline.getBucket(0u, first + 1).counts[LogRateTimeline::RateInfo] == 25u);
+        CHECK(timeline.findBucket(0u, timeline.getOrigin() - 1u) == -1);
+        CHECK(timeline.findBucket(0u, timeline.getEndTime() + LogRateTimeline::getBucketWidth(LogRateTimeline::LevelCount - 1u)) == -1);
+
+        // The level shows the span with no more buckets than asked.
+        const TIME64 span{ timeline.getEndTime() - timeline.getBeginTime() };
+        CHECK(timeline.selectLevel(span, 4000) == 0u);
+        const uint32_t coarse{ timeline.selectLevel(span, 100) };
+        CHECK((coarse > 0u) && (span / LogRateTimeline::getBucketWidth(coarse) < 100u));
+        CHECK(span / LogRateTimeline::getBucketWidth(coarse - 1u) >= 100u);
+
+        // The message older than the first one moves the origin, the counted buckets move with it.
+        LogRateTimeline shifted(timeline);
+        const TIME64 older{ timeline.getOrigin() - LogRateTimeline::getBucketWidth(LogRateTimeline::LevelCount - 1u) };
+        shifted.append(older, areg::LogPriority::PrioError);
+        CHECK(shifted.getOrigin() == older);
+        CHECK(shifted.getBeginTime() == older);
+        CHECK(shifted.getTotalCount() == static_cast<uint64_t>(LOG_ROWS + 1));
+        CHECK(shifted.getBucket(0u, 0).counts[LogRateTimeline::RateError] == 1u);
+        const int moved{ shifted.findBucket(0u, begin + 100000u) };
+        CHECK((moved != -1) && (shifted.getBucket(0u, moved).total() == timeline.getBucket(0u, first + 1).total()));
+
+        // The sidecar is read back only for the same source file.
+        QTemporaryDir dir;
+        CHECK(dir.isValid());
+        const QString path{ LogRateTimeline::getSidecarPath(dir.filePath(QStringLiteral("log.sqlog"))) };
+        const LogRateTimeline::sSourceInfo source{ 123456, 654321 };
+        CHECK(timeline.save(path, source));
+
+        LogRateTimeline loaded;
+        CHECK(loaded.load(path, source));
+        CHECK(loaded.getTotalCount() == timeline.getTotalCount());
+        CHECK((loaded.getOrigin() == timeline.getOrigin()) && (loaded.getEndTime() == timeline.getEndTime()));
+        CHECK(loaded.getBucketCount(0u) == timeline.getBucketCount(0u));
+        CHECK(loaded.getBucket(0u, first + 1).counts[LogRateTimeline::RateInfo] == 25u);
+
+        LogRateTimeline stale;
+        CHECK(stale.load(path, LogRateTimeline::sSourceInfo{ 123456, 654322 }) == false);
+        CHECK(stale.isEmpty());
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Ingest telemetry: messages passing the threads, queues, high-water marks
+    //////////////////////////////////////////////////////////////////////////
+    void testIngestTelemetry()
+    {
+        std::printf("[log] ingest telemetry, %d messages\n", LOG_ROWS);
+
+        LogIngestTelemetry telemetry;
+        const TIME64 received{ static_cast<TIME64>(QDateTime::currentMSecsSinceEpoch()) * 1000u };
+
+        // The messages are received and dispatched in their threads, the half is shown.
+        QElapsedTimer timer;
+        timer.start();
+        std::thread client([&telemetry, received]() {
+            for (int i = 0; i < LOG_ROWS; ++i)
+            {
+                telemetry.messageReceived(received);
+            }
+        });
+
+        client.join();
+        std::thread observer([&telemetry]() {
+            for (int i = 0; i < LOG_ROWS; ++i)
+            {
+                telemetry.messageDispatched();
+            }
+        });
+
+        observer.join();
+        for (int i = 0; i < LOG_ROWS / 2; ++i)
+        {
+            telemetry.messageShown(static_cast<uint32_t>(i + 1));
+        }
+
+        report("telemetry counted", timer.elapsed(), BUDGET_TELEMETRY_MS);
+
+        const LogIngestTelemetry::sIngestSample first{ telemetry.takeSample() };
+        CHECK(first.get(LogIngestTelemetry::MetricObserverQueue) == 0.0);
+        CHECK(first.get(LogIngestTelemetry::MetricUiQueue) == static_cast<double>(LOG_ROWS / 2));
+        CHECK(first.get(LogIngestTelemetry::MetricRows) == static_cast<double>(LOG_ROWS / 2));
+        CHECK(first.get(LogIngestTelemetry::MetricRate) > 0.0);
+        CHECK(first.get(LogIngestTelemetry::MetricDeliveryLag) >= 0.0);
+
+        // The rest is shown and the rows are evicted, the queue is empty, the high-water mark is not.
+        for (int i = LOG_ROWS / 2; i < LOG_ROWS; ++i)
+        {
+            telemetry.messageShown(static_cast<uint32_t>(i + 1));
+        }
+
+        telemetry.rowsEvicted(10000u, static_cast<uint32_t>(LOG_ROWS - 10000));
+        const LogIngestTelemetry::sIngestSample second{ telemetry.takeSample() };
+        CHECK(second.get(LogIngestTelemetry::MetricUiQueue) == 0.0);
+        CHECK(second.get(LogIngestTelemetry::MetricRate) == 0.0);
+        CHECK(second.get(LogIngestTelemetry::MetricEvicted) == 10000.0);
+        CHECK(telemetry.getHighWater().get(LogIngestTelemetry::MetricUiQueue) == static_cast<double>(LOG_ROWS / 2));
+        CHECK(telemetry.getHighWater(1u).get(LogIngestTelemetry::MetricUiQueue) == 0.0);
+        CHECK(telemetry.getSessionHighWater().get(LogIngestTelemetry::MetricRows) == static_cast<double>(LOG_ROWS));
+        CHECK(telemetry.getHistory().size() == 2u);
+
+        // The history is exported with the header and the rolling high-water marks.
+        QTemporaryDir dir;
+        CHECK(dir.isValid());
+        const QString path{ dir.filePath(QStringLiteral("ingest.csv")) };
+        CHECK(telemetry.exportCsv(path));
+        QFile file(path);
+        CHECK(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QList<QByteArray> lines{ file.readAll().split('\n') };
+        CHECK((lines.size() == 4) && lines[0].startsWith("time_us,messages_per_sec,observer_queue,ui_queue"));
+        CHECK((lines.size() == 4) && (lines[1].split(',').size() == 1 + 2 * static_cast<int>(LogIngestTelemetry::MetricCount)));
+        CHECK((lines.size() == 4) && (lines[2].split(',').at(1 + static_cast<int>(LogIngestTelemetry::MetricCount) + LogIngestTelemetry::MetricUiQueue) == QByteArray::number(LOG_ROWS / 2)));
+
+        // The reset starts counting from the received messages.
+        telemetry.reset();
+        CHECK(telemetry.getHistory().empty());
+        CHECK(telemetry.takeSample().get(LogIngestTelemetry::MetricObserverQueue) == 0.0);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Export: the log streamed to the CSV and NDJSON files by batches
+    //////////////////////////////////////////////////////////////////////////
+
+    //!< Writes the log by batches of the export chunk, returns the result of closing the writer.
+    bool exportLog(LogExportWriter& writer, const QString& path, const std::vector<areg::LogEntry>& entries, bool commit)
+    {
+        constexpr int EXPORT_BATCH{ 10000 };
+        areg::ext::LogSqliteDatabase source;
+        bool result{ writer.open(path, source) };
+        for (int i = 0; result && (i < static_cast<int>(entries.size())); ++i)
+        {
+            result = writer.write(entries[static_cast<size_t>(i)]) && (((i + 1) % EXPORT_BATCH != 0) || writer.flush());
+        }
+
+        return writer.close(result && commit);
+    }
+
+    void testExportWriter()
+    {
+        std::printf("[log] export of %d rows to CSV and NDJSON\n", LOG_ROWS);
+
+        constexpr TIME64 begin{ 1760000000000000u };
+        std::vector<areg::LogEntry> entries(static_cast<size_t>(LOG_ROWS));
+        char buffer[128];
+        for (int i = 0; i < LOG_ROWS; ++i)
+        {
+            areg::LogEntry& entry{ entries[static_cast<size_t>(i)] };
+            entry.logMessagePrio = areg::LogPriority::PrioDebug;
+            entry.logTimestamp   = begin + static_cast<TIME64>(i) * 1000u;
+            entry.logReceived    = entry.logTimestamp + 5u;
+            entry.logCookie      = 256u + static_cast<ITEM_ID>(i % 4);
+            std::snprintf(buffer, sizeof(buffer), "Component_%d processed request %d", i % 97, i);
+            setMessage(entry, buffer);
+        }
+
+        // The separators, the quotes and the line breaks of the message are escaped.
+        setMessage(entries[1], "value \"a,b\"\nnext line\t\\");
+
+        QTemporaryDir dir;
+        CHECK(dir.isValid());
+        const QString csvPath{ dir.filePath(QStringLiteral("export.csv")) };
+        const QString jsonPath{ dir.filePath(QStringLiteral("export.ndjson")) };
+        CHECK(LogExportWriter::getFormat(csvPath) == LogExportWriter::eFormat::FormatCsv);
+        CHECK(LogExportWriter::getFormat(jsonPath) == LogExportWriter::eFormat::FormatJson);
+        CHECK(LogExportWriter::getFormat(dir.filePath(QStringLiteral("export.sqlog"))) == LogExportWriter::eFormat::FormatSqlog);
+        CHECK(LogExportWriter::getFormat(dir.filePath(QStringLiteral("export.txt"))) == LogExportWriter::eFormat::FormatInvalid);
+
+        QElapsedTimer timer;
+        timer.start();
+        LogCsvExportWriter csv;
+        CHECK(exportLog(csv, csvPath, entries, true));
+        LogJsonExportWriter json;
+        CHECK(exportLog(json, jsonPath, entries, true));
+        report("log exported to CSV and NDJSON", timer.elapsed(), BUDGET_EXPORT_MS);
+
+        QFile csvFile(csvPath);
+        CHECK(csvFile.open(QIODevice::ReadOnly));
+        const QList<QByteArray> csvLines{ csvFile.readAll().split('\n') };
+        // The header, the rows, the line break of the quoted message and the empty last line.
+        CHECK(csvLines.size() == LOG_ROWS + 3);
+        CHECK(csvLines[0].startsWith("Priority,Timestamp,Received,Duration,Source"));
+        CHECK(csvLines[2].endsWith(",\"value \"\"a,b\"\"") && csvLines[3].startsWith("next line"));
+        CHECK(csvLines[LOG_ROWS + 1].endsWith(QByteArray("processed request ") + QByteArray::number(LOG_ROWS - 1)));
+
+        QFile jsonFile(jsonPath);
+        CHECK(jsonFile.open(QIODevice::ReadOnly));
+        const QList<QByteArray> jsonLines{ jsonFile.readAll().split('\n') };
+        CHECK(jsonLines.size() == LOG_ROWS + 1);
+        CHECK(jsonLines[0].contains("\"timestamp\":1760000000000000,") && jsonLines[0].contains("\"source_id\":256,"));
+        CHECK(jsonLines[1].endsWith("\"message\":\"value \\\"a,b\\\"\\nnext line\\t\\\\\"}"));
+
+        // The canceled export leaves neither the file nor the replaced one.
+        const QString canceledPath{ dir.filePath(QStringLiteral("canceled.csv")) };
+        LogCsvExportWriter canceled;
+        CHECK(exportLog(canceled, canceledPath, entries, false) == false);
+        CHECK(QFile::exists(canceledPath) == false);
+    }
+
+    //!< Returns the path of the scope of the scope tree: 25 modules, 20 classes per module and 50 methods per class.
+    QString makeScopePath(int scope)
+    {
+        return QStringLiteral("service_module%1_class%2.method_%3").arg(scope / 1000).arg((scope / 50) % 20).arg(scope % 50);
+    }
+
+    //!< Returns the priority of all leafs of the node, and clears the flag if a node of the tree has another priority.
+    uint32_t checkLeafPriorities(const ScopeNodeBase& node, bool& valid)
+    {
+        if (node.isLeaf())
+            return node.getPriority();
+
+        uint32_t result{ static_cast<uint32_t>(areg::LogPriority::PrioInvalid) };
+        for (int i = 0; i < node.getChildCount(); ++i)
+        {
+            result |= checkLeafPriorities(*node.getChildAt(i), valid);
+        }
+
+        valid = valid && (node.getPriority() == result);
+        return result;
+    }
+
+    void testScopeTree()
+    {
+        std::printf("[log] scope trees of %d instances, %d scopes\n", SCOPE_INSTANCES, SCOPE_INSTANCES * SCOPES_PER_INSTANCE);
+
+        constexpr uint32_t prioDebug{ static_cast<uint32_t>(areg::LogPriority::PrioDebug) };
+        constexpr uint32_t prioError{ static_cast<uint32_t>(areg::LogPriority::PrioError) };
+
+        std::vector<QString> paths;
+        paths.reserve(SCOPES_PER_INSTANCE);
+        for (int i = 0; i < SCOPES_PER_INSTANCE; ++i)
+        {
+            paths.push_back(makeScopePath(i));
+        }
+
+        std::vector<ScopeRoot*> roots;
+        QElapsedTimer timer;
+        timer.start();
+        for (int inst = 0; inst < SCOPE_INSTANCES; ++inst)
+        {
+            ScopeRoot* root = new ScopeRoot(static_cast<ITEM_ID>(inst + 256), QStringLiteral("instance%1").arg(inst));
+            roots.push_back(root);
+            for (int i = 0; i < SCOPES_PER_INSTANCE; ++i)
+            {
+                QString path(paths[i]);
+                root->addChildRecursive(path, (i % 2) == 0 ? prioDebug : prioError, static_cast<uint32_t>(i + 1));
+            }
+        }
+
+        report("scope trees build", timer.elapsed(), BUDGET_SCOPE_TREE_MS);
+
+        // One root node, 25 modules and 500 classes are shared by the 25000 methods.
+        ScopeRoot& root = *roots.front();
+        CHECK(root.getScopeCount() == SCOPES_PER_INSTANCE);
+        CHECK(root.getAllocatedCount() == static_cast<uint32_t>(SCOPES_PER_INSTANCE + 526));
+        CHECK(root.getChildCount() == 1);
+
+        ScopeLeaf* leaf = root.findLeaf(1235u);
+        CHECK((leaf != nullptr) && (leaf->makePath() == paths[1234]));
+        CHECK(root.findLeaf(static_cast<uint32_t>(SCOPES_PER_INSTANCE + 1)) == nullptr);
+        CHECK(root.findChildByPath(paths[1234]) == leaf);
+
+        // The children are listed in the order of names, the position of a child is found by the name.
+        ScopeNodeBase* service = root.getChildAt(0);
+        CHECK((service != nullptr) && (service->getChildCount() == 25) && (service->getChildNodesCount() == 25));
+        bool ordered{ service != nullptr };
+        for (int i = 0; ordered && (i < service->getChildCount()); ++i)
+        {
+            ScopeNodeBase* child = service->getChildAt(i);
+            ordered = (service->getChildPosition(child->getNodeName()) == i) && ((i == 0) || (service->getChildAt(i - 1)->getNodeName() < child->getNodeName()));
+        }
+
+        CHECK(ordered);
+        ScopeNodeBase* module = (service != nullptr ? service->findChild(QStringLiteral("module1")) : nullptr);
+        ScopeNodeBase* other  = (service != nullptr ? service->findChild(QStringLiteral("module2")) : nullptr);
+        CHECK((module != nullptr) && (other != nullptr) && (module->getChildCount() == 20));
+        ScopeNodeBase* method = (module != nullptr ? module->findChild(QStringLiteral("class3")) : nullptr);
+        CHECK((method != nullptr) && (method->getChildLeafsCount() == 50));
+        CHECK((method != nullptr) && (method->getChildAt(method->getChildPosition(QStringLiteral("method_7")))->getNodeName() == QStringLiteral("method_7")));
+
+        // The equal names of the nodes of the tree share the same data.
+        ScopeNodeBase* sameName = (other != nullptr ? other->findChild(QStringLiteral("class3")) : nullptr);
+        CHECK((sameName != nullptr) && (method != nullptr) && (sameName != method));
+        CHECK((sameName != nullptr) && (method != nullptr) && (sameName->getNodeName().constData() == method->getNodeName().constData()));
+
+        // The child nodes are shown at once, the leafs are fetched by pages. The row of a child is found by its list.
+        constexpr int pageSize{ 256 };
+        ScopeRoot wide(static_cast<ITEM_ID>(1024), QStringLiteral("wide"));
+        for (int i = 0; i < SCOPES_PER_BUILD; ++i)
+        {
+            QString path(QStringLiteral("wide.method_%1").arg(i, 5, 10, QChar('0')));
+            wide.addChildRecursive(path, prioDebug, static_cast<uint32_t>(i + 1));
+        }
+
+        QString subPath(QStringLiteral("wide_sub.method"));
+        wide.addChildRecursive(subPath, prioDebug, static_cast<uint32_t>(SCOPES_PER_BUILD + 1));
+        ScopeNodeBase* wideNode = wide.findChild(QStringLiteral("wide"));
+        CHECK((wideNode != nullptr) && (wideNode->getChildCount() == SCOPES_PER_BUILD + 1) && (wideNode->getFetchedCount() == 1));
+        int pages{ 0 };
+        while ((wideNode != nullptr) && (wideNode->getFetchedCount() < wideNode->getChildCount()))
+        {
+            pages += (wideNode->fetchChildren(pageSize) != 0 ? 1 : 0);
+        }
+
+        CHECK(pages == (SCOPES_PER_BUILD + pageSize - 1) / pageSize);
+        CHECK((wideNode != nullptr) && (wideNode->getFetchedCount() == wideNode->getChildCount()) && (wideNode->fetchChildren(pageSize) == 0));
+        bool rows{ wideNode != nullptr };
+        for (int i = 0; rows && (i < wideNode->getChildCount()); ++i)
+        {
+            rows = (wideNode->getChildRow(*wideNode->getChildAt(i)) == i);
+        }
+
+        CHECK(rows);
+
+        // A leaf reported later among the fetched leafs takes its row at once, the shown rows stay shown.
+        ScopeNode* wideScope = static_cast<ScopeNode*>(wideNode);
+        const int insertRow{ wideScope != nullptr ? wideScope->getInsertRow(QStringLiteral("method_00000a"), false) : -1 };
+        QString latePath(QStringLiteral("wide.method_00000a"));
+        wide.addChildRecursive(latePath, prioDebug, static_cast<uint32_t>(SCOPES_PER_BUILD + 2));
+        CHECK((wideNode != nullptr) && (insertRow == 2) && (wideNode->getChildAt(insertRow) == wide.findLeaf(static_cast<uint32_t>(SCOPES_PER_BUILD + 2))));
+        CHECK((wideNode != nullptr) && (wideNode->getFetchedCount() == wideNode->getChildCount()));
+        CHECK((wideScope != nullptr) && (wideScope->getInsertRow(QStringLiteral("method_00000a"), false) == static_cast<int>(areg::INVALID_INDEX)));
+        CHECK((wideNode != nullptr) && (method != nullptr) && (wideNode->getChildRow(*method) == static_cast<int>(areg::INVALID_INDEX)));
+        wide.setNodeTreeExpanded();
+        CHECK((wideNode != nullptr) && wideNode->getChildAt(SCOPES_PER_BUILD)->isNodeExpanded());
+        wide.setNodeState(false);
+        CHECK((wideNode != nullptr) && (wideNode->isNodeExpanded() == false) && (wideNode->getChildAt(SCOPES_PER_BUILD)->isNodeExpanded() == false));
+
+        // The traffic of a leaf is counted by the parent nodes up to the instance.
+        ScopeLeaf* busy{ wide.findLeaf(1u) };
+        ScopeLeaf* quiet{ wide.findLeaf(2u) };
+        const TIME64 second{ ScopeTraffic::MICROSECONDS };
+        const TIME64 start{ 1000u * second };
+        CHECK((busy != nullptr) && (quiet != nullptr));
+        for (uint32_t i = 0u; (busy != nullptr) && (quiet != nullptr) && (i < 10u); ++i)
+        {
+            busy->countTraffic(16u, start + i * (second / 10u));
+        }
+
+        if (quiet != nullptr)
+        {
+            quiet->countTraffic(32u, start + second);
+        }
+
+        const ScopeTraffic& busyTraffic{ busy != nullptr ? busy->getTraffic() : wide.getTraffic() };
+        const ScopeTraffic& rootTraffic{ wide.getTraffic() };
+        CHECK((busyTraffic.getMessages() == 10u) && (busyTraffic.getBytes() == 160u));
+        CHECK((wideNode != nullptr) && (wideNode->getTraffic().getMessages() == 11u));
+        CHECK((rootTraffic.getMessages() == 11u) && (rootTraffic.getBytes() == 192u) && (rootTraffic.getLastSeen() == start + second));
+        CHECK((busyTraffic.getRate(start + second) == 10.0) && (busyTraffic.getRate(start + 3u * second) == 0.0));
+        CHECK((rootTraffic.getRate(start + second) == 10.0) && (rootTraffic.getRate(start + 2u * second) == 1.0));
+        CHECK((busyTraffic.getRate(0u) == 10.0) && (rootTraffic.getRate(0u) == 11.0));
+        wide.resetTrafficRecursive();
+        CHECK((rootTraffic.getMessages() == 0u) && (busyTraffic.getMessages() == 0u) && (busyTraffic.getRate(0u) == 0.0));
+
+        // The scopes added again update the existing leafs.
+        QString again(paths[1234]);
+        CHECK(root.addChildRecursive(again, prioError, 1235u) == 4);
+        CHECK(root.getAllocatedCount() == static_cast<uint32_t>(SCOPES_PER_INSTANCE + 526));
+        CHECK((leaf != nullptr) && (leaf->getPriority() == prioError));
+
+        // The priorities of the nodes are the priorities of their leafs, the change of one leaf updates its path.
+        bool consistent{ true };
+        checkLeafPriorities(root, consistent);
+        CHECK(consistent);
+        CHECK(root.getLeafCount(areg::LogPriority::PrioDebug) + root.getLeafCount(areg::LogPriority::PrioError) == static_cast<uint32_t>(SCOPES_PER_INSTANCE));
+
+        timer.restart();
+        for (int i = 0; i < SCOPE_TOGGLES; ++i)
+        {
+            ScopeLeaf* changed = roots[i % SCOPE_INSTANCES]->findLeaf(static_cast<uint32_t>(((i % SCOPES_PER_INSTANCE) * 7919) % SCOPES_PER_INSTANCE + 1));
+            changed->setPriority((i / SCOPE_INSTANCES) % 3 == 0 ? prioError : prioDebug);
+        }
+
+        report("scope priority toggles", timer.elapsed(), BUDGET_SCOPE_TOGGLES_MS);
+        for (ScopeRoot* entry : roots)
+        {
+            checkLeafPriorities(*entry, consistent);
+        }
+
+        CHECK(consistent);
+        CHECK(root.getPriority() == (prioDebug | prioError));
+        CHECK(root.getLeafCount(areg::LogPriority::PrioDebug) + root.getLeafCount(areg::LogPriority::PrioError) == static_cast<uint32_t>(SCOPES_PER_INSTANCE));
+
+        // Counting again gives the same priorities.
+        const uint32_t debugCount{ root.getLeafCount(areg::LogPriority::PrioDebug) };
+        root.refreshPrioritiesRecursive();
+        CHECK(root.getLeafCount(areg::LogPriority::PrioDebug) == debugCount);
+        checkLeafPriorities(root, consistent);
+        CHECK(consistent);
+
+        // The first class has only debug leafs, the module of the class has other classes with errors.
+        ScopeRoot& last = *roots.back();
+        for (uint32_t id = 1u; id <= 50u; ++id)
+        {
+            last.findLeaf(id)->setPriority(prioDebug);
+        }
+
+        ScopeNodeBase* lastClass = last.findLeaf(1u)->getParent();
+        CHECK(lastClass->getPriority() == prioDebug);
+        ScopeNodeBase* lastModule = lastClass->getParent();
+        CHECK(lastModule->getPriority() == (prioDebug | prioError));
+        lastModule->setPriority(prioDebug);
+        CHECK(lastModule->getPriority() == prioDebug);
+        CHECK(last.getPriority() == (prioDebug | prioError));
+
+        // The last error leaf of the class removes the error from the path.
+        last.findLeaf(2u)->setPriority(prioError);
+        CHECK((lastClass->getPriority() == (prioDebug | prioError)) && (lastModule->getPriority() == (prioDebug | prioError)));
+        last.findLeaf(2u)->setPriority(prioDebug);
+        CHECK((lastClass->getPriority() == prioDebug) && (lastModule->getPriority() == prioDebug));
+
+        // The change of the whole tree of every instance is one wildcard scope per instance.
+        ScopePrioTransaction transaction;
+        ScopePrioTransaction::ListScopes scopes;
+        uint32_t requests{ 0u };
+        timer.restart();
+        for (ScopeRoot* entry : roots)
+        {
+            transaction.beginChange(*entry);
+            entry->setPriority(prioError);
+        }
+
+        for (ScopeRoot* entry : roots)
+        {
+            requests += (transaction.commit(*entry, scopes) == 1u) && (std::strcmp(scopes.front().lsName, "*") == 0) ? 1u : 0u;
+        }
+
+        report("scope priority requests", timer.elapsed(), BUDGET_SCOPE_REQUESTS_MS);
+        CHECK(requests == static_cast<uint32_t>(SCOPE_INSTANCES));
+        CHECK(transaction.isEmpty());
+
+        // The uniform node is sent as a wildcard, the changed leafs of the mixed node one by one.
+        transaction.beginChange(*lastModule);
+        lastModule->setPriority(prioDebug);
+        CHECK((transaction.commit(last, scopes) == 1u) && (std::strcmp(scopes.front().lsName, "service_module0_*") == 0));
+        CHECK(scopes.front().lsPrio == prioDebug);
+
+        transaction.beginChange(*last.findLeaf(1u));
+        last.findLeaf(1u)->setPriority(prioError);
+        transaction.beginChange(*last.findLeaf(3u));
+        last.findLeaf(3u)->setPriority(prioError);
+        CHECK(transaction.commit(last, scopes) == 2u);
+        CHECK((std::strcmp(scopes[0].lsName, "service_module0_class0.method_0") == 0) || (std::strcmp(scopes[1].lsName, "service_module0_class0.method_0") == 0));
+        CHECK((std::strcmp(scopes[0].lsName, "service_module0_class0.method_2") == 0) || (std::strcmp(scopes[1].lsName, "service_module0_class0.method_2") == 0));
+
+        // The change and its undo are not sent.
+        transaction.beginChange(*last.findLeaf(1u));
+        last.findLeaf(1u)->setPriority(prioDebug);
+        transaction.beginChange(*lastClass);
+        last.findLeaf(1u)->setPriority(prioError);
+        CHECK(transaction.commit(last, scopes) == 0u);
+        CHECK(transaction.hasChanges(last.getRootId()) == false);
+
+        // Inside of the changed module the uniform class is compressed, the leaf of another class is not.
+        transaction.beginChange(*lastModule);
+        lastClass->setPriority(prioDebug);
+        last.findLeaf(51u)->setPriority(prioError);
+        CHECK(transaction.commit(last, scopes) == 2u);
+        CHECK((std::strcmp(scopes[0].lsName, "service_module0_class0_*") == 0) || (std::strcmp(scopes[1].lsName, "service_module0_class0_*") == 0));
+        CHECK((std::strcmp(scopes[0].lsName, "service_module0_class1.method_0") == 0) || (std::strcmp(scopes[1].lsName, "service_module0_class1.method_0") == 0));
+
+        for (ScopeRoot* entry : roots)
+        {
+            delete entry;
+        }
+    }
+
+    void testScopeTreeBuilder()
+    {
+        std::printf("[log] scope trees of %d instances, %d scopes built in the worker threads\n", BUILD_INSTANCES, BUILD_INSTANCES * SCOPES_PER_BUILD);
+
+        constexpr uint32_t prioScopeLogs{ static_cast<uint32_t>(areg::LogPriority::PrioScopeLogs) };
+        std::vector<areg::ScopeEntry> scopes(static_cast<size_t>(SCOPES_PER_BUILD));
+        for (int i = 0; i < SCOPES_PER_BUILD; ++i)
+        {
+            scopes[i].scopeName = makeScopePath(i).toStdString().c_str();
+            scopes[i].scopeId   = static_cast<uint32_t>(i + 1);
+            scopes[i].scopePrio = static_cast<uint32_t>(areg::LogPriority::PrioDebug);
+        }
+
+        auto makeTrees = [&scopes]() -> ScopeTreeBuilder::ListTrees
+            {
+                ScopeTreeBuilder::ListTrees trees(static_cast<size_t>(BUILD_INSTANCES));
+                for (int inst = 0; inst < BUILD_INSTANCES; ++inst)
+                {
+                    trees[inst].instance.ciCookie = static_cast<ITEM_ID>(inst + 256);
+                    trees[inst].scopes = scopes;
+                }
+
+                return trees;
+            };
+
+        // The trees are delivered once, when all of them are built.
+        ScopeTreeBuilder builder;
+        ScopeTreeBuilder::ListTrees built;
+        std::atomic<int> delivered{ 0 };
+        auto callback = [&built, &delivered](ScopeTreeBuilder::ListTrees& trees)
+            {
+                built = std::move(trees);
+                ++delivered;
+            };
+
+        ScopeTreeBuilder::ListTrees trees{ makeTrees() };
+        QElapsedTimer timer;
+        timer.start();
+        CHECK(builder.start(std::string(), std::move(trees), prioScopeLogs, callback));
+        builder.wait();
+        report("scope trees built in worker threads", timer.elapsed(), BUDGET_SCOPE_BUILDER_MS);
+
+        CHECK(delivered == 1);
+        CHECK(builder.isBuilding() == false);
+        CHECK(built.size() == static_cast<size_t>(BUILD_INSTANCES));
+        bool complete{ built.size() == static_cast<size_t>(BUILD_INSTANCES) };
+        for (int inst = 0; complete && (inst < BUILD_INSTANCES); ++inst)
+        {
+            const ScopeRoot* root = built[inst].root.get();
+            complete = (root != nullptr) && (root->getRootId() == static_cast<ITEM_ID>(inst + 256))
+                    && (root->getScopeCount() == SCOPES_PER_BUILD) && (root->getPriority() == prioScopeLogs);
+        }
+
+        CHECK(complete);
+        CHECK((complete) && (built.back().root->findLeaf(1235u)->makePath() == makeScopePath(1234)));
+
+        // The canceled build does not deliver the trees.
+        CHECK(builder.start(std::string(), makeTrees(), 0u, callback));
+        builder.cancel();
+        CHECK(delivered == 1);
+        CHECK(builder.isBuilding() == false);
+        CHECK(builder.start(std::string(), ScopeTreeBuilder::ListTrees{}, 0u, callback) == false);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Log rows painter: pages of one million rows scrolled and jumped
+    //////////////////////////////////////////////////////////////////////////
+
+    //!< Paints one page of the log starting at the row, returns the number of painted rows.
+    int paintPage(QPainter& painter, const LogTextHighlight& delegate, const PaintLogModel& model, QStyleOptionViewItem& option, int firstRow)
+    {
+        const int rowHeight{ option.rect.height() };
+        const int columns[]{ 0, 190, 270, PAINT_WIDTH };
+        int rows{ 0 };
+        painter.fillRect(0, 0, PAINT_WIDTH, PAINT_HEIGHT, Qt::white);
+        for (int y = 0, row = firstRow; (y < PAINT_HEIGHT) && (row < model.rowCount()); y += rowHeight, ++row, ++rows)
+        {
+            for (int col = 0; col < 3; ++col)
+            {
+                option.rect = QRect(columns[col], y, columns[col + 1] - columns[col], rowHeight);
+                delegate.paint(&painter, option, model.index(row, col));
+            }
+        }
+
+        return rows;
+    }
+
+    void testRowPainter()
+    {
+        std::printf("[log] row painter, %d rows, %d x %d page\n", PAINT_ROWS, PAINT_WIDTH, PAINT_HEIGHT);
+
+        PaintLogModel model(PAINT_ROWS);
+        LogSearchModel::sFoundPos found{};
+        LogTextHighlight delegate(found);
+
+        QImage image(PAINT_WIDTH, PAINT_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+        QPainter painter(&image);
+        QStyleOptionViewItem option;
+        option.font     = QApplication::font();
+        option.palette  = QApplication::palette();
+        option.state    = QStyle::State_Enabled | QStyle::State_Active;
+        option.rect     = QRect(0, 0, PAINT_WIDTH, LogTextHighlight::rowHeight(option.font));
+        const int pageRows{ (PAINT_HEIGHT + option.rect.height() - 1) / option.rect.height() };
+
+        // Scrolling: most rows of the page are painted with the cached texts.
+        QElapsedTimer timer;
+        int painted{ 0 };
+        timer.start();
+        for (int frame = 0; frame < PAINT_SCROLL_FRAMES; ++frame)
+        {
+            painted += paintPage(painter, delegate, model, option, frame * PAINT_SCROLL_STEP);
+        }
+
+        report("pages scrolled", timer.elapsed(), PAINT_SCROLL_FRAMES * BUDGET_FRAME_MS);
+        CHECK(painted == PAINT_SCROLL_FRAMES * pageRows);
+        CHECK(delegate.getCachedCells() <= LogTextHighlight::MAX_CACHED_CELLS);
+
+        // Jumping over the whole log: every page is painted with the texts prepared again.
+        timer.start();
+        for (int frame = 0; frame < PAINT_JUMP_FRAMES; ++frame)
+        {
+            paintPage(painter, delegate, model, option, static_cast<int>((static_cast<qint64>(frame) * 7919 * pageRows) % (PAINT_ROWS - pageRows)));
+        }
+
+        report("pages jumped over the log", timer.elapsed(), PAINT_JUMP_FRAMES * BUDGET_FRAME_MS);
+        CHECK(delegate.getCachedCells() <= LogTextHighlight::MAX_CACHED_CELLS);
+
+        // The found phrase in the message of the last row is highlighted.
+        const int lastRow{ PAINT_ROWS - pageRows };
+        found.rowFound = static_cast<uint32_t>(PAINT_ROWS - 1);
+        found.colFound = 2;
+        found.posStart = 0;
+        found.posEnd   = 9;
+        CHECK(paintPage(painter, delegate, model, option, lastRow) == pageRows);
+        painter.end();
+
+        const QRgb yellow{ QColor(Qt::yellow).rgb() };
+        const int top{ (pageRows - 1) * option.rect.height() };
+        int highlighted{ 0 };
+        for (int y = top; y < std::min(top + option.rect.height(), PAINT_HEIGHT); ++y)
+        {
+            for (int x = 270; x < PAINT_WIDTH; ++x)
+            {
+                highlighted += (image.pixel(x, y) == yellow) ? 1 : 0;
+            }
+        }
+
+        CHECK(highlighted > 0);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// main
+//////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
+{
+    QApplication app(argc, argv);
+    std::printf("==== Log viewer performance gate ====\n");
+
+    testSearch();
+    testSessionIndex();
+    testCallTree();
+    testLatency();
+    testTimeline();
+    testIngestTelemetry();
+    testExportWriter();
+    testScopeTree();
+    testScopeTreeBuilder();
+    testRowPainter();
+
+    std::printf("---- %d checks, %d failure(s) ----\n", gChecks, gFailures);
+    return (gFailures == 0) ? 0 : 1;
+}
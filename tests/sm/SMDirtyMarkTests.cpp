@@ -28,22 +28,38 @@
  *                    back on the next change, goes away on undoing back to that point, and
  *                    comes back on undoing past it.
  *
+ *               And that the autosave takes what the document reports: edits announced by the
+ *               notifier after the first autosave snapshot reach the journal, and recovering the
+ *               autosave gives the edited document back.
+ *
+ *               And that a save written on the save thread counts only once it is on disk: the
+ *               document stays dirty while it is written, stays dirty with its autosave when the
+ *               write fails or an edit came meanwhile, and is clean without one after it.
+ *
  *               Run as: lusan_sm_dirty_mark <TrafficLight.fsml>
  *
  ************************************************************************/
 
+#include "lusan/data/sm/SMAutosaveJournal.hpp"
+#include "lusan/data/sm/SMLayoutData.hpp"
 #include "lusan/data/sm/SMState.hpp"
 #include "lusan/data/sm/StateMachineData.hpp"
+#include "lusan/model/common/DocModelNotifier.hpp"
 #include "lusan/model/sm/SMSelectionModel.hpp"
+#include "lusan/model/sm/SMStateCommands.hpp"
 #include "lusan/model/sm/StateMachineModel.hpp"
 #include "lusan/view/common/PendingEditWatcher.hpp"
 #include "lusan/view/sm/SMPropertiesPanel.hpp"
 
 #include <QApplication>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
 #include <QKeyEvent>
 #include <QLineEdit>
 #include <QPlainTextEdit>
+#include <QThread>
 #include <QVBoxLayout>
 #include <QWidget>
 
@@ -231,6 +247,141 @@ namespace
     }
 }
 
+namespace
+{
+    void testAutosaveFollowsNotifier(const QString& documentPath, const QString& workPath)
+    {
+        // Autosaves are written beside the document, so the document is a copy.
+        StateMachineData::removeAutosave(workPath);
+        QFile::remove(workPath);
+        CHECK(QFile::copy(documentPath, workPath));
+
+        StateMachineModel model;
+        if (model.loadFromFile(workPath) == false)
+        {
+            std::printf("  [FAIL] cannot read %s\n", qPrintable(workPath));
+            ++gFailures;
+            return;
+        }
+
+        StateMachineData& data = model.getData();
+        const uint32_t stateId = firstStateId(data);
+        CHECK(stateId != 0);
+        if (stateId == 0)
+        {
+            return;
+        }
+
+        // The first autosave after opening is a snapshot, written on the save thread.
+        model.getUndoStack().push(new SMRenameStateCommand(data, model.getNotifier(), stateId, QStringLiteral("Snapshotted"), QStringLiteral("Rename")));
+        CHECK(model.writeAutosave());
+
+        // The edits after it are known to the autosave only by what the notifier reports.
+        data.getOverview().setDescription(QStringLiteral("Journaled description"));
+        model.getNotifier().notifyElementChanged(data.getOverview().getId(), eDocElementKind::Overview);
+        SMLayoutNode* node = data.getLayout().findNode(stateId);
+        CHECK(node != nullptr);
+        if (node != nullptr)
+        {
+            node->x += 40.0;
+            model.getNotifier().notifyLayoutChanged(QList<uint32_t>{ stateId });
+        }
+
+        model.getUndoStack().push(new SMRenameStateCommand(data, model.getNotifier(), stateId, QStringLiteral("Journaled"), QStringLiteral("Rename")));
+
+        // The changes wait while the snapshot is written, and are appended to the journal after.
+        const QString journalPath = SMAutosaveJournal::journalPathForDocument(workPath);
+        qint64 headerSize{ -1 };
+        bool appended{ false };
+        QElapsedTimer wait;
+        wait.start();
+        while ((appended == false) && (wait.elapsed() < 3000))
+        {
+            QApplication::processEvents();
+            if ((headerSize < 0) && QFile::exists(journalPath))
+            {
+                headerSize = QFileInfo(journalPath).size();
+            }
+
+            if (headerSize >= 0)
+            {
+                model.writeAutosave();
+                appended = (QFileInfo(journalPath).size() > headerSize);
+            }
+
+            QThread::msleep(10);
+        }
+
+        CHECK(appended);
+        CHECK(StateMachineData::recoverAutosave(workPath));
+        StateMachineData recovered;
+        CHECK(recovered.readFromFile(StateMachineData::autosavePathForDocument(workPath)));
+        CHECK(recovered.writeToBuffer() == data.writeToBuffer());
+
+        StateMachineData::removeAutosave(workPath);
+        QFile::remove(workPath);
+    }
+}
+
+namespace
+{
+    void testBackgroundSaveOutcome(const QString& documentPath, const QString& workPath, const QString& badPath)
+    {
+        StateMachineData::removeAutosave(workPath);
+        QFile::remove(workPath);
+        CHECK(QFile::copy(documentPath, workPath));
+
+        StateMachineModel model;
+        if (model.loadFromFile(workPath) == false)
+        {
+            std::printf("  [FAIL] cannot read %s\n", qPrintable(workPath));
+            ++gFailures;
+            return;
+        }
+
+        StateMachineData& data = model.getData();
+        const uint32_t stateId = firstStateId(data);
+        CHECK(stateId != 0);
+        if (stateId == 0)
+        {
+            return;
+        }
+
+        const QString autosavePath = StateMachineData::autosavePathForDocument(workPath);
+        model.getUndoStack().push(new SMRenameStateCommand(data, model.getNotifier(), stateId, QStringLiteral("Autosaved"), QStringLiteral("Rename")));
+        CHECK(model.writeAutosave());
+        model.finishSaves();
+        CHECK(QFile::exists(autosavePath));
+
+        // A write that fails leaves the document dirty, and the autosave as the copy of its edits.
+        CHECK(model.saveInBackground(badPath));
+        CHECK(model.isDirty());
+        CHECK(model.finishSaves() == false);
+        CHECK(model.isDirty());
+        CHECK(QFile::exists(autosavePath));
+
+        // An edit made while the file is written is not in the file.
+        CHECK(model.saveInBackground(workPath));
+        model.getUndoStack().push(new SMRenameStateCommand(data, model.getNotifier(), stateId, QStringLiteral("Meanwhile"), QStringLiteral("Rename")));
+        CHECK(model.finishSaves() == false);
+        CHECK(model.isDirty());
+
+        // A write that succeeds with nothing edited meanwhile is the save point.
+        CHECK(model.saveInBackground(workPath));
+        CHECK(model.isDirty());
+        CHECK(model.finishSaves());
+        CHECK(model.isDirty() == false);
+        CHECK(QFile::exists(autosavePath) == false);
+
+        StateMachineData saved;
+        CHECK(saved.readFromFile(workPath));
+        CHECK(saved.writeToBuffer() == data.writeToBuffer());
+
+        StateMachineData::removeAutosave(workPath);
+        QFile::remove(workPath);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Entry point
 //////////////////////////////////////////////////////////////////////////
@@ -256,6 +407,14 @@ int main(int argc, char* argv[])
     testDirtyMarkFollowsTypingAndSavePoint(documentPath, savePath);
     QFile::remove(savePath);
 
+    std::printf("=== the autosave journals what the notifier reports ===\n");
+    testAutosaveFollowsNotifier(documentPath, outDir + QDir::separator() + QStringLiteral("autosave-journal.fsml"));
+
+    std::printf("=== a background save counts once it is on disk ===\n");
+    testBackgroundSaveOutcome(documentPath
+                            , outDir + QDir::separator() + QStringLiteral("background-save.fsml")
+                            , outDir + QDir::separator() + QStringLiteral("no-such-dir") + QDir::separator() + QStringLiteral("background-save.fsml"));
+
     std::printf("=== %d checks, %d failure(s) ===\n", gChecks, gFailures);
     return (gFailures == 0) ? 0 : 1;
 }
@@ -24,12 +24,18 @@
  *
  ************************************************************************/
 
+#include "lusan/data/common/DocFileWatcher.hpp"
+#include "lusan/data/common/IncludeEntry.hpp"
+#include "lusan/data/common/MethodDataSection.hpp"
+#include "lusan/data/sm/SMDocumentCache.hpp"
+#include "lusan/data/sm/SMImportResolver.hpp"
 #include "lusan/data/sm/SMLayoutData.hpp"
 #include "lusan/data/sm/SMMethodKind.hpp"
 #include "lusan/data/sm/SMState.hpp"
 #include "lusan/data/sm/SMTransition.hpp"
 #include "lusan/data/sm/StateMachineData.hpp"
 #include "lusan/model/common/DocModelNotifier.hpp"
+#include "lusan/model/common/DocUnknownScan.hpp"
 #include "lusan/model/sm/SMLayoutCommands.hpp"
 #include "lusan/model/sm/SMSelectionModel.hpp"
 #include "lusan/model/sm/SMStateCommands.hpp"
@@ -45,13 +51,18 @@
 #include <QDir>
 #include <QElapsedTimer>
 #include <QEvent>
+#include <QFile>
 #include <QScrollBar>
+#include <QThread>
 #include <QUndoStack>
+#include <QXmlStreamWriter>
 
 #include <cstdio>
 #include <algorithm>
 #include <functional>
 #include <limits>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -70,6 +81,13 @@ namespace
     constexpr int DEEP_STATES       { 50  };
     //!< The small document the large one is compared against.
     constexpr int SMALL_STATES      { 10  };
+    //!< Shape of the ID lookup document: 5,000 states, a root level of 100 states and 49
+    //!< composites with 100 states each.
+    constexpr int INDEX_ROOT_STATES     { 100 };
+    constexpr int INDEX_COMPOSITES      { 49  };
+    constexpr int INDEX_NESTED_STATES   { 100 };
+    //!< Entries of the registry the container lookups are measured on.
+    constexpr int REGISTRY_ENTRIES      { 3000 };
 
     int gChecks = 0;
     int gFailures = 0;
@@ -384,6 +402,50 @@ namespace
         return timings;
     }
 
+    //!< Builds the ID lookup document; no layout is needed, nothing is painted.
+    std::unique_ptr<StateMachineData> buildIndexDocument()
+    {
+        std::unique_ptr<StateMachineData> doc = StateMachineData::createNewDocument(QStringLiteral("IndexMachine"));
+        if (doc == nullptr)
+        {
+            return doc;
+        }
+
+        doc->getStates().removeAll();
+        doc->getMethods().createMethod(QStringLiteral("Step"), NEMethod::SmTrigger);
+        fillLevel(*doc, doc->getStates(), QStringLiteral("Root"), INDEX_ROOT_STATES);
+
+        const QList<SMStateEntry*> rootStates = doc->getStates().getElements();
+        for (int c = 0; (c < INDEX_COMPOSITES) && (c + 1 < rootStates.size()); ++c)
+        {
+            SMStateData* nested = rootStates.at(c + 1)->getOrCreateNestedStates();
+            if (nested != nullptr)
+            {
+                fillLevel(*doc, *nested, QStringLiteral("N%1_").arg(c), INDEX_NESTED_STATES);
+            }
+        }
+
+        return doc;
+    }
+
+    //!< Collects the IDs of every state and every transition, depth first.
+    void collectIds(const SMStateData& level, QList<uint32_t>& states, QList<uint32_t>& transitions)
+    {
+        for (const SMStateEntry* state : level.getElements())
+        {
+            states.append(state->getId());
+            for (const SMTransitionEntry* transition : state->getTransitions().getElements())
+            {
+                transitions.append(transition->getId());
+            }
+
+            if (state->hasNestedStates())
+            {
+                collectIds(*state->getNestedStates(), states, transitions);
+            }
+        }
+    }
+
     int countStates(const SMStateData& level)
     {
         int total = 0;
@@ -607,6 +669,420 @@ int main(int argc, char* argv[])
 
     check(scene.items().isEmpty() == false, "the root scene holds items");
 
+    // ---- document-wide ID lookups ------------------------------------------------------------
+    // The canvas, the validator and the commands resolve IDs in loops, so one lookup must not
+    // cost a walk of the whole tree. Every state, transition and level of a 5,000-state document
+    // is resolved once; the batch is one interaction.
+    {
+        std::unique_ptr<StateMachineData> indexDoc = buildIndexDocument();
+        check(indexDoc != nullptr, "ID lookup document built");
+        if (indexDoc != nullptr)
+        {
+            QList<uint32_t> stateIds;
+            QList<uint32_t> transitionIds;
+            collectIds(indexDoc->getStates(), stateIds, transitionIds);
+            std::printf("  ID lookup document: %d states, %d transitions\n",
+                        static_cast<int>(stateIds.size()), static_cast<int>(transitionIds.size()));
+            check(stateIds.size() == 5000, "ID lookup document has 5,000 states");
+
+            timer.restart();
+            check(indexDoc->getStateCount() == stateIds.size(), "the index counts every state");
+            report("build the ID index (5,000 states)", timer.elapsed(), BUDGET_INTERACTION_MS);
+
+            int mismatches = 0;
+            timer.restart();
+            for (uint32_t id : stateIds)
+            {
+                const SMStateEntry* state = indexDoc->findStateById(id);
+                if ((state == nullptr) || (state->getId() != id) || (indexDoc->getStateLevel(id) == 0u))
+                {
+                    ++mismatches;
+                }
+
+                if ((state != nullptr) && state->hasNestedStates())
+                {
+                    if ((indexDoc->findLevel(id) != state->getNestedStates()) || (indexDoc->getLevelPath(id).size() != 2))
+                    {
+                        ++mismatches;
+                    }
+                }
+            }
+
+            for (uint32_t id : transitionIds)
+            {
+                const SMTransitionEntry* transition = indexDoc->findTransitionById(id);
+                if ((transition == nullptr) || (transition->getId() != id) || (indexDoc->findTransitionOwner(id) == nullptr))
+                {
+                    ++mismatches;
+                }
+            }
+
+            report("resolve every state, transition and level ID", timer.elapsed(), BUDGET_INTERACTION_MS);
+            check(mismatches == 0, "every ID resolves to its own element");
+
+            // An edit outside the undo stack must be seen by the next lookup as well.
+            const SMStateEntry* lastComposite = indexDoc->getStates().getElements().value(INDEX_COMPOSITES, nullptr);
+            SMStateData* lastLevel = (lastComposite != nullptr) ? indexDoc->findLevel(lastComposite->getId()) : nullptr;
+            SMStateEntry* added = (lastLevel != nullptr) ? lastLevel->createState(QStringLiteral("AddedLate"), SMStateEntry::eStateKind::Normal) : nullptr;
+            check((added != nullptr) && (indexDoc->findStateById(added->getId()) == added), "an added state is found at once");
+            if (added != nullptr)
+            {
+                const uint32_t addedId = added->getId();
+                SMStateEntry* removed = nullptr;
+                check(lastLevel->removeElement(addedId, &removed) && (indexDoc->findStateById(addedId) == nullptr),
+                      "a removed state is not found any more");
+                delete removed;
+            }
+
+            // The tree generation belongs to the document: an edit of another document leaves
+            // this index built, an edit of this one moves it.
+            std::unique_ptr<StateMachineData> otherDoc = StateMachineData::createNewDocument(QStringLiteral("OtherMachine"));
+            const uint32_t generation = indexDoc->getTreeGeneration();
+            check((otherDoc != nullptr) && (otherDoc->getStates().createState(QStringLiteral("Elsewhere"), SMStateEntry::eStateKind::Normal) != nullptr),
+                  "a state is added to another document");
+            check(indexDoc->getTreeGeneration() == generation, "another document's edit leaves the tree generation");
+            if (lastLevel != nullptr)
+            {
+                SMStateEntry* nested = lastLevel->createState(QStringLiteral("AddedNested"), SMStateEntry::eStateKind::Normal);
+                check((nested != nullptr) && (indexDoc->getTreeGeneration() != generation), "a nested level edit moves the document's tree generation");
+                SMStateEntry* removed = nullptr;
+                if ((nested != nullptr) && lastLevel->removeElement(nested->getId(), &removed))
+                {
+                    delete removed;
+                }
+            }
+
+            // An ID set on the transition itself is seen as well: the stale entry is not trusted.
+            SMTransitionEntry* renumbered = transitionIds.isEmpty() ? nullptr : indexDoc->findTransitionById(transitionIds.front());
+            if (renumbered != nullptr)
+            {
+                const uint32_t oldId = renumbered->getId();
+                const uint32_t newId = indexDoc->getNextId();
+                renumbered->setId(newId);
+                check(indexDoc->findTransitionOwner(oldId) == nullptr, "a renumbered transition is not found by its old ID");
+                check(indexDoc->findTransitionById(newId) == renumbered, "a renumbered transition is found by its new ID");
+            }
+        }
+    }
+
+    // Opening a machine parses the file twice: once to build the model and once more, token by
+    // token, to find the elements the format does not define. The open of a 5,000-state file is
+    // timed with the second pass in it, the second pass is timed on its own to show its share,
+    // and a block planted in the file must be found with its place and text.
+    {
+        std::unique_ptr<StateMachineData> openDoc = buildIndexDocument();
+        const QString openPath = outDir + QDir::separator() + QStringLiteral("sm27_open.fsml");
+        check((openDoc != nullptr) && openDoc->writeToFile(openPath), "open-time document saved");
+        openDoc.reset();
+
+        QFile file(openPath);
+        QByteArray content;
+        if (file.open(QIODevice::ReadOnly))
+        {
+            content = file.readAll();
+            file.close();
+        }
+
+        StateMachineData opened;
+        timer.restart();
+        check(opened.readFromFile(openPath), "open-time document opened");
+        const qint64 openTime = timer.elapsed();
+
+        timer.restart();
+        const QList<DocUnknownElement> clean = DocUnknownScan::scan(DocElementTable::eDocument::StateMachine, content);
+        const qint64 scanTime = timer.elapsed();
+        check(clean.isEmpty(), "a generated document has no unknown elements");
+
+        std::printf("  open-time document: %lld KB, open %lld ms, of it the unknown-element pass %lld ms\n"
+                    , static_cast<long long>(content.size() / 1024), static_cast<long long>(openTime), static_cast<long long>(scanTime));
+        report("open a 5,000-state document", openTime, BUDGET_ONESHOT_MS);
+
+        QByteArray planted = content;
+        const qsizetype at = planted.indexOf("</StateList>");
+        planted.insert(at < 0 ? 0 : at, "<FutureThing Mode=\"loud\"><Part/></FutureThing>\n");
+        const QList<DocUnknownElement> found = DocUnknownScan::scan(DocElementTable::eDocument::StateMachine, planted);
+        check((found.size() == 1) && (found.constFirst().name == QStringLiteral("FutureThing"))
+              && (found.constFirst().parent == QStringLiteral("StateList"))
+              && found.constFirst().text.contains(QStringLiteral("<Part/>")),
+              "a planted block is found with its place and text");
+
+        // Several requesters of one import get one parse and one document, and a prefetched
+        // document is handed out without being read again.
+        SMDocumentCache& imports = SMDocumentCache::getInstance();
+        imports.invalidate(openPath);
+        std::shared_ptr<const StateMachineData> shared[4];
+        std::vector<std::thread> requesters;
+        timer.restart();
+        for (std::shared_ptr<const StateMachineData>& result : shared)
+        {
+            requesters.emplace_back([&imports, &openPath, &result]() { result = imports.document(openPath); });
+        }
+
+        for (std::thread& requester : requesters)
+        {
+            requester.join();
+        }
+
+        report("four concurrent requests of a 5,000-state import", timer.elapsed(), BUDGET_ONESHOT_MS);
+        check((shared[0] != nullptr) && std::all_of(std::begin(shared), std::end(shared)
+              , [&shared](const std::shared_ptr<const StateMachineData>& doc) { return (doc == shared[0]); }),
+              "concurrent requesters share one parsed import");
+
+        imports.invalidate(openPath);
+        imports.prefetch(QStringList{ openPath });
+        const std::shared_ptr<const StateMachineData> prefetched = imports.document(openPath);
+        check((prefetched != nullptr) && (imports.document(openPath) == prefetched), "a prefetched import is parsed once");
+
+        // A watched import is resolved without asking the disk: neither the resolver's check that
+        // the file exists nor the cache lookup behind it stats the file. It is still dropped when
+        // its file is written.
+        DocFileWatcher& files = DocFileWatcher::getInstance();
+        check(files.isActive(), "the file watch is active under an application");
+        StateMachineData host;
+        host.setFilePath(outDir + QDir::separator() + QStringLiteral("sm27_host.fsml"));
+        const IncludeEntry* import = host.getIncludes().createInclude(QStringLiteral("./sm27_open.fsml"));
+        check((import != nullptr) && (SMImportResolver::resolve(host, *import).document == prefetched),
+              "the host resolves its import to the cached document");
+        QCoreApplication::processEvents();
+        const quint64 statsBefore = DocFileWatcher::getStatCount();
+        int misses = 0;
+        timer.restart();
+        for (int i = 0; (import != nullptr) && (i < REGISTRY_ENTRIES); ++i)
+        {
+            misses += (SMImportResolver::resolve(host, *import).document == prefetched) ? 0 : 1;
+        }
+
+        report("resolve a watched import 3,000 times", timer.elapsed(), BUDGET_INTERACTION_MS);
+        const quint64 statsTaken = DocFileWatcher::getStatCount() - statsBefore;
+        std::printf("  file checks for 3,000 resolutions: %llu\n", static_cast<unsigned long long>(statsTaken));
+        check((misses == 0) && (statsTaken == 0u), "a watched import is resolved without checking the file");
+
+        bool changed = false;
+        const QMetaObject::Connection onChanged = QObject::connect(&files, &DocFileWatcher::fileChanged, &files
+                                                                  , [&changed, &openPath](const QString& path)
+        {
+            changed = changed || (path == openPath);
+        });
+
+        QFile rewrite(openPath);
+        if (rewrite.open(QIODevice::WriteOnly))
+        {
+            rewrite.write(content);
+            rewrite.close();
+        }
+
+        QElapsedTimer wait;
+        wait.start();
+        while ((changed == false) && (wait.elapsed() < BUDGET_ONESHOT_MS))
+        {
+            QCoreApplication::processEvents();
+            QThread::msleep(10);
+        }
+
+        QObject::disconnect(onChanged);
+        check(changed && (imports.document(openPath) != prefetched), "a written import is read again");
+
+        // A dropped entry takes its file off the watch, so the next resolution checks the disk.
+        imports.clear();
+        const quint64 statsCleared = DocFileWatcher::getStatCount();
+        check((import != nullptr) && SMImportResolver::resolve(host, *import).isResolved()
+              && (DocFileWatcher::getStatCount() > statsCleared), "a cleared import is checked on the disk again");
+        imports.clear();
+
+        // A location that does not exist is noted for a while instead of being put on the watch,
+        // where it would be polled for the lifetime of the application.
+        const QString missingPath = QDir::cleanPath(outDir + QDir::separator() + QStringLiteral("sm27_missing.fsml"));
+        QFile::remove(missingPath);
+        const quint64 statsMissing = DocFileWatcher::getStatCount();
+        bool missingAnswered = true;
+        for (int i = 0; i < REGISTRY_ENTRIES; ++i)
+        {
+            missingAnswered = missingAnswered && (files.isFile(missingPath) == false);
+        }
+
+        check(missingAnswered && ((DocFileWatcher::getStatCount() - statsMissing) == 1u) && (files.isWatched(missingPath) == false)
+              , "a missing location is checked once and is not watched");
+    }
+
+    // The registries resolve their entries by ID and by name on every edit and every save,
+    // so a lookup must not walk the list. Every method of a 3,000-entry registry is resolved
+    // both ways; the batch is one interaction.
+    {
+        std::unique_ptr<StateMachineData> registryDoc = StateMachineData::createNewDocument(QStringLiteral("RegistryMachine"));
+        check(registryDoc != nullptr, "registry document built");
+        if (registryDoc != nullptr)
+        {
+            MethodDataSection& methods = registryDoc->getMethods();
+            methods.removeAll();
+            for (int i = 0; i < REGISTRY_ENTRIES; ++i)
+            {
+                methods.createMethod(QStringLiteral("Method%1").arg(i), NEMethod::SmAction);
+            }
+
+            const QList<MethodEntry*> entries = methods.getElements();
+            check(entries.size() == REGISTRY_ENTRIES, "registry holds every method");
+
+            int mismatches = 0;
+            timer.restart();
+            for (const MethodEntry* entry : entries)
+            {
+                if ((methods.findMethod(entry->getId()) != entry) || (methods.findMethod(entry->getName()) != entry))
+                {
+                    ++mismatches;
+                }
+            }
+
+            report("resolve every registry entry by ID and name", timer.elapsed(), BUDGET_INTERACTION_MS);
+            check(mismatches == 0, "every registry entry resolves to itself");
+
+            // The entry is renamed behind the container's back, the lookup must still follow it.
+            MethodEntry* renamed = entries.value(REGISTRY_ENTRIES / 2, nullptr);
+            if (renamed != nullptr)
+            {
+                const QString oldName = renamed->getName();
+                renamed->setName(QStringLiteral("RenamedMethod"));
+                check((methods.findMethod(QStringLiteral("RenamedMethod")) == renamed) && (methods.findMethod(oldName) == nullptr),
+                      "a renamed registry entry is found by its new name only");
+            }
+
+            // The XML order is the list order, the index must not change it.
+            bool ordered = true;
+            const QList<MethodEntry*>& after = methods.getElements();
+            for (int i = 0; ordered && (i < after.size()); ++i)
+            {
+                ordered = (after.at(i) == entries.at(i));
+            }
+
+            check(ordered, "the registry keeps its insertion order");
+        }
+    }
+
+    // Saving used to run every section through one QXmlStreamWriter, which builds a QString of
+    // every number and converts it to UTF-8 a second time. The layout, most of the bytes of a
+    // large machine, is now formatted straight into a buffer reserved at about its size. The old
+    // writer and the save are timed in turns on the same 5,000-state document with routed edges,
+    // compared on the medians of the runs, and must give the same bytes.
+    {
+        std::unique_ptr<StateMachineData> saveDoc = buildIndexDocument();
+        check(saveDoc != nullptr, "save-time document built");
+        if (saveDoc != nullptr)
+        {
+            QList<uint32_t> stateIds;
+            QList<uint32_t> transitionIds;
+            collectIds(saveDoc->getStates(), stateIds, transitionIds);
+            SMLayoutData& layout = saveDoc->getLayout();
+            for (int i = 0; i < transitionIds.size(); ++i)
+            {
+                SMLayoutEdge& edge = layout.addEdge(transitionIds.at(i));
+                edge.points = { QPointF(220.0 + (i % 20) * 220.0, 80.5 + (i / 20) * 0.25)
+                              , QPointF(240.0 + (i % 20) * 220.0, 80.5 + (i / 20) * 0.25) };
+                edge.hasLabel = true;
+                edge.label = QPointF(230.0 + (i % 20) * 220.0, 64.0 + (i % 7) / 3.0);
+            }
+
+            QList<qint64> qtWriter;
+            QList<qint64> direct;
+            QByteArray before;
+            QByteArray after;
+            for (int run = 0; run < GESTURE_RUNS; ++run)
+            {
+                timer.restart();
+                before.clear();
+                {
+                    QXmlStreamWriter xml(&before);
+                    xml.setAutoFormatting(true);
+                    xml.setAutoFormattingIndent(4);
+                    xml.writeStartDocument("1.0", true);
+                    saveDoc->writeToXml(xml);
+                }
+
+                before.append('\n');
+                qtWriter.append(timer.elapsed());
+
+                timer.restart();
+                after = saveDoc->writeToBuffer();
+                direct.append(timer.elapsed());
+            }
+
+            std::sort(qtWriter.begin(), qtWriter.end());
+            std::sort(direct.begin(), direct.end());
+            const qint64 qtMedian = qtWriter.at(qtWriter.size() / 2);
+            const qint64 directMedian = direct.at(direct.size() / 2);
+            std::printf("  save-time document: %lld KB, %d edges\n", static_cast<long long>(after.size() / 1024), static_cast<int>(transitionIds.size()));
+            std::printf("  write before: %lld ms median (%lld..%lld), after: %lld ms median (%lld..%lld)\n"
+                        , static_cast<long long>(qtMedian), static_cast<long long>(qtWriter.first()), static_cast<long long>(qtWriter.last())
+                        , static_cast<long long>(directMedian), static_cast<long long>(direct.first()), static_cast<long long>(direct.last()));
+            reportRuns("write a 5,000-state document to its bytes", direct, BUDGET_ONESHOT_MS);
+            check(directMedian <= qtMedian, "the direct writer is not slower than QXmlStreamWriter, median of the runs");
+            check(after == before, "the direct writer writes the bytes of QXmlStreamWriter");
+        }
+    }
+
+    // A save snapshot used to copy every state of the document. The states are now frozen as
+    // shared subtrees, and a snapshot after one edit copies the edited state alone and gives the
+    // states above it new nodes. The same edit is timed on the small document, so the gate is
+    // what the size of the document adds, and the copy of the whole tree is printed beside it.
+    {
+        std::unique_ptr<StateMachineData> shareDoc = buildIndexDocument();
+        std::unique_ptr<StateMachineData> shareSmall = buildSmallDocument();
+        check((shareDoc != nullptr) && (shareSmall != nullptr), "snapshot documents built");
+        if ((shareDoc != nullptr) && (shareSmall != nullptr))
+        {
+            // Edits the last state of the first nested level, so the node of its composite is
+            // rebuilt too, and returns the fastest snapshot of RUNS edits.
+            constexpr int RUNS { 3 };
+            auto timeSnapshot = [&timer](StateMachineData& doc, std::shared_ptr<const StateMachineData::SaveSnapshot>& snapshot) -> qint64
+            {
+                qint64 fastest = std::numeric_limits<qint64>::max();
+                snapshot = doc.takeSaveSnapshot();
+                const QList<SMStateEntry*>& rootStates = doc.getStates().getElements();
+                const SMStateData* nested = (rootStates.size() > 1) ? rootStates.at(1)->getNestedStates() : nullptr;
+                SMStateEntry* edited = ((nested != nullptr) && (nested->getElements().isEmpty() == false)) ? nested->getElements().last() : nullptr;
+                for (int run = 0; run < RUNS; ++run)
+                {
+                    if (edited != nullptr)
+                    {
+                        edited->setDescription(QStringLiteral("Edit %1").arg(run));
+                        doc.stateElementChanged(edited->getId());
+                    }
+
+                    timer.restart();
+                    snapshot = doc.takeSaveSnapshot();
+                    fastest = std::min(fastest, timer.elapsed());
+                }
+
+                return fastest;
+            };
+
+            QList<uint32_t> stateIds;
+            QList<uint32_t> transitionIds;
+            collectIds(shareDoc->getStates(), stateIds, transitionIds);
+
+            qint64 fullCopy = std::numeric_limits<qint64>::max();
+            for (int run = 0; run < RUNS; ++run)
+            {
+                timer.restart();
+                {
+                    SMStateData copy(shareDoc->getStates());
+                    copy.setParent(static_cast<ElementBase*>(nullptr));
+                }
+
+                fullCopy = std::min(fullCopy, timer.elapsed());
+            }
+
+            std::shared_ptr<const StateMachineData::SaveSnapshot> smallSnapshot;
+            std::shared_ptr<const StateMachineData::SaveSnapshot> snapshot;
+            const qint64 small = timeSnapshot(*shareSmall, smallSnapshot);
+            const qint64 shared = timeSnapshot(*shareDoc, snapshot);
+
+            std::printf("  snapshot of %d states, full copy: %lld ms, after one edit: %lld ms\n"
+                        , static_cast<int>(stateIds.size()), static_cast<long long>(fullCopy), static_cast<long long>(shared));
+            reportScaled("snapshot 5,000 states after one edit", shared, small);
+            check(snapshot->writeToBuffer() == shareDoc->writeToBuffer(), "a shared snapshot writes the document");
+            check(smallSnapshot->writeToBuffer() == shareSmall->writeToBuffer(), "a shared snapshot writes the small document");
+        }
+    }
+
     std::printf("---- %d checks, %d failure(s) ----\n", gChecks, gFailures);
     return (gFailures == 0) ? 0 : 1;
 }
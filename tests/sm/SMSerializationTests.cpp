@@ -26,12 +26,17 @@
  *
  ************************************************************************/
 
+#include "lusan/common/DocElementTable.hpp"
+#include "lusan/data/common/DocXmlWriter.hpp"
 #include "lusan/data/sm/StateMachineData.hpp"
+#include "lusan/data/sm/SMAutosaveJournal.hpp"
 #include "lusan/data/sm/SMState.hpp"
 #include "lusan/data/sm/SMTransition.hpp"
 #include "lusan/data/sm/SMCondition.hpp"
 #include "lusan/data/sm/SMOperation.hpp"
+#include "lusan/data/sm/SMSharedStates.hpp"
 #include "lusan/data/sm/SMMethodKind.hpp"
+#include "lusan/model/common/DocUnknownScan.hpp"
 
 #include <QByteArray>
 #include <QDir>
@@ -39,9 +44,15 @@
 #include <QString>
 #include <QThread>
 #include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <random>
+#include <thread>
 
 #ifndef LUSAN_TEST_DATA_DIR
 #define LUSAN_TEST_DATA_DIR "."
@@ -907,6 +918,507 @@ namespace
         CHECK(StateMachineData::removeAutosave(docPath));
         CHECK(StateMachineData::hasRecoverableAutosave(docPath) == false);
     }
+
+    // The journal holds the edited elements only; replayed into the snapshot it must give back
+    // the edited document, byte for byte once written again.
+    void testAutosaveJournal()
+    {
+        std::printf("[SM-05-EXT] autosave journal replays into the snapshot\n");
+
+        const QString docPath = outFile("sm05_journal_doc.fsml");
+        const QString autosavePath = StateMachineData::autosavePathForDocument(docPath);
+        const QString journalPath = SMAutosaveJournal::journalPathForDocument(docPath);
+
+        StateMachineData doc;
+        CHECK(doc.readFromFile(dataFile("FullFeature.fsml")));
+        CHECK(doc.writeToFile(docPath));
+        StateMachineData::removeAutosave(docPath);
+
+        QThread::msleep(20);
+
+        SMAutosaveJournal journal;
+        SMAutosaveJournal::Changes changes;
+        changes.full = true;
+        CHECK(journal.write(doc, docPath, changes));
+        CHECK(journal.lastWriteCompacted());
+        const QByteArray snapshot = readAllBytes(autosavePath);
+
+        // A renamed state, its moved box, a new note and an edited overview.
+        changes.clear();
+        const QList<SMStateEntry*>& states = doc.getStates().getElements();
+        SMStateEntry* state = states.isEmpty() ? nullptr : states.last();
+        CHECK(state != nullptr);
+        if (state != nullptr)
+        {
+            state->setName(state->getName() + QStringLiteral("Journaled"));
+            changes.elements.insert(state->getId());
+
+            SMLayoutNode* node = doc.getLayout().findNode(state->getId());
+            if (node != nullptr)
+            {
+                node->x += 40.0;
+                changes.owners.insert(state->getId());
+            }
+        }
+
+        SMLayoutNote& note = doc.getLayout().addNote(doc.getOverview().getId());
+        note.width  = 120.0;
+        note.height = 40.0;
+        note.text   = QStringLiteral("Journaled note");
+        changes.notes.insert(note.id);
+
+        doc.getOverview().setDescription(QStringLiteral("Journaled description"));
+        changes.sections.insert(static_cast<int>(SMAutosaveJournal::eSection::Overview));
+
+        CHECK(journal.write(doc, docPath, changes));
+        CHECK(journal.lastWriteCompacted() == false);
+        CHECK(journal.getRecordCount() > 0);
+        CHECK(readAllBytes(autosavePath) == snapshot);
+        CHECK(QFile::exists(journalPath));
+
+        // Detecting the autosave only looks at the files; recovering it folds the journal in.
+        CHECK(StateMachineData::hasRecoverableAutosave(docPath));
+        CHECK(QFile::exists(journalPath));
+        CHECK(readAllBytes(autosavePath) == snapshot);
+        CHECK(StateMachineData::recoverAutosave(docPath));
+        CHECK(QFile::exists(journalPath) == false);
+
+        StateMachineData recovered;
+        CHECK(recovered.readFromFile(autosavePath));
+        CHECK(recovered.writeToBuffer() == doc.writeToBuffer());
+
+        CHECK(StateMachineData::removeAutosave(docPath));
+        CHECK(QFile::exists(autosavePath) == false);
+    }
+
+    //!< The document the autosave of \p docPath recovers to. Replayed from a copy of the files,
+    //!< so the journal of \p docPath goes on taking autosaves.
+    QByteArray recoveredCopy(const QString& docPath, const QString& copyPath)
+    {
+        const QString autosavePath = StateMachineData::autosavePathForDocument(copyPath);
+        StateMachineData::removeAutosave(copyPath);
+        if ((QFile::copy(StateMachineData::autosavePathForDocument(docPath), autosavePath) == false)
+            || (QFile::copy(SMAutosaveJournal::journalPathForDocument(docPath), SMAutosaveJournal::journalPathForDocument(copyPath)) == false)
+            || (StateMachineData::recoverAutosave(copyPath) == false))
+        {
+            return QByteArray();
+        }
+
+        StateMachineData recovered;
+        const QByteArray result = recovered.readFromFile(autosavePath) ? recovered.writeToBuffer() : QByteArray();
+        StateMachineData::removeAutosave(copyPath);
+        return result;
+    }
+
+    // A crash in the middle of an append leaves the journal cut short, and a damaged disk leaves
+    // a record that fails its checksum. Either way the autosaves before it are recovered, and a
+    // journal of another snapshot is not applied at all.
+    void testAutosaveJournalDamage()
+    {
+        std::printf("[SM-05-EXT] a damaged autosave journal replays up to its last intact autosave\n");
+
+        const QString docPath = outFile("sm05_journal_damage.fsml");
+        const QString copyPath = outFile("sm05_journal_damage_copy.fsml");
+        const QString autosavePath = StateMachineData::autosavePathForDocument(docPath);
+        const QString journalPath = SMAutosaveJournal::journalPathForDocument(docPath);
+
+        StateMachineData doc;
+        CHECK(doc.readFromFile(dataFile("TrafficLight.fsml")));
+        CHECK(doc.writeToFile(docPath));
+        StateMachineData::removeAutosave(docPath);
+
+        SMAutosaveJournal journal;
+        SMAutosaveJournal::Changes changes;
+        changes.full = true;
+        CHECK(journal.write(doc, docPath, changes));
+        const QByteArray atSnapshot = doc.writeToBuffer();
+        const QByteArray snapshot = readAllBytes(autosavePath);
+
+        // Two autosaves: the first renames a state, the second describes it.
+        const QList<SMStateEntry*>& states = doc.getStates().getElements();
+        SMStateEntry* state = states.isEmpty() ? nullptr : states.last();
+        CHECK(state != nullptr);
+        if (state == nullptr)
+        {
+            return;
+        }
+
+        changes.clear();
+        state->setName(state->getName() + QStringLiteral("First"));
+        changes.elements.insert(state->getId());
+        CHECK(journal.write(doc, docPath, changes));
+        const QByteArray afterFirst = doc.writeToBuffer();
+        const qint64 firstSize = journal.getJournalSize();
+
+        changes.clear();
+        state->setDescription(QStringLiteral("Second autosave"));
+        changes.elements.insert(state->getId());
+        CHECK(journal.write(doc, docPath, changes));
+        CHECK(journal.lastWriteCompacted() == false);
+        const QByteArray journaled = readAllBytes(journalPath);
+        CHECK(journaled.size() > firstSize);
+        CHECK(recoveredCopy(docPath, copyPath) == doc.writeToBuffer());
+
+        // Cut before the commit of the second autosave.
+        CHECK(writeAllBytes(journalPath, journaled.left(journaled.size() - 3)));
+        CHECK(recoveredCopy(docPath, copyPath) == afterFirst);
+
+        // A flipped byte in the key of the first record of the second autosave.
+        QByteArray flipped = journaled;
+        flipped[firstSize + 8] = static_cast<char>(flipped.at(firstSize + 8) ^ 0x5A);
+        CHECK(writeAllBytes(journalPath, flipped));
+        CHECK(recoveredCopy(docPath, copyPath) == afterFirst);
+
+        // The snapshot was written again since the journal started: the journal names another.
+        CHECK(writeAllBytes(journalPath, journaled));
+        CHECK(writeAllBytes(autosavePath, snapshot + QByteArray("\n")));
+        CHECK(recoveredCopy(docPath, copyPath) == atSnapshot);
+
+        CHECK(StateMachineData::removeAutosave(docPath));
+    }
+
+    // Every change the journal takes, each replayed on its own while the journal goes on: states
+    // added and removed at the top and in a nested level, a nested level created, and
+    // transitions edited, added and removed.
+    void testAutosaveJournalStructure()
+    {
+        std::printf("[SM-05-EXT] the autosave journal replays added and removed states, nested levels and transitions\n");
+
+        const QString docPath = outFile("sm05_journal_structure.fsml");
+        const QString copyPath = outFile("sm05_journal_structure_copy.fsml");
+
+        StateMachineData doc;
+        CHECK(doc.readFromFile(dataFile("FullFeature.fsml")));
+        CHECK(doc.writeToFile(docPath));
+        StateMachineData::removeAutosave(docPath);
+
+        SMAutosaveJournal journal;
+        SMAutosaveJournal::Changes changes;
+        changes.full = true;
+        CHECK(journal.write(doc, docPath, changes));
+        changes.clear();
+
+        auto autosave = [&](const char* what)
+        {
+            check(journal.write(doc, docPath, changes) && (journal.lastWriteCompacted() == false), what);
+            check(recoveredCopy(docPath, copyPath) == doc.writeToBuffer(), what);
+            changes.clear();
+        };
+
+        // Operational (43) paints a nested level with Idle (50) and Paying (60).
+        SMStateEntry* operational = doc.findStateById(43u);
+        SMStateEntry* idle = doc.findStateById(50u);
+        SMStateEntry* paying = doc.findStateById(60u);
+        SMStateEntry* off = doc.findStateById(40u);
+        CHECK((operational != nullptr) && operational->hasNestedStates() && (idle != nullptr) && (paying != nullptr) && (off != nullptr));
+        if ((operational == nullptr) || (operational->hasNestedStates() == false) || (idle == nullptr) || (paying == nullptr) || (off == nullptr))
+        {
+            return;
+        }
+
+        SMStateData& nested = *operational->getNestedStates();
+        SMStateEntry* top = doc.getStates().createState(QStringLiteral("JournaledTop"), SMStateEntry::eStateKind::Normal);
+        CHECK(top != nullptr);
+        const uint32_t topId = (top != nullptr) ? top->getId() : 0u;
+        changes.elements.insert(topId);
+        autosave("a state added at the top level is journaled and replayed");
+
+        SMStateEntry* inner = nested.createState(QStringLiteral("JournaledInner"), SMStateEntry::eStateKind::Normal);
+        CHECK(inner != nullptr);
+        const uint32_t innerId = (inner != nullptr) ? inner->getId() : 0u;
+        changes.elements.insert(innerId);
+        autosave("a state added to a nested level is journaled and replayed");
+
+        idle->setName(QStringLiteral("IdleJournaled"));
+        changes.elements.insert(idle->getId());
+        autosave("a renamed nested state is journaled and replayed");
+
+        SMTransitionEntry* edited = nullptr;
+        for (SMTransitionEntry* transition : idle->getTransitions().getElements())
+        {
+            if ((transition != nullptr) && (transition->getId() == 54u))
+            {
+                edited = transition;
+            }
+        }
+
+        CHECK(edited != nullptr);
+        if (edited != nullptr)
+        {
+            edited->setStimulus(QStringLiteral("select_slot_journaled"));
+            changes.elements.insert(edited->getId());
+            autosave("an edited transition is journaled and replayed");
+        }
+
+        SMTransitionEntry* added = paying->getTransitions().createTransition(SMTransitionEntry::eStimulusKind::Trigger, QStringLiteral("journaled"), idle->getId());
+        CHECK(added != nullptr);
+        const uint32_t addedId = (added != nullptr) ? added->getId() : 0u;
+        changes.elements.insert(addedId);
+        autosave("an added transition is journaled and replayed");
+
+        SMTransitionEntry* removedTransition = nullptr;
+        CHECK(paying->getTransitions().removeElement(addedId, &removedTransition));
+        delete removedTransition;
+        changes.elements.insert(addedId);
+        autosave("a removed transition is journaled and replayed");
+
+        SMStateEntry* removedState = nullptr;
+        CHECK(nested.removeElement(innerId, &removedState));
+        delete removedState;
+        changes.elements.insert(innerId);
+        autosave("a state removed from a nested level is journaled and replayed");
+
+        removedState = nullptr;
+        CHECK(doc.getStates().removeElement(topId, &removedState));
+        delete removedState;
+        changes.elements.insert(topId);
+        autosave("a state removed from the top level is journaled and replayed");
+
+        SMStateEntry* created = off->getOrCreateNestedStates()->createState(QStringLiteral("OffInner"), SMStateEntry::eStateKind::Normal);
+        CHECK(created != nullptr);
+        changes.elements.insert((created != nullptr) ? created->getId() : 0u);
+        autosave("a nested level created under a state is journaled and replayed");
+
+        CHECK(StateMachineData::removeAutosave(docPath));
+    }
+
+    // A save written on another thread from a snapshot gives the bytes of a save written at once,
+    // whatever the document goes through after the snapshot is taken.
+    void testSaveSnapshot()
+    {
+        std::printf("[SM-05-EXT] a save snapshot writes the bytes of a direct save\n");
+
+        const char* const fixtures[]{ "TrafficLight.fsml", "FullFeature.fsml", "SubmachineDemo.fsml", "GuardDemo.fsml", "LegacyImports.fsml", "TurnCycle.fsml" };
+        for (const char* fixture : fixtures)
+        {
+            StateMachineData doc;
+            CHECK(doc.readFromFile(dataFile(fixture)));
+            CHECK(doc.takeSaveSnapshot()->writeToBuffer() == doc.writeToBuffer());
+        }
+
+        // Unknown elements inside a section and at the root after the layout.
+        QByteArray odd = readAllBytes(dataFile("TrafficLight.fsml"));
+        CHECK(replaceOnce(odd, "<TimerList>", "<TimerList>\n        <Time ID=\"901\" Name=\"Blink\"/>"));
+        CHECK(replaceOnce(odd, "</StateMachine>", "    <FutureSection Flag=\"x\"/>\n</StateMachine>"));
+        const QString oddPath = outFile("sm05_snapshot_unknown.fsml");
+        CHECK(writeAllBytes(oddPath, odd));
+        StateMachineData unknown;
+        CHECK(unknown.readFromFile(oddPath));
+        CHECK(unknown.getUnknownElements().size() == 2);
+        CHECK(unknown.takeSaveSnapshot()->writeToBuffer() == unknown.writeToBuffer());
+
+        // Without states and layout the root closes right after the sections.
+        StateMachineData empty;
+        CHECK(empty.takeSaveSnapshot()->writeToBuffer() == empty.writeToBuffer());
+
+        StateMachineData doc;
+        CHECK(doc.readFromFile(dataFile("FullFeature.fsml")));
+        const QByteArray before = doc.writeToBuffer();
+        std::shared_ptr<const StateMachineData::SaveSnapshot> snapshot = doc.takeSaveSnapshot();
+
+        const QList<SMStateEntry*>& states = doc.getStates().getElements();
+        SMStateEntry* state = states.isEmpty() ? nullptr : states.last();
+        CHECK(state != nullptr);
+        if (state != nullptr)
+        {
+            state->setName(state->getName() + QStringLiteral("Edited"));
+            SMLayoutNode* node = doc.getLayout().findNode(state->getId());
+            if (node != nullptr)
+            {
+                node->x += 40.0;
+            }
+        }
+
+        CHECK(doc.writeToBuffer() != before);
+
+        const QString outPath = outFile("sm05_snapshot_out.fsml");
+        bool written = false;
+        std::thread writer([&snapshot, &outPath, &written]() { written = snapshot->writeToFile(outPath); });
+        writer.join();
+        CHECK(written);
+        CHECK(readAllBytes(outPath) == before);
+    }
+
+    // The snapshots share the states no edit reported with the snapshot before. A changed state
+    // is copied again and the states above it get new nodes; every snapshot writes its own document.
+    void testSharedStates()
+    {
+        std::printf("[SM-05-EXT] save snapshots share the unchanged states\n");
+
+        StateMachineData doc;
+        CHECK(doc.readFromFile(dataFile("TrafficLight.fsml")));
+        SMStateEntry* deep = doc.findStateById(56);
+        CHECK(deep != nullptr);
+        if (deep == nullptr)
+            return;
+
+        SMSharedStates shared;
+        const SMSharedState::Level first = shared.freeze(doc.getStates());
+        CHECK(shared.getCopiedCount() == doc.getStateCount());
+        CHECK(shared.freeze(doc.getStates()) == first);
+        CHECK(shared.getCopiedCount() == 0);
+
+        // State 56 sits in LightOn (28): the top level shares every node but the one of LightOn,
+        // and that one keeps the copy of the state itself.
+        deep->setDescription(QStringLiteral("Shared"));
+        shared.elementChanged(56);
+        const SMSharedState::Level second = shared.freeze(doc.getStates());
+        CHECK(shared.getCopiedCount() == 1);
+        CHECK(second.size() == first.size());
+        for (int i = 0; (i < first.size()) && (i < second.size()); ++i)
+        {
+            if (first.at(i)->getId() == 28u)
+            {
+                CHECK(second.at(i) != first.at(i));
+                CHECK(&second.at(i)->getState() == &first.at(i)->getState());
+            }
+            else
+            {
+                CHECK(second.at(i) == first.at(i));
+            }
+        }
+
+        // A transition or an operation names the state it belongs to.
+        shared.elementChanged(61);
+        const SMSharedState::Level third = shared.freeze(doc.getStates());
+        CHECK(shared.getCopiedCount() == 1);
+
+        // A reordered level needs no report; an ID the states do not have unshares them all.
+        doc.getStates().moveElement(1, 2);
+        const SMSharedState::Level moved = shared.freeze(doc.getStates());
+        CHECK(shared.getCopiedCount() == 0);
+        CHECK((moved.size() > 2) && (third.size() > 2) && (moved.at(1) == third.at(2)) && (moved.at(2) == third.at(1)));
+        shared.elementChanged(0x7FFFFFFFu);
+        shared.freeze(doc.getStates());
+        CHECK(shared.getCopiedCount() == doc.getStateCount());
+
+        // The snapshots of a document taken around edits, reported and not.
+        StateMachineData saved;
+        CHECK(saved.readFromFile(dataFile("TrafficLight.fsml")));
+        const QByteArray before = saved.writeToBuffer();
+        std::shared_ptr<const StateMachineData::SaveSnapshot> snapshot = saved.takeSaveSnapshot();
+        CHECK(snapshot->writeToBuffer() == before);
+
+        SMStateEntry* renamed = saved.findStateById(56);
+        SMStateEntry* leaf = saved.findStateById(25);
+        CHECK((renamed != nullptr) && (leaf != nullptr));
+        if ((renamed == nullptr) || (leaf == nullptr))
+            return;
+
+        renamed->setName(renamed->getName() + QStringLiteral("Edited"));
+        saved.stateElementChanged(56);
+        saved.getStates().moveElement(1, 2);
+        std::shared_ptr<const StateMachineData::SaveSnapshot> next = saved.takeSaveSnapshot();
+        CHECK(next->writeToBuffer() == saved.writeToBuffer());
+
+        // A painted level without a real state is not written, then written once it has one.
+        SMStateData* nested = leaf->getOrCreateNestedStates();
+        std::shared_ptr<const StateMachineData::SaveSnapshot> dropped = saved.takeSaveSnapshot();
+        CHECK(dropped->writeToBuffer() == saved.writeToBuffer());
+        CHECK(nested->createState(QStringLiteral("Inner"), SMStateEntry::eStateKind::Normal) != nullptr);
+        std::shared_ptr<const StateMachineData::SaveSnapshot> painted = saved.takeSaveSnapshot();
+        CHECK(painted->writeToBuffer() == saved.writeToBuffer());
+        CHECK(painted->writeToBuffer() != dropped->writeToBuffer());
+
+        // The earlier snapshots still write the document as it was when they were taken.
+        CHECK(snapshot->writeToBuffer() == before);
+        CHECK(next->writeToBuffer() != before);
+    }
+
+    //!< The document as one auto-formatting QXmlStreamWriter writes it, every section through it.
+    QByteArray writeWithQt(const StateMachineData& doc)
+    {
+        QByteArray buffer;
+        {
+            QXmlStreamWriter xml(&buffer);
+            xml.setAutoFormatting(true);
+            xml.setAutoFormattingIndent(4);
+            xml.writeStartDocument("1.0", true);
+            doc.writeToXml(xml);
+        }
+
+        buffer = DocUnknownScan::restore(DocElementTable::eDocument::StateMachine, buffer, doc.getUnknownElements());
+        buffer.append('\n');
+        return buffer;
+    }
+
+    // The layout is written straight to UTF-8 and must give the bytes QXmlStreamWriter gives:
+    // the numbers as QString::number() formats them, the strings escaped alike.
+    void testDirectLayoutWriter()
+    {
+        std::printf("[SM-05-EXT] the direct layout writer writes the bytes of QXmlStreamWriter\n");
+
+        const double numbers[]{ 0.0, -0.0, 1.0, -1.0, 0.5, 64.0, 100.25, -3.75, 123.456789, 999999.0, 999999.5
+                              , 1000000.0, 1234565.0, 1234575.0, -245536.5, 27801.25, 0.0001, 0.00001, 1e-7, 1e21
+                              , 1.7976931348623157e308, 5e-324, std::numeric_limits<double>::infinity()
+                              , -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN() };
+        for (const double number : numbers)
+        {
+            QByteArray written;
+            DocXmlWriter::appendNumber(written, number);
+            CHECK(written == QString::number(number).toLatin1());
+        }
+
+        std::mt19937_64 random(49);
+        std::uniform_real_distribution<double> coordinate(-20000.0, 20000.0);
+        int mismatches{ 0 };
+        for (int i = 0; i < 100000; ++i)
+        {
+            // Grid positions, positions with a few decimals, and any bit pattern at all.
+            const double scale = static_cast<double>(1 << (i % 4));
+            const uint64_t bits = random();
+            double value{ 0.0 };
+            std::memcpy(&value, &bits, sizeof(value));
+            value = (i % 3 == 0) ? std::round(coordinate(random) * scale) / scale
+                  : (i % 3 == 1) ? coordinate(random)
+                  : value;
+            QByteArray written;
+            DocXmlWriter::appendNumber(written, value);
+            mismatches += (written == QString::number(value).toLatin1()) ? 0 : 1;
+        }
+
+        CHECK(mismatches == 0);
+
+        const char* const fixtures[]{ "TrafficLight.fsml", "FullFeature.fsml", "SubmachineDemo.fsml", "GuardDemo.fsml", "LegacyImports.fsml", "TurnCycle.fsml" };
+        for (const char* fixture : fixtures)
+        {
+            StateMachineData doc;
+            CHECK(doc.readFromFile(dataFile(fixture)));
+            CHECK(doc.writeToBuffer() == writeWithQt(doc));
+        }
+
+        // Strings the writer escapes itself, and the ones it leaves to Qt.
+        StateMachineData doc;
+        CHECK(doc.readFromFile(dataFile("TrafficLight.fsml")));
+        SMLayoutData& layout = doc.getLayout();
+        SMLayoutNode& node = layout.addNode(9001u);
+        node.x = -12.5;
+        node.y = 1234565.0;
+        node.color = QStringLiteral("#a&b\"<c>");
+        node.headerColor = QString::fromUtf8("gr\xc3\xbcn \xf0\x9f\x98\x80\ttab\nline\rreturn");
+        node.hasExpanded = true;
+        node.expanded = false;
+
+        SMLayoutEdge& edge = layout.addEdge(9002u);
+        edge.shape = SMLayoutEdge::eShape::Arc;
+        edge.bulge = -0.333333333;
+        edge.points = { QPointF(0.1, 0.2), QPointF(1e-5, 1e7) };
+        edge.hasLabel = true;
+        edge.label = QPointF(-0.0, 42.0);
+
+        const QString texts[]{ QString(), QStringLiteral("a & b < c > d \" e ' f"), QStringLiteral("line\nnext\ttab")
+                             , QStringLiteral("cr\r\nlf"), QStringLiteral("bell\x01") };
+        for (const QString& text : texts)
+        {
+            SMLayoutNote& note = layout.addNote(0u);
+            note.width = 120.0;
+            note.height = 48.0;
+            note.text = text;
+        }
+
+        CHECK(doc.writeToBuffer() == writeWithQt(doc));
+        CHECK(doc.takeSaveSnapshot()->writeToBuffer() == writeWithQt(doc));
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1352,6 +1864,12 @@ int main(int /*argc*/, char** /*argv*/)
     testRejectNewerMajor();
     testNewDocumentSkeleton();
     testAutosaveHelpers();
+    testAutosaveJournal();
+    testAutosaveJournalDamage();
+    testAutosaveJournalStructure();
+    testSaveSnapshot();
+    testSharedStates();
+    testDirectLayoutWriter();
     testEphemeralSubmachine();
     testHistoryModes();
     testLegacyMergedStart();